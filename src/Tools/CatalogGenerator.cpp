@@ -0,0 +1,613 @@
+/*!
+ * \file CatalogGenerator.cpp
+ * \brief Генератор синтетических каталогов TLE.
+ * \details
+ * Этот файл содержит отдельную консольную программу, которая записывает
+ * архив наборов элементов (2LE или 3LE) любого размера для нагрузочных
+ * и регрессионных проверок. Распределения элементов берутся из файлов-образцов
+ * (по умолчанию — примеров examples/), результат полностью определяется
+ * зерном генератора и параметрами и не зависит от платформы и стандартной
+ * библиотеки: используются только арифметические операции IEEE-754.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDate>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "Utils/TleUtils.hpp"
+#include "Utils/TleWriter.hpp"
+
+#ifdef Q_OS_WIN
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+
+constexpr int recordsPerBlock = 1 << 16; //! Записей в блоке одного потока
+constexpr int maxObjects = 339999;       //! Наибольший номер объекта в TLE (Alpha-5 "Z9999")
+constexpr int maxNameLength = 24;        //! Наибольшая длина имени объекта в 3LE
+constexpr double pi = 3.14159265358979323846;
+
+/*!
+ * \brief Seed - образец, задающий распределения элементов
+ */
+struct Seed
+{
+    QByteArray name;           //! Имя объекта (ASCII, может быть пустым)
+    int yearLaunch = 0;        //! Последние две цифры года запуска
+    int numberLaunch = 0;      //! Номер запуска
+    double epoch = 0.0;        //! Эпоха (секунды Unix)
+    double inclination = 0.0;  //! Наклонение (градусы)
+    double eccentricity = 0.0; //! Эксцентриситет
+    double meanMotion = 0.0;   //! Среднее движение (обращения в день)
+    double derivative = 0.0;   //! Первая производная среднего движения (rev/day^2)
+    double bstar = 0.0;        //! Коэффициент торможения B*
+};
+
+/*!
+ * \brief Settings - параметры генерации
+ */
+struct Settings
+{
+    qint64 count = 0;           //! Число записей
+    int objects = 0;            //! Число объектов (записи распределяются по ним поровну)
+    quint64 seed = 0;           //! Зерно генератора
+    bool withNames = true;      //! Формат 3LE
+    double start = 0.0;         //! Начало архива (секунды Unix)
+    double cadence = 1.0;       //! Период выпуска наборов одного объекта (сутки)
+    double duplicateRate = 0.0; //! Доля повторно выпущенных наборов (копий предыдущего)
+    double corruptRate = 0.0;   //! Доля испорченных записей
+};
+
+/*!
+ * \brief Block - часть записей, которую формирует один поток
+ */
+struct Block
+{
+    qint64 first = 0; //! Номер первой записи
+    int count = 0;    //! Число записей
+    QByteArray bytes; //! Текст записей
+};
+
+/*!
+ * \brief mix - перемешивание 64 бит (финализатор splitmix64)
+ */
+inline quint64 mix(quint64 value)
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/*!
+ * \brief exponent - e^x только арифметикой
+ * \details
+ * std::exp, std::log, std::cos и std::cbrt не обязаны округляться правильно
+ * и в последнем бите различаются между glibc, MSVC и macOS; при сотнях миллионов
+ * полей это меняет напечатанные цифры. Замены ниже используют только сложение,
+ * умножение, деление и точные ldexp/frexp, поэтому при IEEE-754 double без
+ * слияния операций в FMA (-ffp-contract=off) результат одинаков везде.
+ * Здесь e^x = 2^k · e^r, |r| ≤ ln 2 / 2, e^r — ряд Тейлора до r^17.
+ */
+double exponent(double x)
+{
+    constexpr double ln2 = 0.69314718055994530942;
+    const double k = std::floor(x / ln2 + 0.5);
+    const double r = x - k * ln2;
+    double sum = 1.0;
+    for (int i = 17; i > 0; --i)
+        sum = 1.0 + r * sum / i;
+    return std::ldexp(sum, int(k));
+}
+
+//! cos x для x из [0, pi] только арифметикой (ряд Тейлора до x^24 на [0, pi/2])
+double cosine(double x)
+{
+    const bool reflect = x > 0.5 * pi; //! cos x = -cos(pi - x)
+    const double y = reflect ? pi - x : x;
+    const double y2 = y * y;
+    double sum = 1.0;
+    for (int i = 12; i > 0; --i)
+        sum = 1.0 - y2 * sum / ((2 * i - 1) * (2 * i));
+    return reflect ? -sum : sum;
+}
+
+//! Кубический корень положительного числа: 2^(p/3) по двоичному порядку и метод Ньютона
+double cubeRoot(double x)
+{
+    int power = 0;
+    std::frexp(x, &power);
+    const int shift = int(std::floor(power / 3.0));
+    const double scaled = std::ldexp(x, -3 * shift); //! Из [0.5, 8), корень из [0.79, 2)
+    double root = 1.0 + (scaled - 1.0) / 6.0;
+    for (int i = 0; i < 8; ++i)
+        root -= (root * root * root - scaled) / (3.0 * root * root);
+    return std::ldexp(root, shift);
+}
+
+/*!
+ * \brief Random - генератор псевдослучайных чисел splitmix64
+ * \details
+ * Распределения реализованы здесь же, а не через <random>: распределения стандартной
+ * библиотеки различаются между реализациями, а результат должен зависеть только от зерна.
+ */
+class Random
+{
+public:
+    explicit Random(quint64 state)
+        : state_(state)
+    {}
+
+    //! Следующие 64 бита
+    quint64 next()
+    {
+        this->state_ += 0x9E3779B97F4A7C15ull;
+        return mix(this->state_);
+    }
+
+    //! Равномерное число из [0, 1)
+    double uniform() { return double(this->next() >> 11) * 0x1.0p-53; }
+
+    //! Равномерное целое из [0, bound)
+    int below(int bound) { return int((this->next() >> 32) * quint64(bound) >> 32); }
+
+    //! Приближённо нормальное N(0, 1): сумма 12 равномерных (Ирвин — Холл), только сложение
+    double normal()
+    {
+        double sum = -6.0;
+        for (int i = 0; i < 12; ++i)
+            sum += this->uniform();
+        return sum;
+    }
+
+private:
+    quint64 state_; //! Состояние
+};
+
+/*!
+ * \brief field - поле строки TLE по позициям (с нуля)
+ */
+QByteArray field(const QByteArray &line, int position, int length)
+{
+    return line.mid(position, length).trimmed();
+}
+
+/*!
+ * \brief readSeeds - образцы из файла TLE (2LE или 3LE)
+ * \details Строки без пары и с неверной длиной пропускаются: образцам нужны только значения полей.
+ */
+QVector<Seed> readSeeds(const QString &path)
+{
+    QVector<Seed> seeds;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return seeds;
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    for (int i = 0; i + 1 < lines.size(); ++i) {
+        const QByteArray line1 = lines[i].trimmed();
+        const QByteArray line2 = lines[i + 1].trimmed();
+        if (!line1.startsWith("1 ") || !line2.startsWith("2 ")
+            || line1.size() < TleWriter::lineLength || line2.size() < TleWriter::lineLength)
+            continue;
+
+        Seed seed;
+        const QByteArray name = i > 0 ? lines[i - 1].trimmed() : QByteArray();
+        if (!name.startsWith("1 ") && !name.startsWith("2 ")) {
+            //! Имена в TLE — ASCII; прочие байты заменяются на '?'
+            seed.name = (name.startsWith("0 ") ? name.mid(2) : name).left(maxNameLength);
+            for (char &c : seed.name)
+                if (uchar(c) >= 0x80)
+                    c = '?';
+        }
+        seed.yearLaunch = field(line1, 9, 2).toInt();
+        seed.numberLaunch = field(line1, 11, 3).toInt();
+        seed.epoch = double(TleUtils::epochToUnixMicros(field(line1, 18, 2).toInt(),
+                                                        field(line1, 20, 12).toDouble()))
+                     * 1e-6;
+        seed.derivative = field(line1, 33, 10).toDouble();
+        const QByteArray bstar = line1.mid(53, 8);
+        seed.bstar = TleUtils::parseTleExponent(TleText(bstar.constData(), bstar.size()));
+        seed.inclination = field(line2, 8, 8).toDouble();
+        seed.eccentricity = ("0." + field(line2, 26, 7)).toDouble();
+        seed.meanMotion = field(line2, 52, 11).toDouble();
+        if (seed.meanMotion > 0.0)
+            seeds.append(seed);
+        ++i;
+    }
+    return seeds;
+}
+
+/*!
+ * \brief Orbit - постоянные объекта
+ */
+struct Orbit
+{
+    QByteArray name;                 //! Имя объекта
+    int yearLaunch = 0;              //! Последние две цифры года запуска
+    double inclination = 0.0;        //! Наклонение (градусы)
+    double eccentricity = 0.0;       //! Эксцентриситет
+    double meanMotion = 0.0;         //! Среднее движение в начале архива (обращения в день)
+    double derivative = 0.0;         //! Первая производная среднего движения (rev/day^2)
+    double bstar = 0.0;              //! B*
+    double rightAscension = 0.0;     //! Долгота узла в начале архива (градусы)
+    double argPerigee = 0.0;         //! Аргумент перигея в начале архива (градусы)
+    double meanAnomaly = 0.0;        //! Средняя аномалия в начале архива (градусы)
+    double nodeRate = 0.0;           //! Прецессия узла (градусы в сутки)
+    double perigeeRate = 0.0;        //! Прецессия перигея (градусы в сутки)
+    double phase = 0.0;              //! Сдвиг эпох объекта внутри периода выпуска (доля периода)
+    int numberLaunch = 0;            //! Номер запуска
+    char piece[3] = {'A', ' ', ' '}; //! Часть запуска
+    int revolutions = 0;             //! Номер обращения в начале архива
+};
+
+/*!
+ * \brief Класс Generator
+ * \details
+ * Запись с номером i относится к объекту i % objects и к его набору i / objects:
+ * архив устроен как последовательность выпусков каталога, в каждом из которых
+ * все объекты встречаются по одному разу. Постоянные объекта и отклонения набора
+ * выводятся из зерна и номеров, а не из состояния генератора, поэтому любой блок
+ * записей строится независимо: результат не зависит от числа потоков.
+ *
+ * Между наборами объекта элементы меняются согласованно: средняя аномалия растёт
+ * со средним движением, узел и перигей прецессируют под действием J2, среднее
+ * движение меняется на величину первой производной.
+ */
+class Generator
+{
+public:
+    /*!
+     * \brief Generator - подготовка постоянных всех объектов
+     * \param seeds Образцы (не пустой набор)
+     * \param settings Параметры
+     */
+    Generator(const QVector<Seed> &seeds, const Settings &settings);
+
+    /*!
+     * \brief generate - текст записей [first, first + count)
+     * \param first Номер первой записи
+     * \param count Число записей
+     * \param out Выход: текст (дописывается)
+     */
+    void generate(qint64 first, int count, QByteArray &out) const;
+
+private:
+    //! Постоянные объекта по образцам
+    Orbit orbit(const QVector<Seed> &seeds, int object) const;
+
+    //! Запись одного набора объекта в буфер, возвращает конец записанного
+    char *format(int object, qint64 set, char *out) const;
+
+    //! Порча записи, начинающейся с begin; возвращает новый конец
+    char *corrupt(Random &random, char *begin, char *end) const;
+
+    Settings settings_;     //! Параметры
+    QVector<Orbit> orbits_; //! Постоянные объектов
+};
+
+Generator::Generator(const QVector<Seed> &seeds, const Settings &settings)
+    : settings_(settings)
+{
+    this->orbits_.reserve(settings.objects);
+    for (int object = 0; object < settings.objects; ++object)
+        this->orbits_.append(this->orbit(seeds, object));
+}
+
+Orbit Generator::orbit(const QVector<Seed> &seeds, int object) const
+{
+    Random random(mix(this->settings_.seed) ^ mix(2 * quint64(object) + 1));
+    const Seed &seed = seeds[random.below(int(seeds.size()))];
+    Orbit orbit;
+    orbit.name = seed.name.isEmpty() ? "OBJECT " + QByteArray::number(object + 1) : seed.name;
+    orbit.yearLaunch = seed.yearLaunch;
+
+    //! Элементы образца с небольшим разбросом: распределения каталога сохраняются
+    orbit.inclination = qBound(0.0, seed.inclination + 0.3 * random.normal(), 180.0);
+    orbit.eccentricity = qBound(0.0,
+                                (seed.eccentricity + 1e-5) * exponent(0.5 * random.normal()),
+                                0.95);
+    orbit.meanMotion = qBound(0.05, seed.meanMotion * (1.0 + 0.01 * random.normal()), 17.0);
+    const double dragScale = exponent(0.5 * random.normal());
+    orbit.derivative = seed.derivative * dragScale;
+    orbit.bstar = seed.bstar * dragScale;
+    orbit.rightAscension = 360.0 * random.uniform();
+    orbit.argPerigee = 360.0 * random.uniform();
+    orbit.meanAnomaly = 360.0 * random.uniform();
+    orbit.phase = 0.25 + 0.5 * random.uniform();
+    orbit.numberLaunch = qBound(1, seed.numberLaunch + random.below(41) - 20, 999);
+    orbit.piece[0] = char('A' + random.below(26));
+    if (random.uniform() < 0.3)
+        orbit.piece[1] = char('A' + random.below(26));
+    orbit.revolutions = random.below(50000);
+
+    //! Вековой уход узла и перигея из-за сжатия Земли (J2)
+    constexpr double j2 = 1.082616e-3;
+    constexpr double earthRadius = 6378.135;
+    constexpr double earthMu = 398600.8;
+    const double n = orbit.meanMotion * 2.0 * pi / 86400.0; //! рад/с
+    const double a = cubeRoot(earthMu / (n * n));
+    const double p = a * (1.0 - orbit.eccentricity * orbit.eccentricity);
+    const double factor = 1.5 * j2 * (earthRadius / p) * (earthRadius / p) * orbit.meanMotion * 360.0;
+    const double cosI = cosine(orbit.inclination * pi / 180.0);
+    orbit.nodeRate = -factor * cosI;
+    orbit.perigeeRate = 0.5 * factor * (5.0 * cosI * cosI - 1.0);
+    return orbit;
+}
+
+char *Generator::format(int object, qint64 set, char *out) const
+{
+    const Orbit &orbit = this->orbits_[object];
+    //! Отклонения набора малы, поэтому берутся равномерными: без логарифмов и косинусов
+    Random random(mix(mix(this->settings_.seed) ^ mix(2 * quint64(object) + 1)) ^ mix(quint64(set)));
+    //! Эпоха — внутри своего периода выпуска, поэтому эпохи объекта возрастают
+    const double cadence = this->settings_.cadence;
+    const double days = (double(set) + orbit.phase + 0.4 * (random.uniform() - 0.5)) * cadence;
+    const double epoch = this->settings_.start + days * 86400.0;
+
+    TleRecord record;
+    const char classification = 'U';
+    record.catalogNumber = object + 1;
+    record.classification = TleText(&classification, 1);
+    record.yearLaunch = orbit.yearLaunch;
+    record.numberLaunch = orbit.numberLaunch;
+    record.launchPiece = TleText(orbit.piece, orbit.piece[1] == ' ' ? 1 : 2);
+    TleUtils::unixMicrosToEpoch(qint64(std::llround(epoch * 1e6)),
+                                record.epochYearSuffix,
+                                record.epochTime);
+    record.meanMotionFirstDerivative = orbit.derivative;
+    char bstar[8];
+    TleWriter::formatExponent(orbit.bstar * (1.0 + 0.1 * (random.uniform() - 0.5)), bstar);
+    record.brakingCoefficient = TleText(bstar, 8);
+    record.elementSetNumber = int(set % 999) + 1;
+
+    const double meanMotion = orbit.meanMotion + 2.0 * orbit.derivative * days;
+    record.meanMotion = qBound(0.05, meanMotion, 17.0);
+    record.inclination = qBound(0.0, orbit.inclination + 2e-4 * (random.uniform() - 0.5), 180.0);
+    record.eccentricity = qBound(0.0, orbit.eccentricity * (1.0 + 2e-3 * (random.uniform() - 0.5)), 0.9999999);
+    record.rightAscension = std::fmod(orbit.rightAscension + orbit.nodeRate * days + 3600.0, 360.0);
+    record.argPerigee = std::fmod(orbit.argPerigee + orbit.perigeeRate * days + 3600.0, 360.0);
+    const double revolutions = (orbit.meanMotion + orbit.derivative * days) * days;
+    record.meanAnomaly = std::fmod(orbit.meanAnomaly + 360.0 * (revolutions - std::floor(revolutions)),
+                                   360.0);
+    record.revolutionNumberOfEpoch = int((orbit.revolutions + qint64(revolutions)) % 100000);
+
+    if (this->settings_.withNames) {
+        std::memcpy(out, orbit.name.constData(), size_t(orbit.name.size()));
+        out += orbit.name.size();
+        *out++ = '\n';
+    }
+    TleWriter::formatLine1(record, out);
+    out[TleWriter::lineLength] = '\n';
+    out += TleWriter::lineLength + 1;
+    TleWriter::formatLine2(record, out);
+    out[TleWriter::lineLength] = '\n';
+    return out + TleWriter::lineLength + 1;
+}
+
+char *Generator::corrupt(Random &random, char *begin, char *end) const
+{
+    constexpr int lineBytes = TleWriter::lineLength + 1;
+    char *line2 = end - lineBytes;
+    char *line1 = line2 - lineBytes;
+    switch (random.below(6)) {
+    case 0: //! Неверная контрольная сумма первой строки
+        line1[68] = char('0' + (line1[68] - '0' + 1 + random.below(9)) % 10);
+        return end;
+    case 1: //! Неверная контрольная сумма второй строки
+        line2[68] = char('0' + (line2[68] - '0' + 1 + random.below(9)) % 10);
+        return end;
+    case 2: //! Посторонний символ в числовом поле
+        line2[8 + random.below(55)] = char('a' + random.below(26));
+        return end;
+    case 3: { //! Обрезанная вторая строка
+        const int length = 10 + random.below(TleWriter::lineLength - 10);
+        line2[length] = '\n';
+        return line2 + length + 1;
+    }
+    case 4: //! Пропущенная вторая строка
+        return line2;
+    default: { //! Посторонняя строка перед записью
+        static const char junk[] = "# malformed: this line is not part of a TLE\n";
+        const int size = int(sizeof(junk)) - 1;
+        std::memmove(begin + size, begin, size_t(end - begin));
+        std::memcpy(begin, junk, size_t(size));
+        return end + size;
+    }
+    }
+}
+
+void Generator::generate(qint64 first, int count, QByteArray &out) const
+{
+    //! Запас: имя, две строки и посторонняя строка
+    const int recordBytes = maxNameLength + 16 + 2 * (TleWriter::lineLength + 1) + 64;
+    const int start = int(out.size());
+    out.resize(start + count * recordBytes);
+    char *position = out.data() + start;
+
+    const int objects = this->settings_.objects;
+    int object = int(first % objects);
+    qint64 set = first / objects;
+    for (int k = 0; k < count; ++k) {
+        if (k > 0 && ++object == objects) {
+            object = 0;
+            ++set;
+        }
+        //! Повторный выпуск: копия предыдущего набора объекта с той же эпохой
+        Random random(mix(this->settings_.seed ^ 0x5EED5EED5EED5EEDull) ^ mix(quint64(first + k)));
+        const qint64 issued = set > 0 && random.uniform() < this->settings_.duplicateRate ? set - 1
+                                                                                          : set;
+        char *begin = position;
+        position = this->format(object, issued, position);
+        if (random.uniform() < this->settings_.corruptRate)
+            position = this->corrupt(random, begin, position);
+    }
+    out.resize(int(position - out.constData()));
+}
+
+} // namespace
+
+/*!
+ * \brief main - точка входа генератора.
+ * \param argc Количество аргументов командной строки.
+ * \param argv Массив аргументов командной строки.
+ * \return 0, если каталог записан полностью.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser; //! Разбор аргументов командной строки
+    parser.setApplicationDescription(QStringLiteral("Генератор синтетических каталогов TLE"));
+    parser.addHelpOption();
+    parser.addOption({{QStringLiteral("n"), QStringLiteral("count")},
+                      QStringLiteral("Число записей."),
+                      QStringLiteral("count"),
+                      QStringLiteral("1000000")});
+    parser.addOption({{QStringLiteral("o"), QStringLiteral("output")},
+                      QStringLiteral("Файл результата (по умолчанию — стандартный вывод)."),
+                      QStringLiteral("path")});
+    parser.addOption({QStringLiteral("format"),
+                      QStringLiteral("Формат: 3le (с именами) или 2le."),
+                      QStringLiteral("format"),
+                      QStringLiteral("3le")});
+    parser.addOption({QStringLiteral("seed"),
+                      QStringLiteral("Зерно генератора."),
+                      QStringLiteral("seed"),
+                      QStringLiteral("1")});
+    parser.addOption({QStringLiteral("samples"),
+                      QStringLiteral("Файл-образец с распределениями элементов (можно указать "
+                                     "несколько раз; по умолчанию — примеры из examples/)."),
+                      QStringLiteral("path")});
+    parser.addOption({QStringLiteral("objects"),
+                      QStringLiteral("Число объектов (по умолчанию — не больше 20000)."),
+                      QStringLiteral("count")});
+    parser.addOption({QStringLiteral("start"),
+                      QStringLiteral("Дата начала архива yyyy-MM-dd (по умолчанию архив "
+                                     "заканчивается на самой поздней эпохе образцов)."),
+                      QStringLiteral("date")});
+    parser.addOption({QStringLiteral("cadence"),
+                      QStringLiteral("Период выпуска наборов одного объекта (сутки)."),
+                      QStringLiteral("days"),
+                      QStringLiteral("1")});
+    parser.addOption({QStringLiteral("duplicates"),
+                      QStringLiteral("Доля повторно выпущенных наборов (0..1)."),
+                      QStringLiteral("rate"),
+                      QStringLiteral("0.01")});
+    parser.addOption({QStringLiteral("corrupt"),
+                      QStringLiteral("Доля испорченных записей (0..1)."),
+                      QStringLiteral("rate"),
+                      QStringLiteral("0")});
+    parser.process(app);
+
+    //! Образцы
+    QStringList samples = parser.values(QStringLiteral("samples"));
+    if (samples.isEmpty()) {
+        const QDir examples(QStringLiteral(SATELLITES_EXAMPLES_DIR));
+        for (const QString &name :
+             examples.entryList({QStringLiteral("example*.txt")}, QDir::Files, QDir::Name))
+            samples.append(examples.filePath(name));
+    }
+    QVector<Seed> seeds;
+    for (const QString &path : std::as_const(samples))
+        seeds += readSeeds(path);
+    if (seeds.isEmpty()) {
+        err << "Нет образцов: укажите файл TLE в --samples\n";
+        return 1;
+    }
+
+    Settings settings;
+    settings.count = qMax<qint64>(0, parser.value(QStringLiteral("count")).toLongLong());
+    settings.seed = parser.value(QStringLiteral("seed")).toULongLong();
+    settings.withNames = parser.value(QStringLiteral("format")).toLower() != QStringLiteral("2le");
+    settings.objects = parser.isSet(QStringLiteral("objects"))
+                           ? parser.value(QStringLiteral("objects")).toInt()
+                           : int(qMin<qint64>(settings.count, 20000));
+    settings.objects = qBound(1, settings.objects, maxObjects);
+    settings.cadence = qMax(1e-3, parser.value(QStringLiteral("cadence")).toDouble());
+    settings.duplicateRate = qBound(0.0, parser.value(QStringLiteral("duplicates")).toDouble(), 1.0);
+    settings.corruptRate = qBound(0.0, parser.value(QStringLiteral("corrupt")).toDouble(), 1.0);
+    const qint64 sets = (settings.count + settings.objects - 1) / settings.objects;
+    if (parser.isSet(QStringLiteral("start"))) {
+        const QDate date = QDate::fromString(parser.value(QStringLiteral("start")), Qt::ISODate);
+        if (!date.isValid()) {
+            err << "Неверная дата в --start\n";
+            return 1;
+        }
+        settings.start = double(TleUtils::daysFromCivil(date.year(), date.month(), date.day()))
+                         * 86400.0;
+    } else {
+        double latest = seeds.first().epoch;
+        for (const Seed &seed : std::as_const(seeds))
+            latest = qMax(latest, seed.epoch);
+        settings.start = std::floor(latest / 86400.0 - double(sets) * settings.cadence) * 86400.0;
+    }
+
+    QFile output;
+    const bool toFile = parser.isSet(QStringLiteral("output"));
+    if (toFile) {
+        output.setFileName(parser.value(QStringLiteral("output")));
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            err << "Не удалось открыть файл для записи: " << output.fileName() << '\n';
+            return 1;
+        }
+    } else {
+#ifdef Q_OS_WIN
+        _setmode(_fileno(stdout), _O_BINARY); //! Без замены \n на \r\n: вывод совпадает с файлом
+#endif
+        if (!output.open(stdout, QIODevice::WriteOnly)) {
+            err << "Не удалось открыть стандартный вывод\n";
+            return 1;
+        }
+    }
+
+    //! Блоки считаются пачками во всех потоках и записываются по порядку
+    const Generator generator(seeds, settings);
+    const int batchSize = 2 * qMax(1, QThread::idealThreadCount());
+    QVector<Block> blocks;
+    QElapsedTimer timer;
+    timer.start();
+    qint64 written = 0;
+    for (qint64 first = 0; first < settings.count;) {
+        blocks.resize(0);
+        for (int i = 0; i < batchSize && first < settings.count; ++i) {
+            const int count = int(qMin<qint64>(recordsPerBlock, settings.count - first));
+            blocks.append({first, count, {}});
+            first += count;
+        }
+        QtConcurrent::blockingMap(blocks, [&generator](Block &block) {
+            generator.generate(block.first, block.count, block.bytes);
+        });
+        for (const Block &block : std::as_const(blocks)) {
+            if (output.write(block.bytes) != block.bytes.size()) {
+                err << "Ошибка записи: " << output.errorString() << '\n';
+                return 1;
+            }
+            written += block.bytes.size();
+        }
+    }
+    output.close();
+
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    err << "Записей: " << settings.count << ", объектов: " << settings.objects
+        << ", образцов: " << seeds.size() << ", " << QString::number(written / 1e6, 'f', 1)
+        << " МБ за " << QString::number(seconds, 'f', 2) << " с ("
+        << QString::number(written / 1e6 / qMax(seconds, 1e-9), 'f', 0) << " МБ/с)\n";
+    return 0;
+}
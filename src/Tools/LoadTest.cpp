@@ -0,0 +1,225 @@
+/*!
+ * \file LoadTest.cpp
+ * \brief Нагрузочный клиент для сервера каталога.
+ * \details
+ * Этот файл содержит отдельную консольную программу, которая открывает несколько
+ * постоянных соединений с сервером (Satellites --serve), отправляет запросы
+ * и выводит пропускную способность и распределение задержек (p50, p90, p99).
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTcpSocket>
+#include <QTextStream>
+#include <QVector>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/*!
+ * \brief Connection - одно постоянное соединение с сервером
+ * \details В каждом соединении одновременно находится не более одного запроса.
+ */
+struct Connection
+{
+    QTcpSocket socket;     //! Сокет соединения
+    QByteArray buffer;     //! Непрочитанная часть ответа
+    qint64 sentAt = 0;     //! Время отправки текущего запроса (нс)
+    int nextPath = 0;      //! Индекс следующего запроса в списке путей
+    bool finished = false; //! Соединение закрыто
+};
+
+/*!
+ * \brief responseSize - размер полного ответа в буфере
+ * \param buffer Полученные данные
+ * \param status Код ответа HTTP
+ * \return Размер ответа или -1, если ответ получен не полностью
+ */
+qint64 responseSize(const QByteArray &buffer, int &status)
+{
+    const auto headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0)
+        return -1;
+    const QByteArray headers = buffer.left(headerEnd).toLower();
+    status = headers.mid(9, 3).toInt(); //! "http/1.1 200 ok"
+    qint64 contentLength = 0;
+    const auto lengthPos = headers.indexOf("content-length:");
+    if (lengthPos >= 0) {
+        const auto lineEnd = headers.indexOf('\r', lengthPos);
+        contentLength = headers.mid(lengthPos + 15, lineEnd < 0 ? -1 : lineEnd - lengthPos - 15)
+                            .trimmed()
+                            .toLongLong();
+    }
+    const qint64 total = headerEnd + 4 + contentLength;
+    return buffer.size() >= total ? total : -1;
+}
+
+/*!
+ * \brief percentile - процентиль отсортированной выборки
+ * \param sorted Отсортированные значения
+ * \param p Процентиль (0..100)
+ */
+qint64 percentile(const QVector<qint64> &sorted, double p)
+{
+    if (sorted.isEmpty())
+        return 0;
+    const int index = std::min(int(sorted.size()) - 1, int(p / 100.0 * sorted.size()));
+    return sorted[index];
+}
+
+} // namespace
+
+/*!
+ * \brief main - точка входа нагрузочного клиента.
+ * \param argc Количество аргументов командной строки.
+ * \param argv Массив аргументов командной строки.
+ * \return 0, если все запросы выполнены успешно.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    QCommandLineParser parser; //! Разбор аргументов командной строки
+    parser.setApplicationDescription(QStringLiteral("Нагрузочный клиент для Satellites --serve"));
+    parser.addHelpOption();
+    parser.addOption({QStringLiteral("host"),
+                      QStringLiteral("Адрес сервера."),
+                      QStringLiteral("host"),
+                      QStringLiteral("127.0.0.1")});
+    parser.addOption({{QStringLiteral("p"), QStringLiteral("port")},
+                      QStringLiteral("Порт сервера."),
+                      QStringLiteral("port"),
+                      QStringLiteral("8080")});
+    parser.addOption({{QStringLiteral("c"), QStringLiteral("connections")},
+                      QStringLiteral("Число одновременных соединений."),
+                      QStringLiteral("count"),
+                      QStringLiteral("8")});
+    parser.addOption({{QStringLiteral("n"), QStringLiteral("requests")},
+                      QStringLiteral("Общее число запросов."),
+                      QStringLiteral("count"),
+                      QStringLiteral("100000")});
+    parser.addOption({QStringLiteral("path"),
+                      QStringLiteral("Путь запроса (можно указать несколько раз)."),
+                      QStringLiteral("path")});
+    parser.process(app);
+
+    const QString host = parser.value(QStringLiteral("host"));
+    const quint16 port = quint16(parser.value(QStringLiteral("port")).toUInt());
+    const int connectionCount = std::max(1, parser.value(QStringLiteral("connections")).toInt());
+    const int totalRequests = std::max(1, parser.value(QStringLiteral("requests")).toInt());
+    QStringList paths = parser.values(QStringLiteral("path"));
+    if (paths.isEmpty())
+        paths = {QStringLiteral("/stats"),
+                 QStringLiteral("/objects/25544"),
+                 QStringLiteral("/objects?inclination=97..99&limit=10"),
+                 QStringLiteral("/histogram?field=perigee&bins=50")};
+
+    //! Запросы подготавливаются заранее, чтобы не влиять на измерения
+    QVector<QByteArray> requests;
+    for (const QString &path : std::as_const(paths))
+        requests.append("GET " + path.toUtf8() + " HTTP/1.1\r\nHost: " + host.toUtf8()
+                        + "\r\nConnection: keep-alive\r\n\r\n");
+
+    QVector<qint64> latencies; //! Задержки всех запросов (нс)
+    latencies.reserve(totalRequests);
+    int sent = 0;
+    int failed = 0;
+    int openConnections = connectionCount;
+    QElapsedTimer clock;
+
+    std::vector<std::unique_ptr<Connection>> connections;
+    for (int i = 0; i < connectionCount; ++i)
+        connections.push_back(std::make_unique<Connection>());
+
+    //! Отправка следующего запроса по соединению; если запросы закончились — закрытие
+    auto sendNext = [&](Connection *connection) {
+        if (sent >= totalRequests) {
+            connection->socket.disconnectFromHost();
+            return;
+        }
+        ++sent;
+        connection->sentAt = clock.nsecsElapsed();
+        connection->socket.write(requests[connection->nextPath]);
+        connection->nextPath = (connection->nextPath + 1) % int(requests.size());
+    };
+
+    //! Учёт закрытого соединения; после закрытия всех соединений клиент завершается
+    auto finishConnection = [&](Connection *connection) {
+        if (connection->finished)
+            return;
+        connection->finished = true;
+        if (--openConnections == 0)
+            app.quit();
+    };
+
+    for (int i = 0; i < connectionCount; ++i) {
+        Connection *connection = connections[i].get();
+        connection->nextPath = i % int(requests.size());
+
+        QObject::connect(&connection->socket, &QTcpSocket::connected, [&, connection]() {
+            //! Отключаем алгоритм Нейгла, иначе задержка определяется таймером ACK
+            connection->socket.setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            sendNext(connection);
+        });
+        QObject::connect(&connection->socket, &QTcpSocket::readyRead, [&, connection]() {
+            connection->buffer.append(connection->socket.readAll());
+            int status = 0;
+            const qint64 size = responseSize(connection->buffer, status);
+            if (size < 0)
+                return; //! Ответ ещё не получен полностью
+            latencies.append(clock.nsecsElapsed() - connection->sentAt);
+            if (status != 200)
+                ++failed;
+            connection->buffer.remove(0, int(size));
+            sendNext(connection);
+        });
+        QObject::connect(&connection->socket, &QTcpSocket::disconnected, [&, connection]() {
+            finishConnection(connection);
+        });
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        const auto errorSignal = &QAbstractSocket::errorOccurred;
+#else
+        const auto errorSignal = QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error);
+#endif
+        QObject::connect(&connection->socket, errorSignal, [&, connection]() {
+            //! Закрытие соединения после последнего запроса ошибкой не считается
+            if (sent < totalRequests)
+                QTextStream(stderr) << connection->socket.errorString() << '\n';
+            if (connection->socket.state() == QAbstractSocket::UnconnectedState)
+                finishConnection(connection);
+        });
+    }
+
+    clock.start();
+    for (const auto &connection : connections)
+        connection->socket.connectToHost(host, port);
+    app.exec();
+
+    const double seconds = clock.nsecsElapsed() / 1e9;
+    std::sort(latencies.begin(), latencies.end());
+    out << "Запросов:       " << latencies.size() << " из " << totalRequests << '\n'
+        << "Ошибок:         " << failed << '\n'
+        << "Соединений:     " << connectionCount << '\n'
+        << "Время:          " << QString::number(seconds, 'f', 3) << " с\n"
+        << "Запросов/с:     " << QString::number(latencies.size() / seconds, 'f', 0) << '\n'
+        << "Задержка p50:   " << QString::number(percentile(latencies, 50) / 1000.0, 'f', 1)
+        << " мкс\n"
+        << "Задержка p90:   " << QString::number(percentile(latencies, 90) / 1000.0, 'f', 1)
+        << " мкс\n"
+        << "Задержка p99:   " << QString::number(percentile(latencies, 99) / 1000.0, 'f', 1)
+        << " мкс\n"
+        << "Задержка max:   "
+        << QString::number((latencies.isEmpty() ? 0 : latencies.last()) / 1000.0, 'f', 1)
+        << " мкс\n";
+    out.flush();
+
+    return failed == 0 && latencies.size() == totalRequests ? 0 : 1;
+}
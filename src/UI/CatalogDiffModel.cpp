@@ -0,0 +1,112 @@
+/*!
+ * \file CatalogDiffModel.cpp
+ * \brief Модель списка изменений каталога
+ * \details
+ * Этот файл содержит реализацию класса CatalogDiffModel.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "CatalogDiffModel.hpp"
+
+#include <QStringList>
+
+CatalogDiffModel::CatalogDiffModel(const CatalogDiffResult &result, QObject *parent)
+    : QAbstractTableModel(parent)
+    , result_(result)
+{}
+
+int CatalogDiffModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(this->result_.changes.size());
+}
+
+int CatalogDiffModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QString CatalogDiffModel::changeText(const CatalogChange &change)
+{
+    switch (change.type) {
+    case ChangeType::Added:
+        return tr("Новый");
+    case ChangeType::Removed:
+        return tr("Исчез");
+    case ChangeType::Changed:
+        break;
+    }
+    QStringList fields; //! Список изменившихся полей
+    if (change.fields & InclinationChanged)
+        fields << tr("наклонение");
+    if (change.fields & MeanMotionChanged)
+        fields << tr("среднее движение");
+    if (change.fields & EccentricityChanged)
+        fields << tr("эксцентриситет");
+    return tr("Изменён: %1").arg(fields.join(QLatin1String(", ")));
+}
+
+QString CatalogDiffModel::cellText(int row, int column) const
+{
+    const CatalogChange &change = this->result_.changes[row];
+    const TleRecord *before = change.oldIndex >= 0 ? &this->result_.oldCatalog[change.oldIndex]
+                                                   : nullptr;
+    const TleRecord *after = change.newIndex >= 0 ? &this->result_.newCatalog[change.newIndex]
+                                                  : nullptr;
+
+    //! Значение поля: разность для изменившихся объектов, иначе само значение
+    auto valueText = [before, after](double TleRecord::*field, int precision) {
+        if (before && after)
+            return QString::number(after->*field - before->*field, 'f', precision);
+        return QString::number((before ? before : after)->*field, 'f', precision);
+    };
+
+    switch (column) {
+    case CatalogNumberColumn:
+        return QString::number(change.catalogNumber);
+    case NameColumn:
+        return (after ? after : before)->name.trimmed().toString();
+    case ChangeColumn:
+        return changeText(change);
+    case InclinationColumn:
+        return valueText(&TleRecord::inclination, 4);
+    case MeanMotionColumn:
+        return valueText(&TleRecord::meanMotion, 8);
+    case EccentricityColumn:
+        return valueText(&TleRecord::eccentricity, 7);
+    default:
+        break;
+    }
+    return QString();
+}
+
+QVariant CatalogDiffModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+    return this->cellText(index.row(), index.column());
+}
+
+QVariant CatalogDiffModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+    case CatalogNumberColumn:
+        return tr("Номер");
+    case NameColumn:
+        return tr("Имя");
+    case ChangeColumn:
+        return tr("Изменение");
+    case InclinationColumn:
+        return tr("Наклонение (Δ°)");
+    case MeanMotionColumn:
+        return tr("Среднее движение (Δ об/сут)");
+    case EccentricityColumn:
+        return tr("Эксцентриситет (Δ)");
+    default:
+        break;
+    }
+    return QVariant();
+}
@@ -0,0 +1,72 @@
+/*!
+ * \file CatalogDiffModel.hpp
+ * \brief Заголовочный файл для модели списка изменений каталога
+ * \details
+ * Этот файл содержит определение класса CatalogDiffModel — табличной модели,
+ * которая отображает результат CatalogDiff без копирования данных в элементы модели.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef CATALOGDIFFMODEL_HPP
+#define CATALOGDIFFMODEL_HPP
+
+#include <QAbstractTableModel>
+
+#include "Utils/CatalogDiff.hpp"
+
+/*!
+ * \brief Класс CatalogDiffModel
+ * \details
+ * Значения ячеек вычисляются по запросу представления, поэтому модель
+ * подходит и для списков из миллионов изменений.
+ */
+class CatalogDiffModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    //! Столбцы модели
+    enum Column {
+        CatalogNumberColumn,
+        NameColumn,
+        ChangeColumn,
+        InclinationColumn,
+        MeanMotionColumn,
+        EccentricityColumn,
+        ColumnCount
+    };
+
+    /*!
+     * \brief CatalogDiffModel - конструктор модели
+     * \param result Результат сравнения каталогов
+     * \param parent Родитель объекта
+     */
+    explicit CatalogDiffModel(const CatalogDiffResult &result, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section,
+                        Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    /*!
+     * \brief changeText - текстовое описание изменения
+     * \param change Изменение
+     * \return Например, "Изменён: наклонение, среднее движение"
+     */
+    static QString changeText(const CatalogChange &change);
+
+    /*!
+     * \brief cellText - текст ячейки (используется и для экспорта)
+     * \param row Строка
+     * \param column Столбец
+     */
+    QString cellText(int row, int column) const;
+
+private:
+    CatalogDiffResult result_; //! Результат сравнения
+};
+
+#endif // CATALOGDIFFMODEL_HPP
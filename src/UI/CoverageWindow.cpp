@@ -0,0 +1,179 @@
+/*!
+ * \file CoverageWindow.cpp
+ * \brief Исходный файл для окна карты покрытия
+ * \details
+ * Этот файл содержит реализацию класса CoverageWindow.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "CoverageWindow.hpp"
+#include "./ui_CoverageWindow.h"
+
+#include <QDateTime>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+
+constexpr int frameFieldIndex = 4; //! Пункт «Отдельный шаг» списка величин
+
+//! Заголовок карты для пункта списка величин
+QString fieldTitle(int index)
+{
+    switch (index) {
+    case 0:
+        return CoverageWindow::tr("Среднее число видимых объектов");
+    case 1:
+        return CoverageWindow::tr("Наименьшее число видимых объектов");
+    case 2:
+        return CoverageWindow::tr("Наибольшее число видимых объектов");
+    case 3:
+        return CoverageWindow::tr("Доля времени без покрытия");
+    default:
+        return CoverageWindow::tr("Число видимых объектов на шаге");
+    }
+}
+
+} // namespace
+
+void CoverageWindow::compute()
+{
+    if (this->watcher_.isRunning())
+        return;
+
+    CoverageSettings settings; //! Параметры из элементов управления
+    settings.cellSize = this->ui_->cellSpinBox->value();
+    settings.minElevation = this->ui_->elevationSpinBox->value();
+    settings.start = double(this->ui_->startDateTimeEdit->dateTime().toMSecsSinceEpoch()) / 1000.0;
+    settings.end = settings.start + this->ui_->hoursSpinBox->value() * 3600.0;
+    settings.step = this->ui_->stepSpinBox->value() * 60.0;
+
+    this->ui_->computeButton->setEnabled(false);
+    this->ui_->exportButton->setEnabled(false);
+    this->statusBar()->showMessage(tr("Расчёт покрытия..."));
+    this->timer_.start();
+    //! Копия QVector разделяет данные с records_, записи не копируются
+    const QVector<TleRecord> records = this->records_;
+    this->watcher_.setFuture(QtConcurrent::run([records, settings]() {
+        return CoverageEngine::compute(records, settings);
+    }));
+}
+
+void CoverageWindow::onComputed()
+{
+    const qint64 elapsed = this->timer_.elapsed();
+    this->grid_ = this->watcher_.result();
+    this->ui_->computeButton->setEnabled(true);
+    this->ui_->exportButton->setEnabled(true);
+
+    this->ui_->frameSlider->setRange(0, qMax(0, this->grid_.steps - 1));
+    this->ui_->frameSlider->setValue(0);
+    this->showField();
+
+    double uncovered = 0.0; //! Средняя доля поверхности без покрытия
+    for (float area : this->grid_.uncoveredArea)
+        uncovered += area;
+    if (this->grid_.steps > 0)
+        uncovered /= this->grid_.steps;
+    this->statusBar()->showMessage(
+        tr("Объектов: %1 (без прогноза SGP4: %2), шагов: %3, прогнозов SGP4: %4, время: %5 мс, "
+           "без покрытия в среднем %6% поверхности")
+            .arg(this->grid_.objects)
+            .arg(this->grid_.unsupported)
+            .arg(this->grid_.steps)
+            .arg(this->grid_.propagations)
+            .arg(elapsed)
+            .arg(uncovered * 100.0, 0, 'f', 1));
+}
+
+void CoverageWindow::showField()
+{
+    const int index = this->ui_->fieldComboBox->currentIndex();
+    const bool frame = index == frameFieldIndex;
+    this->ui_->frameSlider->setEnabled(frame && this->grid_.hasFrames());
+    this->ui_->coveragePlot->setTitle(fieldTitle(index), tr("Долгота, °"), tr("Широта, °"));
+    if (this->grid_.rows == 0)
+        return;
+
+    if (!frame) {
+        this->ui_->frameLabel->clear();
+        this->ui_->coveragePlot->setGrid(this->grid_.toDensityGrid(CoverageField(index)));
+        return;
+    }
+    if (!this->grid_.hasFrames()) {
+        //! Сетки шагов не помещаются в отведённую память
+        this->ui_->frameLabel->setText(tr("Шаги не сохранены"));
+        this->ui_->coveragePlot->setGrid(DensityGrid());
+        return;
+    }
+    const int step = this->ui_->frameSlider->value();
+    const double seconds = this->grid_.start + step * this->grid_.step;
+    this->ui_->frameLabel->setText(QDateTime::fromMSecsSinceEpoch(qint64(seconds * 1000.0))
+                                       .toUTC()
+                                       .toString(QStringLiteral("yyyy-MM-dd HH:mm")));
+    this->ui_->coveragePlot->setGrid(this->grid_.frameGrid(step));
+}
+
+void CoverageWindow::exportCsv()
+{
+    if (this->grid_.rows == 0) {
+        this->statusBar()->showMessage(tr("Сначала выполните расчёт"), 2500);
+        return;
+    }
+
+    //! Открываем диалоговое окно для сохранения файла
+    const QString filePath = QFileDialog::getSaveFileName(this,
+                                                          tr("Экспорт покрытия"),
+                                                          "coverage.csv",
+                                                          tr("Файл CSV (*.csv)"));
+    if (filePath.isEmpty())
+        return;
+
+    QSaveFile file(filePath); //! Запись во временный файл с атомарной заменой
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::critical(this,
+                              tr("Ошибка"),
+                              tr("Не удалось открыть файл для записи: %1").arg(filePath));
+        return;
+    }
+    if (!CoverageEngine::exportCsv(this->grid_, &file) || !file.commit()) {
+        QMessageBox::critical(this, tr("Ошибка"), tr("Не удалось сохранить файл: %1").arg(filePath));
+        return;
+    }
+    this->statusBar()->showMessage(tr("Сохранено в файл: %1").arg(filePath), 2500);
+}
+
+CoverageWindow::CoverageWindow(const QVector<TleRecord> &records, QWidget *parent)
+    : QMainWindow(parent)
+    , ui_(new Ui::CoverageWindow)
+    , records_(records)
+{
+    this->ui_->setupUi(this); //! Инициализация пользовательского интерфейса
+
+    //! По умолчанию расчёт начинается с текущей минуты
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    now.setTime(QTime(now.time().hour(), now.time().minute()));
+    this->ui_->startDateTimeEdit->setDateTime(now);
+
+    this->ui_->coveragePlot->setTitle(fieldTitle(0), tr("Долгота, °"), tr("Широта, °"));
+
+    this->connect(this->ui_->computeButton, &QPushButton::clicked, this, &CoverageWindow::compute);
+    this->connect(this->ui_->exportButton, &QPushButton::clicked, this, &CoverageWindow::exportCsv);
+    this->connect(&this->watcher_,
+                  &QFutureWatcher<CoverageGrid>::finished,
+                  this,
+                  &CoverageWindow::onComputed);
+    this->connect(this->ui_->fieldComboBox,
+                  QOverload<int>::of(&QComboBox::currentIndexChanged),
+                  this,
+                  &CoverageWindow::showField);
+    this->connect(this->ui_->frameSlider, &QSlider::valueChanged, this, &CoverageWindow::showField);
+}
+
+CoverageWindow::~CoverageWindow()
+{
+    delete this->ui_; //! Освобождение ресурсов пользовательского интерфейса
+}
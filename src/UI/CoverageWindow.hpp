@@ -0,0 +1,79 @@
+/*!
+ * \file CoverageWindow.hpp
+ * \brief Заголовочный файл для класса CoverageWindow.
+ * \details
+ * Этот файл содержит определение класса CoverageWindow — окна карты покрытия
+ * поверхности Земли объектами загруженного каталога.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef COVERAGEWINDOW_HPP
+#define COVERAGEWINDOW_HPP
+
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QMainWindow>
+
+#include "Utils/CoverageEngine.hpp"
+
+namespace Ui {
+class CoverageWindow;
+}
+
+/*!
+ * \brief Класс CoverageWindow
+ * \details
+ * Считает CoverageEngine в фоновом потоке для выбранных сетки, порога возвышения
+ * и интервала времени и показывает результат тепловой картой (долгота × широта):
+ * среднее, наименьшее и наибольшее число видимых объектов, долю времени
+ * без покрытия или отдельный шаг по времени, если сетки шагов сохранены.
+ */
+class CoverageWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief CoverageWindow - конструктор класса CoverageWindow.
+     * \param records Записи каталога (копия разделяет данные с исходной).
+     * \param parent Указатель на родительский виджет (по умолчанию nullptr).
+     */
+    explicit CoverageWindow(const QVector<TleRecord> &records, QWidget *parent = nullptr);
+
+    /*!
+     * \brief ~CoverageWindow - деструктор класса CoverageWindow.
+     */
+    ~CoverageWindow();
+
+public slots:
+    /*!
+     * \brief compute - слот для запуска расчёта покрытия с выбранными параметрами.
+     */
+    void compute();
+
+    /*!
+     * \brief exportCsv - слот для выгрузки сводных величин по ячейкам в CSV.
+     */
+    void exportCsv();
+
+private slots:
+    /*!
+     * \brief onComputed - расчёт завершён
+     */
+    void onComputed();
+
+    /*!
+     * \brief showField - показ выбранной величины или шага на карте
+     */
+    void showField();
+
+private:
+    Ui::CoverageWindow *ui_;               //! Пользовательский интерфейс окна
+    QVector<TleRecord> records_;           //! Записи каталога
+    CoverageGrid grid_;                    //! Результат последнего расчёта
+    QFutureWatcher<CoverageGrid> watcher_; //! Расчёт в фоне
+    QElapsedTimer timer_;                  //! Время расчёта
+};
+
+#endif // COVERAGEWINDOW_HPP
@@ -0,0 +1,352 @@
+/*!
+ * \file DensityPlotWidget.cpp
+ * \brief Диаграмма рассеяния с растеризацией по плотности
+ * \details
+ * Этот файл содержит реализацию класса DensityPlotWidget.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "DensityPlotWidget.hpp"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QWheelEvent>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int overviewSize = 1024; //! Размер подробной сетки всей области (ячеек по стороне)
+constexpr int refineDelay = 80;    //! Пауза во взаимодействии перед точным построением (мс)
+
+constexpr int marginLeft = 64;   //! Отступ под подписи оси Y
+constexpr int marginRight = 16;  //! Правый отступ
+constexpr int marginTop = 28;    //! Отступ под заголовок
+constexpr int marginBottom = 44; //! Отступ под подписи оси X
+
+/*!
+ * \brief ticks - «круглые» значения делений оси
+ * \param min Начало оси
+ * \param max Конец оси
+ * \param maxCount Желаемое наибольшее число делений
+ */
+QVector<double> ticks(double min, double max, int maxCount)
+{
+    QVector<double> result;
+    const double span = max - min;
+    if (!(span > 0.0) || maxCount < 1)
+        return result;
+    const double raw = span / maxCount;
+    const double magnitude = std::pow(10.0, std::floor(std::log10(raw)));
+    const double normalized = raw / magnitude;
+    const double step = (normalized < 1.5 ? 1.0
+                         : normalized < 3.0 ? 2.0
+                         : normalized < 7.0 ? 5.0
+                                            : 10.0)
+                        * magnitude;
+    for (double v = std::ceil(min / step) * step; v <= max + step * 1e-9; v += step)
+        result.append(std::abs(v) < step * 1e-9 ? 0.0 : v); //! Без "-0" и 1e-17 у нуля
+    return result;
+}
+
+} // namespace
+
+DensityPlotWidget::DensityPlotWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    this->setMinimumSize(240, 200);
+    //! Фон рисуется в paintEvent целиком
+    this->setAttribute(Qt::WA_OpaquePaintEvent);
+
+    this->refineTimer_.setSingleShot(true);
+    this->refineTimer_.setInterval(refineDelay);
+    this->connect(&this->refineTimer_, &QTimer::timeout, this, &DensityPlotWidget::refine);
+    this->connect(&this->overviewWatcher_,
+                  &QFutureWatcher<DensityGrid>::finished,
+                  this,
+                  &DensityPlotWidget::onOverviewReady);
+    this->connect(&this->imageWatcher_,
+                  &QFutureWatcher<QImage>::finished,
+                  this,
+                  &DensityPlotWidget::onImageReady);
+}
+
+void DensityPlotWidget::setTitle(const QString &title, const QString &xLabel, const QString &yLabel)
+{
+    this->title_ = title;
+    this->xLabel_ = xLabel;
+    this->yLabel_ = yLabel;
+    this->update();
+}
+
+void DensityPlotWidget::setData(const QVector<double> &x, const QVector<double> &y)
+{
+    this->x_ = x;
+    this->y_ = y;
+    //! Прежнее изображение показывается (в своей области), пока refine не построит новое
+    this->overview_ = DensityGrid();
+
+    //! Область всех точек с небольшим запасом по краям (вырожденная область расширяется)
+    const QRectF range = DensityRaster::bounds(x, y);
+    const double padX = range.width() > 0.0 ? range.width() * 0.02 : 1.0;
+    const double padY = range.height() > 0.0 ? range.height() * 0.02 : 1.0;
+    const QRectF previous = this->fullRange_;
+    this->fullRange_ = range.adjusted(-padX, -padY, padX, padY);
+    if (this->viewRange_.isEmpty() || this->viewRange_ == previous) {
+        this->viewRange_ = this->fullRange_; //! Масштаб не меняли: показываем все точки
+    } else {
+        //! Увеличенная область сохраняется и сдвигается внутрь новой области всех точек
+        const QRectF &full = this->fullRange_;
+        const double width = std::min(this->viewRange_.width(), full.width());
+        const double height = std::min(this->viewRange_.height(), full.height());
+        const double left = std::clamp(this->viewRange_.left(), full.left(), full.right() - width);
+        const double top = std::clamp(this->viewRange_.top(), full.top(), full.bottom() - height);
+        this->viewRange_ = QRectF(left, top, width, height);
+    }
+
+    //! Подробная сетка всей области строится один раз в фоне (копии QVector разделяют данные)
+    const QRectF fullRange = this->fullRange_;
+    this->overviewWatcher_.setFuture(QtConcurrent::run([x, y, fullRange]() {
+        return DensityRaster::bin(x, y, fullRange, overviewSize, overviewSize);
+    }));
+    this->refine(); //! Точное изображение исходного масштаба
+    this->update();
+}
+
+void DensityPlotWidget::setGrid(const DensityGrid &grid)
+{
+    //! Без точек и подробной сетки renderPreview и refine ничего не делают: изображение остаётся
+    this->x_.clear();
+    this->y_.clear();
+    this->overview_ = DensityGrid();
+    this->image_ = DensityRaster::render(grid);
+    this->imageRange_ = grid.range;
+    this->fullRange_ = grid.range;
+    this->viewRange_ = grid.range;
+    this->update();
+}
+
+void DensityPlotWidget::resetView()
+{
+    this->viewRange_ = this->fullRange_;
+    this->updatePreview();
+}
+
+QRect DensityPlotWidget::plotRect() const
+{
+    return this->rect().adjusted(marginLeft, marginTop, -marginRight, -marginBottom);
+}
+
+QPointF DensityPlotWidget::toData(const QPointF &point) const
+{
+    const QRect area = this->plotRect();
+    return QPointF(this->viewRange_.left()
+                       + (point.x() - area.left()) / area.width() * this->viewRange_.width(),
+                   this->viewRange_.top()
+                       + (area.bottom() - point.y()) / area.height() * this->viewRange_.height());
+}
+
+void DensityPlotWidget::renderPreview()
+{
+    const QRect area = this->plotRect();
+    if (this->overview_.isEmpty() || area.width() <= 0 || area.height() <= 0)
+        return;
+    //! Пересчёт из подробной сетки: не зависит от числа точек
+    this->image_ = DensityRaster::render(
+        DensityRaster::resample(this->overview_, this->viewRange_, area.width(), area.height()));
+    this->imageRange_ = this->viewRange_;
+}
+
+void DensityPlotWidget::updatePreview()
+{
+    this->renderPreview();
+    this->update();
+    this->refineTimer_.start(); //! Точное построение после паузы во взаимодействии
+}
+
+void DensityPlotWidget::refine()
+{
+    const QRect area = this->plotRect();
+    if (this->x_.isEmpty() || area.width() <= 0 || area.height() <= 0)
+        return;
+
+    //! Изображение строится в физических пикселях экрана
+    const qreal ratio = this->devicePixelRatioF();
+    const int width = qRound(area.width() * ratio);
+    const int height = qRound(area.height() * ratio);
+    const QVector<double> x = this->x_;
+    const QVector<double> y = this->y_;
+    const QRectF range = this->viewRange_;
+    this->pendingRange_ = range;
+    //! Новый запуск заменяет предыдущий: его результат уже не будет получен
+    this->imageWatcher_.setFuture(QtConcurrent::run([x, y, range, width, height]() {
+        return DensityRaster::render(DensityRaster::bin(x, y, range, width, height));
+    }));
+}
+
+void DensityPlotWidget::onOverviewReady()
+{
+    this->overview_ = this->overviewWatcher_.result();
+    //! Пока точного изображения нет, показываем приближённое (точное уже строится)
+    if (this->image_.isNull()) {
+        this->renderPreview();
+        this->update();
+    }
+}
+
+void DensityPlotWidget::onImageReady()
+{
+    this->image_ = this->imageWatcher_.result();
+    this->imageRange_ = this->pendingRange_;
+    this->update();
+}
+
+void DensityPlotWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(this->rect(), this->palette().window());
+
+    const QRect area = this->plotRect();
+    if (area.width() <= 0 || area.height() <= 0)
+        return;
+    painter.fillRect(area, this->palette().base());
+
+    //! Перевод координат данных в координаты виджета
+    const QRectF &view = this->viewRange_;
+    auto toWidgetX = [&](double x) {
+        return area.left() + (x - view.left()) / view.width() * area.width();
+    };
+    auto toWidgetY = [&](double y) {
+        return area.bottom() - (y - view.top()) / view.height() * area.height();
+    };
+
+    //! Изображение может относиться к другой области (во время уточнения), поэтому масштабируется
+    if (!this->image_.isNull()) {
+        painter.save();
+        painter.setClipRect(area);
+        const QRectF target(QPointF(toWidgetX(this->imageRange_.left()),
+                                    toWidgetY(this->imageRange_.bottom())),
+                            QPointF(toWidgetX(this->imageRange_.right()),
+                                    toWidgetY(this->imageRange_.top())));
+        painter.drawImage(target, this->image_);
+        painter.restore();
+    } else {
+        painter.drawText(area,
+                         Qt::AlignCenter,
+                         this->x_.isEmpty() ? tr("Нет данных") : tr("Построение..."));
+    }
+
+    //! Рамка, деления и подписи
+    const QColor textColor = this->palette().color(QPalette::WindowText);
+    painter.setPen(textColor);
+    painter.drawRect(area.adjusted(0, 0, -1, -1));
+    const QFontMetrics metrics = painter.fontMetrics();
+
+    for (double v : ticks(view.left(), view.right(), std::max(2, area.width() / 80))) {
+        const int px = qRound(toWidgetX(v));
+        painter.drawLine(px, area.bottom(), px, area.bottom() + 4);
+        const QString text = QString::number(v, 'g', 6);
+        painter.drawText(QRect(px - 40, area.bottom() + 6, 80, metrics.height()),
+                         Qt::AlignHCenter | Qt::AlignTop,
+                         text);
+    }
+    for (double v : ticks(view.top(), view.bottom(), std::max(2, area.height() / 50))) {
+        const int py = qRound(toWidgetY(v));
+        painter.drawLine(area.left() - 4, py, area.left(), py);
+        const QString text = QString::number(v, 'g', 6);
+        painter.drawText(QRect(0, py - metrics.height() / 2, area.left() - 6, metrics.height()),
+                         Qt::AlignRight | Qt::AlignVCenter,
+                         text);
+    }
+
+    //! Заголовок и подписи осей
+    QFont bold = painter.font();
+    bold.setBold(true);
+    painter.setFont(bold);
+    painter.drawText(QRect(area.left(), 0, area.width(), marginTop), Qt::AlignCenter, this->title_);
+    painter.setFont(this->font());
+    painter.drawText(QRect(area.left(), this->height() - metrics.height() - 4, area.width(),
+                           metrics.height()),
+                     Qt::AlignCenter,
+                     this->xLabel_);
+    painter.save();
+    painter.translate(metrics.height() / 2 + 2, area.center().y());
+    painter.rotate(-90);
+    painter.drawText(QRect(-area.height() / 2, -metrics.height() / 2, area.height(),
+                           metrics.height()),
+                     Qt::AlignCenter,
+                     this->yLabel_);
+    painter.restore();
+}
+
+void DensityPlotWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    this->updatePreview(); //! Разрешение изображения зависит от размера виджета
+}
+
+void DensityPlotWidget::wheelEvent(QWheelEvent *event)
+{
+    const QRect area = this->plotRect();
+    const QPointF position = event->position();
+    if (!area.contains(position.toPoint()) || event->angleDelta().y() == 0) {
+        event->ignore();
+        return;
+    }
+
+    //! Масштабирование относительно точки под курсором (один шаг колеса — примерно 1.2 раза)
+    const double factor = std::pow(1.0015, -event->angleDelta().y());
+    const QPointF anchor = this->toData(position);
+    const QRectF &view = this->viewRange_;
+    this->viewRange_ = QRectF(anchor.x() + (view.left() - anchor.x()) * factor,
+                              anchor.y() + (view.top() - anchor.y()) * factor,
+                              view.width() * factor,
+                              view.height() * factor);
+    this->updatePreview();
+    event->accept();
+}
+
+void DensityPlotWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton && this->plotRect().contains(event->pos())) {
+        this->dragging_ = true;
+        this->lastMousePos_ = event->pos();
+        this->setCursor(Qt::ClosedHandCursor);
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void DensityPlotWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!this->dragging_) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+    //! Смещение области на расстояние, пройденное мышью
+    const QRect area = this->plotRect();
+    const QPoint delta = event->pos() - this->lastMousePos_;
+    this->lastMousePos_ = event->pos();
+    this->viewRange_.translate(-delta.x() * this->viewRange_.width() / area.width(),
+                               delta.y() * this->viewRange_.height() / area.height());
+    this->updatePreview();
+}
+
+void DensityPlotWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton && this->dragging_) {
+        this->dragging_ = false;
+        this->unsetCursor();
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void DensityPlotWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton)
+        this->resetView();
+    QWidget::mouseDoubleClickEvent(event);
+}
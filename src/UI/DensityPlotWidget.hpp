@@ -0,0 +1,148 @@
+/*!
+ * \file DensityPlotWidget.hpp
+ * \brief Заголовочный файл для класса DensityPlotWidget.
+ * \details
+ * Этот файл содержит определение виджета диаграммы рассеяния, который рисует
+ * не отдельные точки, а сетку плотности, поэтому подходит для каталогов из миллионов записей.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef DENSITYPLOTWIDGET_HPP
+#define DENSITYPLOTWIDGET_HPP
+
+#include <QFutureWatcher>
+#include <QImage>
+#include <QTimer>
+#include <QWidget>
+
+#include "Utils/DensityRaster.hpp"
+
+/*!
+ * \brief Класс DensityPlotWidget
+ * \details
+ * Точки раскладываются по сетке плотности в фоновом потоке, а отрисовка
+ * выводит только готовое изображение. Уровни детализации:
+ * - при загрузке данных в фоне строится подробная сетка по всей области;
+ * - при масштабировании и перемещении изображение сразу пересчитывается из неё
+ *   (стоимость зависит только от размера сетки);
+ * - после паузы во взаимодействии точная сетка видимой области считается в фоне
+ *   и заменяет приближённую.
+ *
+ * Колесо мыши масштабирует относительно курсора, перетаскивание перемещает область,
+ * двойной щелчок возвращает исходный масштаб.
+ */
+class DensityPlotWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief DensityPlotWidget - конструктор виджета
+     * \param parent Родительский виджет
+     */
+    explicit DensityPlotWidget(QWidget *parent = nullptr);
+
+    /*!
+     * \brief setTitle - задаёт заголовок и подписи осей
+     * \param title Заголовок диаграммы
+     * \param xLabel Подпись оси X
+     * \param yLabel Подпись оси Y
+     */
+    void setTitle(const QString &title, const QString &xLabel, const QString &yLabel);
+
+    /*!
+     * \brief setData - задаёт точки диаграммы
+     * \param x Координаты x
+     * \param y Координаты y
+     * \details Если масштаб не меняли, показывается область, содержащая все точки;
+     * увеличенная область сохраняется в пределах новой. Прежнее изображение остаётся
+     * на экране, пока не построено новое.
+     */
+    void setData(const QVector<double> &x, const QVector<double> &y);
+
+    /*!
+     * \brief setGrid - задаёт готовую сетку вместо точек (например, карту покрытия)
+     * \param grid Сетка; её область становится исходным масштабом
+     * \details
+     * Изображение строится один раз по ячейкам сетки и при масштабировании
+     * только растягивается, уточнение в фоне не выполняется.
+     */
+    void setGrid(const DensityGrid &grid);
+
+    /*!
+     * \brief resetView - возвращает исходный масштаб
+     */
+    void resetView();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private slots:
+    /*!
+     * \brief onOverviewReady - подробная сетка всей области построена
+     */
+    void onOverviewReady();
+
+    /*!
+     * \brief onImageReady - точное изображение видимой области построено
+     */
+    void onImageReady();
+
+    /*!
+     * \brief refine - запуск точного построения видимой области в фоне
+     */
+    void refine();
+
+private:
+    /*!
+     * \brief plotRect - область построения внутри виджета (без осей и подписей)
+     */
+    QRect plotRect() const;
+
+    /*!
+     * \brief renderPreview - быстрое изображение видимой области из подробной сетки
+     */
+    void renderPreview();
+
+    /*!
+     * \brief updatePreview - быстрое изображение и отложенное точное построение
+     */
+    void updatePreview();
+
+    /*!
+     * \brief toData - перевод точки виджета в координаты данных
+     * \param point Точка виджета
+     */
+    QPointF toData(const QPointF &point) const;
+
+    QString title_;  //! Заголовок
+    QString xLabel_; //! Подпись оси X
+    QString yLabel_; //! Подпись оси Y
+
+    QVector<double> x_; //! Координаты x
+    QVector<double> y_; //! Координаты y
+
+    QRectF fullRange_; //! Область, содержащая все точки
+    QRectF viewRange_; //! Видимая область
+
+    DensityGrid overview_; //! Подробная сетка всей области (уровень детализации)
+    QImage image_;         //! Изображение видимой области
+    QRectF imageRange_;    //! Область, которой соответствует image_
+
+    QFutureWatcher<DensityGrid> overviewWatcher_; //! Построение подробной сетки
+    QFutureWatcher<QImage> imageWatcher_;         //! Построение точного изображения
+    QRectF pendingRange_;                         //! Область, для которой строится изображение
+    QTimer refineTimer_;                          //! Задержка перед точным построением
+
+    bool dragging_ = false; //! Идёт перетаскивание
+    QPoint lastMousePos_;   //! Последняя позиция мыши при перетаскивании
+};
+
+#endif // DENSITYPLOTWIDGET_HPP
@@ -0,0 +1,90 @@
+/*!
+ * \file DiffWindow.cpp
+ * \brief Исходный файл для окна сравнения каталогов
+ * \details
+ * Этот файл содержит реализацию класса DiffWindow.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "DiffWindow.hpp"
+#include "./ui_DiffWindow.h"
+
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QSaveFile>
+#include <QTextStream>
+
+void DiffWindow::exportCsv()
+{
+    //! Открываем диалоговое окно для сохранения файла
+    const QString filePath = QFileDialog::getSaveFileName(this,
+                                                          tr("Экспорт изменений"),
+                                                          "diff.csv",
+                                                          tr("Файл CSV (*.csv)"));
+    if (filePath.isEmpty())
+        return;
+
+    QSaveFile file(filePath); //! Запись во временный файл с атомарной заменой
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::critical(this,
+                              tr("Ошибка"),
+                              tr("Не удалось открыть файл для записи: %1").arg(filePath));
+        return;
+    }
+
+    QTextStream out(&file);
+    //! Заголовок
+    for (int column = 0; column < this->model_->columnCount(); ++column)
+        out << (column ? "," : "")
+            << this->model_->headerData(column, Qt::Horizontal).toString();
+    out << '\n';
+    //! Строки; имя объекта берётся в кавычки, так как может содержать запятые
+    for (int row = 0; row < this->model_->rowCount(); ++row) {
+        for (int column = 0; column < this->model_->columnCount(); ++column) {
+            QString text = this->model_->cellText(row, column);
+            if (column == CatalogDiffModel::NameColumn || column == CatalogDiffModel::ChangeColumn)
+                text = QLatin1Char('"') + text.replace(QLatin1Char('"'), QLatin1String("\"\""))
+                       + QLatin1Char('"');
+            out << (column ? "," : "") << text;
+        }
+        out << '\n';
+    }
+    out.flush();
+
+    if (!file.commit()) {
+        QMessageBox::critical(this, tr("Ошибка"), tr("Не удалось сохранить файл: %1").arg(filePath));
+        return;
+    }
+    this->statusBar()->showMessage(tr("Сохранено в файл: %1").arg(filePath), 2500);
+}
+
+DiffWindow::DiffWindow(const CatalogDiffResult &result, QWidget *parent)
+    : QMainWindow(parent)
+    , ui_(new Ui::DiffWindow)
+    , model_(new CatalogDiffModel(result, this))
+{
+    this->ui_->setupUi(this); //! Инициализация пользовательского интерфейса
+
+    //! Сводка по изменениям
+    this->ui_->summaryLabel->setText(
+        tr("Новых: %1, исчезнувших: %2, изменившихся: %3, без изменений: %4")
+            .arg(result.added)
+            .arg(result.removed)
+            .arg(result.changed)
+            .arg(result.unchanged));
+
+    //! Таблица со списком изменений
+    this->ui_->diffTableView->setModel(this->model_);
+    this->ui_->diffTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    //! Одинаковая высота строк: таблица не измеряет каждую строку при прокрутке
+    this->ui_->diffTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
+    this->connect(this->ui_->exportAction, &QAction::triggered, this, &DiffWindow::exportCsv);
+}
+
+DiffWindow::~DiffWindow()
+{
+    delete this->ui_; //! Освобождение ресурсов пользовательского интерфейса
+}
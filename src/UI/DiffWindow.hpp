@@ -0,0 +1,56 @@
+/*!
+ * \file DiffWindow.hpp
+ * \brief Заголовочный файл для класса DiffWindow.
+ * \details
+ * Этот файл содержит определение класса DiffWindow — окна со списком различий
+ * между двумя снимками каталога.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef DIFFWINDOW_HPP
+#define DIFFWINDOW_HPP
+
+#include <QMainWindow>
+
+#include "CatalogDiffModel.hpp"
+
+namespace Ui {
+class DiffWindow;
+}
+
+/*!
+ * \brief Класс DiffWindow
+ * \details
+ * Показывает сводку и список изменений между двумя каталогами,
+ * позволяет экспортировать список в CSV.
+ */
+class DiffWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief DiffWindow - конструктор класса DiffWindow.
+     * \param result Результат сравнения каталогов.
+     * \param parent Указатель на родительский виджет (по умолчанию nullptr).
+     */
+    explicit DiffWindow(const CatalogDiffResult &result, QWidget *parent = nullptr);
+
+    /*!
+     * \brief ~DiffWindow - деструктор класса DiffWindow.
+     */
+    ~DiffWindow();
+
+public slots:
+    /*!
+     * \brief exportCsv - слот для экспорта списка изменений в CSV-файл.
+     */
+    void exportCsv();
+
+private:
+    Ui::DiffWindow *ui_;      //! Пользовательский интерфейс окна
+    CatalogDiffModel *model_; //! Модель списка изменений
+};
+
+#endif // DIFFWINDOW_HPP
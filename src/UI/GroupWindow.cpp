@@ -0,0 +1,105 @@
+/*!
+ * \file GroupWindow.cpp
+ * \brief Исходный файл для окна группировки записей
+ * \details
+ * Этот файл содержит реализацию класса GroupWindow.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "GroupWindow.hpp"
+#include "./ui_GroupWindow.h"
+
+#include <QElapsedTimer>
+#include <QHeaderView>
+
+void GroupWindow::regroup()
+{
+    //! Выбранные ключи: пункт "нет" хранит -1
+    QVector<GroupKey> keys;
+    for (const QComboBox *combo :
+         {this->ui_->firstKeyComboBox, this->ui_->secondKeyComboBox, this->ui_->thirdKeyComboBox}) {
+        const int key = combo->currentData().toInt();
+        if (key >= 0)
+            keys.append(GroupKey(key));
+    }
+    const QString field = this->ui_->fieldComboBox->currentText();
+
+    QElapsedTimer timer;
+    timer.start();
+    const GroupResult result = GroupAggregator::aggregate(this->stats_, keys, {field});
+    const qint64 elapsed = timer.elapsed();
+
+    //! Заголовки: ключи, количество и агрегаты поля
+    QStringList headers;
+    for (GroupKey key : result.keys)
+        headers.append(GroupAggregator::keyName(key));
+    headers << tr("Записей") << tr("%1, мин").arg(field) << tr("%1, макс").arg(field)
+            << tr("%1, среднее").arg(field);
+    this->model_->clear();
+    this->model_->setHorizontalHeaderLabels(headers);
+
+    //! Числа хранятся как числа, чтобы сортировка по столбцу была числовой
+    const int keyCount = int(result.keys.size());
+    this->model_->setRowCount(int(result.rows.size()));
+    for (int row = 0; row < result.rows.size(); ++row) {
+        const GroupRow &group = result.rows[row];
+        for (int column = 0; column < keyCount; ++column)
+            this->model_->setItem(row,
+                                  column,
+                                  new QStandardItem(group.keys[column].isEmpty()
+                                                        ? tr("(нет)")
+                                                        : group.keys[column]));
+        const QVector<double> values = {double(group.count),
+                                        group.min.value(0),
+                                        group.max.value(0),
+                                        group.mean.value(0)};
+        for (int i = 0; i < values.size(); ++i) {
+            QStandardItem *item = new QStandardItem;
+            item->setData(values[i], Qt::DisplayRole);
+            this->model_->setItem(row, keyCount + i, item);
+        }
+    }
+
+    this->statusBar()->showMessage(
+        tr("Групп: %1, записей: %2, время группировки: %3 мс")
+            .arg(result.rows.size())
+            .arg(this->stats_.records.size())
+            .arg(elapsed));
+}
+
+GroupWindow::GroupWindow(const TleStatistics &stats, QWidget *parent)
+    : QMainWindow(parent)
+    , ui_(new Ui::GroupWindow)
+    , stats_(stats)
+    , model_(new QStandardItemModel(this))
+{
+    this->ui_->setupUi(this); //! Инициализация пользовательского интерфейса
+
+    //! Списки ключей: первый ключ обязателен, второй и третий — по желанию
+    for (QComboBox *combo :
+         {this->ui_->firstKeyComboBox, this->ui_->secondKeyComboBox, this->ui_->thirdKeyComboBox}) {
+        if (combo != this->ui_->firstKeyComboBox)
+            combo->addItem(tr("(нет)"), -1);
+        for (int key = 0; key < int(GroupKey::Count); ++key)
+            combo->addItem(GroupAggregator::keyName(GroupKey(key)), key);
+    }
+    //! По умолчанию — объекты по запускам: так видны разрушения (много фрагментов одного запуска)
+    this->ui_->firstKeyComboBox->setCurrentIndex(int(GroupKey::Launch));
+    this->ui_->fieldComboBox->addItems(GroupAggregator::fieldNames());
+    this->ui_->fieldComboBox->setCurrentText(QStringLiteral("perigee"));
+
+    this->ui_->groupTableView->setModel(this->model_);
+    this->ui_->groupTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    //! Одинаковая высота строк: таблица не измеряет каждую строку при прокрутке
+    this->ui_->groupTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
+    this->connect(this->ui_->groupButton, &QPushButton::clicked, this, &GroupWindow::regroup);
+
+    this->regroup(); //! Первая группировка с ключами по умолчанию
+}
+
+GroupWindow::~GroupWindow()
+{
+    delete this->ui_; //! Освобождение ресурсов пользовательского интерфейса
+}
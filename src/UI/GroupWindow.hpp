@@ -0,0 +1,58 @@
+/*!
+ * \file GroupWindow.hpp
+ * \brief Заголовочный файл для класса GroupWindow.
+ * \details
+ * Этот файл содержит определение класса GroupWindow — окна группировки
+ * записей каталога по выбранным ключам.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef GROUPWINDOW_HPP
+#define GROUPWINDOW_HPP
+
+#include <QMainWindow>
+#include <QStandardItemModel>
+
+#include "Utils/GroupAggregator.hpp"
+
+namespace Ui {
+class GroupWindow;
+}
+
+/*!
+ * \brief Класс GroupWindow
+ * \details
+ * Позволяет выбрать до трёх ключей группировки и числовое поле и показывает
+ * для каждой группы количество записей, минимум, максимум и среднее поля.
+ */
+class GroupWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief GroupWindow - конструктор класса GroupWindow.
+     * \param stats Статистика каталога (копия разделяет данные с исходной).
+     * \param parent Указатель на родительский виджет (по умолчанию nullptr).
+     */
+    explicit GroupWindow(const TleStatistics &stats, QWidget *parent = nullptr);
+
+    /*!
+     * \brief ~GroupWindow - деструктор класса GroupWindow.
+     */
+    ~GroupWindow();
+
+public slots:
+    /*!
+     * \brief regroup - слот для группировки по выбранным ключам и полю.
+     */
+    void regroup();
+
+private:
+    Ui::GroupWindow *ui_;       //! Пользовательский интерфейс окна
+    TleStatistics stats_;       //! Группируемый каталог
+    QStandardItemModel *model_; //! Модель таблицы групп
+};
+
+#endif // GROUPWINDOW_HPP
@@ -11,6 +11,23 @@
 #include "InfoWindow.hpp"
 #include "./ui_InfoWindow.h"
 
+#include "CoverageWindow.hpp"
+#include "DiffWindow.hpp"
+#include "GroupWindow.hpp"
+#include "ManeuverWindow.hpp"
+#include "MapWindow.hpp"
+#include "PassWindow.hpp"
+#include "Utils/MapPropagator.hpp"
+#include "Utils/TleWriter.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QInputDialog>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <cmath>
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
 void InfoWindow::changeEvent(QEvent *event)
 {
@@ -118,20 +135,65 @@ QString InfoWindow::formattedResults() const
         out += tr("%1°: %2\n")
                    .arg(it.key())
                    .arg(it.value()); //! Добавляем количество спутников по наклону
+    //! Заголовок для количества спутников по орбитальным режимам
+    out += tr("Количество спутников по орбитальным режимам:\n");
+    for (auto it = this->stats_.regimeCounts.constBegin();
+         it != this->stats_.regimeCounts.constEnd();
+         ++it)
+        out += tr("%1: %2\n")
+                   .arg(OrbitalMetrics::regimeName(OrbitRegime(it.key())))
+                   .arg(it.value()); //! Добавляем количество спутников по режиму
+    //! Заголовок для количества спутников по высоте перигея
+    out += tr("Количество спутников по высоте перигея:\n");
+    for (auto it = this->stats_.altitudeBins.constBegin();
+         it != this->stats_.altitudeBins.constEnd();
+         ++it)
+        out += tr("%1 км: %2\n")
+                   .arg(it.key())
+                   .arg(it.value()); //! Добавляем количество спутников по высоте
+    //! Заголовок для квантилей распределений
+    out += tr("Квантили распределений (медиана, p95, p99):\n");
+    for (int row = 0; row < this->quantileModel_->rowCount(); ++row)
+        out += tr("%1: %2, %3, %4\n")
+                   .arg(this->quantileModel_->item(row, 0)->text(),
+                        this->quantileModel_->item(row, 1)->text(),
+                        this->quantileModel_->item(row, 2)->text(),
+                        this->quantileModel_->item(row, 3)->text());
     return out;
 }
 
-QAbstractItemModel *InfoWindow::modelFromMap(const QMap<int, int> &map, const QStringList &headers)
+QStandardItemModel *InfoWindow::createModel(QTableView *view, const QStringList &headers)
 {
     QStandardItemModel *model = new QStandardItemModel(this); //! Создаем новую модель
     model->setHorizontalHeaderLabels(headers);                //! Устанавливаем заголовки для модели
-    //! Заполняем модель данными из QMap
-    for (auto it = map.constBegin(); it != map.constEnd(); ++it)
-        model->appendRow({new QStandardItem(QString::number(it.key())),
-                          new QStandardItem(QString::number(it.value()))});
+    view->setModel(model);                                    //! Подключаем модель к таблице
+    //! Устанавливаем выравнивание заголовков таблицы
+    view->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     return model; //! Возвращаем указатель на созданную модель
 }
 
+void InfoWindow::fillModelFromMap(QStandardItemModel *model,
+                                  const QMap<int, int> &map,
+                                  const std::function<QString(int)> &keyText)
+{
+    //! Записывает текст в ячейку, если он изменился
+    auto setCell = [model](int row, int column, const QString &text) {
+        QStandardItem *item = model->item(row, column);
+        if (!item)
+            model->setItem(row, column, new QStandardItem(text));
+        else if (item->text() != text)
+            item->setText(text);
+    };
+
+    model->setRowCount(map.size()); //! Лишние строки удаляются, недостающие добавляются
+    int row = 0;
+    //! Заполняем модель данными из QMap
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it, ++row) {
+        setCell(row, 0, keyText ? keyText(it.key()) : QString::number(it.key()));
+        setCell(row, 1, QString::number(it.value()));
+    }
+}
+
 void InfoWindow::showError(const QString &message)
 {
     QMessageBox::critical(this, tr("Ошибка"), message); //! Отображение сообщения об ошибке в окне
@@ -154,6 +216,94 @@ void InfoWindow::bindActions()
 
     //! Подключение слота для открытия URL к действию меню
     this->connect(this->ui_->urlOpenAction, &QAction::triggered, this, &InfoWindow::requestOpenUrl);
+
+    //! Подключение слота для сравнения каталогов к действию меню
+    this->connect(this->ui_->compareAction,
+                  &QAction::triggered,
+                  this,
+                  &InfoWindow::compareWithFile);
+
+    //! Подключение слота для выгрузки каталога в TLE к действию меню
+    this->connect(this->ui_->exportTleAction, &QAction::triggered, this, &InfoWindow::exportTle);
+
+    //! Подключение слота для группировки записей к действию меню
+    this->connect(this->ui_->groupAction, &QAction::triggered, this, &InfoWindow::showGroups);
+
+    //! Подключение слота для поиска манёвров к действию меню
+    this->connect(this->ui_->maneuverAction, &QAction::triggered, this, &InfoWindow::showManeuvers);
+
+    //! Подключение слота для прогноза пролётов к действию меню
+    this->connect(this->ui_->passAction, &QAction::triggered, this, &InfoWindow::showPasses);
+
+    //! Подключение слота для карты покрытия к действию меню
+    this->connect(this->ui_->coverageAction, &QAction::triggered, this, &InfoWindow::showCoverage);
+
+    //! Подключение слота для карты движения объектов к действию меню
+    this->connect(this->ui_->mapAction, &QAction::triggered, this, &InfoWindow::showMap);
+
+    //! Подключение переключателя автообновления из сети
+    this->connect(this->ui_->autoRefreshAction, &QAction::toggled, this, [this](bool checked) {
+        if (!this->refresher_)
+            return;
+        this->refresher_->setEnabled(checked);
+        this->statusBar()->showMessage(checked ? tr("Автообновление включено")
+                                               : tr("Автообновление выключено"),
+                                       2500);
+    });
+
+    //! Подключение слота для немедленного обновления к действию меню
+    this->connect(this->ui_->refreshNowAction, &QAction::triggered, this, [this]() {
+        if (!this->refresher_)
+            return;
+        this->refresher_->refreshNow();
+        this->statusBar()->showMessage(tr("Обновление источников…"), 2500);
+    });
+
+    //! Подключение слота для изменения источников к действию меню
+    this->connect(this->ui_->sourcesAction, &QAction::triggered, this, &InfoWindow::editSources);
+
+    //! Подключение слота для изменения правил оповещений к действию меню
+    this->connect(this->ui_->alertRulesAction,
+                  &QAction::triggered,
+                  this,
+                  &InfoWindow::editAlertRules);
+
+    //! Подключение переключателя слежения за файлом
+    this->connect(this->ui_->watchAction, &QAction::toggled, this, [this](bool checked) {
+        if (!this->watcher_)
+            return;
+        this->watcher_->setEnabled(checked);
+        this->statusBar()->showMessage(checked ? tr("Слежение за файлом включено")
+                                               : tr("Слежение за файлом выключено"),
+                                       2500);
+    });
+}
+
+void InfoWindow::fillQuantileModel()
+{
+    const QList<QPair<QString, const QuantileSketch *>> rows = {
+        {tr("Среднее движение (об/сут)"), &this->stats_.meanMotionQuantiles},
+        {tr("Эксцентриситет"), &this->stats_.eccentricityQuantiles},
+        {tr("Высота перигея (км)"), &this->stats_.perigeeQuantiles},
+        {tr("Возраст эпохи (сут)"), &this->stats_.epochAgeQuantiles},
+    };
+
+    this->quantileModel_->setRowCount(rows.size());
+    for (int row = 0; row < rows.size(); ++row) {
+        const QuantileSketch *sketch = rows[row].second;
+        const QStringList cells = {rows[row].first,
+                                   QString::number(sketch->quantile(0.5), 'g', 5),
+                                   QString::number(sketch->quantile(0.95), 'g', 5),
+                                   QString::number(sketch->quantile(0.99), 'g', 5)};
+        for (int column = 0; column < cells.size(); ++column) {
+            //! Ячейки обновляются на месте, как и в остальных таблицах
+            QStandardItem *item = this->quantileModel_->item(row, column);
+            if (!item)
+                this->quantileModel_->setItem(row, column, new QStandardItem(cells[column]));
+            else if (item->text() != cells[column])
+                item->setText(cells[column]);
+        }
+    }
 }
 
 void InfoWindow::fillUiFromStats()
@@ -164,16 +314,386 @@ void InfoWindow::fillUiFromStats()
     //! Установка даты и времени в метку
     this->ui_->inputDateLabel->setText(this->stats_.oldestEpoch.toString("dd.MM.yyyy hh:mm:ss"));
 
-    //! Установка моделей для таблиц с данными
-    this->ui_->yearTableView->setModel(
-        this->modelFromMap(this->stats_.launchesPerYear, {tr("Год"), tr("Число запусков")}));
-    this->ui_->inclinationTableView->setModel(
-        this->modelFromMap(this->stats_.inclinationBins,
-                           {tr("Наклонение (°)"), tr("Число запусков")}));
+    //! Заполнение таблиц с данными
+    this->fillModelFromMap(this->yearModel_, this->stats_.launchesPerYear);
+    this->fillModelFromMap(this->inclinationModel_, this->stats_.inclinationBins);
+    this->fillModelFromMap(this->regimeModel_, this->stats_.regimeCounts, [](int regime) {
+        return OrbitalMetrics::regimeName(OrbitRegime(regime));
+    });
+    this->fillModelFromMap(this->altitudeModel_, this->stats_.altitudeBins);
+    this->fillQuantileModel();
+
+    //! Заполнение диаграмм: столбцы собираются один раз, растеризация идёт в фоне
+    const int count = int(this->stats_.records.size());
+    QVector<double> meanMotion(count), inclination(count), eccentricity(count);
+    for (int i = 0; i < count; ++i) {
+        const TleRecord &record = this->stats_.records[i];
+        meanMotion[i] = record.meanMotion;
+        inclination[i] = record.inclination;
+        eccentricity[i] = record.eccentricity;
+    }
+    this->ui_->inclinationPlot->setData(meanMotion, inclination);
+    this->ui_->eccentricityPlot->setData(this->stats_.derived.perigeeAltitude, eccentricity);
+}
+
+const QVector<TleRecord> &InfoWindow::fullRecords()
+{
+    TleParser::decodeFields(this->stats_.records, TleField::All);
+    return this->stats_.records;
+}
+
+void InfoWindow::appendRecords(const QVector<TleRecord> &records)
+{
+    this->stats_.append(records); //! Дополняем статистику новыми записями
+    this->fillUiFromStats();      //! Обновляем таблицы на месте
+    this->statusBar()->showMessage(tr("Добавлено записей: %1").arg(records.size()), 2500);
+    this->checkAlerts(records); //! Оповещения заменяют сообщение в статусной строке
+}
+
+void InfoWindow::replaceRecords(const QVector<TleRecord> &records)
+{
+    this->stats_ = TleStatistics(records); //! Пересчитываем статистику заново
+    this->fillUiFromStats();               //! Обновляем таблицы на месте
+    this->statusBar()->showMessage(tr("Файл перезагружен: %1 записей").arg(records.size()), 2500);
+    this->checkAlerts();
+}
+
+void InfoWindow::replaceStatistics(const TleStatistics &statistics)
+{
+    this->stats_ = statistics; //! Статистика уже посчитана в фоне
+    this->fillUiFromStats();   //! Обновляем таблицы на месте
+    this->statusBar()->showMessage(tr("Каталог обновлён: %1 записей").arg(statistics.records.size()),
+                                   2500);
+    this->checkAlerts();
+}
+
+void InfoWindow::checkAlerts(const QVector<TleRecord> &appended)
+{
+    if (!this->alertsStarted_)
+        return; //! Правила не заданы
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch() * 1000;
+    QVector<Alert> alerts;
+    if (appended.isEmpty()) {
+        //! Недостающие поля декодируются на месте, как в fullRecords()
+        TleParser::decodeFields(this->stats_.records, AlertEngine::requiredFields());
+        alerts = this->alerts_.replace(this->stats_.records, now);
+    } else {
+        QVector<TleRecord> records = appended;
+        TleParser::decodeFields(records, AlertEngine::requiredFields());
+        alerts = this->alerts_.append(records, now);
+    }
+    if (alerts.isEmpty())
+        return;
+
+    //! Журнал дописывается; при ошибке оповещения всё равно показываются
+    const QString directory
+        = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QFile log(QDir(directory).filePath(QStringLiteral("alerts.log")));
+    if (QDir().mkpath(directory)
+        && log.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        QTextStream out(&log);
+        const QString time = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        for (const Alert &alert : alerts)
+            out << time << '\t' << this->alertText(alert) << '\n';
+    } else
+        emit errorOccurred(tr("Не удалось записать журнал оповещений: %1").arg(log.fileName()));
+
+    this->statusBar()->showMessage(alerts.size() == 1
+                                       ? this->alertText(alerts.first())
+                                       : tr("Оповещений: %1 (журнал: %2); первое: %3")
+                                             .arg(alerts.size())
+                                             .arg(QDir::toNativeSeparators(log.fileName()),
+                                                  this->alertText(alerts.first())),
+                                   15000);
+}
 
-    //! Установка выравнивание заголовков таблиц
-    this->ui_->yearTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    this->ui_->inclinationTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+QString InfoWindow::alertText(const Alert &alert) const
+{
+    const AlertRule &rule = this->alerts_.rules()[alert.rule];
+    const QString epoch = QDateTime::fromMSecsSinceEpoch(alert.epoch / 1000)
+                              .toUTC()
+                              .toString(QStringLiteral("yyyy-MM-dd HH:mm:ss"));
+    switch (rule.type) {
+    case AlertRuleType::StaleEpoch:
+        return tr("Объект %1: эпоха %2 старше %3 сут (%4 сут)")
+            .arg(alert.catalogNumber)
+            .arg(epoch)
+            .arg(rule.days)
+            .arg(alert.value, 0, 'f', 1);
+    case AlertRuleType::NewInBand:
+        return tr("Новый объект %1 в полосе %2–%3°, %4–%5 км (перигей %6 км)")
+            .arg(alert.catalogNumber)
+            .arg(rule.inclinationMin)
+            .arg(rule.inclinationMax)
+            .arg(rule.altitudeMin)
+            .arg(rule.altitudeMax)
+            .arg(alert.value, 0, 'f', 0);
+    case AlertRuleType::Disappeared:
+        return tr("Объект %1 исчез из каталога (последняя эпоха %2)")
+            .arg(alert.catalogNumber)
+            .arg(epoch);
+    case AlertRuleType::BstarRise:
+        return std::isfinite(alert.value)
+                   ? tr("Объект %1: B* вырос в %2 раза (эпоха %3)")
+                         .arg(alert.catalogNumber)
+                         .arg(alert.value, 0, 'f', 1)
+                         .arg(epoch)
+                   : tr("Объект %1: B* вырос с нуля (эпоха %2)")
+                         .arg(alert.catalogNumber)
+                         .arg(epoch);
+    }
+    return QString();
+}
+
+void InfoWindow::editAlertRules()
+{
+    //! Правило на строку в формате AlertEngine::parseRule
+    QStringList lines;
+    for (const AlertRule &rule : this->alerts_.rules())
+        lines.append(AlertEngine::ruleText(rule));
+    bool accepted = false;
+    const QString text = QInputDialog::getMultiLineText(
+        this,
+        tr("Правила оповещений"),
+        tr("По правилу на строку, после параметров — номера объектов (без них — все объекты):\n"
+           "stale 14 — эпоха старше 14 суток\n"
+           "band 97 99 400 600 — новый объект с наклонением 97–99° и перигеем 400–600 км\n"
+           "gone 25544 — объект исчез из каталога\n"
+           "bstar 5 — B* нового набора вырос в 5 раз"),
+        lines.join(QLatin1Char('\n')),
+        &accepted);
+    if (!accepted)
+        return;
+
+    QVector<AlertRule> rules;
+    for (const QString &line : text.split(QLatin1Char('\n'))) {
+        if (line.simplified().isEmpty())
+            continue; //! Пустая строка
+        AlertRule rule;
+        if (!AlertEngine::parseRule(line, rule)) {
+            emit errorOccurred(tr("Неверная строка правила: %1").arg(line));
+            return;
+        }
+        rules.append(rule);
+    }
+    this->alerts_.setRules(rules); //! Состояние каталога сохраняется
+
+    //! Первые правила: текущий каталог становится исходным состоянием
+    if (!rules.isEmpty() && !this->alertsStarted_) {
+        TleParser::decodeFields(this->stats_.records, AlertEngine::requiredFields());
+        this->alerts_.reset(this->stats_.records, QDateTime::currentMSecsSinceEpoch() * 1000);
+        this->alertsStarted_ = true;
+    }
+    //! Поля правил декодируются при фоновом разборе обновлений, а не в окне
+    if (this->refresher_)
+        this->refresher_->setFields(TleStatistics::requiredFields()
+                                    | (this->alertsStarted_ ? AlertEngine::requiredFields()
+                                                            : TleFields()));
+    this->statusBar()->showMessage(tr("Правил оповещений: %1").arg(rules.size()), 2500);
+}
+
+void InfoWindow::editSources()
+{
+    if (!this->refresher_)
+        return;
+
+    //! Источник на строку: адрес и период обновления в минутах
+    QStringList lines;
+    for (const RefreshSource &source : this->refresher_->sources())
+        lines.append(QStringLiteral("%1 %2").arg(source.url.toString()).arg(source.interval / 60));
+    bool accepted = false;
+    const QString text
+        = QInputDialog::getMultiLineText(this,
+                                         tr("Источники обновления"),
+                                         tr("Адрес и период обновления в минутах, по источнику на строку:"),
+                                         lines.join(QLatin1Char('\n')),
+                                         &accepted);
+    if (!accepted)
+        return;
+
+    QVector<RefreshSource> sources;
+    for (const QString &line : text.split(QLatin1Char('\n'))) {
+        const QStringList parts = line.simplified().split(QLatin1Char(' '));
+        if (parts.first().isEmpty())
+            continue; //! Пустая строка
+        RefreshSource source;
+        source.url = QUrl(parts.first());
+        bool valid = parts.size() <= 2 && source.url.isValid()
+                     && (source.url.scheme() == QLatin1String("http")
+                         || source.url.scheme() == QLatin1String("https"));
+        if (parts.size() == 2) {
+            const int minutes = parts[1].toInt(&valid);
+            valid = valid && minutes > 0;
+            source.interval = minutes * 60;
+        }
+        if (!valid) {
+            emit errorOccurred(tr("Неверная строка источника: %1").arg(line));
+            return;
+        }
+        sources.append(source);
+    }
+    if (sources.isEmpty()) {
+        emit errorOccurred(tr("Нужен хотя бы один источник"));
+        return;
+    }
+    this->refresher_->setSources(sources); //! Состояние оставшихся источников сохраняется
+}
+
+void InfoWindow::compareWithFile()
+{
+    //! Открываем диалоговое окно для выбора второго снимка
+    const QString filePath
+        = QFileDialog::getOpenFileName(this,
+                                       tr("Выберите снимок каталога"),
+                                       "",
+                                       tr("Все поддерживаемые (*.txt *.tle *.json *.csv *.xml *.gz *.zip *.xz);;"
+                                          "TLE файлы (*.txt *.tle);;"
+                                          "OMM файлы (*.json *.csv *.xml);;"
+                                          "Сжатые файлы (*.gz *.zip *.xz)"));
+    if (filePath.isEmpty())
+        return;
+
+    TleParser parser; //! Отдельный парсер, чтобы не затрагивать слежение за файлом
+    this->connect(&parser, &TleParser::errorOccurred, this, &InfoWindow::errorOccurred);
+    if (!parser.loadFromFile(filePath))
+        return;
+
+    //! Текущий каталог считается старым снимком, выбранный файл — новым
+    const CatalogDiffResult result = CatalogDiff::compare(this->fullRecords(), parser.records());
+
+    DiffWindow *diffWindow = new DiffWindow(result, this);
+    diffWindow->setAttribute(Qt::WA_DeleteOnClose); //! Окно удаляется при закрытии
+    diffWindow->setWindowTitle(tr("Сравнение с %1").arg(QFileInfo(filePath).fileName()));
+    diffWindow->show();
+}
+
+void InfoWindow::exportTle()
+{
+    //! Открываем диалоговое окно для выбора файла каталога
+    const QString filePath = QFileDialog::getSaveFileName(this,
+                                                          tr("Сохранить в TLE"),
+                                                          "catalog.tle",
+                                                          tr("TLE файлы (*.tle *.txt)"));
+    if (filePath.isEmpty())
+        return;
+
+    QSaveFile file(filePath); //! Файл заменяется только после успешной записи
+    if (!file.open(QIODevice::WriteOnly)) {
+        emit errorOccurred(tr("Не удалось открыть файл для записи: %1").arg(filePath));
+        return;
+    }
+
+    bool written = false;
+    int skipped = 0; //! Записи с номером, не представимым в TLE
+    {
+        TleWriter writer(&file); //! Буфер сбрасывается до фиксации файла
+        written = writer.write(this->fullRecords()) && writer.flush();
+        skipped = writer.skipped();
+    }
+    if (!written || !file.commit()) {
+        emit errorOccurred(tr("Не удалось записать файл: %1").arg(file.errorString()));
+        return;
+    }
+
+    this->statusBar()->showMessage(
+        tr("Сохранено записей: %1").arg(this->stats_.records.size() - skipped), 2500);
+    if (skipped > 0)
+        emit errorOccurred(tr("Не сохранено записей с номером объекта больше %1 "
+                              "(не представим в TLE даже в формате Alpha-5): %2")
+                               .arg(TleUtils::maxCatalogNumber)
+                               .arg(skipped));
+}
+
+void InfoWindow::showGroups()
+{
+    this->fullRecords(); //! Группировать можно по любому полю
+    GroupWindow *groupWindow = new GroupWindow(this->stats_, this);
+    groupWindow->setAttribute(Qt::WA_DeleteOnClose); //! Окно удаляется при закрытии
+    groupWindow->show();
+}
+
+void InfoWindow::showManeuvers()
+{
+    ManeuverWindow *maneuverWindow = new ManeuverWindow(this->fullRecords(), this);
+    maneuverWindow->setAttribute(Qt::WA_DeleteOnClose); //! Окно удаляется при закрытии
+    maneuverWindow->show();
+}
+
+void InfoWindow::showPasses()
+{
+    TleParser::decodeFields(this->stats_.records, PassPredictor::requiredFields());
+    PassWindow *passWindow = new PassWindow(this->stats_.records, this);
+    passWindow->setAttribute(Qt::WA_DeleteOnClose); //! Окно удаляется при закрытии
+    passWindow->show();
+}
+
+void InfoWindow::showCoverage()
+{
+    TleParser::decodeFields(this->stats_.records, CoverageEngine::requiredFields());
+    CoverageWindow *coverageWindow = new CoverageWindow(this->stats_.records, this);
+    coverageWindow->setAttribute(Qt::WA_DeleteOnClose); //! Окно удаляется при закрытии
+    coverageWindow->show();
+}
+
+void InfoWindow::showMap()
+{
+    TleParser::decodeFields(this->stats_.records, MapPropagator::requiredFields());
+    MapWindow *mapWindow = new MapWindow(this->stats_.records, this);
+    mapWindow->setAttribute(Qt::WA_DeleteOnClose); //! Окно удаляется при закрытии
+    mapWindow->show();
+}
+
+void InfoWindow::setSourceFile(const QString &filePath)
+{
+    if (!this->watcher_) {
+        this->watcher_ = new TleFileWatcher(this); //! Создаем объект для слежения за файлом
+        this->connect(this->watcher_,
+                      &TleFileWatcher::recordsAppended,
+                      this,
+                      &InfoWindow::appendRecords);
+        this->connect(this->watcher_,
+                      &TleFileWatcher::recordsReloaded,
+                      this,
+                      &InfoWindow::replaceRecords);
+        //! Ошибки слежения показываются в статусной строке, а не в диалоге
+        this->connect(this->watcher_,
+                      &TleFileWatcher::errorOccurred,
+                      this,
+                      [this](const QString &message) {
+                          this->statusBar()->showMessage(message, 5000);
+                      });
+    }
+    this->watcher_->setFile(filePath);        //! Запоминаем текущее состояние файла
+    this->ui_->watchAction->setEnabled(true); //! Слежение доступно только для файлов
+}
+
+void InfoWindow::setSourceUrl(const QUrl &url)
+{
+    if (!this->refresher_) {
+        this->refresher_ = new TleUrlRefresher(this); //! Создаем объект для обновления из сети
+        //! Разбираются те же поля, что и при первой загрузке
+        this->refresher_->setFields(TleStatistics::requiredFields());
+        this->connect(this->refresher_,
+                      &TleUrlRefresher::refreshed,
+                      this,
+                      &InfoWindow::replaceStatistics);
+        //! Ошибки обновления показываются в статусной строке, а не в диалоге
+        this->connect(this->refresher_,
+                      &TleUrlRefresher::errorOccurred,
+                      this,
+                      [this](const QString &message) {
+                          this->statusBar()->showMessage(message, 5000);
+                      });
+    }
+    RefreshSource source;
+    source.url = url;
+    this->refresher_->setSources({source});
+    this->refresher_->setRecords(url, this->stats_.records); //! Источник уже загружен
+    //! Автообновление доступно только для данных из сети
+    this->ui_->autoRefreshAction->setEnabled(true);
+    this->ui_->refreshNowAction->setEnabled(true);
+    this->ui_->sourcesAction->setEnabled(true);
 }
 
 InfoWindow::InfoWindow(const QVector<TleRecord> &records, QWidget *parent)
@@ -189,6 +709,27 @@ InfoWindow::InfoWindow(const QVector<TleRecord> &records, QWidget *parent)
 
     this->bindActions(); //! Связываем действия с соответствующими слотами
 
+    //! Создание моделей для таблиц с данными
+    this->yearModel_ = this->createModel(this->ui_->yearTableView,
+                                         {tr("Год"), tr("Число запусков")});
+    this->inclinationModel_ = this->createModel(this->ui_->inclinationTableView,
+                                                {tr("Наклонение (°)"), tr("Число запусков")});
+    this->regimeModel_ = this->createModel(this->ui_->regimeTableView,
+                                           {tr("Режим"), tr("Число спутников")});
+    this->altitudeModel_ = this->createModel(this->ui_->altitudeTableView,
+                                             {tr("Высота перигея (км, от)"), tr("Число спутников")});
+    this->quantileModel_ = this->createModel(this->ui_->quantileTableView,
+                                             {tr("Величина"), tr("Медиана"), tr("p95"), tr("p99")});
+
+    //! Подписи диаграмм; панель с ними можно скрыть и вернуть кнопкой на панели инструментов
+    this->ui_->inclinationPlot->setTitle(tr("Наклонение и среднее движение"),
+                                         tr("Среднее движение (об/сут)"),
+                                         tr("Наклонение (°)"));
+    this->ui_->eccentricityPlot->setTitle(tr("Эксцентриситет и высота перигея"),
+                                          tr("Высота перигея (км)"),
+                                          tr("Эксцентриситет"));
+    this->ui_->toolBar->addAction(this->ui_->plotDock->toggleViewAction());
+
     this->fillUiFromStats(); //! Заполнение пользовательского интерфейса статистикой
 }
 
@@ -21,11 +21,17 @@
 #include <QMessageBox>
 #include <QStandardItemModel>
 #include <QStyleHints>
+#include <QTableView>
 #include <QTimer>
 #include <QToolBar>
 #include <QOperatingSystemVersion>
 
+#include <functional>
+
+#include "Utils/AlertEngine.hpp"
+#include "Utils/TleFileWatcher.hpp"
 #include "Utils/TleParser.hpp"
+#include "Utils/TleUrlRefresher.hpp"
 
 namespace Ui {
 class InfoWindow;
@@ -53,6 +59,25 @@ public:
      */
     ~InfoWindow();
 
+    /*!
+     * \brief setSourceFile - задаёт файл, из которого загружены записи.
+     * \param filePath Путь к файлу.
+     * \details
+     * После этого становится доступен режим слежения за файлом:
+     * дописанные записи добавляются в статистику без повторного открытия окна.
+     */
+    void setSourceFile(const QString &filePath);
+
+    /*!
+     * \brief setSourceUrl - задаёт URL, из которого загружены записи.
+     * \param url Адрес источника.
+     * \details
+     * После этого становится доступно автообновление: источники (этот и добавленные
+     * пользователем) загружаются по расписанию, а статистика заменяется целиком
+     * без повторного открытия окна.
+     */
+    void setSourceUrl(const QUrl &url);
+
 signals:
     /*!
      * \brief requestOpenLocalFile - сигнал, который запрашивает открытие локального файла.
@@ -102,6 +127,97 @@ public slots:
      */
     void showError(const QString &message);
 
+    /*!
+     * \brief appendRecords - слот для добавления новых записей.
+     * \param records Новые записи TLE.
+     * \details
+     * Статистика дополняется на месте, таблицы обновляются без пересоздания моделей.
+     */
+    void appendRecords(const QVector<TleRecord> &records);
+
+    /*!
+     * \brief replaceRecords - слот для замены всех записей.
+     * \param records Новый набор записей TLE.
+     * \details
+     * Статистика пересчитывается заново, таблицы обновляются без пересоздания моделей.
+     */
+    void replaceRecords(const QVector<TleRecord> &records);
+
+    /*!
+     * \brief replaceStatistics - слот для замены статистики, посчитанной в фоне.
+     * \param statistics Новая статистика.
+     * \details Таблицы обновляются без пересоздания моделей.
+     */
+    void replaceStatistics(const TleStatistics &statistics);
+
+    /*!
+     * \brief editSources - слот для изменения списка источников автообновления.
+     * \details
+     * Источник задаётся строкой «адрес период», период — в минутах
+     * (без периода — раз в час).
+     */
+    void editSources();
+
+    /*!
+     * \brief editAlertRules - слот для изменения правил оповещений.
+     * \details
+     * Правило задаётся строкой (см. AlertEngine::parseRule). Правила проверяются
+     * при каждом обновлении каталога по набору изменений; сработавшие показываются
+     * в статусной строке и дописываются в журнал alerts.log.
+     */
+    void editAlertRules();
+
+    /*!
+     * \brief compareWithFile - слот для сравнения каталога с другим снимком.
+     * \details
+     * Открывает диалог выбора файла, загружает из него второй снимок каталога
+     * и показывает окно со списком новых, исчезнувших и изменившихся объектов.
+     */
+    void compareWithFile();
+
+    /*!
+     * \brief exportTle - слот для сохранения загруженных записей в формате TLE.
+     * \details
+     * Строки формируются заново по полям записей (в том числе загруженных из OMM)
+     * с пересчитанными контрольными суммами и записываются в файл 3LE.
+     */
+    void exportTle();
+
+    /*!
+     * \brief showGroups - слот для открытия окна группировки записей.
+     * \details
+     * Окно получает копию статистики, разделяющую данные с текущим каталогом,
+     * поэтому последующие изменения каталога на него не влияют.
+     */
+    void showGroups();
+
+    /*!
+     * \brief showManeuvers - слот для открытия окна поиска манёвров.
+     * \details
+     * Поиск выполняется по наборам элементов текущего каталога: файл должен
+     * содержать несколько наборов каждого объекта (например, выгрузку истории).
+     */
+    void showManeuvers();
+
+    /*!
+     * \brief showPasses - слот для открытия окна прогноза пролётов над наземной станцией.
+     * \details
+     * Прогноз выполняется по последнему набору элементов каждого объекта каталога.
+     */
+    void showPasses();
+
+    /*!
+     * \brief showCoverage - слот для открытия окна карты покрытия поверхности Земли.
+     * \details
+     * Расчёт выполняется по последнему набору элементов каждого объекта каталога.
+     */
+    void showCoverage();
+
+    /*!
+     * \brief showMap - слот для открытия карты движения объектов каталога.
+     */
+    void showMap();
+
 protected:
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
     /*!
@@ -139,20 +255,57 @@ private:
     QString formattedResults() const;
 
     /*!
-     * \brief modelFromMap - создает модель QAbstractItemModel из QMap.
-     * \param map QMap, содержащий данные для модели.
+     * \brief createModel - создает пустую модель для таблицы.
+     * \param view Таблица, к которой подключается модель.
      * \param headers Список заголовков для модели.
      * \return Указатель на созданную модель.
+     */
+    QStandardItemModel *createModel(QTableView *view, const QStringList &headers);
+
+    /*!
+     * \brief fillModelFromMap - заполняет модель данными из QMap.
+     * \param model Модель, которую нужно заполнить.
+     * \param map QMap, содержащий данные для модели.
+     * \param keyText Функция, переводящая ключ в текст (по умолчанию — число).
      * \details
-     * Этот метод создает модель из QMap, которая будет использоваться для отображения данных в таблице.
+     * Модель обновляется на месте: изменяются только ячейки с новыми значениями,
+     * поэтому таблица сохраняет прокрутку и выделение.
      */
-    QAbstractItemModel *modelFromMap(const QMap<int, int> &map, const QStringList &headers);
+    void fillModelFromMap(QStandardItemModel *model,
+                          const QMap<int, int> &map,
+                          const std::function<QString(int)> &keyText = {});
+
+    /*!
+     * \brief fillQuantileModel - заполняет таблицу квантилей из эскизов статистики.
+     * \details Строка на величину: медиана, p95 и p99.
+     */
+    void fillQuantileModel();
 
     /*!
      * \brief fillUiFromStats - заполняет пользовательский интерфейс данными из статистики.
      */
     void fillUiFromStats();
 
+    /*!
+     * \brief fullRecords - записи со всеми декодированными полями
+     * \details
+     * Главное окно загружает только поля статистики; остальные декодируются здесь
+     * при первом обращении окна, которому они нужны (сравнение, выгрузка, группы, манёвры).
+     */
+    const QVector<TleRecord> &fullRecords();
+
+    /*!
+     * \brief checkAlerts - проверка правил оповещений после обновления каталога
+     * \param appended Записи, дописанные в каталог (пусто — каталог заменён целиком)
+     */
+    void checkAlerts(const QVector<TleRecord> &appended = {});
+
+    /*!
+     * \brief alertText - текст оповещения
+     * \param alert Сработавшее правило
+     */
+    QString alertText(const Alert &alert) const;
+
     /*!
      * \brief ui_ Указатель на пользовательский интерфейс, созданный с помощью Qt Designer.
      * \details
@@ -166,6 +319,32 @@ private:
      * Содержит данные, такие как количество спутников, даты запусков и наклоны орбит и сам набор спутников.
      */
     TleStatistics stats_;
+
+    QStandardItemModel *yearModel_ = nullptr;        //! Модель таблицы запусков по годам
+    QStandardItemModel *inclinationModel_ = nullptr; //! Модель таблицы по наклонению
+    QStandardItemModel *regimeModel_ = nullptr;      //! Модель таблицы по орбитальным режимам
+    QStandardItemModel *altitudeModel_ = nullptr;    //! Модель таблицы по высоте перигея
+    QStandardItemModel *quantileModel_ = nullptr;    //! Модель таблицы квантилей
+
+    /*!
+     * \brief watcher_ Слежение за файлом-источником (nullptr, если данные загружены из сети).
+     */
+    TleFileWatcher *watcher_ = nullptr;
+
+    /*!
+     * \brief refresher_ Автообновление из сети (nullptr, если данные загружены из файла).
+     */
+    TleUrlRefresher *refresher_ = nullptr;
+
+    /*!
+     * \brief alerts_ Правила оповещений и состояние каталога, с которым сравниваются обновления.
+     */
+    AlertEngine alerts_;
+
+    /*!
+     * \brief alertsStarted_ Задано ли исходное состояние каталога для правил.
+     */
+    bool alertsStarted_ = false;
 };
 
 #endif // INFOWINDOW_HPP
@@ -54,7 +54,10 @@ void MainWindow::openLocalFile()
     const QString filePath = QFileDialog::getOpenFileName(this,
                                                           tr("Открыть TLE файл"),
                                                           "",
-                                                          tr("TLE файлы (*.txt *.tle)"));
+                                                          tr("Все поддерживаемые (*.txt *.tle *.json *.csv *.xml *.gz *.zip *.xz);;"
+                                                             "TLE файлы (*.txt *.tle);;"
+                                                             "OMM файлы (*.json *.csv *.xml);;"
+                                                             "Сжатые файлы (*.gz *.zip *.xz)"));
     this->tleParser_->loadFromFile(filePath); //! Если пользователь выбрал файл
 }
 
@@ -89,10 +92,17 @@ void MainWindow::showError(const QString &message)
     QMessageBox::critical(this, tr("Ошибка"), message);
 }
 
-void MainWindow::showInfoWindow(const QVector<TleRecord> &records)
+void MainWindow::showInfoWindow(const QVector<TleRecord> &records,
+                                const QString &sourcePath,
+                                const QUrl &sourceUrl)
 {
     //! Создание нового окна с информацией о спутниках
     InfoWindow *infoWindow_ = new InfoWindow(records);
+    //! Для файлов доступен режим слежения за изменениями, для сети — автообновление
+    if (!sourcePath.isEmpty())
+        infoWindow_->setSourceFile(sourcePath);
+    else if (!sourceUrl.isEmpty())
+        infoWindow_->setSourceUrl(sourceUrl);
 
     //! Подключаем сигнал для обработки открытия локального файла в окне InfoWindow
     this->connect(infoWindow_, &InfoWindow::requestOpenLocalFile, this, &MainWindow::openLocalFile);
@@ -111,7 +121,9 @@ void MainWindow::bindActions()
     this->connect(this->tleParser_, &TleParser::errorOccurred, this, &MainWindow::showError);
     //! Подключаем сигнал завершения парсинга к слоту showInfoWindow
     this->connect(this->tleParser_, &TleParser::parsingFinished, this, [this]() {
-        this->showInfoWindow(this->tleParser_->records());
+        this->showInfoWindow(this->tleParser_->records(),
+                             this->tleParser_->sourcePath(),
+                             this->tleParser_->sourceUrl());
     });
 
     //! Подключаем сигнал к кнопке "filePushButton"
@@ -130,6 +142,8 @@ MainWindow::MainWindow(QWidget *parent)
     , tleParser_(new TleParser(this))
 {
     this->ui_->setupUi(this); //! Инициализация пользовательского интерфейса
+    //! Для окна статистики достаточно части полей, остальные декодируются по требованию
+    this->tleParser_->setFields(TleStatistics::requiredFields());
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
     this->updateStyles(); //! Обновление стилей приложения при смене темы
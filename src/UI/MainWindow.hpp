@@ -99,11 +99,15 @@ private:
     /*!
      * \brief showInfoWindow - показывает окно с информацией о спутниках
      * \param records Список записей TLE, которые будут отображаться в окне
+     * \param sourcePath Путь к файлу-источнику (пусто, если данные загружены из сети)
+     * \param sourceUrl Адрес источника (пусто, если данные загружены из файла)
      * \details
      * Этот метод создает новое окно с информацией о спутниках,
      * используя данные из списка records.
      */
-    void showInfoWindow(const QVector<TleRecord> &records);
+    void showInfoWindow(const QVector<TleRecord> &records,
+                        const QString &sourcePath,
+                        const QUrl &sourceUrl);
 
     /*!
      * \brief bindActions - связывает действия с соответствующими слотами
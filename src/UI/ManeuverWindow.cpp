@@ -0,0 +1,143 @@
+/*!
+ * \file ManeuverWindow.cpp
+ * \brief Исходный файл для окна поиска манёвров
+ * \details
+ * Этот файл содержит реализацию класса ManeuverWindow.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "ManeuverWindow.hpp"
+#include "./ui_ManeuverWindow.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QSaveFile>
+#include <QTextStream>
+
+namespace {
+
+//! Эпоха в микросекундах Unix в виде текста UTC
+QString epochText(qint64 micros)
+{
+    return QDateTime::fromMSecsSinceEpoch(micros / 1000).toUTC().toString(
+        QStringLiteral("yyyy-MM-dd HH:mm:ss"));
+}
+
+} // namespace
+
+void ManeuverWindow::rescan()
+{
+    ManeuverSettings settings; //! Пороги из элементов управления
+    settings.sigma = this->ui_->sigmaSpinBox->value();
+    settings.bstarRatio = this->ui_->bstarRatioSpinBox->value();
+
+    QElapsedTimer timer;
+    timer.start();
+    const QVector<ManeuverEvent> events = ManeuverDetector::scan(this->records_, settings);
+    const qint64 elapsed = timer.elapsed();
+
+    this->model_->clear();
+    this->model_->setHorizontalHeaderLabels({tr("Номер"),
+                                             tr("Название"),
+                                             tr("Эпоха (UTC)"),
+                                             tr("Предыдущая эпоха"),
+                                             tr("Событие"),
+                                             tr("Величина"),
+                                             tr("Порог")});
+    this->model_->setRowCount(int(events.size()));
+    for (int row = 0; row < events.size(); ++row) {
+        const ManeuverEvent &event = events[row];
+        QStandardItem *number = new QStandardItem;
+        number->setData(event.catalogNumber, Qt::DisplayRole);
+        this->model_->setItem(row, 0, number);
+        this->model_->setItem(row, 1, new QStandardItem(this->names_.value(event.catalogNumber)));
+        this->model_->setItem(row, 2, new QStandardItem(epochText(event.epoch)));
+        this->model_->setItem(row, 3, new QStandardItem(epochText(event.previousEpoch)));
+        this->model_->setItem(row, 4, new QStandardItem(ManeuverDetector::typeName(event.type)));
+        //! Числа хранятся как числа, чтобы сортировка по столбцу была числовой
+        for (int column = 5; column <= 6; ++column) {
+            QStandardItem *item = new QStandardItem;
+            item->setData(column == 5 ? event.value : event.threshold, Qt::DisplayRole);
+            this->model_->setItem(row, column, item);
+        }
+    }
+
+    this->statusBar()->showMessage(tr("Событий: %1, наборов элементов: %2, время поиска: %3 мс")
+                                       .arg(events.size())
+                                       .arg(this->records_.size())
+                                       .arg(elapsed));
+}
+
+void ManeuverWindow::exportCsv()
+{
+    //! Открываем диалоговое окно для сохранения файла
+    const QString filePath = QFileDialog::getSaveFileName(this,
+                                                          tr("Экспорт событий"),
+                                                          "maneuvers.csv",
+                                                          tr("Файл CSV (*.csv)"));
+    if (filePath.isEmpty())
+        return;
+
+    QSaveFile file(filePath); //! Запись во временный файл с атомарной заменой
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::critical(this,
+                              tr("Ошибка"),
+                              tr("Не удалось открыть файл для записи: %1").arg(filePath));
+        return;
+    }
+
+    QTextStream out(&file);
+    for (int column = 0; column < this->model_->columnCount(); ++column)
+        out << (column ? "," : "")
+            << this->model_->headerData(column, Qt::Horizontal).toString();
+    out << '\n';
+    //! Строки; имя объекта берётся в кавычки, так как может содержать запятые
+    for (int row = 0; row < this->model_->rowCount(); ++row) {
+        for (int column = 0; column < this->model_->columnCount(); ++column) {
+            QString text = this->model_->item(row, column)->text();
+            if (column == 1)
+                text = QLatin1Char('"') + text.replace(QLatin1Char('"'), QLatin1String("\"\""))
+                       + QLatin1Char('"');
+            out << (column ? "," : "") << text;
+        }
+        out << '\n';
+    }
+    out.flush();
+
+    if (!file.commit()) {
+        QMessageBox::critical(this, tr("Ошибка"), tr("Не удалось сохранить файл: %1").arg(filePath));
+        return;
+    }
+    this->statusBar()->showMessage(tr("Сохранено в файл: %1").arg(filePath), 2500);
+}
+
+ManeuverWindow::ManeuverWindow(const QVector<TleRecord> &records, QWidget *parent)
+    : QMainWindow(parent)
+    , ui_(new Ui::ManeuverWindow)
+    , records_(records)
+    , model_(new QStandardItemModel(this))
+{
+    this->ui_->setupUi(this); //! Инициализация пользовательского интерфейса
+
+    for (const TleRecord &record : this->records_)
+        this->names_.insert(record.catalogNumber, record.name.trimmed().toString());
+
+    this->ui_->eventTableView->setModel(this->model_);
+    this->ui_->eventTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    //! Одинаковая высота строк: таблица не измеряет каждую строку при прокрутке
+    this->ui_->eventTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
+    this->connect(this->ui_->scanButton, &QPushButton::clicked, this, &ManeuverWindow::rescan);
+    this->connect(this->ui_->exportButton, &QPushButton::clicked, this, &ManeuverWindow::exportCsv);
+
+    this->rescan(); //! Первый поиск с порогами по умолчанию
+}
+
+ManeuverWindow::~ManeuverWindow()
+{
+    delete this->ui_; //! Освобождение ресурсов пользовательского интерфейса
+}
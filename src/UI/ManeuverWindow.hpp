@@ -0,0 +1,66 @@
+/*!
+ * \file ManeuverWindow.hpp
+ * \brief Заголовочный файл для класса ManeuverWindow.
+ * \details
+ * Этот файл содержит определение класса ManeuverWindow — окна поиска манёвров
+ * и аномалий в истории наборов элементов загруженного каталога.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef MANEUVERWINDOW_HPP
+#define MANEUVERWINDOW_HPP
+
+#include <QHash>
+#include <QMainWindow>
+#include <QStandardItemModel>
+
+#include "Utils/ManeuverDetector.hpp"
+
+namespace Ui {
+class ManeuverWindow;
+}
+
+/*!
+ * \brief Класс ManeuverWindow
+ * \details
+ * Показывает события, найденные ManeuverDetector, с возможностью изменить
+ * пороги и выгрузить список в CSV. Имеет смысл для файлов с несколькими
+ * наборами элементов каждого объекта.
+ */
+class ManeuverWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief ManeuverWindow - конструктор класса ManeuverWindow.
+     * \param records Записи каталога (копия разделяет данные с исходной).
+     * \param parent Указатель на родительский виджет (по умолчанию nullptr).
+     */
+    explicit ManeuverWindow(const QVector<TleRecord> &records, QWidget *parent = nullptr);
+
+    /*!
+     * \brief ~ManeuverWindow - деструктор класса ManeuverWindow.
+     */
+    ~ManeuverWindow();
+
+public slots:
+    /*!
+     * \brief rescan - слот для поиска событий с выбранными порогами.
+     */
+    void rescan();
+
+    /*!
+     * \brief exportCsv - слот для выгрузки событий в CSV.
+     */
+    void exportCsv();
+
+private:
+    Ui::ManeuverWindow *ui_;     //! Пользовательский интерфейс окна
+    QVector<TleRecord> records_; //! Наборы элементов каталога
+    QHash<int, QString> names_;  //! Названия объектов по номеру
+    QStandardItemModel *model_;  //! Модель таблицы событий
+};
+
+#endif // MANEUVERWINDOW_HPP
@@ -0,0 +1,383 @@
+/*!
+ * \file MapWidget.cpp
+ * \brief Карта движения объектов каталога
+ * \details
+ * Этот файл содержит реализацию класса MapWidget.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "MapWidget.hpp"
+
+#include <QDateTime>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QWheelEvent>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr int frameInterval = 16;    //! Период кадров (мс), около 60 кадров в секунду
+constexpr int objectsPerChunk = 512; //! Объектов в пачке одного потока
+constexpr int markerSize = 2;        //! Размер маркера и ячейки отсечения (пиксели)
+constexpr double maxZoom = 200.0;    //! Наибольшее увеличение
+constexpr int trackPoints = 360;     //! Точек трассы на два витка
+constexpr int selectRadius = 8;      //! Радиус выбора объекта щелчком (пиксели)
+
+} // namespace
+
+MapWidget::MapWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    this->setMinimumSize(360, 180);
+    //! Фон рисуется в paintEvent целиком
+    this->setAttribute(Qt::WA_OpaquePaintEvent);
+
+    this->frameTimer_.setInterval(frameInterval);
+    this->frameTimer_.setTimerType(Qt::PreciseTimer);
+    this->connect(&this->frameTimer_, &QTimer::timeout, this, &MapWidget::nextFrame);
+    this->connect(&this->watcher_, &QFutureWatcher<void>::finished, this, &MapWidget::onFrameReady);
+
+    this->clock_.start();
+    this->fpsClock_.start();
+    this->baseTime_ = double(QDateTime::currentMSecsSinceEpoch()) / 1000.0;
+}
+
+MapWidget::~MapWidget()
+{
+    //! Потоки пишут в back_ и читают propagator_
+    this->watcher_.waitForFinished();
+}
+
+void MapWidget::setPropagator(const MapPropagator &propagator)
+{
+    this->watcher_.waitForFinished();
+    this->propagator_ = propagator;
+    const int size = this->propagator_.size();
+
+    this->chunks_.clear();
+    for (int first = 0; first < size; first += objectsPerChunk)
+        this->chunks_.append({first, qMin(size, first + objectsPerChunk)});
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    this->front_ = QVector<QPointF>(size, QPointF(nan, nan));
+    this->back_ = QVector<QPointF>(size, QPointF(nan, nan));
+    this->frontValid_ = false;
+    this->selected_ = -1;
+    this->track_.clear();
+    this->nextFrame();
+}
+
+void MapWidget::setTime(double unixSeconds)
+{
+    this->baseTime_ = unixSeconds;
+    this->baseClock_ = this->clock_.elapsed();
+}
+
+void MapWidget::setSpeed(double factor)
+{
+    this->rebase();
+    this->speed_ = factor;
+}
+
+void MapWidget::setRunning(bool running)
+{
+    this->rebase();
+    this->running_ = running;
+}
+
+double MapWidget::clockTime() const
+{
+    if (!this->running_)
+        return this->baseTime_;
+    return this->baseTime_
+           + double(this->clock_.elapsed() - this->baseClock_) / 1000.0 * this->speed_;
+}
+
+void MapWidget::rebase()
+{
+    this->baseTime_ = this->clockTime();
+    this->baseClock_ = this->clock_.elapsed();
+}
+
+void MapWidget::nextFrame()
+{
+    if (this->watcher_.isRunning() || this->chunks_.isEmpty())
+        return; //! Прошлый кадр ещё считается: этот пропускается
+    const double time = this->clockTime();
+    if (this->frontValid_ && time == this->frontTime_)
+        return; //! Время остановлено, кадр не изменится
+
+    this->backTime_ = time;
+    this->frameClock_.start();
+    //! Буфер не разделяется с другими QVector, поэтому указатель не меняется до смены буферов
+    const MapPropagator *propagator = &this->propagator_;
+    QPointF *out = this->back_.data();
+    this->watcher_.setFuture(QtConcurrent::map(this->chunks_, [propagator, time, out](Chunk &chunk) {
+        propagator->subpoints(time, chunk.first, chunk.last, out);
+    }));
+}
+
+void MapWidget::onFrameReady()
+{
+    this->frameCost_ = double(this->frameClock_.nsecsElapsed()) / 1e6;
+    this->front_.swap(this->back_);
+    this->frontTime_ = this->backTime_;
+    this->frontValid_ = true;
+
+    ++this->frames_;
+    const qint64 elapsed = this->fpsClock_.elapsed();
+    if (elapsed >= 1000) {
+        this->framesPerSecond_ = this->frames_ * 1000.0 / elapsed;
+        this->frames_ = 0;
+        this->fpsClock_.restart();
+    }
+
+    this->updateTrack();
+    this->update();
+}
+
+void MapWidget::updateTrack()
+{
+    if (this->selected_ < 0)
+        return;
+    //! Трасса строится на виток назад и вперёд и обновляется, когда объект проходит четверть витка
+    const double period = qMin(this->propagator_.period(this->selected_), 1440.0) * 60.0;
+    if (!this->track_.isEmpty() && std::abs(this->frontTime_ - this->trackTime_) < period / 4.0)
+        return;
+    this->trackTime_ = this->frontTime_;
+    this->track_ = this->propagator_.groundTrack(this->selected_,
+                                                 this->frontTime_ - period,
+                                                 this->frontTime_ + period,
+                                                 2.0 * period / trackPoints);
+}
+
+void MapWidget::resetView()
+{
+    this->center_ = QPointF(0.0, 0.0);
+    this->zoom_ = 1.0;
+    this->update();
+}
+
+double MapWidget::scale() const
+{
+    //! Вся карта (360° × 180°) при увеличении 1 вписывается в виджет
+    return qMin(this->width() / 360.0, this->height() / 180.0) * this->zoom_;
+}
+
+QPointF MapWidget::toWidget(const QPointF &point) const
+{
+    const double scale = this->scale();
+    return QPointF(this->width() / 2.0 + (point.x() - this->center_.x()) * scale,
+                   this->height() / 2.0 - (point.y() - this->center_.y()) * scale);
+}
+
+QPointF MapWidget::toMap(const QPointF &point) const
+{
+    const double scale = this->scale();
+    return QPointF(this->center_.x() + (point.x() - this->width() / 2.0) / scale,
+                   this->center_.y() - (point.y() - this->height() / 2.0) / scale);
+}
+
+void MapWidget::clampCenter()
+{
+    //! Край карты не уходит дальше середины виджета
+    this->center_.setX(qBound(-180.0, this->center_.x(), 180.0));
+    this->center_.setY(qBound(-90.0, this->center_.y(), 90.0));
+}
+
+void MapWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(this->rect(), this->palette().window());
+
+    //! Область карты и сетка через 30°
+    const QRectF map(this->toWidget(QPointF(-180.0, 90.0)), this->toWidget(QPointF(180.0, -90.0)));
+    painter.fillRect(map, this->palette().base());
+    QColor gridColor = this->palette().color(QPalette::WindowText);
+    gridColor.setAlpha(50);
+    painter.setPen(gridColor);
+    for (int longitude = -150; longitude <= 150; longitude += 30) {
+        const double x = this->toWidget(QPointF(longitude, 0.0)).x();
+        painter.drawLine(QPointF(x, map.top()), QPointF(x, map.bottom()));
+    }
+    for (int latitude = -60; latitude <= 60; latitude += 30) {
+        const double y = this->toWidget(QPointF(0.0, latitude)).y();
+        painter.drawLine(QPointF(map.left(), y), QPointF(map.right(), y));
+    }
+    gridColor.setAlpha(120);
+    painter.setPen(gridColor);
+    painter.drawRect(map);
+
+    if (!this->frontValid_) {
+        painter.setPen(this->palette().color(QPalette::WindowText));
+        painter.drawText(this->rect(),
+                         Qt::AlignCenter,
+                         this->chunks_.isEmpty() ? tr("Нет объектов") : tr("Построение..."));
+        return;
+    }
+
+    //! Отсечение: точки вне виджета и повторные точки одной ячейки не рисуются
+    const double scale = this->scale();
+    const double originX = this->width() / 2.0 - this->center_.x() * scale;
+    const double originY = this->height() / 2.0 + this->center_.y() * scale;
+    const int cellsX = this->width() / markerSize + 1;
+    const int cellsY = this->height() / markerSize + 1;
+    this->occupied_.fill(0, cellsX * cellsY);
+    this->visible_.resize(0);
+    for (const QPointF &point : this->front_) {
+        const double x = originX + point.x() * scale;
+        const double y = originY - point.y() * scale;
+        //! NaN не проходит ни одно сравнение и тоже отбрасывается
+        if (!(x >= 0.0 && x < this->width() && y >= 0.0 && y < this->height()))
+            continue;
+        quint8 &cell = this->occupied_[int(y) / markerSize * cellsX + int(x) / markerSize];
+        if (cell)
+            continue;
+        cell = 1;
+        this->visible_.append(QPointF(x, y));
+    }
+    this->drawnPoints_ = int(this->visible_.size());
+
+    painter.setPen(QPen(this->palette().color(QPalette::Highlight),
+                        markerSize,
+                        Qt::SolidLine,
+                        Qt::SquareCap));
+    painter.drawPoints(this->visible_.constData(), int(this->visible_.size()));
+
+    if (this->selected_ < 0)
+        return;
+
+    //! Трасса выбранного объекта: разрывы на ±180° и там, где прогноза нет
+    painter.setRenderHint(QPainter::Antialiasing);
+    QPainterPath path;
+    bool open = false;
+    QPointF previous;
+    for (const QPointF &point : this->track_) {
+        if (std::isnan(point.x())) {
+            open = false;
+            continue;
+        }
+        if (open && std::abs(point.x() - previous.x()) < 180.0)
+            path.lineTo(this->toWidget(point));
+        else
+            path.moveTo(this->toWidget(point));
+        open = true;
+        previous = point;
+    }
+    const QColor trackColor(230, 60, 40);
+    painter.setPen(QPen(trackColor, 1.5));
+    painter.drawPath(path);
+
+    const QPointF &current = this->front_[this->selected_];
+    if (!std::isnan(current.x())) {
+        painter.setBrush(trackColor);
+        painter.drawEllipse(this->toWidget(current), 4.0, 4.0);
+    }
+}
+
+void MapWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    this->frameTimer_.start();
+}
+
+void MapWidget::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    this->frameTimer_.stop(); //! Скрытая карта не считает кадры
+}
+
+void MapWidget::wheelEvent(QWheelEvent *event)
+{
+    if (event->angleDelta().y() == 0) {
+        event->ignore();
+        return;
+    }
+    //! Масштабирование относительно точки под курсором (один шаг колеса — примерно 1.2 раза)
+    const QPointF anchor = this->toMap(event->position());
+    const double zoom = qBound(1.0,
+                               this->zoom_ * std::pow(1.0015, event->angleDelta().y()),
+                               maxZoom);
+    const double factor = this->zoom_ / zoom;
+    this->center_ = anchor + (this->center_ - anchor) * factor;
+    this->zoom_ = zoom;
+    this->clampCenter();
+    this->update();
+    event->accept();
+}
+
+void MapWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        this->dragging_ = true;
+        this->moved_ = false;
+        this->pressPos_ = event->pos();
+        this->lastMousePos_ = event->pos();
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void MapWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!this->dragging_) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+    if (!this->moved_ && (event->pos() - this->pressPos_).manhattanLength() < 4)
+        return; //! Дрожание руки при щелчке не сдвигает карту
+    if (!this->moved_) {
+        this->moved_ = true;
+        this->setCursor(Qt::ClosedHandCursor);
+    }
+    //! Смещение карты на расстояние, пройденное мышью
+    const QPoint delta = event->pos() - this->lastMousePos_;
+    this->lastMousePos_ = event->pos();
+    const double scale = this->scale();
+    this->center_ -= QPointF(delta.x() / scale, -delta.y() / scale);
+    this->clampCenter();
+    this->update();
+}
+
+void MapWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton && this->dragging_) {
+        this->dragging_ = false;
+        if (this->moved_)
+            this->unsetCursor();
+        else
+            this->selectAt(event->pos());
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void MapWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton)
+        this->resetView();
+    QWidget::mouseDoubleClickEvent(event);
+}
+
+void MapWidget::selectAt(const QPointF &position)
+{
+    int nearest = -1;
+    double best = selectRadius * selectRadius;
+    for (int i = 0; i < this->front_.size(); ++i) {
+        const QPointF delta = this->toWidget(this->front_[i]) - position;
+        const double distance = QPointF::dotProduct(delta, delta);
+        if (distance < best) {
+            best = distance;
+            nearest = i;
+        }
+    }
+    this->selected_ = nearest;
+    this->track_.clear();
+    this->updateTrack();
+    this->update();
+    emit this->objectSelected(nearest >= 0 ? this->propagator_.catalogNumber(nearest) : 0);
+}
@@ -0,0 +1,196 @@
+/*!
+ * \file MapWidget.hpp
+ * \brief Заголовочный файл для класса MapWidget.
+ * \details
+ * Этот файл содержит определение виджета карты, на которой объекты каталога
+ * движутся в реальном или ускоренном времени.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef MAPWIDGET_HPP
+#define MAPWIDGET_HPP
+
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <QWidget>
+
+#include "Utils/MapPropagator.hpp"
+
+/*!
+ * \brief Класс MapWidget
+ * \details
+ * Карта в равнопромежуточной проекции (долгота × широта). Кадр строится так:
+ * - по таймеру подспутниковые точки всего каталога на новый момент считаются
+ *   пачками в пуле потоков во второй буфер, пока на экране остаётся первый;
+ *   если прошлый кадр ещё считается, новый не запускается (кадр пропускается);
+ * - готовый буфер меняется местами с показанным, и виджет перерисовывается;
+ * - при отрисовке точки вне видимой области отбрасываются, а из точек,
+ *   попавших в одну ячейку размером с маркер, рисуется одна (уровень детализации
+ *   при отдалении), после чего все маркеры выводятся одним вызовом drawPoints.
+ *
+ * Колесо мыши масштабирует относительно курсора, перетаскивание перемещает карту,
+ * щелчок выбирает ближайший объект и показывает его трассу на виток назад и вперёд,
+ * двойной щелчок возвращает исходный масштаб.
+ */
+class MapWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief MapWidget - конструктор виджета
+     * \param parent Родительский виджет
+     */
+    explicit MapWidget(QWidget *parent = nullptr);
+
+    /*!
+     * \brief ~MapWidget - деструктор, дожидается расчёта текущего кадра
+     */
+    ~MapWidget();
+
+    /*!
+     * \brief setPropagator - задаёт объекты карты
+     * \param propagator Модели объектов
+     */
+    void setPropagator(const MapPropagator &propagator);
+
+    /*!
+     * \brief setTime - переход к моменту
+     * \param unixSeconds Момент (секунды Unix, UTC)
+     */
+    void setTime(double unixSeconds);
+
+    /*!
+     * \brief setSpeed - ускорение времени
+     * \param factor Во сколько раз время карты идёт быстрее реального
+     */
+    void setSpeed(double factor);
+
+    /*!
+     * \brief setRunning - запуск и остановка времени карты
+     * \param running Идёт ли время
+     */
+    void setRunning(bool running);
+
+    //! Момент показанного кадра (секунды Unix, UTC)
+    double time() const { return this->frontTime_; }
+
+    //! Кадров в секунду за последнюю секунду
+    double framesPerSecond() const { return this->framesPerSecond_; }
+
+    //! Время расчёта последнего кадра (мс)
+    double frameCost() const { return this->frameCost_; }
+
+    //! Маркеров в последнем кадре после отсечения
+    int drawnPoints() const { return this->drawnPoints_; }
+
+    /*!
+     * \brief resetView - возвращает исходный масштаб
+     */
+    void resetView();
+
+signals:
+    /*!
+     * \brief objectSelected - выбран объект
+     * \param catalogNumber Номер объекта (0, если выбор снят)
+     */
+    void objectSelected(int catalogNumber);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private slots:
+    /*!
+     * \brief nextFrame - запуск расчёта следующего кадра
+     */
+    void nextFrame();
+
+    /*!
+     * \brief onFrameReady - кадр рассчитан: смена буферов
+     */
+    void onFrameReady();
+
+private:
+    /*!
+     * \brief Chunk - часть каталога, которую считает один поток
+     */
+    struct Chunk
+    {
+        int first = 0; //! Первый индекс
+        int last = 0;  //! Индекс за последним
+    };
+
+    //! Момент времени карты по часам
+    double clockTime() const;
+
+    //! Запоминает текущий момент как начало отсчёта часов
+    void rebase();
+
+    //! Пикселей на градус
+    double scale() const;
+
+    //! Перевод координат карты (долгота, широта) в координаты виджета
+    QPointF toWidget(const QPointF &point) const;
+
+    //! Перевод точки виджета в координаты карты
+    QPointF toMap(const QPointF &point) const;
+
+    //! Центр карты в допустимых пределах
+    void clampCenter();
+
+    //! Трасса выбранного объекта вокруг момента показанного кадра
+    void updateTrack();
+
+    //! Выбор объекта, ближайшего к точке виджета
+    void selectAt(const QPointF &position);
+
+    MapPropagator propagator_; //! Модели объектов
+    QVector<Chunk> chunks_;    //! Разбиение каталога между потоками
+
+    QVector<QPointF> front_;       //! Показанные точки
+    QVector<QPointF> back_;        //! Точки, которые считаются
+    double frontTime_ = 0.0;       //! Момент показанных точек
+    double backTime_ = 0.0;        //! Момент, который считается
+    bool frontValid_ = false;      //! Показанные точки рассчитаны
+    QFutureWatcher<void> watcher_; //! Расчёт кадра
+    QTimer frameTimer_;            //! Таймер кадров
+    QElapsedTimer frameClock_;     //! Время расчёта кадра
+
+    QElapsedTimer clock_;   //! Часы реального времени
+    double baseTime_ = 0.0; //! Момент карты в начале отсчёта
+    qint64 baseClock_ = 0;  //! Показание часов в начале отсчёта (мс)
+    double speed_ = 1.0;    //! Ускорение времени
+    bool running_ = true;   //! Идёт ли время
+
+    int frames_ = 0;               //! Кадров с начала секунды
+    QElapsedTimer fpsClock_;       //! Отсчёт секунды для подсчёта кадров
+    double framesPerSecond_ = 0.0; //! Кадров в секунду
+    double frameCost_ = 0.0;       //! Время расчёта последнего кадра (мс)
+    int drawnPoints_ = 0;          //! Маркеров в последнем кадре
+
+    int selected_ = -1;      //! Индекс выбранного объекта
+    QVector<QPointF> track_; //! Трасса выбранного объекта
+    double trackTime_ = 0.0; //! Момент, вокруг которого построена трасса
+
+    QPointF center_ = QPointF(0.0, 0.0); //! Центр видимой области (долгота, широта)
+    double zoom_ = 1.0;                  //! Увеличение относительно всей карты
+
+    QVector<QPointF> visible_; //! Маркеры кадра после отсечения (буфер отрисовки)
+    QVector<quint8> occupied_; //! Занятые ячейки кадра
+
+    bool dragging_ = false; //! Идёт перетаскивание
+    bool moved_ = false;    //! Мышь сдвинулась после нажатия
+    QPoint pressPos_;       //! Позиция нажатия
+    QPoint lastMousePos_;   //! Последняя позиция мыши при перетаскивании
+};
+
+#endif // MAPWIDGET_HPP
@@ -0,0 +1,90 @@
+/*!
+ * \file MapWindow.cpp
+ * \brief Исходный файл для окна карты объектов
+ * \details
+ * Этот файл содержит реализацию класса MapWindow.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "MapWindow.hpp"
+#include "./ui_MapWindow.h"
+
+#include <QDateTime>
+
+#include <iterator>
+
+#include "Utils/MapPropagator.hpp"
+
+namespace {
+
+constexpr int statusInterval = 250;                           //! Период обновления строки состояния (мс)
+constexpr double speeds[] = {1.0, 10.0, 60.0, 600.0, 3600.0}; //! Ускорения пунктов списка
+
+} // namespace
+
+void MapWindow::updateStatus()
+{
+    const double time = this->ui_->mapWidget->time();
+    this->ui_->timeLabel->setText(QDateTime::fromMSecsSinceEpoch(qint64(time * 1000.0))
+                                      .toUTC()
+                                      .toString(QStringLiteral("yyyy-MM-dd HH:mm:ss 'UTC'")));
+    this->statusBar()->showMessage(
+        tr("Объектов: %1 (без прогноза SGP4: %2), на экране: %3, кадров в секунду: %4, "
+           "расчёт кадра: %5 мс")
+            .arg(this->objects_)
+            .arg(this->unsupported_)
+            .arg(this->ui_->mapWidget->drawnPoints())
+            .arg(this->ui_->mapWidget->framesPerSecond(), 0, 'f', 0)
+            .arg(this->ui_->mapWidget->frameCost(), 0, 'f', 1));
+}
+
+void MapWindow::showSelection(int catalogNumber)
+{
+    if (catalogNumber == 0) {
+        this->ui_->selectionLabel->clear();
+        return;
+    }
+    this->ui_->selectionLabel->setText(
+        tr("Объект %1 %2").arg(catalogNumber).arg(this->names_.value(catalogNumber)));
+}
+
+MapWindow::MapWindow(const QVector<TleRecord> &records, QWidget *parent)
+    : QMainWindow(parent)
+    , ui_(new Ui::MapWindow)
+{
+    this->ui_->setupUi(this); //! Инициализация пользовательского интерфейса
+
+    for (const TleRecord &record : records)
+        this->names_.insert(record.catalogNumber, record.name.trimmed().toString());
+
+    const MapPropagator propagator(records);
+    this->objects_ = propagator.size();
+    this->unsupported_ = propagator.unsupported();
+    this->ui_->mapWidget->setPropagator(propagator);
+
+    this->connect(this->ui_->runButton, &QPushButton::toggled, this, [this](bool checked) {
+        this->ui_->mapWidget->setRunning(checked);
+        this->ui_->runButton->setText(checked ? tr("Пауза") : tr("Пуск"));
+    });
+    this->connect(this->ui_->speedComboBox,
+                  QOverload<int>::of(&QComboBox::currentIndexChanged),
+                  this,
+                  [this](int index) {
+                      if (index >= 0 && index < int(std::size(speeds)))
+                          this->ui_->mapWidget->setSpeed(speeds[index]);
+                  });
+    this->connect(this->ui_->nowButton, &QPushButton::clicked, this, [this]() {
+        this->ui_->mapWidget->setTime(double(QDateTime::currentMSecsSinceEpoch()) / 1000.0);
+    });
+    this->connect(this->ui_->mapWidget, &MapWidget::objectSelected, this, &MapWindow::showSelection);
+
+    this->statusTimer_.setInterval(statusInterval);
+    this->connect(&this->statusTimer_, &QTimer::timeout, this, &MapWindow::updateStatus);
+    this->statusTimer_.start();
+}
+
+MapWindow::~MapWindow()
+{
+    delete this->ui_; //! Освобождение ресурсов пользовательского интерфейса
+}
@@ -0,0 +1,67 @@
+/*!
+ * \file MapWindow.hpp
+ * \brief Заголовочный файл для класса MapWindow.
+ * \details
+ * Этот файл содержит определение класса MapWindow — окна карты, на которой
+ * объекты загруженного каталога движутся в реальном или ускоренном времени.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef MAPWINDOW_HPP
+#define MAPWINDOW_HPP
+
+#include <QHash>
+#include <QMainWindow>
+#include <QTimer>
+
+#include "Utils/TleRecord.hpp"
+
+namespace Ui {
+class MapWindow;
+}
+
+/*!
+ * \brief Класс MapWindow
+ * \details
+ * Управляет временем карты MapWidget (пуск и пауза, ускорение, переход к текущему
+ * моменту) и показывает момент кадра, выбранный объект и частоту кадров.
+ */
+class MapWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief MapWindow - конструктор класса MapWindow.
+     * \param records Записи каталога.
+     * \param parent Указатель на родительский виджет (по умолчанию nullptr).
+     */
+    explicit MapWindow(const QVector<TleRecord> &records, QWidget *parent = nullptr);
+
+    /*!
+     * \brief ~MapWindow - деструктор класса MapWindow.
+     */
+    ~MapWindow();
+
+private slots:
+    /*!
+     * \brief updateStatus - обновление момента кадра и строки состояния
+     */
+    void updateStatus();
+
+    /*!
+     * \brief showSelection - показ выбранного объекта
+     * \param catalogNumber Номер объекта (0, если выбор снят)
+     */
+    void showSelection(int catalogNumber);
+
+private:
+    Ui::MapWindow *ui_;         //! Пользовательский интерфейс окна
+    QHash<int, QString> names_; //! Названия объектов по номеру
+    int objects_ = 0;           //! Объектов на карте
+    int unsupported_ = 0;       //! Объектов без прогноза SGP4
+    QTimer statusTimer_;        //! Таймер обновления строки состояния
+};
+
+#endif // MAPWINDOW_HPP
@@ -0,0 +1,175 @@
+/*!
+ * \file PassWindow.cpp
+ * \brief Исходный файл для окна прогноза пролётов
+ * \details
+ * Этот файл содержит реализацию класса PassWindow.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "PassWindow.hpp"
+#include "./ui_PassWindow.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileDialog>
+#include <QGuiApplication>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QSaveFile>
+#include <QTextStream>
+
+namespace {
+
+//! Момент в секундах Unix в виде текста UTC
+QString timeText(double seconds)
+{
+    return QDateTime::fromMSecsSinceEpoch(qint64(seconds * 1000.0))
+        .toUTC()
+        .toString(QStringLiteral("yyyy-MM-dd HH:mm:ss"));
+}
+
+//! Ячейка с числом: сортировка по столбцу будет числовой
+QStandardItem *numberItem(double value, int decimals)
+{
+    QStandardItem *item = new QStandardItem;
+    item->setData(QString::number(value, 'f', decimals).toDouble(), Qt::DisplayRole);
+    return item;
+}
+
+} // namespace
+
+void PassWindow::predict()
+{
+    PassSettings settings; //! Параметры из элементов управления
+    settings.station.latitude = this->ui_->latitudeSpinBox->value();
+    settings.station.longitude = this->ui_->longitudeSpinBox->value();
+    settings.station.altitude = this->ui_->altitudeSpinBox->value() / 1000.0;
+    settings.station.minElevation = this->ui_->elevationSpinBox->value();
+    settings.start = double(this->ui_->startDateTimeEdit->dateTime().toMSecsSinceEpoch()) / 1000.0;
+    settings.end = settings.start + this->ui_->daysSpinBox->value() * 86400.0;
+
+    QGuiApplication::setOverrideCursor(Qt::WaitCursor);
+    QElapsedTimer timer;
+    timer.start();
+    PassStatistics statistics;
+    const QVector<SatellitePass> passes = PassPredictor::predict(this->records_,
+                                                                 settings,
+                                                                 &statistics);
+    const qint64 elapsed = timer.elapsed();
+    QGuiApplication::restoreOverrideCursor();
+
+    this->model_->clear();
+    this->model_->setHorizontalHeaderLabels({tr("Номер"),
+                                             tr("Название"),
+                                             tr("AOS (UTC)"),
+                                             tr("TCA (UTC)"),
+                                             tr("LOS (UTC)"),
+                                             tr("Длительность, мин"),
+                                             tr("Наиб. возвышение, °"),
+                                             tr("Азимут AOS, °"),
+                                             tr("Азимут LOS, °")});
+    //! Сортировка отключается на время заполнения, иначе строки переставляются после каждой ячейки
+    this->ui_->passTableView->setSortingEnabled(false);
+    this->model_->setRowCount(int(passes.size()));
+    for (int row = 0; row < passes.size(); ++row) {
+        const SatellitePass &pass = passes[row];
+        QStandardItem *number = new QStandardItem;
+        number->setData(pass.catalogNumber, Qt::DisplayRole);
+        this->model_->setItem(row, 0, number);
+        this->model_->setItem(row, 1, new QStandardItem(this->names_.value(pass.catalogNumber)));
+        //! Пролёт, обрезанный границей интервала, отмечается звёздочкой у времени
+        const QString mark = pass.clipped ? QStringLiteral("*") : QString();
+        this->model_->setItem(row, 2, new QStandardItem(timeText(pass.aos) + mark));
+        this->model_->setItem(row, 3, new QStandardItem(timeText(pass.tca)));
+        this->model_->setItem(row, 4, new QStandardItem(timeText(pass.los) + mark));
+        this->model_->setItem(row, 5, numberItem((pass.los - pass.aos) / 60.0, 1));
+        this->model_->setItem(row, 6, numberItem(pass.maxElevation, 1));
+        this->model_->setItem(row, 7, numberItem(pass.aosAzimuth, 0));
+        this->model_->setItem(row, 8, numberItem(pass.losAzimuth, 0));
+    }
+    this->ui_->passTableView->setSortingEnabled(true);
+
+    this->statusBar()->showMessage(
+        tr("Пролётов: %1, объектов: %2 (без прогноза SGP4: %3, не видны со станции: %4), "
+           "прогнозов SGP4: %5, время: %6 мс")
+            .arg(passes.size())
+            .arg(statistics.objects)
+            .arg(statistics.unsupported)
+            .arg(statistics.filtered)
+            .arg(statistics.propagations)
+            .arg(elapsed));
+}
+
+void PassWindow::exportCsv()
+{
+    //! Открываем диалоговое окно для сохранения файла
+    const QString filePath = QFileDialog::getSaveFileName(this,
+                                                          tr("Экспорт пролётов"),
+                                                          "passes.csv",
+                                                          tr("Файл CSV (*.csv)"));
+    if (filePath.isEmpty())
+        return;
+
+    QSaveFile file(filePath); //! Запись во временный файл с атомарной заменой
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::critical(this,
+                              tr("Ошибка"),
+                              tr("Не удалось открыть файл для записи: %1").arg(filePath));
+        return;
+    }
+
+    QTextStream out(&file);
+    for (int column = 0; column < this->model_->columnCount(); ++column)
+        out << (column ? "," : "")
+            << this->model_->headerData(column, Qt::Horizontal).toString();
+    out << '\n';
+    //! Строки в порядке сортировки таблицы; имя объекта берётся в кавычки
+    for (int row = 0; row < this->model_->rowCount(); ++row) {
+        for (int column = 0; column < this->model_->columnCount(); ++column) {
+            QString text = this->model_->item(row, column)->text();
+            if (column == 1)
+                text = QLatin1Char('"') + text.replace(QLatin1Char('"'), QLatin1String("\"\""))
+                       + QLatin1Char('"');
+            out << (column ? "," : "") << text;
+        }
+        out << '\n';
+    }
+    out.flush();
+
+    if (!file.commit()) {
+        QMessageBox::critical(this, tr("Ошибка"), tr("Не удалось сохранить файл: %1").arg(filePath));
+        return;
+    }
+    this->statusBar()->showMessage(tr("Сохранено в файл: %1").arg(filePath), 2500);
+}
+
+PassWindow::PassWindow(const QVector<TleRecord> &records, QWidget *parent)
+    : QMainWindow(parent)
+    , ui_(new Ui::PassWindow)
+    , records_(records)
+    , model_(new QStandardItemModel(this))
+{
+    this->ui_->setupUi(this); //! Инициализация пользовательского интерфейса
+
+    for (const TleRecord &record : this->records_)
+        this->names_.insert(record.catalogNumber, record.name.trimmed().toString());
+
+    //! По умолчанию прогноз начинается с текущей минуты
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    now.setTime(QTime(now.time().hour(), now.time().minute()));
+    this->ui_->startDateTimeEdit->setDateTime(now);
+
+    this->ui_->passTableView->setModel(this->model_);
+    this->ui_->passTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    //! Одинаковая высота строк: таблица не измеряет каждую строку при прокрутке
+    this->ui_->passTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
+    this->connect(this->ui_->predictButton, &QPushButton::clicked, this, &PassWindow::predict);
+    this->connect(this->ui_->exportButton, &QPushButton::clicked, this, &PassWindow::exportCsv);
+}
+
+PassWindow::~PassWindow()
+{
+    delete this->ui_; //! Освобождение ресурсов пользовательского интерфейса
+}
@@ -0,0 +1,66 @@
+/*!
+ * \file PassWindow.hpp
+ * \brief Заголовочный файл для класса PassWindow.
+ * \details
+ * Этот файл содержит определение класса PassWindow — окна прогноза пролётов
+ * объектов загруженного каталога над наземной станцией.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef PASSWINDOW_HPP
+#define PASSWINDOW_HPP
+
+#include <QHash>
+#include <QMainWindow>
+#include <QStandardItemModel>
+
+#include "Utils/PassPredictor.hpp"
+
+namespace Ui {
+class PassWindow;
+}
+
+/*!
+ * \brief Класс PassWindow
+ * \details
+ * Показывает пролёты, найденные PassPredictor для станции и интервала времени,
+ * выбранных пользователем, в таблице с сортировкой по любому столбцу
+ * и позволяет выгрузить список в CSV.
+ */
+class PassWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief PassWindow - конструктор класса PassWindow.
+     * \param records Записи каталога (копия разделяет данные с исходной).
+     * \param parent Указатель на родительский виджет (по умолчанию nullptr).
+     */
+    explicit PassWindow(const QVector<TleRecord> &records, QWidget *parent = nullptr);
+
+    /*!
+     * \brief ~PassWindow - деструктор класса PassWindow.
+     */
+    ~PassWindow();
+
+public slots:
+    /*!
+     * \brief predict - слот для прогноза пролётов с выбранными параметрами.
+     */
+    void predict();
+
+    /*!
+     * \brief exportCsv - слот для выгрузки пролётов в CSV.
+     */
+    void exportCsv();
+
+private:
+    Ui::PassWindow *ui_;         //! Пользовательский интерфейс окна
+    QVector<TleRecord> records_; //! Записи каталога
+    QHash<int, QString> names_;  //! Названия объектов по номеру
+    QStandardItemModel *model_;  //! Модель таблицы пролётов
+};
+
+#endif // PASSWINDOW_HPP
@@ -0,0 +1,472 @@
+/*!
+ * \file AlertEngine.cpp
+ * \brief Правила оповещений о каталоге
+ * \details
+ * Этот файл содержит реализацию класса AlertEngine.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "AlertEngine.hpp"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "OrbitalMetrics.hpp"
+#include "TleUtils.hpp"
+
+namespace {
+
+//! Микросекунд в сутках
+constexpr double microsPerDay = 86400e6;
+//! Корзин наклонения: по градусу от 0 до 180 включительно
+constexpr int bandBucketCount = 181;
+
+//! Корзина наклонения (градусы)
+int bandBucket(double inclination)
+{
+    return qBound(0, int(std::floor(inclination)), bandBucketCount - 1);
+}
+
+//! Высота перигея (км), как в производных столбцах статистики
+double perigeeAltitude(const TleRecord &record)
+{
+    double semiMajorAxis = 0.0, apogee = 0.0, perigee = 0.0, period = 0.0;
+    OrbitalMetrics::computeKernel(&record.meanMotion,
+                                  &record.eccentricity,
+                                  1,
+                                  &semiMajorAxis,
+                                  &apogee,
+                                  &perigee,
+                                  &period);
+    return perigee;
+}
+
+//! Порог возраста эпохи правила (мкс)
+qint64 staleThreshold(const AlertRule &rule)
+{
+    return qint64(rule.days * microsPerDay);
+}
+
+//! Попадает ли объект в полосу правила
+bool inBand(const AlertRule &rule, double inclination, double perigee)
+{
+    return inclination >= rule.inclinationMin && inclination <= rule.inclinationMax
+           && perigee >= rule.altitudeMin && perigee <= rule.altitudeMax;
+}
+
+//! Вырос ли B* настолько, что правило срабатывает
+bool bstarRose(const AlertRule &rule, double before, double after)
+{
+    return after - before >= rule.bstarMinimum && after >= rule.bstarRatio * std::fabs(before);
+}
+
+//! Отношение нового B* к прежнему (бесконечность, если прежний равен нулю)
+double bstarGrowth(double before, double after)
+{
+    return before != 0.0 ? after / std::fabs(before) : std::numeric_limits<double>::infinity();
+}
+
+} // namespace
+
+AlertEngine::AlertEngine()
+{
+    this->rebuildIndexes(); //! Пустые корзины полос
+}
+
+TleFields AlertEngine::requiredFields()
+{
+    return TleField::CatalogNumber | TleField::Epoch | TleField::Drag | TleField::Inclination
+           | TleField::Eccentricity | TleField::MeanMotion;
+}
+
+bool AlertEngine::parseRule(const QString &text, AlertRule &rule)
+{
+    const QStringList parts = text.simplified().split(QLatin1Char(' '));
+    const QString keyword = parts.first().toLower();
+    int parameters = 0;
+    if (keyword == QLatin1String("stale")) {
+        rule.type = AlertRuleType::StaleEpoch;
+        parameters = 1;
+    } else if (keyword == QLatin1String("band")) {
+        rule.type = AlertRuleType::NewInBand;
+        parameters = 4;
+    } else if (keyword == QLatin1String("gone")) {
+        rule.type = AlertRuleType::Disappeared;
+    } else if (keyword == QLatin1String("bstar")) {
+        rule.type = AlertRuleType::BstarRise;
+        parameters = 1;
+    } else
+        return false;
+    if (parts.size() <= parameters)
+        return false;
+
+    double values[4] = {};
+    for (int i = 0; i < parameters; ++i) {
+        bool ok = false;
+        values[i] = parts[i + 1].toDouble(&ok);
+        if (!ok || !std::isfinite(values[i]))
+            return false;
+    }
+    switch (rule.type) {
+    case AlertRuleType::StaleEpoch:
+        rule.days = values[0];
+        if (!(rule.days > 0.0))
+            return false;
+        break;
+    case AlertRuleType::NewInBand:
+        rule.inclinationMin = values[0];
+        rule.inclinationMax = values[1];
+        rule.altitudeMin = values[2];
+        rule.altitudeMax = values[3];
+        if (rule.inclinationMin > rule.inclinationMax || rule.altitudeMin > rule.altitudeMax)
+            return false;
+        break;
+    case AlertRuleType::BstarRise:
+        rule.bstarRatio = values[0];
+        if (!(rule.bstarRatio > 1.0))
+            return false;
+        break;
+    case AlertRuleType::Disappeared:
+        break;
+    }
+
+    rule.catalogNumbers.clear();
+    for (int i = parameters + 1; i < parts.size(); ++i) {
+        bool ok = false;
+        const int number = parts[i].toInt(&ok);
+        if (!ok || number <= 0)
+            return false;
+        rule.catalogNumbers.append(number);
+    }
+    return true;
+}
+
+QString AlertEngine::ruleText(const AlertRule &rule)
+{
+    QStringList parts;
+    switch (rule.type) {
+    case AlertRuleType::StaleEpoch:
+        parts << QStringLiteral("stale") << QString::number(rule.days);
+        break;
+    case AlertRuleType::NewInBand:
+        parts << QStringLiteral("band") << QString::number(rule.inclinationMin)
+              << QString::number(rule.inclinationMax) << QString::number(rule.altitudeMin)
+              << QString::number(rule.altitudeMax);
+        break;
+    case AlertRuleType::Disappeared:
+        parts << QStringLiteral("gone");
+        break;
+    case AlertRuleType::BstarRise:
+        parts << QStringLiteral("bstar") << QString::number(rule.bstarRatio);
+        break;
+    }
+    for (int number : rule.catalogNumbers)
+        parts << QString::number(number);
+    return parts.join(QLatin1Char(' '));
+}
+
+int AlertEngine::addRule(const AlertRule &rule)
+{
+    this->rules_.append(rule);
+    this->rebuildIndexes();
+    return int(this->rules_.size()) - 1;
+}
+
+void AlertEngine::setRules(const QVector<AlertRule> &rules)
+{
+    this->rules_ = rules;
+    this->rebuildIndexes();
+}
+
+const QVector<AlertRule> &AlertEngine::rules() const
+{
+    return this->rules_;
+}
+
+void AlertEngine::rebuildIndexes()
+{
+    this->staleRules_.clear();
+    this->bandBuckets_ = QVector<QVector<int>>(bandBucketCount);
+    this->goneRules_.clear();
+    this->bstarRules_.clear();
+    this->numberRules_.clear();
+
+    for (int i = 0; i < this->rules_.size(); ++i) {
+        const AlertRule &rule = this->rules_[i];
+        //! Правило с перечнем проверяется только для своих объектов
+        if (!rule.catalogNumbers.isEmpty()) {
+            for (int number : rule.catalogNumbers)
+                this->numberRules_[number].append(i);
+            continue;
+        }
+        switch (rule.type) {
+        case AlertRuleType::StaleEpoch:
+            this->staleRules_.append({staleThreshold(rule), i});
+            break;
+        case AlertRuleType::NewInBand:
+            if (rule.inclinationMax < 0.0 || rule.inclinationMin > 180.0)
+                break; //! Полоса вне возможных наклонений
+            for (int bucket = bandBucket(rule.inclinationMin);
+                 bucket <= bandBucket(rule.inclinationMax);
+                 ++bucket)
+                this->bandBuckets_[bucket].append(i);
+            break;
+        case AlertRuleType::Disappeared:
+            this->goneRules_.append(i);
+            break;
+        case AlertRuleType::BstarRise:
+            this->bstarRules_.append({rule.bstarRatio, i});
+            break;
+        }
+    }
+    std::sort(this->staleRules_.begin(), this->staleRules_.end());
+    std::sort(this->bstarRules_.begin(), this->bstarRules_.end());
+}
+
+void AlertEngine::reset(const QVector<TleRecord> &records, qint64 now)
+{
+    this->entries_.clear();
+    this->epochIndex_.clear();
+    ++this->generation_;
+    QVector<int> removed;
+    this->apply(this->collect(records, false, removed), removed);
+    this->time_ = now;
+}
+
+QVector<Alert> AlertEngine::replace(const QVector<TleRecord> &records, qint64 now)
+{
+    return this->process(records, true, now);
+}
+
+QVector<Alert> AlertEngine::append(const QVector<TleRecord> &records, qint64 now)
+{
+    return this->process(records, false, now);
+}
+
+int AlertEngine::size() const
+{
+    return int(this->entries_.size());
+}
+
+QVector<AlertEngine::Change> AlertEngine::collect(const QVector<TleRecord> &records,
+                                                   bool replacing,
+                                                   QVector<int> &removed)
+{
+    QHash<int, int> added; //! Новые объекты: номер → индекс записи с самой поздней эпохой
+    QVector<int> seen;     //! Известные объекты, встретившиеся в загрузке
+    for (int i = 0; i < records.size(); ++i) {
+        const TleRecord &record = records[i];
+        const qint64 epoch = TleUtils::epochToUnixMicros(record);
+        const auto entry = this->entries_.find(record.catalogNumber);
+        if (entry == this->entries_.end()) {
+            const auto it = added.find(record.catalogNumber);
+            if (it == added.end())
+                added.insert(record.catalogNumber, i);
+            else if (epoch > TleUtils::epochToUnixMicros(records[it.value()]))
+                it.value() = i;
+            continue;
+        }
+        //! В загрузке может быть несколько наборов объекта — запоминается самый поздний
+        if (entry->seen != this->generation_) {
+            entry->seen = this->generation_;
+            entry->loaded = epoch;
+            entry->record = i;
+            seen.append(record.catalogNumber);
+        } else if (epoch > entry->loaded) {
+            entry->loaded = epoch;
+            entry->record = i;
+        }
+    }
+
+    QVector<Change> changes;
+    for (int number : std::as_const(seen)) {
+        Entry &entry = this->entries_[number];
+        //! При замене каталога изменением считается любая другая эпоха,
+        //! при дополнении — только более поздняя
+        if (replacing ? entry.loaded == entry.epoch : entry.loaded <= entry.epoch)
+            continue;
+        entry.touched = this->generation_;
+        const TleRecord &record = records[entry.record];
+        changes.append(
+            {&record, entry.loaded, TleUtils::bstar(record), false, entry.epoch, entry.bstar});
+    }
+    for (auto it = added.cbegin(); it != added.cend(); ++it) {
+        const TleRecord &record = records[it.value()];
+        changes.append(
+            {&record, TleUtils::epochToUnixMicros(record), TleUtils::bstar(record), true, 0, 0.0});
+    }
+
+    if (replacing)
+        for (auto it = this->entries_.cbegin(); it != this->entries_.cend(); ++it)
+            if (it->seen != this->generation_)
+                removed.append(it.key());
+    return changes;
+}
+
+void AlertEngine::apply(const QVector<Change> &changes, const QVector<int> &removed)
+{
+    for (const Change &change : changes) {
+        const int number = change.record->catalogNumber;
+        Entry &entry = this->entries_[number];
+        if (!change.added)
+            this->epochIndex_.erase({change.oldEpoch, number});
+        entry.epoch = change.epoch;
+        entry.bstar = change.bstar;
+        entry.seen = this->generation_;
+        this->epochIndex_.insert({change.epoch, number});
+    }
+    for (int number : removed) {
+        this->epochIndex_.erase({this->entries_.value(number).epoch, number});
+        this->entries_.remove(number);
+    }
+}
+
+QVector<Alert> AlertEngine::process(const QVector<TleRecord> &records, bool replacing, qint64 now)
+{
+    ++this->generation_;
+    QVector<int> removed;
+    const QVector<Change> changes = this->collect(records, replacing, removed);
+    const qint64 before = this->time_;
+    //! Часы, переведённые назад, не возвращают объекты в прошлое
+    const qint64 after = qMax(now, before);
+
+    QVector<Alert> alerts;
+    //! Объект без изменений и не исчезнувший, который проверяется по ходу времени
+    auto unchanged = [this, replacing](const Entry &entry) {
+        return entry.touched != this->generation_
+               && (!replacing || entry.seen == this->generation_);
+    };
+
+    //! Объекты, устаревшие только из-за хода времени: эпоха в [before − T, after − T)
+    if (after > before) {
+        for (const auto &rule : std::as_const(this->staleRules_)) {
+            const qint64 threshold = rule.first;
+            const auto first = this->epochIndex_.lower_bound({before - threshold,
+                                                              std::numeric_limits<int>::min()});
+            const auto last = this->epochIndex_.lower_bound({after - threshold,
+                                                             std::numeric_limits<int>::min()});
+            for (auto it = first; it != last; ++it)
+                if (unchanged(*this->entries_.constFind(it->second)))
+                    alerts.append(
+                        {rule.second, it->second, it->first, (after - it->first) / microsPerDay});
+        }
+        for (auto it = this->numberRules_.cbegin(); it != this->numberRules_.cend(); ++it) {
+            const auto entry = this->entries_.constFind(it.key());
+            if (entry == this->entries_.cend() || !unchanged(*entry))
+                continue;
+            for (int index : it.value()) {
+                const AlertRule &rule = this->rules_[index];
+                if (rule.type != AlertRuleType::StaleEpoch)
+                    continue;
+                const qint64 threshold = staleThreshold(rule);
+                if (entry->epoch >= before - threshold && entry->epoch < after - threshold)
+                    alerts.append(
+                        {index, it.key(), entry->epoch, (after - entry->epoch) / microsPerDay});
+            }
+        }
+    }
+
+    for (const Change &change : changes)
+        this->matchChange(change, before, after, alerts);
+
+    for (int number : std::as_const(removed)) {
+        const qint64 epoch = this->entries_.value(number).epoch;
+        for (int index : std::as_const(this->goneRules_))
+            alerts.append({index, number, epoch, 0.0});
+        for (int index : this->numberRules_.value(number))
+            if (this->rules_[index].type == AlertRuleType::Disappeared)
+                alerts.append({index, number, epoch, 0.0});
+    }
+
+    this->apply(changes, removed);
+    this->time_ = after;
+
+    std::sort(alerts.begin(), alerts.end(), [](const Alert &a, const Alert &b) {
+        return a.catalogNumber != b.catalogNumber ? a.catalogNumber < b.catalogNumber
+                                                  : a.rule < b.rule;
+    });
+    return alerts;
+}
+
+void AlertEngine::matchChange(const Change &change,
+                              qint64 before,
+                              qint64 after,
+                              QVector<Alert> &alerts) const
+{
+    const int number = change.record->catalogNumber;
+
+    //! Возраст эпохи: сработавшие правила — пороги в [прежний возраст, новый возраст)
+    const qint64 age = after - change.epoch;
+    const qint64 oldAge = change.added ? std::numeric_limits<qint64>::min()
+                                       : before - change.oldEpoch;
+    if (oldAge < age) {
+        const auto first = std::lower_bound(this->staleRules_.cbegin(),
+                                            this->staleRules_.cend(),
+                                            std::make_pair(oldAge,
+                                                           std::numeric_limits<int>::min()));
+        const auto last = std::lower_bound(first,
+                                           this->staleRules_.cend(),
+                                           std::make_pair(age, std::numeric_limits<int>::min()));
+        for (auto it = first; it != last; ++it)
+            alerts.append({it->second, number, change.epoch, age / microsPerDay});
+    }
+
+    if (change.added) {
+        //! Полосы: только правила корзины наклонения объекта
+        const QVector<int> &bucket = this->bandBuckets_[bandBucket(change.record->inclination)];
+        if (!bucket.isEmpty()) {
+            const double perigee = perigeeAltitude(*change.record);
+            for (int index : bucket)
+                if (inBand(this->rules_[index], change.record->inclination, perigee))
+                    alerts.append({index, number, change.epoch, perigee});
+        }
+    } else if (change.epoch > change.oldEpoch && change.bstar > change.oldBstar) {
+        //! B*: правила с порогом отношения не выше наблюдаемого
+        const double growth = bstarGrowth(change.oldBstar, change.bstar);
+        const auto last = std::upper_bound(this->bstarRules_.cbegin(),
+                                           this->bstarRules_.cend(),
+                                           std::make_pair(growth, std::numeric_limits<int>::max()));
+        for (auto it = this->bstarRules_.cbegin(); it != last; ++it)
+            if (bstarRose(this->rules_[it->second], change.oldBstar, change.bstar))
+                alerts.append({it->second, number, change.epoch, growth});
+    }
+
+    for (int index : this->numberRules_.value(number))
+        this->matchRule(index, change, before, after, alerts);
+}
+
+void AlertEngine::matchRule(
+    int index, const Change &change, qint64 before, qint64 after, QVector<Alert> &alerts) const
+{
+    const AlertRule &rule = this->rules_[index];
+    const int number = change.record->catalogNumber;
+    switch (rule.type) {
+    case AlertRuleType::StaleEpoch: {
+        const qint64 threshold = staleThreshold(rule);
+        const bool wasStale = !change.added && change.oldEpoch < before - threshold;
+        if (!wasStale && change.epoch < after - threshold)
+            alerts.append({index, number, change.epoch, (after - change.epoch) / microsPerDay});
+        break;
+    }
+    case AlertRuleType::NewInBand:
+        if (change.added) {
+            const double perigee = perigeeAltitude(*change.record);
+            if (inBand(rule, change.record->inclination, perigee))
+                alerts.append({index, number, change.epoch, perigee});
+        }
+        break;
+    case AlertRuleType::BstarRise:
+        if (!change.added && change.epoch > change.oldEpoch
+            && bstarRose(rule, change.oldBstar, change.bstar))
+            alerts.append(
+                {index, number, change.epoch, bstarGrowth(change.oldBstar, change.bstar)});
+        break;
+    case AlertRuleType::Disappeared:
+        break; //! Проверяется по исчезнувшим объектам
+    }
+}
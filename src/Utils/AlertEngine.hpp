@@ -0,0 +1,252 @@
+/*!
+ * \file AlertEngine.hpp
+ * \brief Заголовочный файл для правил оповещений о каталоге
+ * \details
+ * Этот файл содержит определение класса AlertEngine и структур правил и оповещений:
+ * устаревшая эпоха, новый объект в полосе наклонения и высоты, исчезновение объекта
+ * и резкий рост B*.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef ALERTENGINE_HPP
+#define ALERTENGINE_HPP
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <set>
+#include <utility>
+
+#include "TleRecord.hpp"
+
+/*!
+ * \brief AlertRuleType - тип правила
+ */
+enum class AlertRuleType : quint8 {
+    StaleEpoch,  //! Эпоха объекта старше заданного числа суток
+    NewInBand,   //! Новый объект в полосе наклонения и высоты перигея
+    Disappeared, //! Объект исчез из каталога
+    BstarRise    //! B* нового набора элементов резко вырос
+};
+
+/*!
+ * \brief AlertRule - правило оповещения
+ * \details
+ * Правило проверяется для объектов из catalogNumbers, а если список пуст — для всех
+ * объектов каталога. Для каждого типа используются только его параметры.
+ */
+struct AlertRule
+{
+    AlertRuleType type = AlertRuleType::StaleEpoch; //! Тип правила
+    QVector<int> catalogNumbers;                    //! Отслеживаемые объекты (пусто — все)
+    double days = 7.0;                              //! StaleEpoch: возраст эпохи (сутки)
+    double inclinationMin = 0.0;                    //! NewInBand: наименьшее наклонение (градусы)
+    double inclinationMax = 180.0;                  //! NewInBand: наибольшее наклонение (градусы)
+    double altitudeMin = 0.0;                       //! NewInBand: наименьшая высота перигея (км)
+    double altitudeMax = 1e6;                       //! NewInBand: наибольшая высота перигея (км)
+    double bstarRatio = 5.0;                        //! BstarRise: во сколько раз вырос B*
+    double bstarMinimum = 1e-5;                     //! BstarRise: наименьший прирост B*
+};
+
+/*!
+ * \brief Alert - сработавшее правило
+ */
+struct Alert
+{
+    int rule;          //! Индекс правила в AlertEngine::rules()
+    int catalogNumber; //! Номер объекта
+    qint64 epoch;      //! Эпоха набора элементов (мкс Unix), для исчезнувших — последняя известная
+    double value;      //! Возраст эпохи (сутки), высота перигея (км), отношение B* или 0
+};
+
+/*!
+ * \brief Класс AlertEngine
+ * \details
+ * Правила регистрируются один раз, а каталог передаётся при каждой загрузке.
+ * Движок хранит по объекту только последнюю эпоху и B*, сравнивает с ними новый
+ * каталог и проверяет правила лишь по набору изменений: новые, исчезнувшие
+ * и получившие новый набор элементов объекты. Оповещение выдаётся при переходе
+ * в состояние правила, а не на каждой загрузке: первый каталог (reset())
+ * задаёт исходное состояние без оповещений.
+ *
+ * Для правил строятся индексы по полям, которые они проверяют:
+ * - возраст эпохи — пороги правил упорядочены, поэтому для объекта сработавшие
+ *   правила образуют отрезок, найденный двоичным поиском; объекты, устаревшие
+ *   только из-за хода времени, находятся диапазоном упорядоченного индекса эпох;
+ * - полосы — корзины по градусу наклонения со списками пересекающихся правил;
+ * - отношение B* — правила упорядочены по порогу, подходящие образуют префикс;
+ * - правила с перечнем объектов — хеш-таблица по номеру объекта.
+ *
+ * Поэтому время проверки растёт с числом изменений и сработавших правил,
+ * а не с произведением размера каталога на число правил.
+ */
+class AlertEngine
+{
+public:
+    /*!
+     * \brief AlertEngine - конструктор класса AlertEngine (без правил и с пустым каталогом)
+     */
+    AlertEngine();
+
+    /*!
+     * \brief requiredFields - поля записей, которые читают правила (TleParser::setFields)
+     */
+    static TleFields requiredFields();
+
+    /*!
+     * \brief parseRule - разбирает правило из строки
+     * \param text Строка вида «stale 14», «band 97 99 400 600», «gone 25544»,
+     * «bstar 5»; после параметров можно перечислить номера объектов
+     * \param rule Выход: правило
+     * \return true, если строка разобрана
+     */
+    static bool parseRule(const QString &text, AlertRule &rule);
+
+    /*!
+     * \brief ruleText - строка правила в формате parseRule()
+     * \param rule Правило
+     */
+    static QString ruleText(const AlertRule &rule);
+
+    /*!
+     * \brief addRule - регистрирует правило
+     * \param rule Правило
+     * \return Индекс правила
+     * \details Состояние каталога сохраняется; правило проверяется со следующей загрузки.
+     */
+    int addRule(const AlertRule &rule);
+
+    /*!
+     * \brief setRules - заменяет все правила
+     * \param rules Правила
+     */
+    void setRules(const QVector<AlertRule> &rules);
+
+    /*!
+     * \brief rules
+     * \return Зарегистрированные правила
+     */
+    const QVector<AlertRule> &rules() const;
+
+    /*!
+     * \brief reset - задаёт исходный каталог без проверки правил
+     * \param records Записи (объект может встречаться несколько раз)
+     * \param now Текущий момент (мкс Unix)
+     */
+    void reset(const QVector<TleRecord> &records, qint64 now);
+
+    /*!
+     * \brief replace - каталог загружен заново целиком
+     * \param records Новые записи
+     * \param now Текущий момент (мкс Unix)
+     * \return Оповещения, упорядоченные по номеру объекта и индексу правила
+     * \details Объекты, которых нет в новом каталоге, считаются исчезнувшими.
+     */
+    QVector<Alert> replace(const QVector<TleRecord> &records, qint64 now);
+
+    /*!
+     * \brief append - к каталогу добавлены записи
+     * \param records Только добавленные записи
+     * \param now Текущий момент (мкс Unix)
+     * \return Оповещения, упорядоченные по номеру объекта и индексу правила
+     * \details Записи с эпохой не новее известной не считаются изменением.
+     */
+    QVector<Alert> append(const QVector<TleRecord> &records, qint64 now);
+
+    /*!
+     * \brief size
+     * \return Количество объектов в состоянии каталога
+     */
+    int size() const;
+
+private:
+    /*!
+     * \brief Entry - состояние объекта
+     */
+    struct Entry
+    {
+        qint64 epoch = 0;    //! Последняя эпоха (мкс Unix)
+        double bstar = 0.0;  //! B* последнего набора
+        quint32 seen = 0;    //! Поколение последней загрузки, в которой объект был
+        quint32 touched = 0; //! Поколение последнего изменения
+        qint64 loaded = 0;   //! Самая поздняя эпоха объекта в текущей загрузке (мкс Unix)
+        int record = -1;     //! Индекс записи с этой эпохой в текущей загрузке
+    };
+
+    /*!
+     * \brief Change - новый или изменившийся объект в загрузке
+     */
+    struct Change
+    {
+        const TleRecord *record; //! Новый набор элементов
+        qint64 epoch;            //! Эпоха нового набора (мкс Unix)
+        double bstar;            //! B* нового набора
+        bool added;              //! Объекта не было в каталоге
+        qint64 oldEpoch;         //! Прежняя эпоха (если объект был)
+        double oldBstar;         //! Прежний B* (если объект был)
+    };
+
+    /*!
+     * \brief rebuildIndexes - перестраивает индексы правил
+     */
+    void rebuildIndexes();
+
+    /*!
+     * \brief collect - набор изменений относительно состояния
+     * \param records Записи загрузки
+     * \param replacing Загрузка заменяет каталог целиком
+     * \param removed Выход: номера исчезнувших объектов (только при замене)
+     * \return Новые и изменившиеся объекты, по одному набору на объект
+     * \details Состояние не меняется, кроме отметок поколения generation_.
+     */
+    QVector<Change> collect(const QVector<TleRecord> &records,
+                            bool replacing,
+                            QVector<int> &removed);
+
+    /*!
+     * \brief apply - применяет изменения к состоянию и индексу эпох
+     */
+    void apply(const QVector<Change> &changes, const QVector<int> &removed);
+
+    /*!
+     * \brief process - набор изменений, проверка правил и применение изменений
+     * \param records Записи загрузки
+     * \param replacing Загрузка заменяет каталог целиком
+     * \param now Текущий момент (мкс Unix)
+     */
+    QVector<Alert> process(const QVector<TleRecord> &records, bool replacing, qint64 now);
+
+    /*!
+     * \brief matchChange - общие правила и правила объекта, сработавшие на изменение
+     * \param change Изменение
+     * \param before Момент предыдущей проверки (мкс Unix)
+     * \param after Момент этой проверки (мкс Unix)
+     * \param alerts Выход: оповещения дописываются
+     */
+    void matchChange(const Change &change,
+                     qint64 before,
+                     qint64 after,
+                     QVector<Alert> &alerts) const;
+
+    /*!
+     * \brief matchRule - проверка правила с перечнем объектов на изменение
+     */
+    void matchRule(
+        int index, const Change &change, qint64 before, qint64 after, QVector<Alert> &alerts) const;
+
+    QVector<AlertRule> rules_;                    //! Правила
+    QHash<int, Entry> entries_;                   //! Состояние по номеру объекта
+    std::set<std::pair<qint64, int>> epochIndex_; //! Эпохи всех объектов по возрастанию
+    quint32 generation_ = 0;                      //! Номер текущей загрузки
+    qint64 time_ = 0;                             //! Момент предыдущей проверки (мкс Unix)
+
+    QVector<std::pair<qint64, int>> staleRules_; //! Общие правила возраста: порог (мкс), индекс
+    QVector<QVector<int>> bandBuckets_;          //! Общие правила полос по градусу наклонения
+    QVector<int> goneRules_;                     //! Общие правила исчезновения
+    QVector<std::pair<double, int>> bstarRules_; //! Общие правила B*: порог отношения, индекс
+    QHash<int, QVector<int>> numberRules_;       //! Правила с перечнем объектов по номеру
+};
+
+#endif // ALERTENGINE_HPP
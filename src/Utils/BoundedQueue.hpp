@@ -0,0 +1,187 @@
+/*!
+ * \file BoundedQueue.hpp
+ * \brief Ограниченная очередь без блокировок
+ * \details
+ * Этот файл содержит шаблон BoundedQueue — кольцевую очередь фиксированной ёмкости
+ * для нескольких писателей и нескольких читателей (алгоритм Д. Вьюкова).
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef BOUNDEDQUEUE_HPP
+#define BOUNDEDQUEUE_HPP
+
+#include <QThread>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/*!
+ * \brief Класс BoundedQueue
+ * \details
+ * Каждая ячейка кольца хранит счётчик поколения: по нему писатель и читатель узнают,
+ * свободна ли ячейка, и занимают её одной операцией compare-exchange над своим индексом.
+ * Память выделяется один раз в конструкторе.
+ *
+ * tryPush и tryPop не ждут. push и pop ждут освобождения места или появления элемента:
+ * сначала короткое активное ожидание, затем уступка процессора и короткий сон,
+ * поэтому простаивающий поток почти не расходует процессорное время.
+ */
+template<typename T>
+class BoundedQueue
+{
+public:
+    /*!
+     * \brief BoundedQueue - очередь заданной ёмкости
+     * \param capacity Ёмкость (округляется вверх до степени двойки)
+     */
+    explicit BoundedQueue(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        this->mask_ = size - 1;
+        this->cells_.reset(new Cell[size]);
+        for (std::size_t i = 0; i < size; ++i)
+            this->cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(const BoundedQueue &) = delete;
+    BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+    //! Ёмкость очереди
+    std::size_t capacity() const { return this->mask_ + 1; }
+
+    /*!
+     * \brief tryPush - добавить элемент, если есть место
+     * \return false, если очередь заполнена
+     */
+    bool tryPush(const T &value)
+    {
+        std::size_t position = this->tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = this->cells_[position & this->mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(position);
+            if (diff == 0) {
+                if (this->tail_.compare_exchange_weak(position,
+                                                      position + 1,
+                                                      std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; //! Ячейка ещё не прочитана: очередь заполнена
+            } else {
+                position = this->tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /*!
+     * \brief tryPop - извлечь элемент, если он есть
+     * \return false, если очередь пуста
+     */
+    bool tryPop(T &value)
+    {
+        std::size_t position = this->head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = this->cells_[position & this->mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(position + 1);
+            if (diff == 0) {
+                if (this->head_.compare_exchange_weak(position,
+                                                      position + 1,
+                                                      std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(position + this->mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; //! Ячейка ещё не записана: очередь пуста
+            } else {
+                position = this->head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //! Добавить элемент, ожидая освобождения места
+    void push(const T &value)
+    {
+        for (int attempt = 0; !this->tryPush(value); ++attempt)
+            backoff(attempt);
+    }
+
+    //! Извлечь элемент, ожидая его появления
+    T pop()
+    {
+        T value;
+        for (int attempt = 0; !this->tryPop(value); ++attempt)
+            backoff(attempt);
+        return value;
+    }
+
+    /*!
+     * \brief pushUntil - добавить элемент, ожидая освобождения места или выполнения условия
+     * \param value Элемент
+     * \param stop Условие окончания ожидания (проверяется, пока очередь заполнена)
+     * \return false, если элемент не добавлен: ожидание закончилось по условию
+     */
+    template<typename Predicate>
+    bool pushUntil(const T &value, Predicate stop)
+    {
+        for (int attempt = 0; !this->tryPush(value); ++attempt) {
+            if (stop())
+                return false;
+            backoff(attempt);
+        }
+        return true;
+    }
+
+    /*!
+     * \brief popUntil - извлечь элемент, ожидая его появления или выполнения условия
+     * \param value Извлечённый элемент
+     * \param stop Условие окончания ожидания (проверяется, пока очередь пуста)
+     * \return false, если ожидание закончилось по условию
+     */
+    template<typename Predicate>
+    bool popUntil(T &value, Predicate stop)
+    {
+        for (int attempt = 0; !this->tryPop(value); ++attempt) {
+            if (stop())
+                return this->tryPop(value); //! Элемент мог появиться одновременно с условием
+            backoff(attempt);
+        }
+        return true;
+    }
+
+private:
+    //! Ячейка кольца
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence; //! Поколение ячейки
+        T value;                           //! Значение
+    };
+
+    //! Ожидание перед следующей попыткой
+    static void backoff(int attempt)
+    {
+        if (attempt < 64)
+            return;
+        if (attempt < 128)
+            QThread::yieldCurrentThread();
+        else
+            QThread::usleep(attempt < 1024 ? 20 : 200);
+    }
+
+    std::unique_ptr<Cell[]> cells_; //! Кольцо
+    std::size_t mask_ = 0;          //! Ёмкость - 1
+
+    //! Индексы писателей и читателей в разных строках кэша, чтобы не мешать друг другу
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::atomic<std::size_t> head_{0};
+};
+
+#endif // BOUNDEDQUEUE_HPP
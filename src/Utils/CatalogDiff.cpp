@@ -0,0 +1,111 @@
+/*!
+ * \file CatalogDiff.cpp
+ * \brief Сравнение двух каталогов TLE
+ * \details
+ * Этот файл содержит реализацию класса CatalogDiff.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "CatalogDiff.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "TleUtils.hpp"
+
+namespace {
+
+//! Ключ записи для соединения: номер объекта и эпоха
+struct JoinKey
+{
+    int catalogNumber; //! Номер объекта
+    qint64 epoch;      //! Эпоха (мкс)
+    int index;         //! Индекс записи в каталоге
+
+    bool operator<(const JoinKey &other) const
+    {
+        return catalogNumber != other.catalogNumber ? catalogNumber < other.catalogNumber
+                                                    : epoch < other.epoch;
+    }
+};
+
+/*!
+ * \brief joinKeys - упорядоченные ключи каталога, по одному на объект
+ * \details Для повторяющихся объектов остаётся запись с самой поздней эпохой.
+ */
+QVector<JoinKey> joinKeys(const QVector<TleRecord> &catalog)
+{
+    QVector<JoinKey> keys(catalog.size());
+    for (int i = 0; i < catalog.size(); ++i)
+        keys[i] = {catalog[i].catalogNumber, TleUtils::epochToUnixMicros(catalog[i]), i};
+
+    //! Каталоги обычно уже упорядочены по номеру — тогда сортировка не нужна
+    if (!std::is_sorted(keys.cbegin(), keys.cend()))
+        std::sort(keys.begin(), keys.end());
+
+    //! Оставляем последний (по эпохе) набор элементов каждого объекта
+    int last = -1;
+    for (int i = 0; i < keys.size(); ++i) {
+        if (last >= 0 && keys[last].catalogNumber == keys[i].catalogNumber)
+            keys[last] = keys[i];
+        else
+            keys[++last] = keys[i];
+    }
+    keys.resize(last + 1);
+    return keys;
+}
+
+} // namespace
+
+CatalogDiffResult CatalogDiff::compare(const QVector<TleRecord> &oldCatalog,
+                                       const QVector<TleRecord> &newCatalog,
+                                       const DiffThresholds &thresholds)
+{
+    CatalogDiffResult result;
+    result.oldCatalog = oldCatalog; //! Неявное разделение памяти, без копирования записей
+    result.newCatalog = newCatalog;
+
+    const QVector<JoinKey> oldKeys = joinKeys(oldCatalog);
+    const QVector<JoinKey> newKeys = joinKeys(newCatalog);
+
+    //! Линейное слияние двух упорядоченных списков
+    int i = 0, j = 0;
+    while (i < oldKeys.size() || j < newKeys.size()) {
+        if (j == newKeys.size()
+            || (i < oldKeys.size() && oldKeys[i].catalogNumber < newKeys[j].catalogNumber)) {
+            result.changes.append(
+                {oldKeys[i].catalogNumber, ChangeType::Removed, 0, oldKeys[i].index, -1});
+            ++result.removed;
+            ++i;
+        } else if (i == oldKeys.size() || newKeys[j].catalogNumber < oldKeys[i].catalogNumber) {
+            result.changes.append(
+                {newKeys[j].catalogNumber, ChangeType::Added, 0, -1, newKeys[j].index});
+            ++result.added;
+            ++j;
+        } else {
+            const TleRecord &before = oldCatalog[oldKeys[i].index];
+            const TleRecord &after = newCatalog[newKeys[j].index];
+            quint8 fields = 0;
+            if (std::fabs(after.inclination - before.inclination) > thresholds.inclination)
+                fields |= InclinationChanged;
+            if (std::fabs(after.meanMotion - before.meanMotion) > thresholds.meanMotion)
+                fields |= MeanMotionChanged;
+            if (std::fabs(after.eccentricity - before.eccentricity) > thresholds.eccentricity)
+                fields |= EccentricityChanged;
+
+            if (fields) {
+                result.changes.append({oldKeys[i].catalogNumber,
+                                       ChangeType::Changed,
+                                       fields,
+                                       oldKeys[i].index,
+                                       newKeys[j].index});
+                ++result.changed;
+            } else
+                ++result.unchanged;
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,100 @@
+/*!
+ * \file CatalogDiff.hpp
+ * \brief Заголовочный файл для сравнения двух каталогов TLE
+ * \details
+ * Этот файл содержит определение класса CatalogDiff и структур с результатом
+ * сравнения двух снимков каталога: новые, исчезнувшие и изменившиеся объекты.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef CATALOGDIFF_HPP
+#define CATALOGDIFF_HPP
+
+#include <QVector>
+
+#include "TleRecord.hpp"
+
+/*!
+ * \brief ChangeType - тип изменения объекта
+ */
+enum class ChangeType : quint8 {
+    Added,   //! Объект появился в новом каталоге
+    Removed, //! Объект отсутствует в новом каталоге (сошёл с орбиты)
+    Changed  //! Элементы орбиты изменились больше порогов
+};
+
+/*!
+ * \brief ChangedField - флаги изменившихся полей
+ */
+enum ChangedField : quint8 {
+    InclinationChanged = 1u << 0,  //! Наклонение
+    MeanMotionChanged = 1u << 1,   //! Среднее движение
+    EccentricityChanged = 1u << 2, //! Эксцентриситет
+};
+
+/*!
+ * \brief DiffThresholds - пороги, начиная с которых изменение считается значимым
+ */
+struct DiffThresholds
+{
+    double inclination = 0.01;    //! Наклонение (градусы)
+    double meanMotion = 0.001;    //! Среднее движение (об/сут)
+    double eccentricity = 0.0001; //! Эксцентриситет
+};
+
+/*!
+ * \brief CatalogChange - одно изменение
+ * \details Индексы указывают на записи в oldCatalog и newCatalog результата (-1 — нет записи).
+ */
+struct CatalogChange
+{
+    int catalogNumber; //! Номер объекта
+    ChangeType type;   //! Тип изменения
+    quint8 fields;     //! Изменившиеся поля (ChangedField), только для Changed
+    int oldIndex;      //! Индекс записи в старом каталоге
+    int newIndex;      //! Индекс записи в новом каталоге
+};
+
+/*!
+ * \brief CatalogDiffResult - результат сравнения
+ * \details
+ * Каталоги хранятся как неявно разделяемые (implicitly shared) копии QVector,
+ * то есть используют ту же память, что и исходные снимки. Неизменившиеся записи
+ * не копируются: список изменений содержит только индексы.
+ */
+struct CatalogDiffResult
+{
+    QVector<TleRecord> oldCatalog;  //! Старый снимок каталога
+    QVector<TleRecord> newCatalog;  //! Новый снимок каталога
+    QVector<CatalogChange> changes; //! Изменения, упорядоченные по номеру объекта
+    int added = 0;                  //! Количество новых объектов
+    int removed = 0;                //! Количество исчезнувших объектов
+    int changed = 0;                //! Количество изменившихся объектов
+    int unchanged = 0;              //! Количество объектов без значимых изменений
+};
+
+/*!
+ * \brief Класс CatalogDiff
+ * \details
+ * Сравнивает два каталога соединением по catalogNumber: записи каждого каталога
+ * упорядочиваются по номеру (если они ещё не упорядочены), после чего выполняется
+ * линейное слияние. Если объект встречается несколько раз, используется набор
+ * элементов с самой поздней эпохой.
+ */
+class CatalogDiff
+{
+public:
+    /*!
+     * \brief compare - сравнивает два каталога
+     * \param oldCatalog Старый снимок
+     * \param newCatalog Новый снимок
+     * \param thresholds Пороги значимых изменений
+     * \return Классифицированный список изменений и сводка
+     */
+    static CatalogDiffResult compare(const QVector<TleRecord> &oldCatalog,
+                                     const QVector<TleRecord> &newCatalog,
+                                     const DiffThresholds &thresholds = DiffThresholds());
+};
+
+#endif // CATALOGDIFF_HPP
@@ -0,0 +1,564 @@
+/*!
+ * \file CatalogServer.cpp
+ * \brief Локальный HTTP-сервер каталога
+ * \details
+ * Этот файл содержит реализацию класса CatalogServer.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "CatalogServer.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+
+#include <algorithm>
+#include <limits>
+
+#include "TleUtils.hpp"
+
+namespace {
+
+constexpr int maxHeaderSize = 16 * 1024; //! Максимальный размер заголовков запроса
+constexpr qint64 maxBodySize = 1 << 20;  //! Максимальный размер тела запроса
+constexpr int cacheLimit = 4096;         //! Максимальное число кэшированных ответов
+constexpr int defaultLimit = 1000;       //! Число объектов в ответе фильтра по умолчанию
+constexpr int defaultBins = 10;          //! Число интервалов гистограммы по умолчанию
+constexpr int maxBins = 100000;          //! Максимальное число интервалов гистограммы
+
+//! Функция, возвращающая значение поля записи с индексом index
+using FieldGetter = double (*)(const TleStatistics &stats, int index);
+
+//! Поле, доступное для фильтров и гистограмм
+struct Field
+{
+    const char *name;  //! Имя поля в запросе
+    FieldGetter value; //! Значение поля
+};
+
+const Field fields[] = {
+    {"inclination", [](const TleStatistics &s, int i) { return s.records[i].inclination; }},
+    {"eccentricity", [](const TleStatistics &s, int i) { return s.records[i].eccentricity; }},
+    {"meanMotion", [](const TleStatistics &s, int i) { return s.records[i].meanMotion; }},
+    {"rightAscension", [](const TleStatistics &s, int i) { return s.records[i].rightAscension; }},
+    {"argPerigee", [](const TleStatistics &s, int i) { return s.records[i].argPerigee; }},
+    {"meanAnomaly", [](const TleStatistics &s, int i) { return s.records[i].meanAnomaly; }},
+    {"semiMajorAxis", [](const TleStatistics &s, int i) { return s.derived.semiMajorAxis[i]; }},
+    {"apogee", [](const TleStatistics &s, int i) { return s.derived.apogeeAltitude[i]; }},
+    {"perigee", [](const TleStatistics &s, int i) { return s.derived.perigeeAltitude[i]; }},
+    {"period", [](const TleStatistics &s, int i) { return s.derived.period[i]; }},
+    {"epoch",
+     [](const TleStatistics &s, int i) { return TleUtils::epochToUnixSeconds(s.records[i]); }},
+    {"bstar", [](const TleStatistics &s, int i) { return TleUtils::bstar(s.records[i]); }},
+};
+
+//! Поиск поля по имени (nullptr, если поле неизвестно)
+FieldGetter findField(const QString &name)
+{
+    for (const Field &field : fields)
+        if (name == QLatin1String(field.name))
+            return field.value;
+    return nullptr;
+}
+
+//! Разбор диапазона вида "от..до", любая из границ может отсутствовать
+bool parseRange(const QString &text, double &min, double &max)
+{
+    const auto separator = text.indexOf(QLatin1String(".."));
+    if (separator < 0)
+        return false;
+    const QString from = text.left(separator);
+    const QString to = text.mid(separator + 2);
+    bool ok = true;
+    min = from.isEmpty() ? -std::numeric_limits<double>::infinity() : from.toDouble(&ok);
+    if (!ok)
+        return false;
+    max = to.isEmpty() ? std::numeric_limits<double>::infinity() : to.toDouble(&ok);
+    return ok;
+}
+
+//! Преобразование QMap в объект JSON
+QJsonObject mapToJson(const QMap<int, int> &map, QString (*keyText)(int) = nullptr)
+{
+    QJsonObject object;
+    for (auto it = map.cbegin(); it != map.cend(); ++it)
+        object.insert(keyText ? keyText(it.key()) : QString::number(it.key()), it.value());
+    return object;
+}
+
+//! Запись каталога в виде объекта JSON
+QJsonObject recordToJson(const TleStatistics &stats, int index)
+{
+    const TleRecord &record = stats.records[index];
+    const QDateTime epoch = QDateTime::fromMSecsSinceEpoch(TleUtils::epochToUnixMicros(record)
+                                                           / 1000)
+                                .toUTC();
+    return QJsonObject{
+        {"catalogNumber", record.catalogNumber},
+        {"name", record.name.trimmed().toString()},
+        {"classification", record.classification.toString()},
+        {"internationalDesignator",
+         QString("%1%2%3")
+             .arg(record.yearLaunch, 2, 10, QLatin1Char('0'))
+             .arg(record.numberLaunch, 3, 10, QLatin1Char('0'))
+             .arg(record.launchPiece.trimmed().toString())},
+        {"epoch", epoch.toString(Qt::ISODateWithMs)},
+        {"meanMotion", record.meanMotion},
+        {"meanMotionFirstDerivative", record.meanMotionFirstDerivative},
+        {"meanMotionSecondDerivative", record.meanMotionSecondDerivative},
+        {"bstar", TleUtils::bstar(record)},
+        {"inclination", record.inclination},
+        {"rightAscension", record.rightAscension},
+        {"eccentricity", record.eccentricity},
+        {"argPerigee", record.argPerigee},
+        {"meanAnomaly", record.meanAnomaly},
+        {"revolutionNumber", record.revolutionNumberOfEpoch},
+        {"semiMajorAxis", stats.derived.semiMajorAxis[index]},
+        {"apogee", stats.derived.apogeeAltitude[index]},
+        {"perigee", stats.derived.perigeeAltitude[index]},
+        {"period", stats.derived.period[index]},
+        {"regime", OrbitalMetrics::regimeName(OrbitRegime(stats.derived.regime[index]))},
+        {"line1", record.line1.toString()},
+        {"line2", record.line2.toString()},
+    };
+}
+
+//! Имя режима по его номеру (для mapToJson)
+QString regimeKey(int regime)
+{
+    return OrbitalMetrics::regimeName(OrbitRegime(regime));
+}
+
+} // namespace
+
+CatalogServer::CatalogServer(QObject *parent)
+    : QObject(parent)
+{
+    this->connect(&this->server_,
+                  &QTcpServer::newConnection,
+                  this,
+                  &CatalogServer::onNewConnection);
+    this->connect(&this->parser_,
+                  &TleParser::parsingFinished,
+                  this,
+                  &CatalogServer::onSourceLoaded);
+    this->connect(&this->parser_,
+                  &TleParser::errorOccurred,
+                  this,
+                  &CatalogServer::onSourceFailed);
+}
+
+void CatalogServer::setSources(const QStringList &sources)
+{
+    this->sources_ = sources;
+}
+
+bool CatalogServer::listen(const QHostAddress &address, quint16 port)
+{
+    return this->server_.listen(address, port);
+}
+
+quint16 CatalogServer::serverPort() const
+{
+    return this->server_.serverPort();
+}
+
+QString CatalogServer::errorString() const
+{
+    return this->server_.errorString();
+}
+
+void CatalogServer::reload()
+{
+    //! Повторный запрос во время загрузки ничего не меняет
+    if (this->loading_)
+        return;
+    this->loading_ = true;
+    this->nextSource_ = 0;
+    this->pending_.clear();
+    this->loadNextSource();
+}
+
+void CatalogServer::loadNextSource()
+{
+    while (this->nextSource_ < this->sources_.size()) {
+        const QString source = this->sources_[this->nextSource_++];
+        const QUrl url(source);
+        if (url.scheme() == QLatin1String("http") || url.scheme() == QLatin1String("https")) {
+            //! Продолжение — в onSourceLoaded() или onSourceFailed()
+            this->waitingForUrl_ = true;
+            this->parser_.loadFromUrl(url);
+            return;
+        }
+        if (this->parser_.loadFromFile(source))
+            this->pending_ += this->parser_.records();
+    }
+    this->finishReload();
+}
+
+void CatalogServer::onSourceLoaded()
+{
+    //! Файлы разбираются синхронно в loadNextSource(), здесь обрабатываются только URL
+    if (!this->waitingForUrl_)
+        return;
+    this->waitingForUrl_ = false;
+    this->pending_ += this->parser_.records();
+    this->loadNextSource();
+}
+
+void CatalogServer::onSourceFailed(const QString &message)
+{
+    emit this->errorOccurred(message);
+    //! Недоступный источник пропускается, остальные загружаются
+    if (!this->waitingForUrl_)
+        return;
+    this->waitingForUrl_ = false;
+    this->loadNextSource();
+}
+
+void CatalogServer::finishReload()
+{
+    this->stats_ = TleStatistics(this->pending_); //! Статистика считается один раз на загрузку
+    this->pending_.clear();
+
+    //! Индекс по номеру объекта; при повторах берётся запись с самой поздней эпохой
+    this->index_.clear();
+    this->index_.reserve(int(this->stats_.records.size()));
+    for (int i = 0; i < this->stats_.records.size(); ++i) {
+        const TleRecord &record = this->stats_.records[i];
+        const auto it = this->index_.constFind(record.catalogNumber);
+        if (it == this->index_.cend()
+            || TleUtils::epochToUnixMicros(record)
+                   >= TleUtils::epochToUnixMicros(this->stats_.records[it.value()]))
+            this->index_.insert(record.catalogNumber, i);
+    }
+
+    this->cache_.clear(); //! Кэшированные ответы относятся к старому каталогу
+    this->loading_ = false;
+    emit this->reloaded(int(this->stats_.records.size()));
+}
+
+void CatalogServer::onNewConnection()
+{
+    while (QTcpSocket *socket = this->server_.nextPendingConnection()) {
+        //! Отключаем алгоритм Нейгла: ответы маленькие, задержка важнее
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        this->buffers_.insert(socket, QByteArray());
+        this->connect(socket, &QTcpSocket::readyRead, this, &CatalogServer::onReadyRead);
+        this->connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            this->buffers_.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void CatalogServer::onReadyRead()
+{
+    auto *socket = qobject_cast<QTcpSocket *>(this->sender());
+    if (!socket)
+        return;
+
+    QByteArray &buffer = this->buffers_[socket];
+    buffer.append(socket->readAll());
+
+    QByteArray output; //! Ответы на все полученные (в том числе конвейерные) запросы
+    bool close = false;
+    while (!close) {
+        const auto headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            //! Заголовки ещё не получены полностью
+            if (buffer.size() > maxHeaderSize) {
+                output += httpResponse(400, errorBody(tr("Слишком длинный запрос")), false);
+                close = true;
+            }
+            break;
+        }
+
+        const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+        const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+        if (requestLine.size() != 3) {
+            output += httpResponse(400, errorBody(tr("Неверная строка запроса")), false);
+            close = true;
+            break;
+        }
+
+        //! HTTP/1.1 по умолчанию оставляет соединение открытым, HTTP/1.0 — закрывает
+        bool keepAlive = requestLine[2] == "HTTP/1.1";
+        qint64 contentLength = 0;
+        for (int i = 1; i < lines.size(); ++i) {
+            const QByteArray line = lines[i].trimmed().toLower();
+            if (line.startsWith("content-length:")) {
+                contentLength = qMax<qint64>(0, line.mid(15).trimmed().toLongLong());
+            } else if (line.startsWith("connection:")) {
+                const QByteArray value = line.mid(11).trimmed();
+                if (value == "close")
+                    keepAlive = false;
+                else if (value == "keep-alive")
+                    keepAlive = true;
+            }
+        }
+        if (contentLength > maxBodySize) {
+            output += httpResponse(400, errorBody(tr("Слишком большое тело запроса")), false);
+            close = true;
+            break;
+        }
+        const qint64 requestSize = headerEnd + 4 + contentLength;
+        if (buffer.size() < requestSize)
+            break; //! Тело запроса ещё не получено
+
+        int status = 200;
+        const QByteArray body = this->handle(requestLine[0], requestLine[1], status);
+        buffer.remove(0, int(requestSize));
+        output += httpResponse(status, body, keepAlive);
+        close = !keepAlive;
+    }
+
+    if (!output.isEmpty())
+        socket->write(output);
+    if (close)
+        socket->disconnectFromHost();
+}
+
+QByteArray CatalogServer::handle(const QByteArray &method, const QByteArray &target, int &status)
+{
+    const QUrl url(QString::fromLatin1(target));
+    const QString path = url.path();
+
+    if (method == "POST" && path == QLatin1String("/reload")) {
+        this->reload();
+        status = 202;
+        return QJsonDocument(QJsonObject{{"status", "reloading"}}).toJson(QJsonDocument::Compact);
+    }
+    if (method != "GET") {
+        status = 405;
+        return errorBody(tr("Метод не поддерживается: %1").arg(QString::fromLatin1(method)));
+    }
+
+    //! Повторные запросы отвечаются из кэша без обращения к каталогу
+    const auto cached = this->cache_.constFind(target);
+    if (cached != this->cache_.cend()) {
+        status = 200;
+        return cached.value();
+    }
+
+    const QUrlQuery query(url);
+    QByteArray body;
+    status = 200;
+    if (path == QLatin1String("/stats")) {
+        body = this->statsBody();
+    } else if (path == QLatin1String("/objects")) {
+        body = this->filterBody(query, status);
+    } else if (path.startsWith(QLatin1String("/objects/"))) {
+        bool ok = false;
+        const int catalogNumber = path.mid(9).toInt(&ok);
+        if (ok)
+            body = this->objectBody(catalogNumber, status);
+        else {
+            status = 400;
+            body = errorBody(tr("Неверный номер объекта: %1").arg(path.mid(9)));
+        }
+    } else if (path == QLatin1String("/histogram")) {
+        body = this->histogramBody(query, status);
+    } else {
+        status = 404;
+        body = errorBody(tr("Неизвестный запрос: %1").arg(path));
+    }
+
+    if (status == 200) {
+        //! Кэш ограничен: при переполнении он очищается целиком
+        if (this->cache_.size() >= cacheLimit)
+            this->cache_.clear();
+        this->cache_.insert(target, body);
+    }
+    return body;
+}
+
+QByteArray CatalogServer::statsBody() const
+{
+    const QJsonObject stats{
+        {"count", int(this->stats_.records.size())},
+        {"objects", int(this->index_.size())},
+        {"oldestEpoch", this->stats_.oldestEpoch.toString(Qt::ISODate)},
+        {"launchesPerYear", mapToJson(this->stats_.launchesPerYear)},
+        {"inclinationBins", mapToJson(this->stats_.inclinationBins)},
+        {"regimes", mapToJson(this->stats_.regimeCounts, regimeKey)},
+        {"perigeeAltitudeBins", mapToJson(this->stats_.altitudeBins)},
+        {"quantiles",
+         QJsonObject{{"meanMotion", this->stats_.meanMotionQuantiles.toJson()},
+                     {"eccentricity", this->stats_.eccentricityQuantiles.toJson()},
+                     {"perigee", this->stats_.perigeeQuantiles.toJson()},
+                     {"epochAgeDays", this->stats_.epochAgeQuantiles.toJson()}}},
+    };
+    return QJsonDocument(stats).toJson(QJsonDocument::Compact);
+}
+
+QByteArray CatalogServer::objectBody(int catalogNumber, int &status) const
+{
+    const auto it = this->index_.constFind(catalogNumber);
+    if (it == this->index_.cend()) {
+        status = 404;
+        return errorBody(tr("Объект %1 не найден").arg(catalogNumber));
+    }
+    return QJsonDocument(recordToJson(this->stats_, it.value())).toJson(QJsonDocument::Compact);
+}
+
+QByteArray CatalogServer::filterBody(const QUrlQuery &query, int &status) const
+{
+    //! Диапазон значений одного поля
+    struct Range
+    {
+        FieldGetter value;
+        double min;
+        double max;
+    };
+    QVector<Range> ranges;
+    int limit = defaultLimit;
+
+    const auto items = query.queryItems(QUrl::FullyDecoded);
+    for (const auto &item : items) {
+        if (item.first == QLatin1String("limit")) {
+            bool ok = false;
+            limit = item.second.toInt(&ok);
+            if (!ok || limit < 0) {
+                status = 400;
+                return errorBody(tr("Неверное значение limit: %1").arg(item.second));
+            }
+            continue;
+        }
+        Range range{findField(item.first), 0.0, 0.0};
+        if (!range.value) {
+            status = 400;
+            return errorBody(tr("Неизвестное поле: %1").arg(item.first));
+        }
+        if (!parseRange(item.second, range.min, range.max)) {
+            status = 400;
+            return errorBody(tr("Неверный диапазон для поля %1: %2").arg(item.first, item.second));
+        }
+        ranges.append(range);
+    }
+
+    QJsonArray objects;
+    int total = 0;
+    for (int i = 0; i < this->stats_.records.size(); ++i) {
+        const bool matches = std::all_of(ranges.cbegin(), ranges.cend(), [this, i](const Range &r) {
+            const double value = r.value(this->stats_, i);
+            return value >= r.min && value <= r.max;
+        });
+        if (!matches)
+            continue;
+        if (total++ < limit)
+            objects.append(QJsonObject{{"catalogNumber", this->stats_.records[i].catalogNumber},
+                                       {"name", this->stats_.records[i].name.trimmed().toString()}});
+    }
+
+    const QJsonObject result{{"total", total}, {"objects", objects}};
+    return QJsonDocument(result).toJson(QJsonDocument::Compact);
+}
+
+QByteArray CatalogServer::histogramBody(const QUrlQuery &query, int &status) const
+{
+    const QString fieldName = query.queryItemValue(QStringLiteral("field"));
+    const FieldGetter value = findField(fieldName);
+    if (!value) {
+        status = 400;
+        return errorBody(tr("Неизвестное поле: %1").arg(fieldName));
+    }
+
+    bool ok = true;
+    int bins = defaultBins;
+    if (query.hasQueryItem(QStringLiteral("bins")))
+        bins = query.queryItemValue(QStringLiteral("bins")).toInt(&ok);
+    if (!ok || bins < 1 || bins > maxBins) {
+        status = 400;
+        return errorBody(tr("Число интервалов должно быть от 1 до %1").arg(maxBins));
+    }
+
+    const int count = int(this->stats_.records.size());
+    //! Границы по умолчанию — минимум и максимум поля в каталоге
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    const bool hasMin = query.hasQueryItem(QStringLiteral("min"));
+    const bool hasMax = query.hasQueryItem(QStringLiteral("max"));
+    if (!hasMin || !hasMax) {
+        for (int i = 0; i < count; ++i) {
+            const double v = value(this->stats_, i);
+            min = std::min(min, v);
+            max = std::max(max, v);
+        }
+    }
+    if (count == 0)
+        min = max = 0.0; //! Пустой каталог
+    if (hasMin)
+        min = query.queryItemValue(QStringLiteral("min")).toDouble(&ok);
+    if (ok && hasMax)
+        max = query.queryItemValue(QStringLiteral("max")).toDouble(&ok);
+    if (!ok) {
+        status = 400;
+        return errorBody(tr("Неверные границы гистограммы"));
+    }
+    if (!(max > min))
+        max = min + 1.0; //! Все значения попадают в один интервал
+
+    const double width = (max - min) / bins;
+    QVector<int> counts(bins, 0);
+    int below = 0;
+    int above = 0;
+    for (int i = 0; i < count; ++i) {
+        const double v = value(this->stats_, i);
+        if (v < min)
+            ++below;
+        else if (v > max)
+            ++above;
+        else if (v == v) //! NaN не учитывается
+            ++counts[std::min(bins - 1, int((v - min) / width))];
+    }
+
+    QJsonArray countsJson;
+    for (int c : counts)
+        countsJson.append(c);
+    const QJsonObject result{{"field", fieldName},
+                             {"min", min},
+                             {"max", max},
+                             {"width", width},
+                             {"below", below},
+                             {"above", above},
+                             {"counts", countsJson}};
+    return QJsonDocument(result).toJson(QJsonDocument::Compact);
+}
+
+QByteArray CatalogServer::httpResponse(int status, const QByteArray &body, bool keepAlive)
+{
+    const char *reason = "OK";
+    switch (status) {
+    case 202:
+        reason = "Accepted";
+        break;
+    case 400:
+        reason = "Bad Request";
+        break;
+    case 404:
+        reason = "Not Found";
+        break;
+    case 405:
+        reason = "Method Not Allowed";
+        break;
+    default:
+        break;
+    }
+
+    QByteArray response;
+    response.reserve(body.size() + 128);
+    response += "HTTP/1.1 " + QByteArray::number(status) + ' ' + reason + "\r\n";
+    response += "Content-Type: application/json; charset=utf-8\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+QByteArray CatalogServer::errorBody(const QString &message)
+{
+    return QJsonDocument(QJsonObject{{"error", message}}).toJson(QJsonDocument::Compact);
+}
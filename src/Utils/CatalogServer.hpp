@@ -0,0 +1,182 @@
+/*!
+ * \file CatalogServer.hpp
+ * \brief Заголовочный файл для класса CatalogServer.
+ * \details
+ * Этот файл содержит определение класса CatalogServer — локального HTTP-сервера,
+ * который держит разобранный каталог и статистику в памяти и отвечает на JSON-запросы.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef CATALOGSERVER_HPP
+#define CATALOGSERVER_HPP
+
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QObject>
+#include <QStringList>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUrlQuery>
+
+#include "TleParser.hpp"
+
+/*!
+ * \brief Класс CatalogServer
+ * \details
+ * Источники (файлы или URL) загружаются один раз при reload(), после чего
+ * каталог, индекс по номеру объекта и статистика находятся в памяти.
+ * Сервер работает в цикле событий на QTcpServer, поддерживает keep-alive
+ * и конвейерные запросы HTTP/1.1.
+ *
+ * Запросы (все ответы в JSON):
+ * - GET /stats — сводная статистика каталога;
+ * - GET /objects/<номер> — запись по номеру объекта;
+ * - GET /objects?<поле>=<от>..<до>&limit=N — фильтр по диапазонам (границы необязательны);
+ * - GET /histogram?field=<поле>&bins=N[&min=..&max=..] — гистограмма с заданными интервалами;
+ * - POST /reload — перезагрузка источников.
+ *
+ * Тела ответов на GET кэшируются по строке запроса; кэш сбрасывается при перезагрузке.
+ */
+class CatalogServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief CatalogServer - конструктор класса CatalogServer
+     * \param parent Родитель объекта
+     */
+    explicit CatalogServer(QObject *parent = nullptr);
+
+    /*!
+     * \brief setSources - задаёт источники каталога
+     * \param sources Пути к файлам или URL (http/https)
+     */
+    void setSources(const QStringList &sources);
+
+    /*!
+     * \brief listen - начинает принимать соединения
+     * \param address Адрес для прослушивания
+     * \param port Порт (0 — выбрать свободный)
+     * \return true, если сервер запущен
+     */
+    bool listen(const QHostAddress &address, quint16 port);
+
+    /*!
+     * \brief serverPort
+     * \return Порт, на котором работает сервер
+     */
+    quint16 serverPort() const;
+
+    /*!
+     * \brief errorString
+     * \return Описание последней ошибки сервера
+     */
+    QString errorString() const;
+
+public slots:
+    /*!
+     * \brief reload - загружает источники заново
+     * \details
+     * Пока идёт загрузка, запросы обслуживаются по предыдущему каталогу.
+     * После загрузки каталог и статистика заменяются, а кэш ответов сбрасывается.
+     */
+    void reload();
+
+signals:
+    /*!
+     * \brief reloaded - каталог загружен
+     * \param count Количество записей
+     */
+    void reloaded(int count);
+
+    /*!
+     * \brief errorOccurred - ошибка при загрузке источника
+     * \param message Сообщение об ошибке
+     */
+    void errorOccurred(const QString &message);
+
+private slots:
+    /*!
+     * \brief onNewConnection - приём новых соединений
+     */
+    void onNewConnection();
+
+    /*!
+     * \brief onReadyRead - разбор поступивших запросов
+     */
+    void onReadyRead();
+
+    /*!
+     * \brief onSourceLoaded - источник по URL загружен
+     */
+    void onSourceLoaded();
+
+    /*!
+     * \brief onSourceFailed - источник по URL не загружен
+     * \param message Сообщение об ошибке
+     */
+    void onSourceFailed(const QString &message);
+
+private:
+    /*!
+     * \brief loadNextSource - загружает источники, начиная с nextSource_
+     * \details Файлы читаются сразу, на URL загрузка приостанавливается до ответа.
+     */
+    void loadNextSource();
+
+    /*!
+     * \brief finishReload - заменяет каталог загруженными записями
+     */
+    void finishReload();
+
+    /*!
+     * \brief handle - обрабатывает один запрос
+     * \param method Метод HTTP
+     * \param target Путь с параметрами запроса
+     * \param status Код ответа HTTP
+     * \return Тело ответа (JSON)
+     */
+    QByteArray handle(const QByteArray &method, const QByteArray &target, int &status);
+
+    //! Ответ на /stats
+    QByteArray statsBody() const;
+    //! Ответ на /objects/<номер>
+    QByteArray objectBody(int catalogNumber, int &status) const;
+    //! Ответ на /objects?<поле>=<от>..<до>
+    QByteArray filterBody(const QUrlQuery &query, int &status) const;
+    //! Ответ на /histogram
+    QByteArray histogramBody(const QUrlQuery &query, int &status) const;
+
+    /*!
+     * \brief httpResponse - формирует ответ HTTP
+     * \param status Код ответа
+     * \param body Тело ответа
+     * \param keepAlive Оставить соединение открытым
+     */
+    static QByteArray httpResponse(int status, const QByteArray &body, bool keepAlive);
+
+    /*!
+     * \brief errorBody - тело ответа с сообщением об ошибке
+     * \param message Сообщение
+     */
+    static QByteArray errorBody(const QString &message);
+
+    QTcpServer server_;                       //! Принимает соединения
+    QHash<QTcpSocket *, QByteArray> buffers_; //! Непрочитанные данные каждого соединения
+
+    QStringList sources_;        //! Источники каталога
+    TleParser parser_;           //! Парсер источников
+    QVector<TleRecord> pending_; //! Записи, загружаемые при перезагрузке
+    int nextSource_ = 0;         //! Следующий загружаемый источник
+    bool loading_ = false;       //! Идёт перезагрузка
+    bool waitingForUrl_ = false; //! Ожидается ответ на загрузку по URL
+
+    TleStatistics stats_{QVector<TleRecord>()}; //! Каталог и статистика
+    QHash<int, int> index_;                     //! Номер объекта -> индекс записи в каталоге
+    QHash<QByteArray, QByteArray> cache_;       //! Кэш тел ответов по строке запроса
+};
+
+#endif // CATALOGSERVER_HPP
@@ -0,0 +1,429 @@
+/*!
+ * \file CoverageEngine.cpp
+ * \brief Реализация расчёта покрытия Земли объектами каталога
+ * \details
+ * Этот файл содержит реализацию методов класса CoverageEngine.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "CoverageEngine.hpp"
+
+#include <QTextStream>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "EarthFrames.hpp"
+#include "EphemerisCache.hpp"
+#include "Sgp4.hpp"
+#include "TleUtils.hpp"
+
+namespace {
+
+using EarthFrames::deg2rad;
+
+constexpr double sphereRadius = 6371.0;     //! Средний радиус Земли (км), Земля считается шаром
+constexpr qint64 maxBlockMemory = 64ll << 20; //! Память под положения объектов кэша в блоке (байт)
+
+/*!
+ * \brief Rows - постоянные строк сетки
+ */
+struct Rows
+{
+    QVector<double> sinLatitude; //! Синус широты центра строки
+    QVector<double> cosLatitude; //! Косинус широты центра строки
+    QVector<double> area;        //! Доля поверхности, приходящаяся на ячейку строки
+};
+
+/*!
+ * \brief Job - часть шагов по времени, обрабатываемая одним потоком
+ */
+struct Job
+{
+    int firstStep = 0;          //! Первый шаг
+    int lastStep = 0;           //! Шаг за последним
+    QVector<quint64> sum;       //! Сумма чисел видимых объектов по шагам
+    QVector<quint32> minimum;   //! Наименьшее число
+    QVector<quint32> maximum;   //! Наибольшее число
+    QVector<quint32> gaps;      //! Шагов без покрытия
+    QVector<qint32> difference; //! Разностные массивы строк текущего шага
+    qint64 propagations = 0;    //! Выполнено прогнозов
+};
+
+/*!
+ * \brief addSpan - отрезок столбцов [first, first + count) строки в разностный массив
+ * \details Отрезок может переходить через долготу ±180° (first вне [0, columns)).
+ */
+inline void addSpan(qint32 *difference, int columns, int first, int count)
+{
+    if (count >= columns) {
+        ++difference[0];
+        --difference[columns];
+        return;
+    }
+    first %= columns;
+    if (first < 0)
+        first += columns;
+    const int end = first + count;
+    ++difference[first];
+    if (end <= columns) {
+        --difference[end];
+    } else {
+        //! Переход через ±180°: два отрезка
+        --difference[columns];
+        ++difference[0];
+        --difference[end - columns];
+    }
+}
+
+/*!
+ * \brief rasterize - зона видимости объекта в разностный массив сетки
+ * \param position Положение объекта в ECEF (км)
+ * \param minElevation Порог возвышения (радианы)
+ * \param grid Параметры сетки
+ * \param rows Постоянные строк
+ * \param difference Разностные массивы строк (по columns + 1 элементов)
+ */
+void rasterize(const double position[3],
+               double minElevation,
+               const CoverageGrid &grid,
+               const Rows &rows,
+               qint32 *difference)
+{
+    const double radius = std::sqrt(position[0] * position[0] + position[1] * position[1]
+                                    + position[2] * position[2]);
+    const double cosine = sphereRadius * std::cos(minElevation) / radius;
+    if (cosine >= 1.0)
+        return; //! Объект ниже порога из любой точки
+    const double cone = std::acos(cosine) - minElevation; //! Угловой радиус зоны видимости
+    const double cosCone = std::cos(cone);
+
+    const double latitude = std::asin(position[2] / radius); //! Подспутниковая точка
+    const double longitude = std::atan2(position[1], position[0]);
+    const double sinLatitude = std::sin(latitude);
+    const double cosLatitude = std::cos(latitude);
+
+    //! Центр строки i — широта -π/2 + (i + 0.5)·cell, центр столбца j — долгота -π + (j + 0.5)·cell
+    const double cell = grid.cellSize * deg2rad;
+    const double rowOrigin = 0.5 * EarthFrames::pi / cell - 0.5;
+    const double columnOrigin = EarthFrames::pi / cell - 0.5;
+    const int firstRow = qMax(0, int(std::ceil((latitude - cone) / cell + rowOrigin)));
+    const int lastRow = qMin(grid.rows - 1, int(std::floor((latitude + cone) / cell + rowOrigin)));
+    const int columns = grid.columns;
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        qint32 *line = difference + qint64(row) * (columns + 1);
+        const double denominator = rows.cosLatitude[row] * cosLatitude;
+        //! cos(Δλ) ≥ (cos λ - sin φ·sin φs) / (cos φ·cos φs): отрезок долгот строки
+        const double bound = denominator > 1e-12
+                                 ? (cosCone - rows.sinLatitude[row] * sinLatitude) / denominator
+                                 : -1.0; //! Строка у полюса или подспутниковая точка на полюсе
+        if (bound <= -1.0) {
+            addSpan(line, columns, 0, columns); //! Вся строка
+            continue;
+        }
+        if (bound > 1.0)
+            continue;
+        const double halfWidth = std::acos(bound);
+        const int first = int(std::ceil((longitude - halfWidth) / cell + columnOrigin));
+        const int last = int(std::floor((longitude + halfWidth) / cell + columnOrigin));
+        if (last >= first)
+            addSpan(line, columns, first, last - first + 1);
+    }
+}
+
+} // namespace
+
+DensityGrid CoverageGrid::toDensityGrid(CoverageField field) const
+{
+    DensityGrid grid;
+    grid.width = this->columns;
+    grid.height = this->rows;
+    grid.range = QRectF(-180.0, -90.0, 360.0, 180.0);
+    grid.counts.resize(this->rows * this->columns);
+    for (int i = 0; i < grid.counts.size(); ++i) {
+        float value = 0.0f;
+        switch (field) {
+        case CoverageField::Mean:
+            value = this->mean[i];
+            break;
+        case CoverageField::Minimum:
+            value = float(this->minimum[i]);
+            break;
+        case CoverageField::Maximum:
+            value = float(this->maximum[i]);
+            break;
+        case CoverageField::GapFraction:
+            value = this->gapFraction[i];
+            break;
+        }
+        grid.counts[i] = value;
+        grid.maxCount = qMax(grid.maxCount, value);
+    }
+    return grid;
+}
+
+DensityGrid CoverageGrid::frameGrid(int index) const
+{
+    DensityGrid grid;
+    const qint64 cells = qint64(this->rows) * this->columns;
+    if (index < 0 || index >= this->steps || this->frames.size() < (index + 1) * cells)
+        return grid;
+    grid.width = this->columns;
+    grid.height = this->rows;
+    grid.range = QRectF(-180.0, -90.0, 360.0, 180.0);
+    grid.counts.resize(int(cells));
+    const quint16 *frame = this->frames.constData() + index * cells;
+    for (int i = 0; i < cells; ++i) {
+        grid.counts[i] = float(frame[i]);
+        grid.maxCount = qMax(grid.maxCount, grid.counts[i]);
+    }
+    return grid;
+}
+
+TleFields CoverageEngine::requiredFields()
+{
+    return Sgp4::requiredFields();
+}
+
+CoverageGrid CoverageEngine::compute(const QVector<TleRecord> &records,
+                                     const CoverageSettings &settings)
+{
+    CoverageGrid grid;
+    grid.cellSize = qBound(0.05, settings.cellSize, 30.0);
+    grid.rows = qMax(1, int(std::lround(180.0 / grid.cellSize)));
+    grid.columns = 2 * grid.rows;
+    grid.cellSize = 180.0 / grid.rows; //! Целое число ячеек по широте и долготе
+    grid.start = settings.start;
+    grid.step = qMax(1.0, settings.step);
+    grid.steps = settings.end >= settings.start
+                     ? int(std::floor((settings.end - settings.start) / grid.step)) + 1
+                     : 0;
+    const int cells = grid.rows * grid.columns;
+
+    //! Модели объектов; для каждого объекта — запись с самой поздней эпохой.
+    //! Объект считается по кэшу эфемерид, если на его отрезок аппроксимации (четверть
+    //! периода) приходится больше шагов, чем прогнозов стоит построение отрезка
+    EphemerisSettings ephemeris;
+    const int fitCost = EphemerisCache::fitCost(ephemeris);
+    const QVector<int> indices = TleUtils::latestEpochIndices(records);
+    QVector<Sgp4> models;
+    QVector<TleRecord> cachedRecords;
+    QVector<int> cachedNumbers;
+    double shortestSegment = std::numeric_limits<double>::infinity(); //! Секунды
+    models.reserve(indices.size());
+    for (int index : indices) {
+        const Sgp4 model(records[index]);
+        if (!model.isValid()) {
+            ++grid.unsupported;
+            continue;
+        }
+        const double segment = model.period() * 60.0 / 4.0;
+        if (segment / grid.step > fitCost) {
+            cachedRecords.append(records[index]);
+            cachedNumbers.append(records[index].catalogNumber);
+            shortestSegment = std::min(shortestSegment, segment);
+        } else {
+            models.append(model);
+        }
+    }
+    grid.objects = int(indices.size());
+    const int cached = int(cachedNumbers.size());
+
+    //! Окно кэша — интервал расчёта; памяти хватает на отрезки текущего блока всех объектов
+    ephemeris.windowStart = grid.start;
+    ephemeris.windowEnd = grid.start + qMax(0, grid.steps - 1) * grid.step;
+    ephemeris.maxMemory = qMax(ephemeris.maxMemory, qint64(cached) << 12);
+    EphemerisCache cache(cachedRecords, ephemeris);
+
+    //! Шаги идут блоками: в блок входит не больше двух отрезков каждого объекта из кэша,
+    //! отрезки блока строятся заранее, а положения этих объектов на шагах блока
+    //! вычисляются по объектам до растеризации
+    int blockSteps = qMax(1, grid.steps);
+    if (cached > 0) {
+        const qint64 fit = qint64(maxBlockMemory / (qint64(cached) * 3 * sizeof(double)));
+        const int segmentSteps = int(shortestSegment / grid.step);
+        blockSteps = qBound(1, segmentSteps, int(qBound<qint64>(1, fit, INT_MAX)));
+    }
+
+    Rows rows;
+    rows.sinLatitude.resize(grid.rows);
+    rows.cosLatitude.resize(grid.rows);
+    rows.area.resize(grid.rows);
+    const double halfCell = 0.5 * grid.cellSize * deg2rad;
+    for (int row = 0; row < grid.rows; ++row) {
+        const double latitude = grid.latitude(row) * deg2rad;
+        rows.sinLatitude[row] = std::sin(latitude);
+        rows.cosLatitude[row] = std::cos(latitude);
+        //! Площадь пояса между границами строки, делённая на число ячеек и площадь сферы
+        rows.area[row] = (std::sin(latitude + halfCell) - std::sin(latitude - halfCell)) / 2.0
+                         / grid.columns;
+    }
+
+    grid.uncoveredArea = QVector<float>(grid.steps, 0.0f);
+    if (settings.maxFrameMemory > 0
+        && qint64(cells) * grid.steps * qint64(sizeof(quint16)) <= settings.maxFrameMemory)
+        grid.frames = QVector<quint16>(int(qint64(cells) * grid.steps), 0);
+
+    //! Каждому потоку — непрерывная часть шагов блока и свои сетки на весь расчёт
+    const int threads = qMax(1, QThread::idealThreadCount());
+    QVector<Job> jobs(threads);
+
+    const double minElevation = settings.minElevation * deg2rad;
+    //! Потоки пишут в непересекающиеся части этих массивов
+    quint16 *frames = grid.frames.isEmpty() ? nullptr : grid.frames.data();
+    float *uncoveredArea = grid.uncoveredArea.data();
+    QVector<int> objects(cached);
+    std::iota(objects.begin(), objects.end(), 0);
+    QVector<EarthFrames::TemeRotation> rotations;
+    QVector<double> times;
+    QVector<double> positions; //! ECEF объектов кэша: [шаг блока][объект][3], NaN без прогноза
+
+    for (int blockStart = 0; blockStart < grid.steps; blockStart += blockSteps) {
+        const int stepCount = qMin(blockSteps, grid.steps - blockStart);
+        //! Поворот Земли считается один раз на шаг, а не для каждого объекта
+        times.resize(stepCount);
+        rotations.resize(stepCount);
+        for (int k = 0; k < stepCount; ++k) {
+            times[k] = grid.start + (blockStart + k) * grid.step;
+            rotations[k] = EarthFrames::temeRotation(times[k]);
+        }
+
+        if (cached > 0) {
+            cache.prefetch(cachedNumbers, times.first(), times.last());
+            positions.resize(stepCount * cached * 3);
+            double *table = positions.data();
+            QtConcurrent::blockingMap(objects, [&](const int &object) {
+                QVector<StateVector> states;
+                QVector<bool> ok;
+                cache.states(cachedNumbers[object], times, states, &ok);
+                for (int k = 0; k < stepCount; ++k) {
+                    double *ecef = table + (qint64(k) * cached + object) * 3;
+                    if (ok[k])
+                        EarthFrames::temeToEcef(states[k].position, rotations[k], ecef);
+                    else
+                        ecef[0] = std::numeric_limits<double>::quiet_NaN(); //! Сошёл с орбиты
+                }
+            });
+            grid.cachedStates += qint64(stepCount) * cached;
+        }
+
+        const int jobCount = qMin(threads, stepCount);
+        for (int k = 0; k < threads; ++k) {
+            const bool active = k < jobCount; //! Остальным потокам шагов в блоке не досталось
+            jobs[k].firstStep = active ? blockStart + int(qint64(stepCount) * k / jobCount) : 0;
+            jobs[k].lastStep = active ? blockStart + int(qint64(stepCount) * (k + 1) / jobCount)
+                                      : 0;
+        }
+
+        QtConcurrent::blockingMap(jobs, [&](Job &job) {
+            if (job.lastStep <= job.firstStep)
+                return;
+            if (job.sum.isEmpty()) {
+                job.sum = QVector<quint64>(cells, 0);
+                job.minimum = QVector<quint32>(cells, std::numeric_limits<quint32>::max());
+                job.maximum = QVector<quint32>(cells, 0);
+                job.gaps = QVector<quint32>(cells, 0);
+                job.difference = QVector<qint32>(grid.rows * (grid.columns + 1));
+            }
+            qint32 *difference = job.difference.data();
+
+            for (int step = job.firstStep; step < job.lastStep; ++step) {
+                const int k = step - blockStart;
+                const double time = times[k];
+                const EarthFrames::TemeRotation &rotation = rotations[k];
+                std::fill(job.difference.begin(), job.difference.end(), 0);
+                for (const Sgp4 &model : models) {
+                    StateVector state;
+                    ++job.propagations;
+                    if (!model.propagateAt(time, state))
+                        continue; //! Объект сошёл с орбиты
+                    double ecef[3];
+                    EarthFrames::temeToEcef(state.position, rotation, ecef);
+                    rasterize(ecef, minElevation, grid, rows, difference);
+                }
+                const double *position = positions.constData() + qint64(k) * cached * 3;
+                for (int object = 0; object < cached; ++object, position += 3) {
+                    if (!std::isnan(position[0]))
+                        rasterize(position, minElevation, grid, rows, difference);
+                }
+
+                //! Префиксные суммы строк дают числа ячеек; сразу же обновляются накопители
+                quint16 *frame = frames ? frames + qint64(step) * cells : nullptr;
+                double uncovered = 0.0;
+                for (int row = 0; row < grid.rows; ++row) {
+                    const qint32 *line = difference + row * (grid.columns + 1);
+                    const int offset = row * grid.columns;
+                    qint32 count = 0;
+                    int empty = 0;
+                    for (int column = 0; column < grid.columns; ++column) {
+                        count += line[column];
+                        const quint32 value = quint32(count);
+                        const int cell = offset + column;
+                        job.sum[cell] += value;
+                        job.minimum[cell] = qMin(job.minimum[cell], value);
+                        job.maximum[cell] = qMax(job.maximum[cell], value);
+                        if (value == 0) {
+                            ++job.gaps[cell];
+                            ++empty;
+                        }
+                        if (frame)
+                            frame[cell] = quint16(qMin<quint32>(value, 65535));
+                    }
+                    uncovered += empty * rows.area[row];
+                }
+                uncoveredArea[step] = float(uncovered);
+            }
+        });
+    }
+
+    //! Объединение сеток потоков
+    QVector<quint64> sum(cells, 0);
+    grid.minimum = QVector<quint32>(cells, grid.steps > 0 ? std::numeric_limits<quint32>::max() : 0);
+    grid.maximum = QVector<quint32>(cells, 0);
+    QVector<quint32> gaps(cells, 0);
+    for (const Job &job : jobs) {
+        grid.propagations += job.propagations;
+        if (job.sum.isEmpty())
+            continue; //! Потоку не досталось ни одного шага
+        for (int cell = 0; cell < cells; ++cell) {
+            sum[cell] += job.sum[cell];
+            grid.minimum[cell] = qMin(grid.minimum[cell], job.minimum[cell]);
+            grid.maximum[cell] = qMax(grid.maximum[cell], job.maximum[cell]);
+            gaps[cell] += job.gaps[cell];
+        }
+    }
+    grid.mean = QVector<float>(cells, 0.0f);
+    grid.gapFraction = QVector<float>(cells, 0.0f);
+    if (grid.steps > 0) {
+        for (int cell = 0; cell < cells; ++cell) {
+            grid.mean[cell] = float(double(sum[cell]) / grid.steps);
+            grid.gapFraction[cell] = float(double(gaps[cell]) / grid.steps);
+        }
+    }
+    return grid;
+}
+
+bool CoverageEngine::exportCsv(const CoverageGrid &grid, QIODevice *device)
+{
+    QTextStream out(device);
+    out << "latitude,longitude,mean,min,max,gapFraction\n";
+    for (int row = 0; row < grid.rows; ++row) {
+        for (int column = 0; column < grid.columns; ++column) {
+            const int cell = row * grid.columns + column;
+            out << QString::number(grid.latitude(row), 'f', 3) << ','
+                << QString::number(grid.longitude(column), 'f', 3) << ','
+                << QString::number(grid.mean[cell], 'f', 3) << ',' << grid.minimum[cell] << ','
+                << grid.maximum[cell] << ',' << QString::number(grid.gapFraction[cell], 'f', 4)
+                << '\n';
+        }
+    }
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
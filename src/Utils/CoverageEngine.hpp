@@ -0,0 +1,139 @@
+/*!
+ * \file CoverageEngine.hpp
+ * \brief Заголовочный файл для расчёта покрытия Земли объектами каталога
+ * \details
+ * Этот файл содержит определение класса CoverageEngine и структур с параметрами
+ * расчёта и результатом: для каждой ячейки сетки широта × долгота — сколько
+ * объектов видно из её центра выше порога возвышения на каждом шаге по времени.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef COVERAGEENGINE_HPP
+#define COVERAGEENGINE_HPP
+
+#include <QIODevice>
+#include <QVector>
+
+#include "DensityRaster.hpp"
+#include "TleRecord.hpp"
+
+/*!
+ * \brief CoverageSettings - параметры расчёта покрытия
+ */
+struct CoverageSettings
+{
+    double start = 0.0;                  //! Начало интервала (секунды Unix, UTC)
+    double end = 0.0;                    //! Конец интервала (секунды Unix, UTC)
+    double step = 60.0;                  //! Шаг по времени (секунды)
+    double cellSize = 1.0;               //! Размер ячейки по широте и долготе (градусы)
+    double minElevation = 0.0;           //! Порог возвышения объекта над горизонтом ячейки (градусы)
+    qint64 maxFrameMemory = 256ll << 20; //! Память под сетки отдельных шагов (байт, 0 — не хранить)
+};
+
+/*!
+ * \brief CoverageField - величина, показываемая на карте покрытия
+ */
+enum class CoverageField {
+    Mean,       //! Среднее число видимых объектов
+    Minimum,    //! Наименьшее число
+    Maximum,    //! Наибольшее число
+    GapFraction //! Доля шагов, на которых не видно ни одного объекта
+};
+
+/*!
+ * \brief CoverageGrid - результат расчёта покрытия
+ * \details
+ * Ячейки хранятся построчно; строка 0 — самая южная (центр на широте -90 + cellSize / 2),
+ * столбец 0 — самый западный (центр на долготе -180 + cellSize / 2).
+ */
+struct CoverageGrid
+{
+    int rows = 0;          //! Число строк (по широте)
+    int columns = 0;       //! Число столбцов (по долготе)
+    double cellSize = 0.0; //! Размер ячейки (градусы)
+    double start = 0.0;    //! Момент первого шага (секунды Unix)
+    double step = 0.0;     //! Шаг по времени (секунды)
+    int steps = 0;         //! Количество шагов
+
+    QVector<float> mean;          //! Среднее число видимых объектов
+    QVector<quint32> minimum;     //! Наименьшее число
+    QVector<quint32> maximum;     //! Наибольшее число
+    QVector<float> gapFraction;   //! Доля шагов без покрытия
+    QVector<float> uncoveredArea; //! Доля поверхности без покрытия на каждом шаге
+    QVector<quint16> frames;      //! Сетки отдельных шагов подряд (пусто, если не хранятся)
+
+    int objects = 0;         //! Объектов в каталоге (без повторов)
+    int unsupported = 0;     //! Объектов, для которых прогноз невозможен (SDP4, ошибки элементов)
+    qint64 propagations = 0; //! Выполнено прогнозов SGP4
+    qint64 cachedStates = 0; //! Положений, вычисленных по кэшу эфемерид
+
+    //! Широта центра строки (градусы)
+    double latitude(int row) const { return -90.0 + (row + 0.5) * this->cellSize; }
+
+    //! Долгота центра столбца (градусы)
+    double longitude(int column) const { return -180.0 + (column + 0.5) * this->cellSize; }
+
+    //! Сохранены ли сетки отдельных шагов
+    bool hasFrames() const { return !this->frames.isEmpty(); }
+
+    /*!
+     * \brief toDensityGrid - карта выбранной величины для DensityRaster
+     * \param field Величина
+     */
+    DensityGrid toDensityGrid(CoverageField field) const;
+
+    /*!
+     * \brief frameGrid - карта одного шага для DensityRaster
+     * \param index Номер шага (пустая сетка, если шаги не хранятся)
+     */
+    DensityGrid frameGrid(int index) const;
+};
+
+/*!
+ * \brief Класс CoverageEngine
+ * \details
+ * Из центра ячейки объект виден выше порога e, если угол между направлениями
+ * из центра Земли на ячейку и на объект не больше λ(r) = arccos(R·cos e / r) - e
+ * (Земля — шар). Поэтому зона видимости объекта на шаге — сферическая «шапка»
+ * вокруг подспутниковой точки, а в каждой строке сетки она занимает один отрезок
+ * долгот, границы которого находятся из сферического закона косинусов.
+ *
+ * Зона видимости растеризуется инкрементально: в разностный массив строки
+ * записываются только +1 в начале отрезка и -1 за его концом, поэтому стоимость
+ * объекта пропорциональна числу строк, а не ячеек; числа ячеек получаются одним
+ * проходом префиксных сумм на шаг.
+ *
+ * Шаги по времени делятся между потоками; каждый поток накапливает свои сетки
+ * (сумма, минимум, максимум, шаги без покрытия), которые объединяются в конце.
+ *
+ * Объекты с длинным периодом при частом шаге берутся из EphemerisCache: шаги идут
+ * блоками, отрезки полиномов блока строятся заранее (prefetch), и положение на шаге
+ * вычисляется полиномом вместо прогноза SGP4. Остальные объекты прогнозируются прямо.
+ */
+class CoverageEngine
+{
+public:
+    /*!
+     * \brief requiredFields - поля записей, которые читает расчёт (TleParser::setFields)
+     */
+    static TleFields requiredFields();
+
+    /*!
+     * \brief compute - покрытие для каталога
+     * \param records Записи (при повторах объекта используется самая поздняя эпоха)
+     * \param settings Параметры расчёта
+     * \return Сетка покрытия
+     */
+    static CoverageGrid compute(const QVector<TleRecord> &records, const CoverageSettings &settings);
+
+    /*!
+     * \brief exportCsv - выгрузка сводных величин по ячейкам в CSV
+     * \param grid Сетка покрытия
+     * \param device Устройство, открытое для записи
+     * \return true, если запись выполнена успешно
+     */
+    static bool exportCsv(const CoverageGrid &grid, QIODevice *device);
+};
+
+#endif // COVERAGEENGINE_HPP
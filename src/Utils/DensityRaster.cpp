@@ -0,0 +1,242 @@
+/*!
+ * \file DensityRaster.cpp
+ * \brief Растеризация облака точек в сетку плотности
+ * \details
+ * Этот файл содержит реализацию класса DensityRaster.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "DensityRaster.hpp"
+
+#include <QColor>
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+//! Минимальное число точек на поток: на меньших частях накладные расходы больше выигрыша
+constexpr int minPointsPerTask = 1 << 16;
+
+/*!
+ * \brief binRange - заполняет сетку точками с индексами [begin, end)
+ * \details Ветвление только одно: проверка попадания в область (NaN её не проходит).
+ */
+void binRange(const double *x,
+              const double *y,
+              int begin,
+              int end,
+              const QRectF &range,
+              int width,
+              int height,
+              float *counts)
+{
+    const double left = range.left();
+    const double top = range.top();
+    const double scaleX = width / range.width();
+    const double scaleY = height / range.height();
+    for (int i = begin; i < end; ++i) {
+        const double fx = (x[i] - left) * scaleX;
+        const double fy = (y[i] - top) * scaleY;
+        if (fx >= 0.0 && fx < width && fy >= 0.0 && fy < height)
+            counts[int(fy) * width + int(fx)] += 1.0f;
+    }
+}
+
+/*!
+ * \brief colorTable - цветовая шкала из 256 цветов (от тёмно-фиолетового к жёлтому)
+ */
+const QVector<QRgb> &colorTable()
+{
+    static const QVector<QRgb> table = [] {
+        const QColor stops[] = {QColor(0x44, 0x01, 0x54),
+                                QColor(0x3b, 0x52, 0x8b),
+                                QColor(0x21, 0x91, 0x8c),
+                                QColor(0x5e, 0xc9, 0x62),
+                                QColor(0xfd, 0xe7, 0x25)};
+        constexpr int segments = int(sizeof(stops) / sizeof(stops[0])) - 1;
+        QVector<QRgb> colors(256);
+        for (int i = 0; i < 256; ++i) {
+            const double t = i / 255.0 * segments;
+            const int k = std::min(segments - 1, int(t));
+            const double f = t - k;
+            const QColor &a = stops[k];
+            const QColor &b = stops[k + 1];
+            colors[i] = qRgb(int(a.red() + (b.red() - a.red()) * f),
+                             int(a.green() + (b.green() - a.green()) * f),
+                             int(a.blue() + (b.blue() - a.blue()) * f));
+        }
+        return colors;
+    }();
+    return table;
+}
+
+} // namespace
+
+QRectF DensityRaster::bounds(const QVector<double> &x, const QVector<double> &y)
+{
+    double minX = std::numeric_limits<double>::infinity();
+    double maxX = -minX;
+    double minY = minX;
+    double maxY = -minX;
+    const int count = int(std::min(x.size(), y.size()));
+    for (int i = 0; i < count; ++i) {
+        if (!std::isfinite(x[i]) || !std::isfinite(y[i]))
+            continue;
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+    }
+    if (minX > maxX)
+        return QRectF();
+    return QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+}
+
+DensityGrid DensityRaster::bin(const QVector<double> &x,
+                               const QVector<double> &y,
+                               const QRectF &range,
+                               int width,
+                               int height)
+{
+    DensityGrid grid;
+    grid.width = width;
+    grid.height = height;
+    grid.range = range;
+    if (width <= 0 || height <= 0 || !(range.width() > 0.0) || !(range.height() > 0.0))
+        return grid;
+
+    const int count = int(std::min(x.size(), y.size()));
+    const int cells = width * height;
+
+    //! Число частей ограничено и числом потоков, и минимальным размером части
+    const int tasks = std::max(1,
+                               std::min(QThread::idealThreadCount(),
+                                        count / minPointsPerTask));
+    if (tasks == 1) {
+        grid.counts = QVector<float>(cells, 0.0f);
+        binRange(x.constData(), y.constData(), 0, count, range, width, height, grid.counts.data());
+    } else {
+        //! Каждая часть заполняет свою сетку, поэтому синхронизация не нужна
+        const double *px = x.constData();
+        const double *py = y.constData();
+        const auto binPart = [px, py, range, width, height, cells](int begin, int end) {
+            QVector<float> counts(cells, 0.0f);
+            binRange(px, py, begin, end, range, width, height, counts.data());
+            return counts;
+        };
+        QVector<QFuture<QVector<float>>> futures;
+        for (int t = 1; t < tasks; ++t) {
+            const int begin = int(qint64(count) * t / tasks);
+            const int end = int(qint64(count) * (t + 1) / tasks);
+            futures.append(QtConcurrent::run([binPart, begin, end]() { return binPart(begin, end); }));
+        }
+        //! Первая часть считается в текущем потоке
+        grid.counts = binPart(0, int(qint64(count) / tasks));
+
+        //! Суммирование сеток
+        float *total = grid.counts.data();
+        for (QFuture<QVector<float>> &future : futures) {
+            const QVector<float> counts = future.result();
+            const float *in = counts.constData();
+            for (int i = 0; i < cells; ++i)
+                total[i] += in[i];
+        }
+    }
+
+    grid.maxCount = grid.counts.isEmpty()
+                        ? 0.0f
+                        : *std::max_element(grid.counts.cbegin(), grid.counts.cend());
+    return grid;
+}
+
+DensityGrid DensityRaster::resample(const DensityGrid &source,
+                                    const QRectF &range,
+                                    int width,
+                                    int height)
+{
+    DensityGrid grid;
+    grid.width = width;
+    grid.height = height;
+    grid.range = range;
+    if (width <= 0 || height <= 0 || source.isEmpty() || !(range.width() > 0.0)
+        || !(range.height() > 0.0))
+        return grid;
+    grid.counts = QVector<float>(width * height, 0.0f);
+
+    const double cellWidth = source.range.width() / source.width;
+    const double cellHeight = source.range.height() / source.height;
+    const double pixelWidth = range.width() / width;
+    const double pixelHeight = range.height() / height;
+    float *out = grid.counts.data();
+
+    if (cellWidth >= pixelWidth && cellHeight >= pixelHeight) {
+        //! Увеличение: каждая точка изображения берёт долю ячейки, в которую попадает её центр
+        const float share = float((pixelWidth * pixelHeight) / (cellWidth * cellHeight));
+        for (int row = 0; row < height; ++row) {
+            const double y = range.top() + (row + 0.5) * pixelHeight;
+            const int sourceRow = int(std::floor((y - source.range.top()) / cellHeight));
+            if (sourceRow < 0 || sourceRow >= source.height)
+                continue;
+            const float *sourceLine = source.counts.constData() + sourceRow * source.width;
+            for (int col = 0; col < width; ++col) {
+                const double x = range.left() + (col + 0.5) * pixelWidth;
+                const int sourceCol = int(std::floor((x - source.range.left()) / cellWidth));
+                if (sourceCol >= 0 && sourceCol < source.width)
+                    out[row * width + col] = sourceLine[sourceCol] * share;
+            }
+        }
+    } else {
+        //! Уменьшение: ячейки исходной сетки суммируются в точки изображения по их центрам
+        const double scaleX = 1.0 / pixelWidth;
+        const double scaleY = 1.0 / pixelHeight;
+        for (int sourceRow = 0; sourceRow < source.height; ++sourceRow) {
+            const double y = source.range.top() + (sourceRow + 0.5) * cellHeight;
+            const double fy = (y - range.top()) * scaleY;
+            if (fy < 0.0 || fy >= height)
+                continue;
+            const float *sourceLine = source.counts.constData() + sourceRow * source.width;
+            float *line = out + int(fy) * width;
+            for (int sourceCol = 0; sourceCol < source.width; ++sourceCol) {
+                const double x = source.range.left() + (sourceCol + 0.5) * cellWidth;
+                const double fx = (x - range.left()) * scaleX;
+                if (fx >= 0.0 && fx < width)
+                    line[int(fx)] += sourceLine[sourceCol];
+            }
+        }
+    }
+
+    grid.maxCount = *std::max_element(grid.counts.cbegin(), grid.counts.cend());
+    return grid;
+}
+
+QImage DensityRaster::render(const DensityGrid &grid)
+{
+    if (grid.isEmpty())
+        return QImage();
+
+    QImage image(grid.width, grid.height, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    if (!(grid.maxCount > 0.0f))
+        return image;
+
+    //! Логарифмическая шкала: и одиночные объекты, и плотные скопления остаются различимы
+    const QVector<QRgb> &colors = colorTable();
+    const float scale = 255.0f / std::log1p(grid.maxCount);
+    for (int row = 0; row < grid.height; ++row) {
+        //! Строка 0 сетки — минимальный y, поэтому на изображении она снизу
+        auto *line = reinterpret_cast<QRgb *>(image.scanLine(grid.height - 1 - row));
+        const float *counts = grid.counts.constData() + row * grid.width;
+        for (int col = 0; col < grid.width; ++col) {
+            const float count = counts[col];
+            if (count > 0.0f)
+                line[col] = colors[std::min(255, int(std::log1p(count) * scale))];
+        }
+    }
+    return image;
+}
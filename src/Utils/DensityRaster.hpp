@@ -0,0 +1,90 @@
+/*!
+ * \file DensityRaster.hpp
+ * \brief Заголовочный файл для растеризации облака точек в сетку плотности
+ * \details
+ * Этот файл содержит определение структуры DensityGrid и класса DensityRaster,
+ * которые раскладывают точки (например, наклонение и среднее движение всех записей
+ * каталога) по ячейкам сетки и строят по ней изображение.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef DENSITYRASTER_HPP
+#define DENSITYRASTER_HPP
+
+#include <QImage>
+#include <QRectF>
+#include <QVector>
+
+/*!
+ * \brief DensityGrid - сетка плотности
+ * \details
+ * Ячейка (col, row) покрывает прямоугольник области range шириной range.width() / width
+ * и высотой range.height() / height; строка 0 соответствует минимальному y.
+ */
+struct DensityGrid
+{
+    int width = 0;         //! Число столбцов
+    int height = 0;        //! Число строк
+    QRectF range;          //! Область данных, покрытая сеткой
+    QVector<float> counts; //! Число точек в ячейках (построчно)
+    float maxCount = 0.0f; //! Наибольшее значение ячейки
+
+    //! Пустая ли сетка
+    bool isEmpty() const { return this->counts.isEmpty(); }
+};
+
+/*!
+ * \brief Класс DensityRaster
+ * \details
+ * Стоимость отрисовки зависит только от размера сетки, а не от числа точек.
+ * Разбиение выполняется параллельно: каждый поток заполняет свою сетку
+ * по своей части точек, после чего сетки суммируются.
+ */
+class DensityRaster
+{
+public:
+    /*!
+     * \brief bounds - область, содержащая все конечные точки
+     * \param x Координаты x
+     * \param y Координаты y
+     * \return Прямоугольник (пустой, если точек нет)
+     */
+    static QRectF bounds(const QVector<double> &x, const QVector<double> &y);
+
+    /*!
+     * \brief bin - раскладывает точки по ячейкам сетки
+     * \param x Координаты x
+     * \param y Координаты y
+     * \param range Область данных
+     * \param width Число столбцов
+     * \param height Число строк
+     * \return Сетка плотности; точки вне области не учитываются
+     */
+    static DensityGrid bin(const QVector<double> &x,
+                           const QVector<double> &y,
+                           const QRectF &range,
+                           int width,
+                           int height);
+
+    /*!
+     * \brief resample - пересчитывает готовую сетку на другую область и разрешение
+     * \param source Исходная (обычно более подробная) сетка
+     * \param range Новая область
+     * \param width Число столбцов новой сетки
+     * \param height Число строк новой сетки
+     * \details
+     * Стоимость не зависит от числа точек, поэтому используется как уровень
+     * детализации при масштабировании, пока точная сетка считается в фоне.
+     */
+    static DensityGrid resample(const DensityGrid &source, const QRectF &range, int width, int height);
+
+    /*!
+     * \brief render - изображение сетки в логарифмической цветовой шкале
+     * \param grid Сетка плотности
+     * \return Изображение размером width x height; пустые ячейки прозрачны
+     */
+    static QImage render(const DensityGrid &grid);
+};
+
+#endif // DENSITYRASTER_HPP
@@ -0,0 +1,91 @@
+/*!
+ * \file EarthFrames.cpp
+ * \brief Пакетный перевод положений между системами координат Земли
+ * \details
+ * Этот файл содержит пакетные версии функций EarthFrames над массивами координат.
+ * Тела циклов не содержат ветвлений и вызовов библиотечной тригонометрии, поэтому
+ * компилятор векторизует их (флаги для этого файла заданы в CMakeLists.txt).
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "EarthFrames.hpp"
+
+namespace {
+
+/*!
+ * \brief toGeodetic - общий цикл поворота и перевода в геодезические координаты
+ * \details Выбор записи высоты вынесен в параметр шаблона, чтобы в цикле не было ветвлений.
+ */
+template<bool withAltitude>
+void toGeodetic(const EarthFrames::TemeRotation &rotation,
+                int count,
+                const double *__restrict x,
+                const double *__restrict y,
+                const double *__restrict z,
+                double *__restrict latitude,
+                double *__restrict longitude,
+                double *__restrict altitude)
+{
+    const double c = rotation.cosine;
+    const double s = rotation.sine;
+    for (int i = 0; i < count; ++i) {
+        const double ecef[3] = {c * x[i] + s * y[i], -s * x[i] + c * y[i], z[i]};
+        double height = 0.0;
+        EarthFrames::ecefToGeodetic(ecef, latitude[i], longitude[i], height);
+        if (withAltitude)
+            altitude[i] = height;
+    }
+}
+
+} // namespace
+
+namespace EarthFrames {
+
+void temeToEcef(const TemeRotation &rotation,
+                int count,
+                const double *x,
+                const double *y,
+                double *ecefX,
+                double *ecefY)
+{
+    const double c = rotation.cosine;
+    const double s = rotation.sine;
+    const double *__restrict inX = x;
+    const double *__restrict inY = y;
+    double *__restrict outX = ecefX;
+    double *__restrict outY = ecefY;
+    for (int i = 0; i < count; ++i) {
+        outX[i] = c * inX[i] + s * inY[i];
+        outY[i] = -s * inX[i] + c * inY[i];
+    }
+}
+
+void ecefToGeodetic(int count,
+                    const double *x,
+                    const double *y,
+                    const double *z,
+                    double *latitude,
+                    double *longitude,
+                    double *altitude)
+{
+    //! Тождественный поворот: умножения на 1 и 0 не меняют координат
+    temeToGeodetic(TemeRotation(), count, x, y, z, latitude, longitude, altitude);
+}
+
+void temeToGeodetic(const TemeRotation &rotation,
+                    int count,
+                    const double *x,
+                    const double *y,
+                    const double *z,
+                    double *latitude,
+                    double *longitude,
+                    double *altitude)
+{
+    if (altitude)
+        toGeodetic<true>(rotation, count, x, y, z, latitude, longitude, altitude);
+    else
+        toGeodetic<false>(rotation, count, x, y, z, latitude, longitude, nullptr);
+}
+
+} // namespace EarthFrames
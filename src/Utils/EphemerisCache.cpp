@@ -0,0 +1,361 @@
+/*!
+ * \file EphemerisCache.cpp
+ * \brief Кэш эфемерид на полиномах Чебышёва
+ * \details
+ * Этот файл содержит реализацию класса EphemerisCache.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "EphemerisCache.hpp"
+
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+constexpr int components = 6;            //! x, y, z, vx, vy, vz
+constexpr int maxLevel = 6;              //! Наименьший отрезок — период / 256
+constexpr qint64 indexLimit = 1ll << 27; //! Допустимый номер отрезка по модулю (~90 лет)
+
+} // namespace
+
+EphemerisCache::EphemerisCache(const QVector<TleRecord> &records,
+                               const EphemerisSettings &settings)
+    : settings_(settings)
+{
+    //! Выше 16-й степени переход к степенному ряду теряет слишком много точности
+    this->settings_.degree = qBound(2, this->settings_.degree, 16);
+    this->cache_.setMaxCost(int(qBound<qint64>(1, this->settings_.maxMemory, INT_MAX)));
+
+    //! Для каждого объекта берётся самая поздняя эпоха
+    for (const TleRecord &record : records) {
+        Sgp4 model(record);
+        if (!model.isValid())
+            continue;
+        auto it = this->models_.find(record.catalogNumber);
+        if (it == this->models_.end())
+            this->models_.insert(record.catalogNumber, model);
+        else if (model.epoch() > it->epoch())
+            *it = model;
+    }
+    for (auto it = this->models_.cbegin(); it != this->models_.cend(); ++it)
+        this->levels_.insert(it.key(), 0);
+}
+
+bool EphemerisCache::state(int catalogNumber, double time, StateVector &state)
+{
+    const auto it = this->models_.constFind(catalogNumber);
+    if (it == this->models_.cend())
+        return false;
+    const Sgp4 &model = *it;
+    const double minutes = (time - model.epoch()) / 60.0;
+
+    Segment segment;
+    if (this->inWindow(time) && this->lookup(catalogNumber, model, minutes, segment)) {
+        this->evaluate(segment, minutes, state);
+        return true;
+    }
+    return model.propagate(minutes, state);
+}
+
+int EphemerisCache::states(int catalogNumber,
+                           const QVector<double> &times,
+                           QVector<StateVector> &states,
+                           QVector<bool> *ok)
+{
+    states.resize(times.size());
+    if (ok)
+        ok->fill(false, times.size());
+
+    const auto it = this->models_.constFind(catalogNumber);
+    if (it == this->models_.cend())
+        return 0;
+    const Sgp4 &model = *it;
+
+    int count = 0;
+    Segment segment; //! Последний найденный отрезок
+    for (int i = 0; i < times.size(); ++i) {
+        const double minutes = (times[i] - model.epoch()) / 60.0;
+        bool done = false;
+        if (this->inWindow(times[i])) {
+            //! Моменты одного отрезка обходятся без обращения к кэшу и блокировки
+            const bool inside = !segment.coefficients.isEmpty() && minutes >= segment.start
+                                && minutes < segment.start + segment.length;
+            if (inside || this->lookup(catalogNumber, model, minutes, segment)) {
+                this->evaluate(segment, minutes, states[i]);
+                done = true;
+            }
+        }
+        if (!done)
+            done = model.propagate(minutes, states[i]);
+        if (done) {
+            ++count;
+            if (ok)
+                (*ok)[i] = true;
+        }
+    }
+    return count;
+}
+
+void EphemerisCache::prefetch(const QVector<int> &catalogNumbers, double from, double to)
+{
+    if (this->settings_.windowEnd > this->settings_.windowStart) {
+        from = std::max(from, this->settings_.windowStart);
+        to = std::min(to, this->settings_.windowEnd);
+    }
+    if (!(to >= from))
+        return;
+
+    //! Задание на аппроксимацию одного отрезка
+    struct Job
+    {
+        int catalogNumber;
+        const Sgp4 *model;
+        int level;
+        quint64 key;
+        Segment segment;
+        FitResult result;
+    };
+
+    //! Отрезки, не прошедшие проверку точности, уточняются в следующем круге
+    QVector<int> pending = catalogNumbers;
+    while (!pending.isEmpty()) {
+        QVector<Job> jobs;
+        {
+            QMutexLocker locker(&this->mutex_);
+            for (int catalogNumber : pending) {
+                const auto it = this->models_.constFind(catalogNumber);
+                if (it == this->models_.cend())
+                    continue;
+                const Sgp4 &model = *it;
+                const int level = this->levels_.value(catalogNumber);
+                const double length = model.period() / 4.0 / double(1 << level);
+                const qint64 first = qint64(std::floor((from - model.epoch()) / 60.0 / length));
+                const qint64 last = qint64(std::floor((to - model.epoch()) / 60.0 / length));
+                if (first <= -indexLimit || last >= indexLimit)
+                    continue;
+                for (qint64 index = first; index <= last; ++index) {
+                    const quint64 key = segmentKey(catalogNumber, level, index);
+                    if (this->cache_.contains(key))
+                        continue;
+                    Segment segment;
+                    segment.start = double(index) * length;
+                    segment.length = length;
+                    jobs.append({catalogNumber, &model, level, key, segment, FitResult::Ok});
+                }
+            }
+        }
+
+        QtConcurrent::blockingMap(jobs, [this](Job &job) {
+            job.result = this->fit(*job.model, job.segment.start, job.segment.length, job.segment);
+        });
+
+        pending.clear();
+        QMutexLocker locker(&this->mutex_);
+        for (const Job &job : jobs) {
+            if (job.result == FitResult::Ok) {
+                this->cache_.insert(job.key, new Segment(job.segment), segmentCost(job.segment));
+            } else if (job.result == FitResult::ToleranceExceeded && job.level < maxLevel
+                       && this->levels_.value(job.catalogNumber) == job.level) {
+                this->levels_[job.catalogNumber] = job.level + 1;
+                pending.append(job.catalogNumber);
+            }
+        }
+    }
+}
+
+bool EphemerisCache::contains(int catalogNumber) const
+{
+    return this->models_.contains(catalogNumber);
+}
+
+qint64 EphemerisCache::memoryUsage() const
+{
+    QMutexLocker locker(&this->mutex_);
+    return this->cache_.totalCost();
+}
+
+int EphemerisCache::segmentCount() const
+{
+    QMutexLocker locker(&this->mutex_);
+    return int(this->cache_.count());
+}
+
+int EphemerisCache::fitCost(const EphemerisSettings &settings)
+{
+    //! n узлов Чебышёва и 2n точек проверки, как в fit()
+    return 3 * (qBound(2, settings.degree, 16) + 1);
+}
+
+EphemerisCache::FitResult EphemerisCache::fit(const Sgp4 &model,
+                                              double start,
+                                              double length,
+                                              Segment &segment) const
+{
+    const int n = this->settings_.degree + 1;
+    segment.start = start;
+    segment.length = length;
+    segment.coefficients.fill(0.0, components * n);
+
+    //! Значения модели в узлах Чебышёва x_k = cos(pi (k + 1/2) / n)
+    QVector<double> values(components * n);
+    StateVector state;
+    for (int k = 0; k < n; ++k) {
+        const double x = std::cos(pi * (k + 0.5) / n);
+        if (!model.propagate(start + (x + 1.0) * 0.5 * length, state))
+            return FitResult::PropagationFailed;
+        for (int c = 0; c < 3; ++c) {
+            values[c * n + k] = state.position[c];
+            values[(c + 3) * n + k] = state.velocity[c];
+        }
+    }
+
+    //! Дискретное косинусное преобразование: c_j = 2/n sum f_k cos(pi j (k + 1/2) / n)
+    QVector<double> chebyshev(components * n, 0.0);
+    for (int j = 0; j < n; ++j) {
+        const double scale = (j == 0 ? 1.0 : 2.0) / n;
+        for (int c = 0; c < components; ++c) {
+            double sum = 0.0;
+            for (int k = 0; k < n; ++k)
+                sum += values[c * n + k] * std::cos(pi * j * (k + 0.5) / n);
+            chebyshev[c * n + j] = sum * scale;
+        }
+    }
+
+    //! Переход к степенному ряду по нормированному времени u из [-1, 1]:
+    //! T_0 = 1, T_1 = u, T_{j+1} = 2u T_j - T_{j-1}. Коэффициенты хранятся по степеням,
+    //! внутри степени — по компонентам, чтобы вычисление шло подряд по памяти
+    QVector<double> power(n * n, 0.0); //! power[j * n + i] — коэффициент u^i в T_j
+    power[0] = 1.0;
+    if (n > 1)
+        power[n + 1] = 1.0;
+    for (int j = 2; j < n; ++j) {
+        for (int i = 0; i <= j; ++i) {
+            double value = -power[(j - 2) * n + i];
+            if (i > 0)
+                value += 2.0 * power[(j - 1) * n + i - 1];
+            power[j * n + i] = value;
+        }
+    }
+    double *coefficients = segment.coefficients.data();
+    for (int j = 0; j < n; ++j) {
+        for (int i = j % 2; i <= j; i += 2) { //! T_j содержит степени той же чётности, что и j
+            for (int c = 0; c < components; ++c)
+                coefficients[i * components + c] += power[j * n + i] * chebyshev[c * n + j];
+        }
+    }
+
+    //! Проверка точности положения в точках между узлами
+    const int checks = 2 * n;
+    const double tolerance2 = this->settings_.tolerance * this->settings_.tolerance;
+    StateVector approx;
+    for (int i = 0; i < checks; ++i) {
+        const double minutes = start + length * (i + 0.5) / checks;
+        if (!model.propagate(minutes, state))
+            return FitResult::PropagationFailed;
+        this->evaluate(segment, minutes, approx);
+        double error2 = 0.0;
+        for (int c = 0; c < 3; ++c) {
+            const double d = approx.position[c] - state.position[c];
+            error2 += d * d;
+        }
+        if (!(error2 <= tolerance2))
+            return FitResult::ToleranceExceeded;
+    }
+    return FitResult::Ok;
+}
+
+void EphemerisCache::evaluate(const Segment &segment, double minutes, StateVector &state) const
+{
+    const int degree = this->settings_.degree;
+    const double u = 2.0 * (minutes - segment.start) / segment.length - 1.0;
+    const double u2 = u * u;
+    const double *coefficients = segment.coefficients.constData();
+
+    //! Схема Горнера по u^2 отдельно для чётных и нечётных степеней: две независимые
+    //! цепочки на каждую из шести компонент вдвое короче одной цепочки Кленшоу
+    const int topEven = degree - degree % 2;
+    const int topOdd = degree - 1 + degree % 2;
+    double even[components], odd[components];
+    for (int c = 0; c < components; ++c) {
+        even[c] = coefficients[topEven * components + c];
+        odd[c] = coefficients[topOdd * components + c];
+    }
+    for (int i = topEven - 2; i >= 0; i -= 2) {
+        for (int c = 0; c < components; ++c)
+            even[c] = even[c] * u2 + coefficients[i * components + c];
+    }
+    for (int i = topOdd - 2; i >= 1; i -= 2) {
+        for (int c = 0; c < components; ++c)
+            odd[c] = odd[c] * u2 + coefficients[i * components + c];
+    }
+
+    for (int c = 0; c < 3; ++c) {
+        state.position[c] = even[c] + u * odd[c];
+        state.velocity[c] = even[c + 3] + u * odd[c + 3];
+    }
+}
+
+bool EphemerisCache::lookup(int catalogNumber, const Sgp4 &model, double minutes, Segment &segment)
+{
+    for (;;) {
+        int level;
+        double length;
+        qint64 index;
+        quint64 key;
+        {
+            QMutexLocker locker(&this->mutex_);
+            level = this->levels_.value(catalogNumber);
+            length = model.period() / 4.0 / double(1 << level);
+            const double position = std::floor(minutes / length);
+            if (!(std::abs(position) < double(indexLimit)))
+                return false;
+            index = qint64(position);
+            key = segmentKey(catalogNumber, level, index);
+            if (const Segment *cached = this->cache_.object(key)) {
+                segment = *cached;
+                return true;
+            }
+        }
+
+        //! Аппроксимация выполняется без блокировки: другие потоки продолжают работу
+        Segment fitted;
+        const FitResult result = this->fit(model, double(index) * length, length, fitted);
+
+        QMutexLocker locker(&this->mutex_);
+        if (result == FitResult::Ok) {
+            segment = fitted;
+            this->cache_.insert(key, new Segment(fitted), segmentCost(fitted));
+            return true;
+        }
+        if (result == FitResult::PropagationFailed || level >= maxLevel)
+            return false;
+        //! Отрезки объекта укорачиваются вдвое (если другой поток ещё не сделал этого)
+        int &current = this->levels_[catalogNumber];
+        current = std::max(current, level + 1);
+    }
+}
+
+int EphemerisCache::segmentCost(const Segment &segment)
+{
+    return int(sizeof(Segment) + sizeof(double) * size_t(segment.coefficients.size()));
+}
+
+quint64 EphemerisCache::segmentKey(int catalogNumber, int level, qint64 index)
+{
+    //! 32 бита номера объекта, 4 бита уровня, 28 бит номера отрезка со смещением
+    return (quint64(quint32(catalogNumber)) << 32) | (quint64(level) << 28)
+           | (quint64(index + indexLimit) & 0x0FFFFFFFull);
+}
+
+bool EphemerisCache::inWindow(double time) const
+{
+    if (!(this->settings_.windowEnd > this->settings_.windowStart))
+        return true;
+    return time >= this->settings_.windowStart && time <= this->settings_.windowEnd;
+}
@@ -0,0 +1,172 @@
+/*!
+ * \file EphemerisCache.hpp
+ * \brief Заголовочный файл для кэша эфемерид на полиномах Чебышёва
+ * \details
+ * Этот файл содержит определение класса EphemerisCache, который аппроксимирует
+ * прогноз SGP4 кусочными полиномами Чебышёва и отвечает на запросы положения
+ * и скорости вычислением полинома вместо полного прогноза.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef EPHEMERISCACHE_HPP
+#define EPHEMERISCACHE_HPP
+
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+#include "Sgp4.hpp"
+
+/*!
+ * \brief EphemerisSettings - параметры кэша эфемерид
+ */
+struct EphemerisSettings
+{
+    double windowStart = 0.0;       //! Начало окна аппроксимации (секунды Unix)
+    double windowEnd = 0.0;         //! Конец окна (если не больше начала — окно не ограничено)
+    int degree = 10;                //! Степень полиномов (от 2 до 16)
+    double tolerance = 1.0e-3;      //! Допустимая ошибка положения (км)
+    qint64 maxMemory = 64ll << 20;  //! Наибольший объём памяти под отрезки (байт)
+};
+
+/*!
+ * \brief Класс EphemerisCache
+ * \details
+ * Для каждого объекта время делится на отрезки длиной в четверть периода обращения.
+ * Отрезок аппроксимируется при первом обращении (лениво): SGP4 вычисляется в узлах
+ * Чебышёва, а ошибка проверяется в точках между узлами. Ряд Чебышёва хранится
+ * в виде степенного ряда по нормированному времени: так вычисление короче.
+ * Если ошибка больше допустимой, длина отрезков объекта уменьшается вдвое.
+ * Запросы вне окна и для отрезков, которые не удалось аппроксимировать,
+ * выполняются прямым прогнозом.
+ *
+ * Отрезки хранятся в QCache с вытеснением давно не использованных (LRU),
+ * стоимость отрезка — занимаемая им память. Методы потокобезопасны.
+ */
+class EphemerisCache
+{
+public:
+    /*!
+     * \brief EphemerisCache - кэш для набора записей
+     * \param records Записи TLE (при повторах используется самая поздняя эпоха)
+     * \param settings Параметры кэша
+     */
+    explicit EphemerisCache(const QVector<TleRecord> &records,
+                            const EphemerisSettings &settings = EphemerisSettings());
+
+    /*!
+     * \brief state - положение и скорость объекта в заданный момент
+     * \param catalogNumber Номер объекта
+     * \param time Момент (секунды Unix, UTC)
+     * \param state Положение и скорость (TEME)
+     * \return false, если объекта нет или прогноз невозможен
+     */
+    bool state(int catalogNumber, double time, StateVector &state);
+
+    /*!
+     * \brief states - положения и скорости объекта в последовательность моментов
+     * \param catalogNumber Номер объекта
+     * \param times Моменты (секунды Unix, UTC)
+     * \param states Результаты (размер равен размеру times)
+     * \param ok Признаки успешного прогноза для каждого момента (может быть nullptr)
+     * \return Количество успешно вычисленных моментов
+     * \details Соседние моменты из одного отрезка не требуют повторного поиска в кэше.
+     */
+    int states(int catalogNumber,
+               const QVector<double> &times,
+               QVector<StateVector> &states,
+               QVector<bool> *ok = nullptr);
+
+    /*!
+     * \brief prefetch - заранее аппроксимирует отрезки для интервала времени
+     * \param catalogNumbers Номера объектов
+     * \param from Начало интервала (секунды Unix)
+     * \param to Конец интервала (секунды Unix)
+     * \details Недостающие отрезки аппроксимируются параллельно.
+     */
+    void prefetch(const QVector<int> &catalogNumbers, double from, double to);
+
+    /*!
+     * \brief contains - есть ли объект в кэше и можно ли его прогнозировать
+     * \param catalogNumber Номер объекта
+     */
+    bool contains(int catalogNumber) const;
+
+    //! Объём памяти, занятый отрезками (байт)
+    qint64 memoryUsage() const;
+
+    //! Количество отрезков в кэше
+    int segmentCount() const;
+
+    //! Параметры кэша
+    const EphemerisSettings &settings() const { return this->settings_; }
+
+    /*!
+     * \brief fitCost - число прогнозов SGP4 на аппроксимацию одного отрезка
+     * \param settings Параметры кэша
+     * \details Кэш выгоден, если на отрезок приходится больше запросов.
+     */
+    static int fitCost(const EphemerisSettings &settings);
+
+private:
+    //! Отрезок аппроксимации
+    struct Segment
+    {
+        double start = 0.0;           //! Начало (минуты от эпохи)
+        double length = 0.0;          //! Длина (минуты)
+        QVector<double> coefficients; //! Коэффициенты по степеням u, в каждой — 6 компонент
+    };
+
+    //! Результат аппроксимации
+    enum class FitResult {
+        Ok,                //! Ошибка в пределах допуска
+        ToleranceExceeded, //! Ошибка больше допуска
+        PropagationFailed  //! Прогноз SGP4 невозможен на отрезке
+    };
+
+    /*!
+     * \brief fit - аппроксимация отрезка
+     * \param model Модель движения
+     * \param start Начало отрезка (минуты от эпохи)
+     * \param length Длина отрезка (минуты)
+     * \param segment Результат
+     */
+    FitResult fit(const Sgp4 &model, double start, double length, Segment &segment) const;
+
+    /*!
+     * \brief evaluate - значение полиномов отрезка
+     * \param segment Отрезок
+     * \param minutes Время от эпохи (минуты)
+     * \param state Положение и скорость
+     */
+    void evaluate(const Segment &segment, double minutes, StateVector &state) const;
+
+    /*!
+     * \brief lookup - отрезок, содержащий момент; при отсутствии аппроксимируется
+     * \param catalogNumber Номер объекта
+     * \param model Модель движения объекта
+     * \param minutes Время от эпохи (минуты)
+     * \param segment Найденный отрезок (копия разделяет коэффициенты с кэшем)
+     * \return false, если отрезок построить нельзя (нужен прямой прогноз)
+     */
+    bool lookup(int catalogNumber, const Sgp4 &model, double minutes, Segment &segment);
+
+    //! Стоимость отрезка в кэше (байт)
+    static int segmentCost(const Segment &segment);
+
+    //! Ключ отрезка в кэше
+    static quint64 segmentKey(int catalogNumber, int level, qint64 index);
+
+    //! Попадает ли момент в окно аппроксимации
+    bool inWindow(double time) const;
+
+    EphemerisSettings settings_;     //! Параметры
+    QHash<int, Sgp4> models_;        //! Модели объектов (после конструктора не изменяются)
+    QHash<int, int> levels_;         //! Число делений отрезков объекта пополам
+    QCache<quint64, Segment> cache_; //! Отрезки с вытеснением LRU
+    mutable QMutex mutex_;           //! Защита levels_ и cache_
+};
+
+#endif // EPHEMERISCACHE_HPP
@@ -0,0 +1,453 @@
+/*!
+ * \file GroupAggregator.cpp
+ * \brief Группировка записей каталога
+ * \details
+ * Этот файл содержит реализацию класса GroupAggregator.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "GroupAggregator.hpp"
+
+#include <QHash>
+#include <QObject>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr int blockSize = 4096;           //! Записей в блоке (столбцы блока помещаются в кэш)
+constexpr int minRowsPerThread = 1 << 16; //! Меньшие части не окупают запуск потока
+
+//! Функция, возвращающая значение поля записи с индексом index
+using FieldGetter = double (*)(const TleStatistics &stats, int index);
+
+//! Поле, доступное для агрегации
+struct Field
+{
+    const char *name;  //! Имя поля
+    FieldGetter value; //! Значение поля
+};
+
+const Field fields[] = {
+    {"inclination", [](const TleStatistics &s, int i) { return s.records[i].inclination; }},
+    {"eccentricity", [](const TleStatistics &s, int i) { return s.records[i].eccentricity; }},
+    {"meanMotion", [](const TleStatistics &s, int i) { return s.records[i].meanMotion; }},
+    {"rightAscension", [](const TleStatistics &s, int i) { return s.records[i].rightAscension; }},
+    {"argPerigee", [](const TleStatistics &s, int i) { return s.records[i].argPerigee; }},
+    {"meanAnomaly", [](const TleStatistics &s, int i) { return s.records[i].meanAnomaly; }},
+    {"semiMajorAxis", [](const TleStatistics &s, int i) { return s.derived.semiMajorAxis[i]; }},
+    {"apogee", [](const TleStatistics &s, int i) { return s.derived.apogeeAltitude[i]; }},
+    {"perigee", [](const TleStatistics &s, int i) { return s.derived.perigeeAltitude[i]; }},
+    {"period", [](const TleStatistics &s, int i) { return s.derived.period[i]; }},
+    {"epoch",
+     [](const TleStatistics &s, int i) { return TleUtils::epochToUnixSeconds(s.records[i]); }},
+    {"bstar", [](const TleStatistics &s, int i) { return TleUtils::bstar(s.records[i]); }},
+};
+
+//! Ширина ключа в составном ключе (бит); сумма для всех ключей не превышает 64
+int keyBits(GroupKey key)
+{
+    switch (key) {
+    case GroupKey::LaunchYear:
+        return 8; //! Год - 1900
+    case GroupKey::Launch:
+        return 18; //! (год - 1900) * 1000 + номер запуска
+    case GroupKey::Classification:
+        return 8; //! Символ Latin-1
+    case GroupKey::EphemerisType:
+        return 4;
+    case GroupKey::NamePrefix:
+        return 22; //! Номер префикса в словаре
+    case GroupKey::Regime:
+        return 3;
+    case GroupKey::Count:
+        break;
+    }
+    return 0;
+}
+
+//! Положение ключа в составном ключе
+struct KeyLayout
+{
+    GroupKey key; //! Ключ
+    int shift;    //! Сдвиг (бит)
+    quint64 mask; //! Маска значения после сдвига вправо
+};
+
+//! Первое слово имени: до пробела или дефиса ("STARLINK-1234" -> "STARLINK")
+TleText namePrefix(TleText name)
+{
+    const char *data = name.data();
+    const int size = name.size();
+    int begin = 0;
+    while (begin < size && data[begin] == ' ')
+        ++begin;
+    int end = begin;
+    while (end < size && data[end] != ' ' && data[end] != '-')
+        ++end;
+    return TleText(data + begin, end - begin);
+}
+
+/*!
+ * \brief GroupTable - хеш-таблица групп с открытой адресацией
+ * \details
+ * Таблица хранит только номера групп; ключи и счётчики групп лежат в плотных
+ * массивах, счётчики полей — подряд для каждой группы.
+ */
+struct GroupTable
+{
+    int fieldCount = 0;     //! Количество агрегируемых полей
+    QVector<quint64> keys;  //! Составные ключи групп
+    QVector<qint64> counts; //! Количество записей групп
+    QVector<double> mins;   //! Минимумы [группа * fieldCount + поле]
+    QVector<double> maxs;   //! Максимумы
+    QVector<double> sums;   //! Суммы
+    int shift = 64 - 10;    //! Сдвиг для мультипликативного хеша
+    quint64 mask = 1023;    //! Маска номера ячейки
+    QVector<int> cells;     //! Номер группы в ячейке (-1 — пусто)
+
+    explicit GroupTable(int fields = 0)
+        : fieldCount(fields)
+        , cells(int(mask + 1), -1)
+    {}
+
+    //! Номер группы для ключа (группа создаётся при первом обращении)
+    int insert(quint64 key)
+    {
+        const int *table = this->cells.constData();
+        const quint64 *groupKeys = this->keys.constData();
+        quint64 cell = (key * Q_UINT64_C(0x9E3779B97F4A7C15)) >> this->shift;
+        for (;; cell = (cell + 1) & this->mask) {
+            const int group = table[cell];
+            if (group < 0)
+                break;
+            if (groupKeys[group] == key)
+                return group;
+        }
+
+        const int group = int(this->keys.size());
+        this->cells[int(cell)] = group;
+        this->keys.append(key);
+        this->counts.append(0);
+        for (int f = 0; f < this->fieldCount; ++f) {
+            this->mins.append(std::numeric_limits<double>::infinity());
+            this->maxs.append(-std::numeric_limits<double>::infinity());
+            this->sums.append(0.0);
+        }
+        if (quint64(this->keys.size()) * 2 > this->mask)
+            this->grow(); //! Заполнение не больше половины
+        return group;
+    }
+
+    //! Увеличение таблицы вдвое с повторной раскладкой номеров групп
+    void grow()
+    {
+        --this->shift;
+        this->mask = this->mask * 2 + 1;
+        this->cells.fill(-1, int(this->mask + 1));
+        int *table = this->cells.data();
+        for (int group = 0; group < this->keys.size(); ++group) {
+            quint64 cell = (this->keys[group] * Q_UINT64_C(0x9E3779B97F4A7C15)) >> this->shift;
+            while (table[cell] >= 0)
+                cell = (cell + 1) & this->mask;
+            table[cell] = group;
+        }
+    }
+};
+
+/*!
+ * \brief Partial - часть записей, обрабатываемая одним потоком
+ */
+struct Partial
+{
+    int begin = 0;                     //! Первая запись
+    int end = 0;                       //! Запись за последней
+    GroupTable table;                  //! Группы части
+    QHash<TleText, quint32> prefixIds; //! Словарь префиксов имён части
+    QVector<TleText> prefixes;         //! Префиксы по номерам
+};
+
+//! Номер префикса в словаре; если номера исчерпаны, все новые префиксы получают номер mask
+quint32 prefixId(QHash<TleText, quint32> &ids,
+                 QVector<TleText> &prefixes,
+                 TleText prefix,
+                 quint64 mask)
+{
+    const auto it = ids.constFind(prefix);
+    if (it != ids.cend())
+        return it.value();
+    if (quint64(prefixes.size()) >= mask)
+        return quint32(mask);
+    const quint32 id = quint32(prefixes.size());
+    ids.insert(prefix, id);
+    prefixes.append(prefix);
+    return id;
+}
+
+/*!
+ * \brief aggregatePartial - группировка части записей по блокам
+ */
+void aggregatePartial(Partial &partial,
+                      const TleStatistics &stats,
+                      const QVector<KeyLayout> &layout,
+                      const QVector<FieldGetter> &getters)
+{
+    QVector<quint64> keyColumn(blockSize);
+    QVector<int> groupColumn(blockSize);
+    QVector<double> valueColumn(blockSize);
+    quint64 *blockKeys = keyColumn.data();
+    int *groups = groupColumn.data();
+    double *values = valueColumn.data();
+    GroupTable &table = partial.table;
+
+    for (int start = partial.begin; start < partial.end; start += blockSize) {
+        const int count = qMin(blockSize, partial.end - start);
+        const TleRecord *records = stats.records.constData() + start;
+
+        //! Столбец составных ключей: по одному проходу на ключ
+        std::fill(blockKeys, blockKeys + count, 0);
+        for (const KeyLayout &key : layout) {
+            switch (key.key) {
+            case GroupKey::LaunchYear:
+                for (int i = 0; i < count; ++i)
+                    blockKeys[i] |= quint64(TleUtils::fullYear(records[i].yearLaunch) - 1900)
+                                    << key.shift;
+                break;
+            case GroupKey::Launch:
+                for (int i = 0; i < count; ++i)
+                    blockKeys[i] |= quint64((TleUtils::fullYear(records[i].yearLaunch) - 1900) * 1000
+                                            + qBound(0, records[i].numberLaunch, 999))
+                                    << key.shift;
+                break;
+            case GroupKey::Classification:
+                for (int i = 0; i < count; ++i) {
+                    const TleText &text = records[i].classification;
+                    const quint64 code = text.isEmpty() ? 0 : uchar(text.at(0));
+                    blockKeys[i] |= code << key.shift;
+                }
+                break;
+            case GroupKey::EphemerisType:
+                for (int i = 0; i < count; ++i)
+                    blockKeys[i] |= quint64(qBound(0, records[i].ephemerisType, 15)) << key.shift;
+                break;
+            case GroupKey::NamePrefix:
+                for (int i = 0; i < count; ++i)
+                    blockKeys[i] |= quint64(prefixId(partial.prefixIds,
+                                                     partial.prefixes,
+                                                     namePrefix(records[i].name),
+                                                     key.mask))
+                                    << key.shift;
+                break;
+            case GroupKey::Regime: {
+                const quint8 *regimes = stats.derived.regime.constData() + start;
+                for (int i = 0; i < count; ++i)
+                    blockKeys[i] |= quint64(regimes[i] & 7) << key.shift;
+                break;
+            }
+            case GroupKey::Count:
+                break;
+            }
+        }
+
+        //! Столбец номеров групп
+        for (int i = 0; i < count; ++i)
+            groups[i] = table.insert(blockKeys[i]);
+        qint64 *counts = table.counts.data();
+        for (int i = 0; i < count; ++i)
+            ++counts[groups[i]];
+
+        //! Счётчики полей: значения поля блока собираются в столбец, затем разносятся по группам
+        for (int f = 0; f < getters.size(); ++f) {
+            const FieldGetter getter = getters[f];
+            for (int i = 0; i < count; ++i)
+                values[i] = getter(stats, start + i);
+            double *mins = table.mins.data();
+            double *maxs = table.maxs.data();
+            double *sums = table.sums.data();
+            for (int i = 0; i < count; ++i) {
+                const int cell = groups[i] * table.fieldCount + f;
+                mins[cell] = qMin(mins[cell], values[i]);
+                maxs[cell] = qMax(maxs[cell], values[i]);
+                sums[cell] += values[i];
+            }
+        }
+    }
+}
+
+} // namespace
+
+QString GroupAggregator::keyName(GroupKey key)
+{
+    switch (key) {
+    case GroupKey::LaunchYear:
+        return QObject::tr("Год запуска");
+    case GroupKey::Launch:
+        return QObject::tr("Запуск");
+    case GroupKey::Classification:
+        return QObject::tr("Класс");
+    case GroupKey::EphemerisType:
+        return QObject::tr("Тип эфемерид");
+    case GroupKey::NamePrefix:
+        return QObject::tr("Префикс имени");
+    case GroupKey::Regime:
+        return QObject::tr("Режим");
+    case GroupKey::Count:
+        break;
+    }
+    return QString();
+}
+
+QStringList GroupAggregator::fieldNames()
+{
+    QStringList names;
+    for (const Field &field : fields)
+        names.append(QLatin1String(field.name));
+    return names;
+}
+
+GroupResult GroupAggregator::aggregate(const TleStatistics &stats,
+                                       const QVector<GroupKey> &keys,
+                                       const QStringList &fieldList,
+                                       int threads)
+{
+    GroupResult result;
+
+    //! Раскладка составного ключа
+    QVector<KeyLayout> layout;
+    int shift = 0;
+    for (GroupKey key : keys) {
+        if (key >= GroupKey::Count || result.keys.contains(key))
+            continue;
+        const int bits = keyBits(key);
+        layout.append({key, shift, (Q_UINT64_C(1) << bits) - 1});
+        result.keys.append(key);
+        shift += bits;
+    }
+
+    QVector<FieldGetter> getters;
+    for (const QString &name : fieldList) {
+        for (const Field &field : fields) {
+            if (name == QLatin1String(field.name) && !result.fields.contains(name)) {
+                getters.append(field.value);
+                result.fields.append(name);
+            }
+        }
+    }
+
+    //! Части для потоков
+    const int count = int(stats.records.size());
+    if (threads <= 0)
+        threads = QThread::idealThreadCount();
+    threads = qBound(1, qMin(threads, count / minRowsPerThread), 256);
+    QVector<Partial> partials(threads);
+    for (int t = 0; t < threads; ++t) {
+        partials[t].begin = int(qint64(count) * t / threads);
+        partials[t].end = int(qint64(count) * (t + 1) / threads);
+        partials[t].table = GroupTable(int(getters.size()));
+    }
+    if (threads == 1)
+        aggregatePartial(partials[0], stats, layout, getters);
+    else
+        QtConcurrent::blockingMap(partials, [&](Partial &partial) {
+            aggregatePartial(partial, stats, layout, getters);
+        });
+
+    //! Объединение: номера префиксов частей переводятся в общий словарь
+    const KeyLayout *prefixKey = nullptr;
+    for (const KeyLayout &key : layout)
+        if (key.key == GroupKey::NamePrefix)
+            prefixKey = &key;
+    GroupTable merged(int(getters.size()));
+    QHash<TleText, quint32> prefixIds;
+    QVector<TleText> prefixes;
+    if (partials.size() == 1) {
+        //! Одна часть: её таблица и словарь уже итоговые
+        merged = partials[0].table;
+        prefixes = partials[0].prefixes;
+        partials.clear();
+    }
+    for (const Partial &partial : partials) {
+        const GroupTable &table = partial.table;
+        for (int group = 0; group < table.keys.size(); ++group) {
+            quint64 key = table.keys[group];
+            if (prefixKey) {
+                const quint64 local = (key >> prefixKey->shift) & prefixKey->mask;
+                const quint32 id = local < quint64(partial.prefixes.size())
+                                       ? prefixId(prefixIds,
+                                                  prefixes,
+                                                  partial.prefixes[int(local)],
+                                                  prefixKey->mask)
+                                       : quint32(prefixKey->mask);
+                key = (key & ~(prefixKey->mask << prefixKey->shift))
+                      | (quint64(id) << prefixKey->shift);
+            }
+            const int target = merged.insert(key);
+            merged.counts[target] += table.counts[group];
+            for (int f = 0; f < merged.fieldCount; ++f) {
+                const int from = group * table.fieldCount + f;
+                const int to = target * merged.fieldCount + f;
+                merged.mins[to] = qMin(merged.mins[to], table.mins[from]);
+                merged.maxs[to] = qMax(merged.maxs[to], table.maxs[from]);
+                merged.sums[to] += table.sums[from];
+            }
+        }
+    }
+
+    //! Группы по убыванию количества записей, при равенстве — по составному ключу
+    QVector<int> order(int(merged.keys.size()));
+    for (int group = 0; group < order.size(); ++group)
+        order[group] = group;
+    std::sort(order.begin(), order.end(), [&merged](int a, int b) {
+        if (merged.counts[a] != merged.counts[b])
+            return merged.counts[a] > merged.counts[b];
+        return merged.keys[a] < merged.keys[b];
+    });
+
+    //! Ключи переводятся в текст только для итоговых групп
+    result.rows.reserve(order.size());
+    for (int group : order) {
+        GroupRow row;
+        const quint64 key = merged.keys[group];
+        for (const KeyLayout &part : layout) {
+            const int code = int((key >> part.shift) & part.mask);
+            switch (part.key) {
+            case GroupKey::LaunchYear:
+                row.keys.append(QString::number(code + 1900));
+                break;
+            case GroupKey::Launch:
+                row.keys.append(QStringLiteral("%1-%2")
+                                    .arg(code / 1000 + 1900)
+                                    .arg(code % 1000, 3, 10, QLatin1Char('0')));
+                break;
+            case GroupKey::Classification:
+                row.keys.append(code ? QString(QChar(ushort(code))) : QString());
+                break;
+            case GroupKey::EphemerisType:
+                row.keys.append(QString::number(code));
+                break;
+            case GroupKey::NamePrefix:
+                row.keys.append(code < prefixes.size() ? prefixes[code].toString()
+                                                       : QStringLiteral("…"));
+                break;
+            case GroupKey::Regime:
+                row.keys.append(OrbitalMetrics::regimeName(OrbitRegime(code)));
+                break;
+            case GroupKey::Count:
+                break;
+            }
+        }
+        row.count = merged.counts[group];
+        for (int f = 0; f < merged.fieldCount; ++f) {
+            const int cell = group * merged.fieldCount + f;
+            row.min.append(merged.mins[cell]);
+            row.max.append(merged.maxs[cell]);
+            row.mean.append(merged.sums[cell] / double(row.count));
+        }
+        result.rows.append(row);
+    }
+    return result;
+}
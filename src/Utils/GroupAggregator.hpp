@@ -0,0 +1,93 @@
+/*!
+ * \file GroupAggregator.hpp
+ * \brief Заголовочный файл для группировки записей каталога
+ * \details
+ * Этот файл содержит определение класса GroupAggregator и структур с результатом
+ * группировки записей TLE по одному или нескольким категориальным полям.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef GROUPAGGREGATOR_HPP
+#define GROUPAGGREGATOR_HPP
+
+#include <QStringList>
+#include <QVector>
+
+#include "TleStatistics.hpp"
+
+/*!
+ * \brief GroupKey - поле, по которому группируются записи
+ */
+enum class GroupKey : quint8 {
+    LaunchYear,     //! Год запуска
+    Launch,         //! Запуск: год и номер запуска международного обозначения
+    Classification, //! Класс секретности (U/C/S)
+    EphemerisType,  //! Тип эфемерид
+    NamePrefix,     //! Первое слово имени ("STARLINK", "COSMOS", ...)
+    Regime,         //! Орбитальный режим
+    Count           //! Количество полей
+};
+
+/*!
+ * \brief GroupRow - одна группа
+ * \details Векторы min, max и mean содержат по значению на каждое агрегируемое поле.
+ */
+struct GroupRow
+{
+    QStringList keys;     //! Значения ключей группы в виде текста
+    qint64 count = 0;     //! Количество записей
+    QVector<double> min;  //! Минимумы полей
+    QVector<double> max;  //! Максимумы полей
+    QVector<double> mean; //! Средние значения полей
+};
+
+/*!
+ * \brief GroupResult - результат группировки
+ */
+struct GroupResult
+{
+    QVector<GroupKey> keys; //! Ключи группировки
+    QStringList fields;     //! Агрегируемые поля
+    QVector<GroupRow> rows; //! Группы по убыванию количества записей
+};
+
+/*!
+ * \brief Класс GroupAggregator
+ * \details
+ * Группировка выполняется хеш-агрегацией по блокам записей: для блока сначала
+ * вычисляется столбец составных ключей (значения всех ключей упакованы в одно
+ * 64-битное число), затем столбец номеров групп в открытой хеш-таблице, затем
+ * отдельным проходом по каждому полю обновляются счётчики. Записи делятся между
+ * потоками, у каждого потока своя таблица и свой словарь префиксов имён;
+ * таблицы объединяются в конце, поэтому потоки не синхронизируются.
+ */
+class GroupAggregator
+{
+public:
+    /*!
+     * \brief keyName - название ключа для интерфейса
+     */
+    static QString keyName(GroupKey key);
+
+    /*!
+     * \brief fieldNames - числовые поля, которые можно агрегировать
+     * \details Имена совпадают с полями фильтров и гистограмм сервера каталога.
+     */
+    static QStringList fieldNames();
+
+    /*!
+     * \brief aggregate - группировка записей
+     * \param stats Статистика каталога (записи и производные величины)
+     * \param keys Ключи группировки (повторы игнорируются)
+     * \param fields Агрегируемые поля из fieldNames() (неизвестные игнорируются)
+     * \param threads Количество потоков (0 — по числу ядер)
+     * \return Группы с количеством записей, минимумом, максимумом и средним полей
+     */
+    static GroupResult aggregate(const TleStatistics &stats,
+                                 const QVector<GroupKey> &keys,
+                                 const QStringList &fields,
+                                 int threads = 0);
+};
+
+#endif // GROUPAGGREGATOR_HPP
@@ -0,0 +1,274 @@
+/*!
+ * \file ManeuverDetector.cpp
+ * \brief Поиск манёвров и аномалий в истории наборов элементов
+ * \details
+ * Этот файл содержит реализацию класса ManeuverDetector.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "ManeuverDetector.hpp"
+
+#include <QObject>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "TleUtils.hpp"
+
+namespace {
+
+constexpr double madScale = 1.4826; //! Отношение СКО к медиане абсолютных отклонений (нормальное распределение)
+constexpr double bstarFloor = 1e-6; //! Меньшие по модулю B* считаются шумом
+constexpr int objectsPerJob = 64;   //! Объектов в одной задаче пула потоков
+
+/*!
+ * \brief robustSigma - робастная оценка СКО
+ * \param values Значения (порядок изменяется)
+ * \return 1.4826 · медиана |x - медиана x|, 0 для коротких рядов
+ */
+double robustSigma(QVector<double> &values)
+{
+    if (values.size() < 4)
+        return 0.0;
+    const auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    const double median = *middle;
+    for (double &value : values)
+        value = std::fabs(value - median);
+    std::nth_element(values.begin(), middle, values.end());
+    return madScale * *middle;
+}
+
+//! Медиана count значений начиная с values (окно копируется)
+double windowMedian(const double *values, int count)
+{
+    double window[64];
+    count = qMin(count, 64);
+    std::copy(values, values + count, window);
+    std::nth_element(window, window + count / 2, window + count);
+    return window[count / 2];
+}
+
+/*!
+ * \brief elementSetStep - приращение номера набора элементов
+ * \details Номера трёхзначные и после 999 начинаются с 1; прочие уменьшения
+ * (повторная публикация, смена источника) пропусками не считаются.
+ */
+int elementSetStep(int previous, int current)
+{
+    if (current >= previous)
+        return current - previous;
+    const int modulus = previous < 1000 ? 1000 : 10000;
+    if (previous >= modulus - 100 && current < 100)
+        return current + (modulus - 1 - previous);
+    return 0;
+}
+
+/*!
+ * \brief Job - задача пула потоков: объекты и найденные у них события
+ */
+struct Job
+{
+    QVector<ElementSetSeries> series; //! Истории (для записей, загруженных в память)
+    QVector<int> catalogNumbers;      //! Номера объектов (для хранилища)
+    QVector<ManeuverEvent> events;    //! Результат
+};
+
+//! Объединение результатов задач в исходном порядке
+QVector<ManeuverEvent> collect(const QVector<Job> &jobs)
+{
+    int total = 0;
+    for (const Job &job : jobs)
+        total += int(job.events.size());
+    QVector<ManeuverEvent> events;
+    events.reserve(total);
+    for (const Job &job : jobs)
+        events += job.events;
+    return events;
+}
+
+} // namespace
+
+QString ManeuverDetector::typeName(ManeuverType type)
+{
+    switch (type) {
+    case ManeuverType::MeanMotionJump:
+        return QObject::tr("Скачок среднего движения");
+    case ManeuverType::InclinationJump:
+        return QObject::tr("Скачок наклонения");
+    case ManeuverType::BstarChange:
+        return QObject::tr("Смена уровня B*");
+    case ManeuverType::ElementSetGap:
+        return QObject::tr("Пропуск наборов элементов");
+    }
+    return QString();
+}
+
+TleFields ManeuverDetector::requiredFields()
+{
+    return TleField::CatalogNumber | TleField::Epoch | TleField::Derivatives | TleField::Drag
+           | TleField::ElementSet | TleField::Inclination | TleField::Eccentricity
+           | TleField::MeanMotion;
+}
+
+QVector<ManeuverEvent> ManeuverDetector::scanSeries(const ElementSetSeries &series,
+                                                    const ManeuverSettings &settings)
+{
+    QVector<ManeuverEvent> events;
+    const int count = series.size();
+    if (count < 2)
+        return events;
+    const qint64 *epochs = series.epochs.constData();
+
+    //! Невязки соседних пар: среднее движение относительно прогноза с торможением
+    QVector<int> pairs;
+    QVector<double> meanMotionResiduals, inclinationResiduals;
+    pairs.reserve(count);
+    meanMotionResiduals.reserve(count);
+    inclinationResiduals.reserve(count);
+    for (int i = 1; i < count; ++i) {
+        const double days = double(epochs[i] - epochs[i - 1]) / double(TleUtils::microsPerDay);
+        if (days <= 0.0 || days > settings.maxIntervalDays)
+            continue;
+        const double predicted = series.meanMotion[i - 1] + 2.0 * series.meanMotionDot[i - 1] * days;
+        pairs.append(i);
+        meanMotionResiduals.append(series.meanMotion[i] - predicted);
+        inclinationResiduals.append(series.inclination[i] - series.inclination[i - 1]);
+    }
+
+    //! Пороги по шуму самого объекта
+    QVector<double> scratch = meanMotionResiduals;
+    const double meanMotionThreshold = qMax(settings.minMeanMotionJump,
+                                            settings.sigma * robustSigma(scratch));
+    scratch = inclinationResiduals;
+    const double inclinationThreshold = qMax(settings.minInclinationJump,
+                                             settings.sigma * robustSigma(scratch));
+
+    for (int k = 0; k < pairs.size(); ++k) {
+        const int i = pairs[k];
+        if (std::fabs(meanMotionResiduals[k]) > meanMotionThreshold)
+            events.append({series.catalogNumber,
+                           ManeuverType::MeanMotionJump,
+                           epochs[i],
+                           epochs[i - 1],
+                           meanMotionResiduals[k],
+                           meanMotionThreshold});
+        if (std::fabs(inclinationResiduals[k]) > inclinationThreshold)
+            events.append({series.catalogNumber,
+                           ManeuverType::InclinationJump,
+                           epochs[i],
+                           epochs[i - 1],
+                           inclinationResiduals[k],
+                           inclinationThreshold});
+    }
+
+    //! Уровень B*: медианы окон до и после; событие — там, где отношение уровней наибольшее
+    const int window = qBound(2, settings.bstarWindow, 64);
+    const double *bstar = series.bstar.constData();
+    int best = -1;
+    double bestRatio = 0.0;
+    for (int i = window; i + window <= count + 1; ++i) {
+        double ratio = 0.0;
+        if (i + window <= count) {
+            const double before = std::fabs(windowMedian(bstar + i - window, window));
+            const double after = std::fabs(windowMedian(bstar + i, window));
+            ratio = qMax(before, after) / qMax(qMin(before, after), bstarFloor);
+            if (qMax(before, after) < bstarFloor)
+                ratio = 0.0;
+        }
+        if (ratio > settings.bstarRatio && ratio > bestRatio) {
+            best = i;
+            bestRatio = ratio;
+        } else if (ratio <= settings.bstarRatio && best >= 0) {
+            events.append({series.catalogNumber,
+                           ManeuverType::BstarChange,
+                           epochs[best],
+                           epochs[best - 1],
+                           bestRatio,
+                           settings.bstarRatio});
+            best = -1;
+            bestRatio = 0.0;
+        }
+    }
+
+    //! Пропуски номеров наборов элементов
+    for (int i = 1; i < count; ++i) {
+        const int missing = elementSetStep(series.elementSetNumbers[i - 1],
+                                           series.elementSetNumbers[i])
+                            - 1;
+        if (missing >= settings.minMissingSets)
+            events.append({series.catalogNumber,
+                           ManeuverType::ElementSetGap,
+                           epochs[i],
+                           epochs[i - 1],
+                           double(missing),
+                           double(settings.minMissingSets)});
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const ManeuverEvent &a, const ManeuverEvent &b) {
+        return a.epoch < b.epoch;
+    });
+    return events;
+}
+
+QVector<ManeuverEvent> ManeuverDetector::scan(const QVector<TleRecord> &records,
+                                              const ManeuverSettings &settings)
+{
+    //! Порядок записей по объекту и эпохе
+    QVector<qint64> epochs(records.size());
+    for (int i = 0; i < records.size(); ++i)
+        epochs[i] = TleUtils::epochToUnixMicros(records[i]);
+    QVector<int> order(records.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        if (records[a].catalogNumber != records[b].catalogNumber)
+            return records[a].catalogNumber < records[b].catalogNumber;
+        return epochs[a] < epochs[b];
+    });
+
+    //! Истории объектов; из наборов с одинаковой эпохой остаётся последний
+    QVector<Job> jobs;
+    for (int k = 0; k < order.size();) {
+        const int catalogNumber = records[order[k]].catalogNumber;
+        ElementSetSeries series;
+        series.catalogNumber = catalogNumber;
+        for (; k < order.size() && records[order[k]].catalogNumber == catalogNumber; ++k) {
+            const int index = order[k];
+            if (k + 1 < order.size() && records[order[k + 1]].catalogNumber == catalogNumber
+                && epochs[order[k + 1]] == epochs[index])
+                continue;
+            series.append(records[index]);
+        }
+        if (jobs.isEmpty() || jobs.last().series.size() >= objectsPerJob)
+            jobs.append(Job());
+        jobs.last().series.append(series);
+    }
+
+    QtConcurrent::blockingMap(jobs, [&settings](Job &job) {
+        for (const ElementSetSeries &series : job.series)
+            job.events += scanSeries(series, settings);
+        job.series.clear(); //! Истории больше не нужны
+    });
+    return collect(jobs);
+}
+
+QVector<ManeuverEvent> ManeuverDetector::scan(const TleHistoryStore &store,
+                                              const ManeuverSettings &settings)
+{
+    const QVector<int> numbers = store.catalogNumbers();
+    QVector<Job> jobs;
+    for (int k = 0; k < numbers.size(); k += objectsPerJob)
+        jobs.append({{}, numbers.mid(k, objectsPerJob), {}});
+
+    QtConcurrent::blockingMap(jobs, [&store, &settings](Job &job) {
+        ElementSetSeries series; //! Одна история на поток: память не зависит от размера архива
+        for (int catalogNumber : job.catalogNumbers) {
+            if (store.series(catalogNumber, series))
+                job.events += scanSeries(series, settings);
+        }
+    });
+    return collect(jobs);
+}
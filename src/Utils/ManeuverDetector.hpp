@@ -0,0 +1,124 @@
+/*!
+ * \file ManeuverDetector.hpp
+ * \brief Заголовочный файл для поиска манёвров и аномалий в истории наборов элементов
+ * \details
+ * Этот файл содержит определение класса ManeuverDetector и структур с настройками
+ * и найденными событиями: скачками среднего движения и наклонения, сменой уровня B*
+ * и пропусками номеров наборов элементов.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef MANEUVERDETECTOR_HPP
+#define MANEUVERDETECTOR_HPP
+
+#include <QString>
+#include <QVector>
+
+#include "TleHistoryStore.hpp"
+#include "TleRecord.hpp"
+
+/*!
+ * \brief ManeuverType - тип события
+ */
+enum class ManeuverType : quint8 {
+    MeanMotionJump,  //! Скачок среднего движения, не объяснимый торможением
+    InclinationJump, //! Скачок наклонения
+    BstarChange,     //! Смена уровня B*
+    ElementSetGap    //! Пропуск номеров наборов элементов
+};
+
+/*!
+ * \brief ManeuverSettings - пороги поиска
+ * \details
+ * Для скачков порог вычисляется по каждому объекту: sigma робастных СКО
+ * (1.4826 · медиана абсолютных отклонений) его собственных невязок,
+ * но не меньше абсолютного минимума — так шум старых и плохо наблюдаемых
+ * объектов не даёт ложных срабатываний, а у точных объектов видны малые манёвры.
+ * Одиночные пропуски номеров наборов обычны (номер растёт и на внутренних
+ * пересчётах, которые не публикуются), поэтому пропуск считается событием
+ * начиная с трёх подряд.
+ */
+struct ManeuverSettings
+{
+    double sigma = 8.0;               //! Порог в робастных СКО
+    double minMeanMotionJump = 2e-4;  //! Наименьший скачок среднего движения (об/сут)
+    double minInclinationJump = 0.01; //! Наименьший скачок наклонения (градусы)
+    double maxIntervalDays = 10.0;    //! Пары наборов с большим интервалом не сравниваются
+    double bstarRatio = 5.0;          //! Во сколько раз должен измениться уровень B*
+    int bstarWindow = 8;              //! Наборов для оценки уровня B* до и после события
+    int minMissingSets = 3;           //! Сколько номеров наборов должно быть пропущено
+};
+
+/*!
+ * \brief ManeuverEvent - найденное событие
+ */
+struct ManeuverEvent
+{
+    int catalogNumber;    //! Номер объекта
+    ManeuverType type;    //! Тип события
+    qint64 epoch;         //! Эпоха набора, на котором обнаружено событие (мкс Unix)
+    qint64 previousEpoch; //! Эпоха предыдущего набора (мкс Unix)
+    double value;         //! Величина: невязка (об/сут, градусы), отношение уровней B* или число пропусков
+    double threshold;     //! Превышенный порог в тех же единицах
+};
+
+/*!
+ * \brief Класс ManeuverDetector
+ * \details
+ * История каждого объекта просматривается одним проходом по наборам,
+ * упорядоченным по эпохе:
+ * - среднее движение сравнивается с прогнозом по предыдущему набору
+ *   n + 2·(ṅ/2)·Δt, то есть с учётом торможения, заложенного в сам набор;
+ * - наклонение сравнивается с предыдущим набором;
+ * - уровень B* — медиана окна до события и окна после него, поэтому одиночный
+ *   выброс не считается сменой;
+ * - номера наборов должны идти подряд (с учётом перехода 999 → 1).
+ *
+ * Объекты обрабатываются параллельно и независимо; события каждого объекта
+ * упорядочены по эпохе, объекты — по номеру.
+ */
+class ManeuverDetector
+{
+public:
+    /*!
+     * \brief typeName - название типа события
+     */
+    static QString typeName(ManeuverType type);
+
+    /*!
+     * \brief requiredFields - поля записей, которые читает поиск (TleParser::setFields)
+     */
+    static TleFields requiredFields();
+
+    /*!
+     * \brief scanSeries - поиск событий в истории одного объекта
+     * \param series История, упорядоченная по эпохе
+     * \param settings Пороги
+     * \return События в порядке эпох
+     */
+    static QVector<ManeuverEvent> scanSeries(const ElementSetSeries &series,
+                                             const ManeuverSettings &settings = {});
+
+    /*!
+     * \brief scan - поиск событий по загруженным записям
+     * \param records Записи (объекты и порядок произвольные; повторы эпох отбрасываются)
+     * \param settings Пороги
+     * \return События, упорядоченные по номеру объекта и эпохе
+     */
+    static QVector<ManeuverEvent> scan(const QVector<TleRecord> &records,
+                                       const ManeuverSettings &settings = {});
+
+    /*!
+     * \brief scan - поиск событий по всему хранилищу истории
+     * \param store Хранилище
+     * \param settings Пороги
+     * \return События, упорядоченные по номеру объекта и эпохе
+     * \details Объекты распаковываются по одному в каждом потоке,
+     * поэтому память не зависит от размера архива.
+     */
+    static QVector<ManeuverEvent> scan(const TleHistoryStore &store,
+                                       const ManeuverSettings &settings = {});
+};
+
+#endif // MANEUVERDETECTOR_HPP
@@ -0,0 +1,110 @@
+/*!
+ * \file MapPropagator.cpp
+ * \brief Реализация прогноза подспутниковых точек всего каталога
+ * \details
+ * Этот файл содержит реализацию методов класса MapPropagator.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "MapPropagator.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "EarthFrames.hpp"
+#include "TleUtils.hpp"
+
+namespace {
+
+/*!
+ * \brief subpoint - подспутниковая точка по положению объекта
+ * \param state Положение и скорость (TEME)
+ * \param time Момент (секунды Unix, UTC)
+ */
+QPointF subpoint(const StateVector &state, double time)
+{
+    double ecef[3];
+    EarthFrames::temeToEcef(state.position, EarthFrames::temeRotation(time), ecef);
+    double latitude = 0.0, longitude = 0.0, altitude = 0.0;
+    EarthFrames::ecefToGeodetic(ecef, latitude, longitude, altitude);
+    return QPointF(longitude, latitude);
+}
+
+} // namespace
+
+TleFields MapPropagator::requiredFields()
+{
+    return Sgp4::requiredFields();
+}
+
+MapPropagator::MapPropagator(const QVector<TleRecord> &records)
+{
+    const QVector<int> indices = TleUtils::latestEpochIndices(records);
+    QVector<TleRecord> latest; //! Записи объектов с моделью — для кэша трасс
+    this->models_.reserve(indices.size());
+    this->catalogNumbers_.reserve(indices.size());
+    latest.reserve(indices.size());
+    for (int index : indices) {
+        const Sgp4 model(records[index]);
+        if (!model.isValid()) {
+            ++this->unsupported_;
+            continue;
+        }
+        this->models_.append(model);
+        this->catalogNumbers_.append(records[index].catalogNumber);
+        latest.append(records[index]);
+    }
+    this->cache_ = std::make_shared<EphemerisCache>(latest);
+}
+
+void MapPropagator::subpoints(double time, int first, int last, QPointF *out) const
+{
+    //! Поворот Земли один на всю пачку; положения собираются в массивы по координатам
+    //! и переводятся в широту и долготу пакетом
+    const EarthFrames::TemeRotation rotation = EarthFrames::temeRotation(time);
+    constexpr int block = 256;
+    double x[block], y[block], z[block], latitude[block], longitude[block];
+    for (int begin = first; begin < last; begin += block) {
+        const int count = qMin(block, last - begin);
+        for (int k = 0; k < count; ++k) {
+            StateVector state;
+            if (this->models_[begin + k].propagateAt(time, state)) {
+                x[k] = state.position[0];
+                y[k] = state.position[1];
+                z[k] = state.position[2];
+            } else {
+                //! NaN проходит через преобразование и отмечает точку без прогноза
+                x[k] = y[k] = z[k] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+        EarthFrames::temeToGeodetic(rotation, count, x, y, z, latitude, longitude, nullptr);
+        for (int k = 0; k < count; ++k)
+            out[begin + k] = QPointF(longitude[k], latitude[k]);
+    }
+}
+
+QVector<QPointF> MapPropagator::groundTrack(int index, double start, double end, double step) const
+{
+    QVector<QPointF> track;
+    if (index < 0 || index >= this->models_.size() || !(step > 0.0) || end < start)
+        return track;
+    const int count = int(std::floor((end - start) / step)) + 1;
+    QVector<double> times(count);
+    for (int k = 0; k < count; ++k)
+        times[k] = start + k * step;
+
+    //! Отрезки всего интервала строятся параллельно; уже построенные при прошлых
+    //! пересчётах трассы берутся из кэша
+    const int catalogNumber = this->catalogNumbers_[index];
+    this->cache_->prefetch({catalogNumber}, start, times.last());
+    QVector<StateVector> states;
+    QVector<bool> ok;
+    this->cache_->states(catalogNumber, times, states, &ok);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    track.reserve(count);
+    for (int k = 0; k < count; ++k)
+        track.append(ok[k] ? subpoint(states[k], times[k]) : QPointF(nan, nan));
+    return track;
+}
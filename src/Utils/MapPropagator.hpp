@@ -0,0 +1,91 @@
+/*!
+ * \file MapPropagator.hpp
+ * \brief Заголовочный файл для прогноза подспутниковых точек всего каталога
+ * \details
+ * Этот файл содержит определение класса MapPropagator, который готовит модели SGP4
+ * объектов каталога один раз и затем пачками считает их подспутниковые точки
+ * для карты и трассу выбранного объекта (по кэшу эфемерид).
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef MAPPROPAGATOR_HPP
+#define MAPPROPAGATOR_HPP
+
+#include <QPointF>
+#include <QVector>
+
+#include <memory>
+
+#include "EphemerisCache.hpp"
+#include "Sgp4.hpp"
+#include "TleRecord.hpp"
+
+/*!
+ * \brief Класс MapPropagator
+ * \details
+ * Подспутниковая точка — QPointF(долгота, широта) в градусах (широта геодезическая,
+ * WGS-84); если прогноз на момент невозможен (объект сошёл с орбиты), обе координаты — NaN.
+ * Методы только читают модели, поэтому разные части каталога можно считать
+ * в разных потоках одновременно.
+ *
+ * Трасса пересчитывается при каждом сдвиге карты на четверть витка и почти целиком
+ * повторяет предыдущую, поэтому она берётся из EphemerisCache: отрезки полиномов
+ * строятся один раз и служат следующим пересчётам. Копии объекта разделяют один кэш.
+ */
+class MapPropagator
+{
+public:
+    /*!
+     * \brief requiredFields - поля записей, которые читает прогноз (TleParser::setFields)
+     */
+    static TleFields requiredFields();
+
+    MapPropagator() = default;
+
+    /*!
+     * \brief MapPropagator - модели для каталога
+     * \param records Записи (при повторах объекта используется самая поздняя эпоха)
+     * \details Объекты, которые SGP4 не поддерживает (SDP4, ошибки элементов), пропускаются.
+     */
+    explicit MapPropagator(const QVector<TleRecord> &records);
+
+    //! Число объектов с моделью
+    int size() const { return int(this->models_.size()); }
+
+    //! Число объектов без модели
+    int unsupported() const { return this->unsupported_; }
+
+    //! Номер объекта по индексу модели
+    int catalogNumber(int index) const { return this->catalogNumbers_[index]; }
+
+    //! Период обращения объекта (минуты)
+    double period(int index) const { return this->models_[index].period(); }
+
+    /*!
+     * \brief subpoints - подспутниковые точки части каталога на один момент
+     * \param time Момент (секунды Unix, UTC)
+     * \param first Первый индекс
+     * \param last Индекс за последним
+     * \param out Выход: точки для индексов [first, last) по адресам out[first]...
+     */
+    void subpoints(double time, int first, int last, QPointF *out) const;
+
+    /*!
+     * \brief groundTrack - трасса объекта
+     * \param index Индекс объекта
+     * \param start Начало (секунды Unix, UTC)
+     * \param end Конец (секунды Unix, UTC)
+     * \param step Шаг (секунды)
+     * \return Точки трассы (NaN там, где прогноз невозможен)
+     */
+    QVector<QPointF> groundTrack(int index, double start, double end, double step) const;
+
+private:
+    QVector<Sgp4> models_;                  //! Модели объектов
+    QVector<int> catalogNumbers_;           //! Номера объектов
+    std::shared_ptr<EphemerisCache> cache_; //! Кэш эфемерид для трасс (общий для копий)
+    int unsupported_ = 0;                   //! Объектов без модели
+};
+
+#endif // MAPPROPAGATOR_HPP
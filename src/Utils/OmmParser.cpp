@@ -0,0 +1,629 @@
+/*!
+ * \file OmmParser.cpp
+ * \brief Парсер сообщений OMM
+ * \details
+ * Этот файл содержит реализацию класса OmmParser,
+ * который используется для разбора CCSDS OMM в форматах JSON, CSV и XML.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "OmmParser.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <string_view>
+
+#include <QXmlStreamReader>
+
+#include "TleWriter.hpp"
+
+namespace {
+
+/*!
+ * \brief OmmField - поля OMM, которые переносятся в TleRecord
+ */
+enum class OmmField {
+    Unknown,
+    ObjectName,
+    ObjectId,
+    Epoch,
+    MeanMotion,
+    Eccentricity,
+    Inclination,
+    RaOfAscNode,
+    ArgOfPericenter,
+    MeanAnomaly,
+    EphemerisType,
+    ClassificationType,
+    NoradCatId,
+    ElementSetNo,
+    RevAtEpoch,
+    Bstar,
+    MeanMotionDot,
+    MeanMotionDdot
+};
+
+//! Флаги обязательных полей записи
+enum RequiredField : unsigned {
+    HasCatalogNumber = 1u << 0,
+    HasEpoch = 1u << 1,
+    HasMeanMotion = 1u << 2,
+    HasAllRequired = HasCatalogNumber | HasEpoch | HasMeanMotion
+};
+
+/*!
+ * \brief fieldFromKey - сопоставляет имя поля OMM с OmmField
+ * \param key Имя поля (например, "MEAN_MOTION")
+ */
+OmmField fieldFromKey(std::string_view key)
+{
+    struct Entry
+    {
+        std::string_view key;
+        OmmField field;
+    };
+    static constexpr Entry table[] = {
+        {"OBJECT_NAME", OmmField::ObjectName},
+        {"OBJECT_ID", OmmField::ObjectId},
+        {"EPOCH", OmmField::Epoch},
+        {"MEAN_MOTION", OmmField::MeanMotion},
+        {"ECCENTRICITY", OmmField::Eccentricity},
+        {"INCLINATION", OmmField::Inclination},
+        {"RA_OF_ASC_NODE", OmmField::RaOfAscNode},
+        {"ARG_OF_PERICENTER", OmmField::ArgOfPericenter},
+        {"MEAN_ANOMALY", OmmField::MeanAnomaly},
+        {"EPHEMERIS_TYPE", OmmField::EphemerisType},
+        {"CLASSIFICATION_TYPE", OmmField::ClassificationType},
+        {"NORAD_CAT_ID", OmmField::NoradCatId},
+        {"ELEMENT_SET_NO", OmmField::ElementSetNo},
+        {"REV_AT_EPOCH", OmmField::RevAtEpoch},
+        {"BSTAR", OmmField::Bstar},
+        {"MEAN_MOTION_DOT", OmmField::MeanMotionDot},
+        {"MEAN_MOTION_DDOT", OmmField::MeanMotionDdot},
+    };
+    for (const Entry &entry : table)
+        if (entry.key == key)
+            return entry.field;
+    return OmmField::Unknown;
+}
+
+/*!
+ * \brief trimmed - убирает пробелы и знак '+' в начале и пробелы в конце
+ */
+std::string_view trimmedNumber(std::string_view s)
+{
+    while (!s.empty() && (s.front() == ' ' || s.front() == '+'))
+        s.remove_prefix(1);
+    while (!s.empty() && s.back() == ' ')
+        s.remove_suffix(1);
+    return s;
+}
+
+//! Разбор вещественного числа без выделения памяти
+double toDouble(std::string_view s)
+{
+    s = trimmedNumber(s);
+    double value = 0.0;
+    std::from_chars(s.data(), s.data() + s.size(), value);
+    return value;
+}
+
+//! Разбор целого числа без выделения памяти
+int toInt(std::string_view s)
+{
+    s = trimmedNumber(s);
+    int value = 0;
+    std::from_chars(s.data(), s.data() + s.size(), value);
+    return value;
+}
+
+/*!
+ * \brief parseEpoch - переводит эпоху OMM (ISO 8601) в представление TLE
+ * \param s Строка вида "2025-06-11T08:52:30.000000"
+ * \param rec Запись, в которую записываются epochYearSuffix и epochTime
+ * \return true, если эпоха разобрана
+ */
+bool parseEpoch(std::string_view s, TleRecord &rec)
+{
+    if (s.size() < 19 || s[4] != '-' || s[7] != '-')
+        return false;
+    static const int daysBeforeMonth[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+    const int year = toInt(s.substr(0, 4));
+    const int month = toInt(s.substr(5, 2));
+    const int day = toInt(s.substr(8, 2));
+    const int hours = toInt(s.substr(11, 2));
+    const int minutes = toInt(s.substr(14, 2));
+    const double seconds = toDouble(s.substr(17)); //! Разбор останавливается на 'Z'
+    if (month < 1 || month > 12)
+        return false;
+
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    const int dayOfYear = daysBeforeMonth[month - 1] + day + (leap && month > 2 ? 1 : 0);
+
+    rec.epochYearSuffix = year % 100;
+    rec.epochTime = dayOfYear + (hours * 3600 + minutes * 60 + seconds) / 86400.0;
+    return true;
+}
+
+/*!
+ * \brief parseObjectId - разбирает международное обозначение вида "1998-067A"
+ */
+void parseObjectId(std::string_view s, TleRecord &rec, TleStringArena &arena)
+{
+    if (s.size() < 9 || s[4] != '-')
+        return;
+    rec.yearLaunch = toInt(s.substr(2, 2));
+    rec.numberLaunch = toInt(s.substr(5, 3));
+    rec.launchPiece = arena.intern(TleText(s.data() + 8, int(s.size() - 8)).trimmed());
+}
+
+/*!
+ * \brief applyField - переносит значение поля OMM в запись TLE
+ * \param rec Заполняемая запись
+ * \param field Поле OMM
+ * \param value Значение поля (без кавычек и escape-последовательностей)
+ * \param mask Маска найденных обязательных полей
+ * \param arena Арена строк (класс, часть запуска и B* повторяются и интернируются)
+ */
+void applyField(TleRecord &rec,
+                OmmField field,
+                std::string_view value,
+                unsigned &mask,
+                TleStringArena &arena)
+{
+    switch (field) {
+    case OmmField::ObjectName:
+        rec.name = arena.append(value.data(), int(value.size()));
+        break;
+    case OmmField::ObjectId:
+        parseObjectId(value, rec, arena);
+        break;
+    case OmmField::Epoch:
+        if (parseEpoch(value, rec))
+            mask |= HasEpoch;
+        break;
+    case OmmField::MeanMotion:
+        rec.meanMotion = toDouble(value);
+        mask |= HasMeanMotion;
+        break;
+    case OmmField::Eccentricity:
+        rec.eccentricity = toDouble(value);
+        break;
+    case OmmField::Inclination:
+        rec.inclination = toDouble(value);
+        break;
+    case OmmField::RaOfAscNode:
+        rec.rightAscension = toDouble(value);
+        break;
+    case OmmField::ArgOfPericenter:
+        rec.argPerigee = toDouble(value);
+        break;
+    case OmmField::MeanAnomaly:
+        rec.meanAnomaly = toDouble(value);
+        break;
+    case OmmField::EphemerisType:
+        rec.ephemerisType = toInt(value);
+        break;
+    case OmmField::ClassificationType:
+        rec.classification = arena.intern(value.data(), int(value.size()));
+        break;
+    case OmmField::NoradCatId:
+        rec.catalogNumber = toInt(value);
+        mask |= HasCatalogNumber;
+        break;
+    case OmmField::ElementSetNo:
+        rec.elementSetNumber = toInt(value);
+        break;
+    case OmmField::RevAtEpoch:
+        rec.revolutionNumberOfEpoch = toInt(value);
+        break;
+    case OmmField::Bstar:
+        rec.brakingCoefficient = arena.intern(OmmParser::toTleExponent(toDouble(value)));
+        break;
+    case OmmField::MeanMotionDot:
+        rec.meanMotionFirstDerivative = toDouble(value);
+        break;
+    case OmmField::MeanMotionDdot:
+        rec.meanMotionSecondDerivative = toDouble(value);
+        break;
+    case OmmField::Unknown:
+        break;
+    }
+}
+
+/*!
+ * \brief unescapeJson - раскрывает escape-последовательности строки JSON
+ * \details Используется только для строк, содержащих '\\', что на практике редкость.
+ */
+QByteArray unescapeJson(std::string_view s)
+{
+    QByteArray out;
+    out.reserve(int(s.size()));
+    for (size_t i = 0; i < s.size(); ++i) {
+        char c = s[i];
+        if (c != '\\' || i + 1 >= s.size()) {
+            out.append(c);
+            continue;
+        }
+        c = s[++i];
+        switch (c) {
+        case 'b':
+            out.append('\b');
+            break;
+        case 'f':
+            out.append('\f');
+            break;
+        case 'n':
+            out.append('\n');
+            break;
+        case 'r':
+            out.append('\r');
+            break;
+        case 't':
+            out.append('\t');
+            break;
+        case 'u':
+            if (i + 4 < s.size()) {
+                unsigned code = 0;
+                std::from_chars(s.data() + i + 1, s.data() + i + 5, code, 16);
+                out.append(QString(QChar(ushort(code))).toUtf8());
+                i += 4;
+            }
+            break;
+        default: //! '"', '\\', '/'
+            out.append(c);
+            break;
+        }
+    }
+    return out;
+}
+
+/*!
+ * \brief JsonScanner - однопроходный сканер JSON поверх исходного буфера
+ * \details
+ * Не строит дерево документа: строки и числа возвращаются как
+ * представления (string_view) исходного буфера.
+ */
+class JsonScanner
+{
+public:
+    JsonScanner(const char *begin, const char *end)
+        : p_(begin)
+        , end_(end)
+    {
+        //! Пропускаем BOM UTF-8
+        if (end_ - p_ >= 3 && p_[0] == '\xEF' && p_[1] == '\xBB' && p_[2] == '\xBF')
+            p_ += 3;
+    }
+
+    //! Пропускает пробельные символы и, если следующий символ равен c, поглощает его
+    bool consume(char c)
+    {
+        this->skipWhitespace();
+        if (p_ < end_ && *p_ == c) {
+            ++p_;
+            return true;
+        }
+        return false;
+    }
+
+    //! Читает строку в кавычках; escaped выставляется, если в ней есть '\\'
+    bool readString(std::string_view &out, bool &escaped)
+    {
+        escaped = false;
+        if (!this->consume('"'))
+            return false;
+        const char *start = p_;
+        while (p_ < end_) {
+            const char c = *p_;
+            if (c == '\\') {
+                escaped = true;
+                if (end_ - p_ < 2)
+                    return false;
+                p_ += 2;
+                continue;
+            }
+            if (c == '"') {
+                out = std::string_view(start, size_t(p_ - start));
+                ++p_;
+                return true;
+            }
+            ++p_;
+        }
+        return false;
+    }
+
+    //! Читает значение; вложенные объекты и массивы пропускаются
+    bool readValue(std::string_view &out, bool &isString, bool &escaped)
+    {
+        this->skipWhitespace();
+        if (p_ >= end_)
+            return false;
+        if (*p_ == '"') {
+            isString = true;
+            return this->readString(out, escaped);
+        }
+        isString = false;
+        escaped = false;
+        if (*p_ == '{' || *p_ == '[') {
+            out = std::string_view();
+            return this->skipCompound();
+        }
+        const char *start = p_;
+        while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']' && !isSpace(*p_))
+            ++p_;
+        out = std::string_view(start, size_t(p_ - start));
+        return p_ > start;
+    }
+
+private:
+    static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+    void skipWhitespace()
+    {
+        while (p_ < end_ && isSpace(*p_))
+            ++p_;
+    }
+
+    //! Пропускает вложенный объект или массив с учётом строк
+    bool skipCompound()
+    {
+        int depth = 0;
+        while (p_ < end_) {
+            const char c = *p_;
+            if (c == '"') {
+                std::string_view unused;
+                bool escaped;
+                if (!this->readString(unused, escaped))
+                    return false;
+                continue;
+            }
+            ++p_;
+            if (c == '{' || c == '[')
+                ++depth;
+            else if ((c == '}' || c == ']') && --depth == 0)
+                return true;
+        }
+        return false;
+    }
+
+    const char *p_;   //! Текущая позиция
+    const char *end_; //! Конец буфера
+};
+
+/*!
+ * \brief readCsvField - читает одно поле CSV
+ * \param p Текущая позиция (сдвигается за поле и разделитель)
+ * \param end Конец буфера
+ * \param out Значение поля
+ * \param scratch Буфер для полей с удвоенными кавычками
+ * \return true, если поле последнее в строке
+ */
+bool readCsvField(const char *&p, const char *end, std::string_view &out, QByteArray &scratch)
+{
+    if (p < end && *p == '"') {
+        const char *start = ++p;
+        bool doubled = false;
+        while (p < end) {
+            if (*p == '"') {
+                if (p + 1 < end && p[1] == '"') {
+                    doubled = true;
+                    p += 2;
+                    continue;
+                }
+                break;
+            }
+            ++p;
+        }
+        out = std::string_view(start, size_t(p - start));
+        if (p < end)
+            ++p; //! Закрывающая кавычка
+        if (doubled) {
+            scratch = QByteArray(out.data(), int(out.size())).replace("\"\"", "\"");
+            out = std::string_view(scratch.constData(), size_t(scratch.size()));
+        }
+    } else {
+        const char *start = p;
+        while (p < end && *p != ',' && *p != '\n' && *p != '\r')
+            ++p;
+        out = std::string_view(start, size_t(p - start));
+    }
+    if (p < end && *p == ',') {
+        ++p;
+        return false;
+    }
+    //! Конец строки: пропускаем перевод строки (и пустые строки)
+    while (p < end && (*p == '\r' || *p == '\n'))
+        ++p;
+    return true;
+}
+
+//! Грубая оценка размера одной записи OMM в байтах (для резервирования памяти)
+constexpr int approxRecordBytes = 512;
+
+} // namespace
+
+TleFormat OmmParser::detectFormat(const QByteArray &data, const QString &hint)
+{
+    //! Подсказка: расширение файла или MIME-тип
+    const QString lowerHint = hint.toLower();
+    if (lowerHint.contains(QLatin1String("json")))
+        return TleFormat::OmmJson;
+    if (lowerHint.contains(QLatin1String("csv")))
+        return TleFormat::OmmCsv;
+    if (lowerHint.contains(QLatin1String("xml")))
+        return TleFormat::OmmXml;
+
+    //! Определяем формат по первому значимому символу
+    int i = data.startsWith("\xEF\xBB\xBF") ? 3 : 0;
+    while (i < data.size() && (data[i] == ' ' || data[i] == '\t' || data[i] == '\r' || data[i] == '\n'))
+        ++i;
+    if (i >= data.size())
+        return TleFormat::Tle;
+    if (data[i] == '[' || data[i] == '{')
+        return TleFormat::OmmJson;
+    if (data[i] == '<')
+        return TleFormat::OmmXml;
+
+    //! CSV: первая строка — заголовок с именами полей OMM
+    const int eol = data.indexOf('\n', i);
+    const QByteArray header = data.mid(i, eol < 0 ? -1 : eol - i);
+    if (header.contains(',') && (header.contains("NORAD_CAT_ID") || header.contains("OBJECT_NAME")))
+        return TleFormat::OmmCsv;
+    return TleFormat::Tle;
+}
+
+bool OmmParser::parse(const QByteArray &data, TleFormat format, QVector<TleRecord> &outRecords) const
+{
+    switch (format) {
+    case TleFormat::OmmJson:
+        return this->parseJson(data, outRecords);
+    case TleFormat::OmmCsv:
+        return this->parseCsv(data, outRecords);
+    case TleFormat::OmmXml:
+        return this->parseXml(data, outRecords);
+    case TleFormat::Tle:
+        break;
+    }
+    return false;
+}
+
+bool OmmParser::parseJson(const QByteArray &data, QVector<TleRecord> &outRecords) const
+{
+    const auto before = outRecords.size(); //! Количество записей до разбора
+    outRecords.reserve(before + data.size() / approxRecordBytes);
+
+    const auto arena = std::make_shared<TleStringArena>(); //! Строки всех записей документа
+    JsonScanner scanner(data.constData(), data.constData() + data.size());
+    const bool isArray = scanner.consume('['); //! Массив объектов или один объект
+    do {
+        if (!scanner.consume('{'))
+            break;
+        TleRecord rec{};   //! Запись с обнулёнными полями
+        rec.strings = arena;
+        unsigned mask = 0; //! Найденные обязательные поля
+        if (!scanner.consume('}')) {
+            do {
+                std::string_view key, value;
+                bool keyEscaped, isString, valueEscaped;
+                if (!scanner.readString(key, keyEscaped) || !scanner.consume(':')
+                    || !scanner.readValue(value, isString, valueEscaped))
+                    return outRecords.size() > before; //! Повреждённые данные: оставляем разобранное
+
+                QByteArray unescapedKey;
+                if (keyEscaped) {
+                    unescapedKey = unescapeJson(key);
+                    key = std::string_view(unescapedKey.constData(), size_t(unescapedKey.size()));
+                }
+                const OmmField field = fieldFromKey(key);
+                if (field == OmmField::Unknown || (!isString && value == "null"))
+                    continue;
+                if (valueEscaped) {
+                    const QByteArray unescaped = unescapeJson(value);
+                    applyField(rec,
+                               field,
+                               std::string_view(unescaped.constData(), size_t(unescaped.size())),
+                               mask,
+                               *arena);
+                } else
+                    applyField(rec, field, value, mask, *arena);
+            } while (scanner.consume(','));
+            if (!scanner.consume('}'))
+                return outRecords.size() > before;
+        }
+        if ((mask & HasAllRequired) == HasAllRequired)
+            outRecords.append(std::move(rec));
+    } while (isArray && scanner.consume(','));
+    return outRecords.size() > before;
+}
+
+bool OmmParser::parseCsv(const QByteArray &data, QVector<TleRecord> &outRecords) const
+{
+    const auto before = outRecords.size(); //! Количество записей до разбора
+    outRecords.reserve(before + data.size() / (approxRecordBytes / 2));
+
+    const char *p = data.constData();
+    const char *end = p + data.size();
+    if (data.startsWith("\xEF\xBB\xBF"))
+        p += 3;
+
+    QByteArray scratch;        //! Буфер для полей с удвоенными кавычками
+    std::string_view value;    //! Текущее поле
+    QVector<OmmField> columns; //! Поля OMM по номерам столбцов
+
+    //! Заголовок
+    bool lastField = false;
+    while (p < end && !lastField) {
+        lastField = readCsvField(p, end, value, scratch);
+        columns.append(fieldFromKey(trimmedNumber(value)));
+    }
+
+    //! Строки данных
+    const auto arena = std::make_shared<TleStringArena>(); //! Строки всех записей документа
+    while (p < end) {
+        TleRecord rec{};
+        rec.strings = arena;
+        unsigned mask = 0;
+        int column = 0;
+        lastField = false;
+        while (p < end && !lastField) {
+            lastField = readCsvField(p, end, value, scratch);
+            if (column < columns.size() && !value.empty())
+                applyField(rec, columns[column], value, mask, *arena);
+            ++column;
+        }
+        if ((mask & HasAllRequired) == HasAllRequired)
+            outRecords.append(std::move(rec));
+    }
+    return outRecords.size() > before;
+}
+
+bool OmmParser::parseXml(const QByteArray &data, QVector<TleRecord> &outRecords) const
+{
+    const auto before = outRecords.size(); //! Количество записей до разбора
+    QXmlStreamReader xml(data);           //! Потоковый разбор без построения DOM
+    const auto arena = std::make_shared<TleStringArena>(); //! Строки всех записей документа
+
+    TleRecord rec{};   //! Текущая запись
+    unsigned mask = 0; //! Найденные обязательные поля
+    bool inOmm = false; //! Находимся ли внутри элемента <omm>
+    while (!xml.atEnd()) {
+        const QXmlStreamReader::TokenType token = xml.readNext();
+        if (token == QXmlStreamReader::StartElement) {
+            if (xml.name() == QLatin1String("omm")) {
+                rec = TleRecord{};
+                rec.strings = arena;
+                mask = 0;
+                inOmm = true;
+                continue;
+            }
+            if (!inOmm)
+                continue;
+            const QByteArray key = xml.name().toLatin1();
+            const OmmField field = fieldFromKey(std::string_view(key.constData(), size_t(key.size())));
+            if (field == OmmField::Unknown)
+                continue;
+            const QByteArray text = xml.readElementText().toUtf8();
+            applyField(rec,
+                       field,
+                       std::string_view(text.constData(), size_t(text.size())),
+                       mask,
+                       *arena);
+        } else if (token == QXmlStreamReader::EndElement && xml.name() == QLatin1String("omm")) {
+            inOmm = false;
+            if ((mask & HasAllRequired) == HasAllRequired)
+                outRecords.append(rec);
+        }
+    }
+    return outRecords.size() > before;
+}
+
+QString OmmParser::toTleExponent(double value)
+{
+    char field[8]; //! Поле TLE с ведущим пробелом для положительных значений
+    TleWriter::formatExponent(value, field);
+    return QString::fromLatin1(field, 8).trimmed();
+}
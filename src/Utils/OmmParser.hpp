@@ -0,0 +1,94 @@
+/*!
+ * \file OmmParser.hpp
+ * \brief Заголовочный файл для класса OmmParser.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \details
+ * Этот файл содержит определение класса OmmParser, который предназначен для
+ * разбора данных в формате CCSDS OMM (Orbit Mean-Elements Message)
+ * в представлениях JSON, CSV и XML.
+ */
+#ifndef OMMPARSER_HPP
+#define OMMPARSER_HPP
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include "TleRecord.hpp"
+
+/*!
+ * \brief TleFormat - формат входных данных
+ */
+enum class TleFormat {
+    Tle,     //! Классический 2LE/3LE
+    OmmJson, //! OMM в формате JSON (массив объектов)
+    OmmCsv,  //! OMM в формате CSV (первая строка — заголовок)
+    OmmXml   //! OMM в формате XML (ndm/omm)
+};
+
+/*!
+ * \brief Класс OmmParser
+ * \details
+ * Разбирает OMM-сообщения и заполняет те же структуры TleRecord,
+ * что и разбор 2LE/3LE. Разбор JSON и CSV выполняется за один проход
+ * по исходному буферу без построения промежуточного дерева документа:
+ * память выделяется только под имя объекта и короткие строковые поля.
+ * XML разбирается потоково через QXmlStreamReader.
+ */
+class OmmParser
+{
+public:
+    /*!
+     * \brief detectFormat - определяет формат входных данных
+     * \param data Исходные данные
+     * \param hint Подсказка: расширение файла или MIME-тип (может быть пустой)
+     * \return Определённый формат данных
+     * \details
+     * Сначала используется подсказка (расширение или Content-Type),
+     * затем — первый значимый символ данных.
+     */
+    static TleFormat detectFormat(const QByteArray &data, const QString &hint = QString());
+
+    /*!
+     * \brief parse - разбирает данные в указанном OMM-формате
+     * \param data Исходные данные
+     * \param format Формат данных (OmmJson, OmmCsv или OmmXml)
+     * \param outRecords Вектор, в конец которого добавляются разобранные записи
+     * \return true, если была разобрана хотя бы одна запись
+     */
+    bool parse(const QByteArray &data, TleFormat format, QVector<TleRecord> &outRecords) const;
+
+    /*!
+     * \brief parseJson - разбор OMM в формате JSON
+     * \param data Исходные данные (массив объектов или один объект)
+     * \param outRecords Вектор для добавления записей
+     * \return true, если была разобрана хотя бы одна запись
+     */
+    bool parseJson(const QByteArray &data, QVector<TleRecord> &outRecords) const;
+
+    /*!
+     * \brief parseCsv - разбор OMM в формате CSV
+     * \param data Исходные данные (первая строка — имена полей)
+     * \param outRecords Вектор для добавления записей
+     * \return true, если была разобрана хотя бы одна запись
+     */
+    bool parseCsv(const QByteArray &data, QVector<TleRecord> &outRecords) const;
+
+    /*!
+     * \brief parseXml - разбор OMM в формате XML
+     * \param data Исходные данные (корневой элемент ndm или omm)
+     * \param outRecords Вектор для добавления записей
+     * \return true, если была разобрана хотя бы одна запись
+     */
+    bool parseXml(const QByteArray &data, QVector<TleRecord> &outRecords) const;
+
+    /*!
+     * \brief toTleExponent - переводит число в экспоненциальную запись TLE
+     * \param value Значение (например, B* = -0.00016227)
+     * \return Строка вида "-16227-3" (мантисса с подразумеваемой точкой и порядок)
+     */
+    static QString toTleExponent(double value);
+};
+
+#endif // OMMPARSER_HPP
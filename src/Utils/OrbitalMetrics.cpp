@@ -0,0 +1,137 @@
+/*!
+ * \file OrbitalMetrics.cpp
+ * \brief Производные орбитальные величины
+ * \details
+ * Этот файл содержит реализацию класса OrbitalMetrics.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "OrbitalMetrics.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+/*!
+ * \brief fastCbrt - кубический корень без вызова std::cbrt
+ * \details
+ * std::cbrt не векторизуется компиляторами, поэтому начальное приближение
+ * берётся из битового представления float, а затем уточняется
+ * четырьмя итерациями Ньютона до полной точности double.
+ */
+inline double fastCbrt(double q)
+{
+    float f = float(q);
+    std::uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    bits = bits / 3 + 709921077u; //! Деление порядка на 3
+    std::memcpy(&f, &bits, sizeof(bits));
+
+    double a = f;
+    for (int k = 0; k < 4; ++k)
+        a = (2.0 * a + q / (a * a)) * (1.0 / 3.0);
+    return a;
+}
+
+} // namespace
+
+void OrbitalMetrics::computeKernel(const double *meanMotion,
+                                   const double *eccentricity,
+                                   int count,
+                                   double *semiMajorAxis,
+                                   double *apogeeAltitude,
+                                   double *perigeeAltitude,
+                                   double *period)
+{
+    //! a^3 = mu / n^2, n в рад/с: a^3 = mu * (86400 / 2pi)^2 / n^2 (n в об/сут)
+    constexpr double secondsPerRadian = 86400.0 / 6.283185307179586;
+    constexpr double muScaled = earthMu * secondsPerRadian * secondsPerRadian;
+
+    for (int i = 0; i < count; ++i) {
+        const double n = meanMotion[i] > 0.0 ? meanMotion[i] : 1e-9; //! Защита от деления на 0
+        const double e = eccentricity[i];
+        const double a = fastCbrt(muScaled / (n * n));
+        semiMajorAxis[i] = a;
+        apogeeAltitude[i] = a * (1.0 + e) - earthRadius;
+        perigeeAltitude[i] = a * (1.0 - e) - earthRadius;
+        period[i] = 1440.0 / n;
+    }
+}
+
+OrbitRegime OrbitalMetrics::classify(double apogeeAltitude,
+                                     double perigeeAltitude,
+                                     double eccentricity,
+                                     double meanMotion,
+                                     double inclination)
+{
+    if (meanMotion > 0.9 && meanMotion < 1.1 && eccentricity < 0.1)
+        return OrbitRegime::GEO;
+    if (apogeeAltitude < 2000.0)
+        return OrbitRegime::LEO;
+    //! Апогей около GEO при перигее в LEO; наклонение отделяет GTO от орбит типа «Молния»
+    if (perigeeAltitude < 2000.0 && apogeeAltitude > 30000.0 && apogeeAltitude < 50000.0
+        && inclination < 40.0)
+        return OrbitRegime::GTO;
+    if (eccentricity >= 0.25)
+        return OrbitRegime::HEO;
+    if (perigeeAltitude >= 2000.0 && apogeeAltitude < 35286.0)
+        return OrbitRegime::MEO;
+    return OrbitRegime::Other;
+}
+
+QString OrbitalMetrics::regimeName(OrbitRegime regime)
+{
+    switch (regime) {
+    case OrbitRegime::LEO:
+        return QStringLiteral("LEO");
+    case OrbitRegime::MEO:
+        return QStringLiteral("MEO");
+    case OrbitRegime::GEO:
+        return QStringLiteral("GEO");
+    case OrbitRegime::HEO:
+        return QStringLiteral("HEO");
+    case OrbitRegime::GTO:
+        return QStringLiteral("GTO");
+    case OrbitRegime::Other:
+    case OrbitRegime::Count:
+        break;
+    }
+    return QStringLiteral("Other");
+}
+
+DerivedColumns OrbitalMetrics::compute(const QVector<TleRecord> &records)
+{
+    const int count = int(records.size());
+
+    //! Собираем входные столбцы в непрерывные массивы
+    QVector<double> meanMotion(count), eccentricity(count);
+    for (int i = 0; i < count; ++i) {
+        meanMotion[i] = records[i].meanMotion;
+        eccentricity[i] = records[i].eccentricity;
+    }
+
+    DerivedColumns columns;
+    columns.semiMajorAxis.resize(count);
+    columns.apogeeAltitude.resize(count);
+    columns.perigeeAltitude.resize(count);
+    columns.period.resize(count);
+    columns.regime.resize(count);
+
+    computeKernel(meanMotion.constData(),
+                  eccentricity.constData(),
+                  count,
+                  columns.semiMajorAxis.data(),
+                  columns.apogeeAltitude.data(),
+                  columns.perigeeAltitude.data(),
+                  columns.period.data());
+
+    for (int i = 0; i < count; ++i)
+        columns.regime[i] = quint8(classify(columns.apogeeAltitude[i],
+                                            columns.perigeeAltitude[i],
+                                            eccentricity[i],
+                                            meanMotion[i],
+                                            records[i].inclination));
+    return columns;
+}
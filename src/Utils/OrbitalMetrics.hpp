@@ -0,0 +1,109 @@
+/*!
+ * \file OrbitalMetrics.hpp
+ * \brief Заголовочный файл для производных орбитальных величин
+ * \details
+ * Этот файл содержит определение структуры DerivedColumns и класса OrbitalMetrics,
+ * которые вычисляют большую полуось, высоты апогея и перигея, период
+ * и орбитальный режим по среднему движению и эксцентриситету.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef ORBITALMETRICS_HPP
+#define ORBITALMETRICS_HPP
+
+#include <QString>
+#include <QVector>
+
+#include "TleRecord.hpp"
+
+/*!
+ * \brief OrbitRegime - орбитальный режим
+ */
+enum class OrbitRegime : quint8 {
+    LEO,   //! Низкая орбита (апогей ниже 2000 км)
+    MEO,   //! Средняя орбита (между LEO и геостационарной областью)
+    GEO,   //! Геосинхронная область (около 1 оборота в сутки, почти круговая)
+    HEO,   //! Высокоэллиптическая орбита (e >= 0.25)
+    GTO,   //! Геопереходная орбита (перигей в LEO, апогей около GEO)
+    Other, //! Прочие орбиты
+    Count  //! Количество режимов
+};
+
+/*!
+ * \brief DerivedColumns - производные величины в виде столбцов (SoA)
+ * \details Элемент i каждого столбца относится к записи i каталога.
+ */
+struct DerivedColumns
+{
+    QVector<double> semiMajorAxis;   //! Большая полуось (км)
+    QVector<double> apogeeAltitude;  //! Высота апогея над экватором (км)
+    QVector<double> perigeeAltitude; //! Высота перигея над экватором (км)
+    QVector<double> period;          //! Период обращения (мин)
+    QVector<quint8> regime;          //! Орбитальный режим (OrbitRegime)
+
+    //! Количество записей
+    int size() const { return int(this->semiMajorAxis.size()); }
+};
+
+/*!
+ * \brief Класс OrbitalMetrics
+ * \details
+ * Вычисляет производные величины для всего каталога за один проход.
+ * Основное ядро работает над непрерывными массивами и не содержит ветвлений
+ * и вызовов библиотечных функций, поэтому компилятор векторизует его (SIMD).
+ */
+class OrbitalMetrics
+{
+public:
+    //! Гравитационный параметр Земли (км^3/с^2, WGS-72, как в SGP4)
+    static constexpr double earthMu = 398600.8;
+    //! Экваториальный радиус Земли (км, WGS-72)
+    static constexpr double earthRadius = 6378.135;
+
+    /*!
+     * \brief compute - вычисляет производные столбцы для всего каталога
+     * \param records Записи TLE
+     * \return Столбцы производных величин
+     */
+    static DerivedColumns compute(const QVector<TleRecord> &records);
+
+    /*!
+     * \brief computeKernel - пакетное ядро вычисления производных величин
+     * \param meanMotion Среднее движение (об/сут)
+     * \param eccentricity Эксцентриситет
+     * \param count Количество элементов
+     * \param semiMajorAxis Выход: большая полуось (км)
+     * \param apogeeAltitude Выход: высота апогея (км)
+     * \param perigeeAltitude Выход: высота перигея (км)
+     * \param period Выход: период (мин)
+     */
+    static void computeKernel(const double *meanMotion,
+                              const double *eccentricity,
+                              int count,
+                              double *semiMajorAxis,
+                              double *apogeeAltitude,
+                              double *perigeeAltitude,
+                              double *period);
+
+    /*!
+     * \brief classify - определяет орбитальный режим
+     * \param apogeeAltitude Высота апогея (км)
+     * \param perigeeAltitude Высота перигея (км)
+     * \param eccentricity Эксцентриситет
+     * \param meanMotion Среднее движение (об/сут)
+     * \param inclination Наклонение (градусы)
+     */
+    static OrbitRegime classify(double apogeeAltitude,
+                                double perigeeAltitude,
+                                double eccentricity,
+                                double meanMotion,
+                                double inclination);
+
+    /*!
+     * \brief regimeName - краткое название режима ("LEO", "GEO", ...)
+     */
+    static QString regimeName(OrbitRegime regime);
+};
+
+#endif // ORBITALMETRICS_HPP
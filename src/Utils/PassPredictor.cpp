@@ -0,0 +1,437 @@
+/*!
+ * \file PassPredictor.cpp
+ * \brief Реализация прогноза пролётов над наземной станцией
+ * \details
+ * Этот файл содержит реализацию методов класса PassPredictor.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "PassPredictor.hpp"
+
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+
+#include "EarthFrames.hpp"
+#include "TleUtils.hpp"
+
+namespace {
+
+using EarthFrames::deg2rad;
+using EarthFrames::rad2deg;
+
+constexpr int objectsPerJob = 64;                  //! Объектов в одной задаче пула потоков
+constexpr double coneMargin = 1.0 * deg2rad;       //! Запас конуса видимости (сфера вместо эллипсоида)
+constexpr double radiusMargin = 1.01;              //! Запас радиуса апогея (короткопериодические возмущения)
+constexpr double rateMargin = 1.05;                //! Запас наибольшей угловой скорости
+constexpr double goldenRatio = 0.6180339887498949; //! Доля золотого сечения
+constexpr int maxRootIterations = 64;              //! Ограничение итераций поиска корня
+
+/*!
+ * \brief Observer - станция в ECEF и её локальный базис
+ */
+struct Observer
+{
+    double position[3];  //! Положение (км)
+    double up[3];        //! Нормаль к эллипсоиду
+    double east[3];      //! Направление на восток
+    double north[3];     //! Направление на север
+    double radius;       //! Расстояние от центра Земли (км)
+    double minElevation; //! Порог возвышения (радианы)
+};
+
+Observer makeObserver(const GroundStation &station)
+{
+    Observer observer;
+    EarthFrames::geodeticToEcef(station.latitude, station.longitude, station.altitude,
+                                observer.position);
+    const double phi = station.latitude * deg2rad;
+    const double lambda = station.longitude * deg2rad;
+    observer.up[0] = std::cos(phi) * std::cos(lambda);
+    observer.up[1] = std::cos(phi) * std::sin(lambda);
+    observer.up[2] = std::sin(phi);
+    observer.east[0] = -std::sin(lambda);
+    observer.east[1] = std::cos(lambda);
+    observer.east[2] = 0.0;
+    observer.north[0] = -std::sin(phi) * std::cos(lambda);
+    observer.north[1] = -std::sin(phi) * std::sin(lambda);
+    observer.north[2] = std::cos(phi);
+    observer.radius = std::sqrt(observer.position[0] * observer.position[0]
+                                + observer.position[1] * observer.position[1]
+                                + observer.position[2] * observer.position[2]);
+    observer.minElevation = station.minElevation * deg2rad;
+    return observer;
+}
+
+/*!
+ * \brief OrbitBounds - границы, в которых движется объект
+ */
+struct OrbitBounds
+{
+    double apogeeRadius = 0.0;  //! Наибольшее расстояние от центра Земли (км)
+    double perigeeRadius = 0.0; //! Наименьшее расстояние (км)
+    double maxRate = 0.0;       //! Наибольшая угловая скорость относительно станции (рад/с)
+};
+
+OrbitBounds orbitBounds(const TleRecord &record)
+{
+    OrbitBounds bounds;
+    const double n = record.meanMotion * EarthFrames::twoPi / 86400.0; //! рад/с
+    if (n <= 0.0 || record.eccentricity < 0.0 || record.eccentricity >= 1.0)
+        return bounds;
+    const double a = std::cbrt(Sgp4::earthMu / (n * n));
+    const double e = record.eccentricity;
+    bounds.apogeeRadius = a * (1.0 + e) * radiusMargin;
+    bounds.perigeeRadius = a * (1.0 - e);
+    //! Угловая скорость h / r^2 наибольшая в перигее; к ней добавляется вращение Земли
+    const double h = std::sqrt(Sgp4::earthMu * a * (1.0 - e * e));
+    bounds.maxRate = (h / (bounds.perigeeRadius * bounds.perigeeRadius)
+                      + EarthFrames::earthRotationRate)
+                     * rateMargin;
+    return bounds;
+}
+
+/*!
+ * \brief coneRadius - угловой радиус зоны видимости
+ * \param radius Расстояние объекта от центра Земли (км)
+ * \param observer Станция
+ * \return Наибольший угол между направлениями на станцию и на объект, при котором
+ * возвышение не меньше порога; отрицательное значение — объект не виден никогда
+ */
+double coneRadius(double radius, const Observer &observer)
+{
+    const double cosine = observer.radius * std::cos(observer.minElevation) / radius;
+    if (cosine >= 1.0)
+        return -1.0;
+    return std::acos(cosine) - observer.minElevation;
+}
+
+/*!
+ * \brief Sample - положение объекта относительно станции в момент времени
+ */
+struct Sample
+{
+    double time = 0.0;      //! Момент (секунды Unix)
+    double elevation = 0.0; //! Возвышение минус порог (радианы): >= 0 — объект виден
+    double angle = 0.0;     //! Угол между направлениями из центра Земли на станцию и объект
+    double azimuth = 0.0;   //! Азимут (радианы, только по запросу)
+};
+
+/*!
+ * \brief Tracker - вычисление положения объекта относительно станции
+ */
+class Tracker
+{
+public:
+    Tracker(const Sgp4 &model, const Observer &observer)
+        : model_(model)
+        , observer_(observer)
+    {}
+
+    //! Положение в момент time; false — прогноз невозможен (объект сошёл с орбиты)
+    bool sample(double time, Sample &out, bool withAzimuth = false)
+    {
+        ++this->propagations_;
+        StateVector state;
+        if (!this->model_.propagateAt(time, state))
+            return false;
+        double ecef[3];
+        EarthFrames::temeToEcef(state.position, EarthFrames::gmst(time), ecef);
+
+        const Observer &o = this->observer_;
+        const double rho[3] = {ecef[0] - o.position[0],
+                               ecef[1] - o.position[1],
+                               ecef[2] - o.position[2]};
+        const double range = std::sqrt(rho[0] * rho[0] + rho[1] * rho[1] + rho[2] * rho[2]);
+        const double radius = std::sqrt(ecef[0] * ecef[0] + ecef[1] * ecef[1] + ecef[2] * ecef[2]);
+        const double up = dot(rho, o.up);
+        const double cosAngle = dot(ecef, o.position) / (radius * o.radius);
+
+        out.time = time;
+        out.elevation = std::asin(qBound(-1.0, up / range, 1.0)) - o.minElevation;
+        out.angle = std::acos(qBound(-1.0, cosAngle, 1.0));
+        if (withAzimuth) {
+            out.azimuth = std::atan2(dot(rho, o.east), dot(rho, o.north));
+            if (out.azimuth < 0.0)
+                out.azimuth += EarthFrames::twoPi;
+        }
+        return true;
+    }
+
+    //! Возвышение минус порог; если прогноз невозможен — заведомо ниже горизонта
+    double elevation(double time)
+    {
+        Sample s;
+        return this->sample(time, s) ? s.elevation : -EarthFrames::pi;
+    }
+
+    /*!
+     * \brief root - момент пересечения порога возвышения между a и b
+     * \details Regula falsi, чередующаяся с делением пополам (гарантирует сходимость).
+     */
+    double root(double a, double fa, double b, double fb, double tolerance)
+    {
+        for (int i = 0; i < maxRootIterations && b - a > tolerance; ++i) {
+            double t = (i % 2 == 0 && fb != fa) ? (a * fb - b * fa) / (fb - fa) : 0.5 * (a + b);
+            t = qBound(a + 0.25 * tolerance, t, b - 0.25 * tolerance);
+            const double ft = this->elevation(t);
+            if ((ft >= 0.0) == (fa >= 0.0)) {
+                a = t;
+                fa = ft;
+            } else {
+                b = t;
+                fb = ft;
+            }
+        }
+        return 0.5 * (a + b);
+    }
+
+    /*!
+     * \brief maximum - момент наибольшего возвышения на [a, b] (золотое сечение)
+     * \param value Выход: возвышение минус порог в найденный момент
+     */
+    double maximum(double a, double b, double tolerance, double &value)
+    {
+        double x1 = b - goldenRatio * (b - a);
+        double x2 = a + goldenRatio * (b - a);
+        double f1 = this->elevation(x1);
+        double f2 = this->elevation(x2);
+        while (b - a > tolerance) {
+            if (f1 < f2) {
+                a = x1;
+                x1 = x2;
+                f1 = f2;
+                x2 = a + goldenRatio * (b - a);
+                f2 = this->elevation(x2);
+            } else {
+                b = x2;
+                x2 = x1;
+                f2 = f1;
+                x1 = b - goldenRatio * (b - a);
+                f1 = this->elevation(x1);
+            }
+        }
+        const double t = 0.5 * (a + b);
+        value = this->elevation(t);
+        return t;
+    }
+
+    qint64 propagations() const { return this->propagations_; }
+
+private:
+    static double dot(const double a[3], const double b[3])
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    const Sgp4 &model_;        //! Модель движения
+    const Observer &observer_; //! Станция
+    qint64 propagations_ = 0;  //! Выполнено прогнозов
+};
+
+//! Задача пула потоков: группа объектов и их пролёты
+struct Job
+{
+    QVector<int> indices;          //! Индексы записей
+    QVector<SatellitePass> passes; //! Найденные пролёты
+    qint64 propagations = 0;       //! Выполнено прогнозов
+    int unsupported = 0;           //! Объектов без прогноза
+    int filtered = 0;              //! Объектов, отброшенных по геометрии
+};
+
+} // namespace
+
+TleFields PassPredictor::requiredFields()
+{
+    return Sgp4::requiredFields(); //! Отбор по геометрии читает подмножество тех же полей
+}
+
+bool PassPredictor::isVisibleFrom(const TleRecord &record, const GroundStation &station)
+{
+    const OrbitBounds bounds = orbitBounds(record);
+    if (bounds.apogeeRadius <= 0.0)
+        return false;
+    const Observer observer = makeObserver(station);
+    const double cone = coneRadius(bounds.apogeeRadius, observer);
+    if (cone < 0.0)
+        return false;
+    //! Подспутниковая точка не уходит от экватора дальше наклонения (для обратных орбит — 180° - i)
+    const double inclination = record.inclination <= 90.0 ? record.inclination
+                                                           : 180.0 - record.inclination;
+    const double latitude = std::asin(observer.position[2] / observer.radius);
+    return std::fabs(latitude) <= inclination * deg2rad + cone + coneMargin;
+}
+
+QVector<SatellitePass> PassPredictor::predictObject(const Sgp4 &model,
+                                                    const TleRecord &record,
+                                                    const PassSettings &settings,
+                                                    qint64 *propagations)
+{
+    QVector<SatellitePass> passes;
+    const Observer observer = makeObserver(settings.station);
+    const OrbitBounds bounds = orbitBounds(record);
+    const double cone = bounds.apogeeRadius > 0.0 ? coneRadius(bounds.apogeeRadius, observer)
+                                                  : -1.0;
+    if (!model.isValid() || cone < 0.0 || settings.end <= settings.start)
+        return passes;
+
+    Tracker tracker(model, observer);
+    const double step = qMax(settings.step, 1.0);
+    const double tolerance = qMax(settings.tolerance, 1e-3);
+    const double skipAngle = cone + coneMargin; //! Дальше этого угла объект заведомо не виден
+
+    SatellitePass pass; //! Текущий пролёт
+    Sample best;        //! Шаг текущего пролёта с наибольшим возвышением
+    bool inPass = false;
+
+    //! Завершение пролёта: уточнение TCA около лучшего шага, азимуты AOS и LOS
+    auto finish = [&](double los, bool clipped) {
+        pass.los = los;
+        pass.clipped = pass.clipped || clipped;
+        double value = best.elevation;
+        pass.tca = best.time;
+        const double from = qMax(pass.aos, best.time - step);
+        const double to = qMin(pass.los, best.time + step);
+        if (to - from > tolerance) {
+            const double t = tracker.maximum(from, to, tolerance, value);
+            if (value >= best.elevation)
+                pass.tca = t;
+            else
+                value = best.elevation;
+        }
+        pass.maxElevation = (value + observer.minElevation) * rad2deg;
+        Sample edge;
+        if (tracker.sample(pass.aos, edge, true))
+            pass.aosAzimuth = edge.azimuth * rad2deg;
+        if (tracker.sample(pass.los, edge, true))
+            pass.losAzimuth = edge.azimuth * rad2deg;
+        passes.append(pass);
+        inPass = false;
+    };
+
+    Sample previous, beforePrevious; //! Два предыдущих шага
+    int fineSteps = 0;               //! Сколько последних шагов были короткими (внутри конуса)
+    bool havePrevious = false;
+    bool lastStepFine = false;
+    double t = settings.start;
+    for (;;) {
+        Sample current;
+        if (!tracker.sample(t, current)) {
+            //! Объект сошёл с орбиты: дальше прогноз невозможен
+            if (inPass)
+                finish(previous.time, true);
+            break;
+        }
+        fineSteps = lastStepFine ? fineSteps + 1 : 0;
+
+        if (!havePrevious) {
+            if (current.elevation >= 0.0) {
+                //! Объект уже виден в начале интервала
+                pass = SatellitePass();
+                pass.catalogNumber = record.catalogNumber;
+                pass.aos = current.time;
+                pass.clipped = true;
+                best = current;
+                inPass = true;
+            }
+        } else if (!inPass && current.elevation >= 0.0) {
+            pass = SatellitePass();
+            pass.catalogNumber = record.catalogNumber;
+            pass.aos = tracker.root(previous.time, previous.elevation, t, current.elevation,
+                                    tolerance);
+            best = current;
+            inPass = true;
+        } else if (inPass && current.elevation < 0.0) {
+            finish(tracker.root(previous.time, previous.elevation, t, current.elevation, tolerance),
+                   false);
+        } else if (!inPass && fineSteps >= 2 && previous.elevation > beforePrevious.elevation
+                   && previous.elevation >= current.elevation) {
+            //! Максимум ниже порога на шагах: короткий пролёт мог уместиться между ними
+            double value = 0.0;
+            const double peak = tracker.maximum(beforePrevious.time, t, tolerance, value);
+            if (value >= 0.0) {
+                pass = SatellitePass();
+                pass.catalogNumber = record.catalogNumber;
+                pass.aos = tracker.root(beforePrevious.time, beforePrevious.elevation, peak, value,
+                                        tolerance);
+                best.time = peak;
+                best.elevation = value;
+                inPass = true;
+                finish(tracker.root(peak, value, t, current.elevation, tolerance), false);
+            }
+        }
+        if (inPass && current.elevation > best.elevation)
+            best = current;
+
+        if (t >= settings.end) {
+            if (inPass)
+                finish(settings.end, true);
+            break;
+        }
+
+        //! Вне конуса видимости шаг равен времени, за которое объект не может в него войти
+        double dt = step;
+        lastStepFine = true;
+        if (!inPass) {
+            const double skip = (current.angle - skipAngle) / bounds.maxRate;
+            if (skip > step) {
+                dt = skip;
+                lastStepFine = false;
+            }
+        }
+        beforePrevious = previous;
+        previous = current;
+        havePrevious = true;
+        t = qMin(t + dt, settings.end);
+    }
+
+    if (propagations)
+        *propagations += tracker.propagations();
+    return passes;
+}
+
+QVector<SatellitePass> PassPredictor::predict(const QVector<TleRecord> &records,
+                                              const PassSettings &settings,
+                                              PassStatistics *statistics)
+{
+    //! Для каждого объекта — запись с самой поздней эпохой
+    const QVector<int> indices = TleUtils::latestEpochIndices(records);
+
+    QVector<Job> jobs;
+    for (int k = 0; k < indices.size(); k += objectsPerJob)
+        jobs.append({indices.mid(k, objectsPerJob), {}, 0, 0, 0});
+
+    QtConcurrent::blockingMap(jobs, [&records, &settings](Job &job) {
+        for (int index : job.indices) {
+            const TleRecord &record = records[index];
+            if (!isVisibleFrom(record, settings.station)) {
+                ++job.filtered;
+                continue;
+            }
+            const Sgp4 model(record);
+            if (!model.isValid()) {
+                ++job.unsupported;
+                continue;
+            }
+            job.passes += predictObject(model, record, settings, &job.propagations);
+        }
+    });
+
+    QVector<SatellitePass> passes;
+    PassStatistics summary;
+    summary.objects = int(indices.size());
+    for (const Job &job : jobs) {
+        passes += job.passes;
+        summary.propagations += job.propagations;
+        summary.unsupported += job.unsupported;
+        summary.filtered += job.filtered;
+    }
+    std::sort(passes.begin(), passes.end(), [](const SatellitePass &a, const SatellitePass &b) {
+        return a.aos != b.aos ? a.aos < b.aos : a.catalogNumber < b.catalogNumber;
+    });
+    if (statistics)
+        *statistics = summary;
+    return passes;
+}
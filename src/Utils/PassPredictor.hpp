@@ -0,0 +1,128 @@
+/*!
+ * \file PassPredictor.hpp
+ * \brief Заголовочный файл для прогноза пролётов над наземной станцией
+ * \details
+ * Этот файл содержит определение класса PassPredictor и структур с параметрами
+ * прогноза и найденными пролётами (AOS, TCA, LOS, наибольшее возвышение).
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef PASSPREDICTOR_HPP
+#define PASSPREDICTOR_HPP
+
+#include <QVector>
+
+#include "Sgp4.hpp"
+#include "TleRecord.hpp"
+
+/*!
+ * \brief GroundStation - наземная станция
+ */
+struct GroundStation
+{
+    double latitude = 0.0;     //! Широта (градусы)
+    double longitude = 0.0;    //! Долгота (градусы, к востоку)
+    double altitude = 0.0;     //! Высота над эллипсоидом WGS-84 (км)
+    double minElevation = 0.0; //! Наименьшее возвышение, с которого объект считается видимым (градусы)
+};
+
+/*!
+ * \brief PassSettings - параметры прогноза
+ */
+struct PassSettings
+{
+    GroundStation station;  //! Станция
+    double start = 0.0;     //! Начало интервала (секунды Unix, UTC)
+    double end = 0.0;       //! Конец интервала (секунды Unix, UTC)
+    double step = 60.0;     //! Шаг внутри конуса видимости (секунды)
+    double tolerance = 0.5; //! Точность моментов AOS, TCA и LOS (секунды)
+};
+
+/*!
+ * \brief SatellitePass - пролёт объекта над станцией
+ */
+struct SatellitePass
+{
+    int catalogNumber = 0;     //! Номер объекта
+    double aos = 0.0;          //! Восход: возвышение достигает порога (секунды Unix)
+    double tca = 0.0;          //! Наибольшее сближение: наибольшее возвышение (секунды Unix)
+    double los = 0.0;          //! Заход: возвышение опускается ниже порога (секунды Unix)
+    double maxElevation = 0.0; //! Наибольшее возвышение (градусы)
+    double aosAzimuth = 0.0;   //! Азимут восхода (градусы от севера к востоку)
+    double losAzimuth = 0.0;   //! Азимут захода (градусы)
+    bool clipped = false;      //! Пролёт обрезан границей интервала (AOS или LOS — граница)
+};
+
+/*!
+ * \brief PassStatistics - сводка прогноза
+ */
+struct PassStatistics
+{
+    int objects = 0;         //! Объектов в каталоге (без повторов)
+    int unsupported = 0;     //! Объектов, для которых прогноз невозможен (SDP4, ошибки элементов)
+    int filtered = 0;        //! Объектов, отброшенных без прогноза (не достигают широты станции)
+    qint64 propagations = 0; //! Выполнено прогнозов SGP4
+};
+
+/*!
+ * \brief Класс PassPredictor
+ * \details
+ * Для каждого объекта сначала проверяется геометрия орбиты: если даже с высоты
+ * апогея объект не виден с широты станции (наклонение плюс угловой радиус зоны
+ * видимости меньше широты), прогноз не выполняется.
+ *
+ * Затем время просматривается шагами переменной длины. Пока угол между
+ * направлениями из центра Земли на станцию и на объект больше углового радиуса
+ * зоны видимости (конуса горизонта) для апогея, объект заведомо не виден, а шаг
+ * равен времени, за которое этот угол не может сократиться до радиуса зоны
+ * (по наибольшей угловой скорости объекта в перигее плюс вращение Земли).
+ * Внутри конуса шаг равен PassSettings::step; моменты AOS и LOS уточняются
+ * поиском корня возвышения, TCA — поиском максимума методом золотого сечения.
+ * Локальные максимумы ниже порога между шагами тоже уточняются, поэтому
+ * короткие пролёты у горизонта не пропускаются.
+ *
+ * Объекты обрабатываются параллельно и независимо.
+ */
+class PassPredictor
+{
+public:
+    /*!
+     * \brief requiredFields - поля записей, которые читает прогноз (TleParser::setFields)
+     */
+    static TleFields requiredFields();
+
+    /*!
+     * \brief predictObject - пролёты одного объекта
+     * \param model Модель движения объекта
+     * \param record Запись, по которой построена модель
+     * \param settings Параметры прогноза
+     * \param propagations Счётчик прогнозов SGP4 (может быть nullptr)
+     * \return Пролёты в порядке времени
+     */
+    static QVector<SatellitePass> predictObject(const Sgp4 &model,
+                                                const TleRecord &record,
+                                                const PassSettings &settings,
+                                                qint64 *propagations = nullptr);
+
+    /*!
+     * \brief predict - пролёты всех объектов каталога
+     * \param records Записи (при повторах объекта используется самая поздняя эпоха)
+     * \param settings Параметры прогноза
+     * \param statistics Сводка (может быть nullptr)
+     * \return Пролёты, упорядоченные по времени AOS
+     */
+    static QVector<SatellitePass> predict(const QVector<TleRecord> &records,
+                                          const PassSettings &settings,
+                                          PassStatistics *statistics = nullptr);
+
+    /*!
+     * \brief isVisibleFrom - может ли орбита быть видна со станции
+     * \param record Запись (наклонение, эксцентриситет, среднее движение)
+     * \param station Станция
+     * \details Проверяется только геометрия орбиты, без прогноза.
+     */
+    static bool isVisibleFrom(const TleRecord &record, const GroundStation &station);
+};
+
+#endif // PASSPREDICTOR_HPP
@@ -0,0 +1,202 @@
+/*!
+ * \file QuantileSketch.cpp
+ * \brief Потоковый эскиз квантилей
+ * \details
+ * Этот файл содержит реализацию класса QuantileSketch.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "QuantileSketch.hpp"
+
+#include <cmath>
+#include <limits>
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, int maxBins)
+    : relativeAccuracy_(qBound(1e-6, relativeAccuracy, 0.5))
+    , maxBins_(qMax(maxBins, 16))
+{
+    this->gamma_ = (1.0 + this->relativeAccuracy_) / (1.0 - this->relativeAccuracy_);
+    this->inverseLogGamma_ = 1.0 / std::log(this->gamma_);
+    //! Нулём считаются только денормализованные числа: у них логарифм неточен
+    this->minIndexable_ = std::numeric_limits<double>::min() * this->gamma_;
+}
+
+void QuantileSketch::Store::add(int index, qint64 n, int maxBins)
+{
+    if (this->counts.isEmpty()) {
+        this->offset = index;
+        this->counts.append(n);
+        return;
+    }
+
+    const int last = this->offset + int(this->counts.size()) - 1;
+    if (index >= this->offset && index <= last) {
+        this->counts[index - this->offset] += n;
+        return;
+    }
+
+    //! Новый диапазон; если он шире maxBins, младшие интервалы сливаются в первый оставшийся
+    const int high = qMax(last, index);
+    const int low = qMax(qMin(this->offset, index), high - maxBins + 1);
+    QVector<qint64> resized(high - low + 1, 0);
+    for (int i = 0; i < this->counts.size(); ++i)
+        resized[qMax(this->offset + i, low) - low] += this->counts[i];
+    resized[qMax(index, low) - low] += n;
+    this->counts.swap(resized);
+    this->offset = low;
+}
+
+int QuantileSketch::indexOf(double magnitude) const
+{
+    return int(std::ceil(std::log(magnitude) * this->inverseLogGamma_));
+}
+
+double QuantileSketch::valueOf(int index) const
+{
+    //! Середина интервала (γ^(k-1), γ^k]: относительная погрешность не больше α
+    return 2.0 * std::pow(this->gamma_, index) / (this->gamma_ + 1.0);
+}
+
+void QuantileSketch::add(double value)
+{
+    if (!std::isfinite(value))
+        return;
+
+    if (value > this->minIndexable_)
+        this->positive_.add(this->indexOf(value), 1, this->maxBins_);
+    else if (value < -this->minIndexable_)
+        this->negative_.add(this->indexOf(-value), 1, this->maxBins_);
+    else
+        ++this->zeroCount_;
+
+    if (this->count_ == 0 || value < this->min_)
+        this->min_ = value;
+    if (this->count_ == 0 || value > this->max_)
+        this->max_ = value;
+    ++this->count_;
+}
+
+void QuantileSketch::merge(const QuantileSketch &other)
+{
+    if (other.count_ == 0)
+        return;
+
+    if (other.gamma_ == this->gamma_) {
+        //! Те же интервалы: счётчики складываются, диапазон расширяется один раз
+        auto mergeStore = [this](Store &to, const Store &from) {
+            if (from.counts.isEmpty())
+                return;
+            to.add(from.offset + int(from.counts.size()) - 1, 0, this->maxBins_);
+            to.add(from.offset, 0, this->maxBins_);
+            for (int i = 0; i < from.counts.size(); ++i) {
+                if (from.counts[i] != 0)
+                    to.add(from.offset + i, from.counts[i], this->maxBins_);
+            }
+        };
+        mergeStore(this->positive_, other.positive_);
+        mergeStore(this->negative_, other.negative_);
+    } else {
+        //! Другая точность: интервалы переносятся по своим представителям
+        for (int i = 0; i < other.positive_.counts.size(); ++i) {
+            if (other.positive_.counts[i] != 0)
+                this->positive_.add(this->indexOf(other.valueOf(other.positive_.offset + i)),
+                                    other.positive_.counts[i],
+                                    this->maxBins_);
+        }
+        for (int i = 0; i < other.negative_.counts.size(); ++i) {
+            if (other.negative_.counts[i] != 0)
+                this->negative_.add(this->indexOf(other.valueOf(other.negative_.offset + i)),
+                                    other.negative_.counts[i],
+                                    this->maxBins_);
+        }
+    }
+    this->zeroCount_ += other.zeroCount_;
+
+    if (this->count_ == 0 || other.min_ < this->min_)
+        this->min_ = other.min_;
+    if (this->count_ == 0 || other.max_ > this->max_)
+        this->max_ = other.max_;
+    this->count_ += other.count_;
+}
+
+double QuantileSketch::quantile(double q) const
+{
+    if (this->count_ == 0 || std::isnan(q))
+        return std::numeric_limits<double>::quiet_NaN();
+    if (q <= 0.0)
+        return this->min_;
+    if (q >= 1.0)
+        return this->max_;
+
+    //! Ищется интервал, в который попадает значение с рангом q·(n - 1), по возрастанию значений
+    const double rank = q * double(this->count_ - 1);
+    qint64 cumulative = 0;
+    for (int i = int(this->negative_.counts.size()) - 1; i >= 0; --i) {
+        cumulative += this->negative_.counts[i];
+        if (double(cumulative) > rank)
+            return qBound(this->min_, -this->valueOf(this->negative_.offset + i), this->max_);
+    }
+    cumulative += this->zeroCount_;
+    if (double(cumulative) > rank)
+        return qBound(this->min_, 0.0, this->max_);
+    for (int i = 0; i < this->positive_.counts.size(); ++i) {
+        cumulative += this->positive_.counts[i];
+        if (double(cumulative) > rank)
+            return qBound(this->min_, this->valueOf(this->positive_.offset + i), this->max_);
+    }
+    return this->max_;
+}
+
+QJsonObject QuantileSketch::toJson() const
+{
+    QJsonObject result{{"count", this->count_}};
+    if (this->count_ > 0) {
+        result.insert("min", this->min_);
+        result.insert("max", this->max_);
+        result.insert("p50", this->quantile(0.5));
+        result.insert("p90", this->quantile(0.9));
+        result.insert("p95", this->quantile(0.95));
+        result.insert("p99", this->quantile(0.99));
+    }
+    return result;
+}
+
+void QuantileSketch::save(QDataStream &stream) const
+{
+    stream << this->relativeAccuracy_ << qint32(this->maxBins_) << this->zeroCount_
+           << this->count_ << this->min_ << this->max_;
+    for (const Store *store : {&this->positive_, &this->negative_})
+        stream << qint32(store->offset) << store->counts;
+}
+
+bool QuantileSketch::load(QDataStream &stream)
+{
+    double relativeAccuracy = 0.0;
+    qint32 maxBins = 0;
+    stream >> relativeAccuracy >> maxBins;
+    if (stream.status() != QDataStream::Ok || !(relativeAccuracy > 0.0 && relativeAccuracy < 1.0)) {
+        *this = QuantileSketch();
+        return false;
+    }
+    QuantileSketch sketch(relativeAccuracy, maxBins);
+    stream >> sketch.zeroCount_ >> sketch.count_ >> sketch.min_ >> sketch.max_;
+    for (Store *store : {&sketch.positive_, &sketch.negative_}) {
+        qint32 offset = 0;
+        stream >> offset >> store->counts;
+        store->offset = offset;
+    }
+    if (stream.status() != QDataStream::Ok) {
+        *this = QuantileSketch();
+        return false;
+    }
+    *this = sketch;
+    return true;
+}
+
+int QuantileSketch::memoryUsage() const
+{
+    return int(sizeof(*this))
+           + int(this->positive_.counts.capacity() + this->negative_.counts.capacity())
+                 * int(sizeof(qint64));
+}
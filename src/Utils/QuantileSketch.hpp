@@ -0,0 +1,138 @@
+/*!
+ * \file QuantileSketch.hpp
+ * \brief Заголовочный файл для класса QuantileSketch
+ * \details
+ * Этот файл содержит определение класса QuantileSketch — потокового эскиза
+ * для приближённого вычисления квантилей (медиана, p95, p99) с ограниченной
+ * относительной погрешностью.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef QUANTILESKETCH_HPP
+#define QUANTILESKETCH_HPP
+
+#include <QDataStream>
+#include <QJsonObject>
+#include <QVector>
+
+/*!
+ * \brief Класс QuantileSketch
+ * \details
+ * Значения раскладываются по логарифмическим интервалам (γ^(k-1), γ^k],
+ * γ = (1 + α) / (1 - α); отрицательные значения — в отдельный набор интервалов,
+ * значения по модулю меньше minIndexable — в нулевой счётчик. Квантиль возвращается
+ * как середина интервала, поэтому для любого q результат отличается от точного
+ * значения с рангом q·(n - 1) не больше чем на α·|x|.
+ *
+ * На каждый знак хранится не больше maxBins счётчиков: при выходе за этот диапазон
+ * младшие интервалы (ближайшие к нулю) сливаются, и оценка гарантирована только
+ * для квантилей выше слитой части. При α = 1% и 1024 интервалах это диапазон
+ * в 8·10^8 раз, чего хватает для всех величин каталога; память — не больше 8 КБ
+ * на знак, фактически занято от сотни до тысячи счётчиков.
+ *
+ * Слияние эскизов с одинаковой точностью складывает счётчики и даёт тот же
+ * результат, что и добавление всех значений в один эскиз, независимо от порядка.
+ */
+class QuantileSketch
+{
+public:
+    /*!
+     * \brief QuantileSketch - пустой эскиз
+     * \param relativeAccuracy Относительная погрешность α (0 < α < 1)
+     * \param maxBins Наибольшее количество счётчиков на знак
+     */
+    explicit QuantileSketch(double relativeAccuracy = 0.01, int maxBins = 1024);
+
+    /*!
+     * \brief add - добавляет значение
+     * \param value Значение (NaN и бесконечности пропускаются)
+     */
+    void add(double value);
+
+    /*!
+     * \brief merge - добавляет все значения другого эскиза
+     * \param other Эскиз (при другой точности его интервалы переносятся приближённо)
+     */
+    void merge(const QuantileSketch &other);
+
+    /*!
+     * \brief quantile - приближённый квантиль
+     * \param q Уровень (0 — минимум, 0.5 — медиана, 1 — максимум)
+     * \return Значение квантиля или NaN, если эскиз пуст
+     */
+    double quantile(double q) const;
+
+    /*!
+     * \brief toJson - количество, минимум, максимум, медиана, p90, p95 и p99
+     */
+    QJsonObject toJson() const;
+
+    //! Количество добавленных значений
+    qint64 count() const { return this->count_; }
+
+    //! Пуст ли эскиз
+    bool isEmpty() const { return this->count_ == 0; }
+
+    //! Точный минимум добавленных значений
+    double min() const { return this->min_; }
+
+    //! Точный максимум добавленных значений
+    double max() const { return this->max_; }
+
+    //! Относительная погрешность α
+    double relativeAccuracy() const { return this->relativeAccuracy_; }
+
+    //! Занятая счётчиками память (байт)
+    int memoryUsage() const;
+
+    /*!
+     * \brief save - записывает эскиз в поток (точность, счётчики, минимум и максимум)
+     * \param stream Поток QDataStream
+     */
+    void save(QDataStream &stream) const;
+
+    /*!
+     * \brief load - читает эскиз, записанный save()
+     * \param stream Поток QDataStream
+     * \return false, если данные повреждены (эскиз при этом пуст)
+     */
+    bool load(QDataStream &stream);
+
+private:
+    /*!
+     * \brief Store - плотный массив счётчиков для интервалов одного знака
+     */
+    struct Store
+    {
+        QVector<qint64> counts; //! Счётчики интервалов offset, offset + 1, ...
+        int offset = 0;         //! Номер первого интервала
+
+        /*!
+         * \brief add - добавляет n значений в интервал index
+         * \param maxBins Наибольшее количество счётчиков (лишние младшие сливаются)
+         */
+        void add(int index, qint64 n, int maxBins);
+    };
+
+    //! Номер интервала для положительного значения
+    int indexOf(double magnitude) const;
+
+    //! Представитель интервала (середина в смысле относительной погрешности)
+    double valueOf(int index) const;
+
+    double relativeAccuracy_; //! Относительная погрешность α
+    double gamma_;            //! Основание интервалов γ
+    double inverseLogGamma_;  //! 1 / ln γ
+    double minIndexable_;     //! Значения меньше по модулю считаются нулём
+    int maxBins_;             //! Наибольшее количество счётчиков на знак
+
+    Store positive_;       //! Положительные значения
+    Store negative_;       //! Отрицательные значения (по модулю)
+    qint64 zeroCount_ = 0; //! Значения, близкие к нулю
+    qint64 count_ = 0;     //! Всего значений
+    double min_ = 0.0;     //! Минимум
+    double max_ = 0.0;     //! Максимум
+};
+
+#endif // QUANTILESKETCH_HPP
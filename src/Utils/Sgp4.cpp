@@ -0,0 +1,323 @@
+/*!
+ * \file Sgp4.cpp
+ * \brief Модель движения SGP4
+ * \details
+ * Этот файл содержит реализацию класса Sgp4. Обозначения переменных совпадают
+ * с эталонной реализацией Vallado, чтобы формулы было легко сверить.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "Sgp4.hpp"
+
+#include <cmath>
+
+#include "TleUtils.hpp"
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+constexpr double twoPi = 2.0 * pi;
+constexpr double deg2rad = pi / 180.0;
+constexpr double x2o3 = 2.0 / 3.0;
+
+//! Гармоники гравитационного поля WGS-72
+constexpr double j2 = 0.001082616;
+constexpr double j3 = -0.00000253881;
+constexpr double j4 = -0.00000165597;
+constexpr double j3oj2 = j3 / j2;
+
+//! Радиус Земли и скорость в единицах модели
+const double xke = 60.0 / std::sqrt(Sgp4::earthRadius * Sgp4::earthRadius * Sgp4::earthRadius
+                                    / Sgp4::earthMu);
+const double velocityUnit = Sgp4::earthRadius * xke / 60.0; //! км/с в одной единице скорости
+
+} // namespace
+
+Sgp4::Sgp4(const TleRecord &record)
+{
+    this->init(TleUtils::epochToUnixSeconds(record),
+               TleUtils::bstar(record),
+               record.inclination,
+               record.rightAscension,
+               record.eccentricity,
+               record.argPerigee,
+               record.meanAnomaly,
+               record.meanMotion);
+}
+
+TleFields Sgp4::requiredFields()
+{
+    return TleField::CatalogNumber | TleField::Epoch | TleField::Drag | TleField::Inclination
+           | TleField::RightAscension | TleField::Eccentricity | TleField::ArgPerigee
+           | TleField::MeanAnomaly | TleField::MeanMotion;
+}
+
+bool Sgp4::init(double epoch,
+                double bstar,
+                double inclination,
+                double rightAscension,
+                double eccentricity,
+                double argPerigee,
+                double meanAnomaly,
+                double meanMotion)
+{
+    this->epoch_ = epoch;
+    this->bstar_ = bstar;
+    this->inclo_ = inclination * deg2rad;
+    this->nodeo_ = rightAscension * deg2rad;
+    this->ecco_ = eccentricity;
+    this->argpo_ = argPerigee * deg2rad;
+    this->mo_ = meanAnomaly * deg2rad;
+    this->no_ = meanMotion * twoPi / 1440.0; //! об/сут -> рад/мин
+
+    if (!(this->no_ > 0.0) || this->ecco_ < 0.0 || this->ecco_ >= 1.0) {
+        this->error_ = Error::InvalidElements;
+        return false;
+    }
+
+    //! initl: восстановление среднего движения по Брауэру из значения Козаи
+    const double eccsq = this->ecco_ * this->ecco_;
+    const double omeosq = 1.0 - eccsq;
+    const double rteosq = std::sqrt(omeosq);
+    const double cosio = std::cos(this->inclo_);
+    const double cosio2 = cosio * cosio;
+
+    const double ak = std::pow(xke / this->no_, x2o3);
+    const double d1 = 0.75 * j2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+    double del = d1 / (ak * ak);
+    const double adel = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+    del = d1 / (adel * adel);
+    this->no_ = this->no_ / (1.0 + del);
+
+    const double ao = std::pow(xke / this->no_, x2o3);
+    const double sinio = std::sin(this->inclo_);
+    const double po = ao * omeosq;
+    const double con42 = 1.0 - 5.0 * cosio2;
+    this->con41_ = -con42 - cosio2 - cosio2;
+    const double posq = po * po;
+    const double rp = ao * (1.0 - this->ecco_);
+
+    this->period_ = twoPi / this->no_;
+    if (this->period_ >= 225.0) {
+        this->error_ = Error::DeepSpace;
+        return false;
+    }
+
+    //! sgp4init: околоземные коэффициенты
+    constexpr double ss = 78.0 / earthRadius + 1.0;
+    const double qzms2t = std::pow((120.0 - 78.0) / earthRadius, 4);
+    constexpr double temp4 = 1.5e-12;
+
+    //! Для перигея ниже 220 км используется упрощённая модель торможения
+    this->isimp_ = rp < (220.0 / earthRadius + 1.0);
+
+    double sfour = ss;
+    double qzms24 = qzms2t;
+    const double perige = (rp - 1.0) * earthRadius;
+    if (perige < 156.0) {
+        sfour = perige - 78.0;
+        if (perige < 98.0)
+            sfour = 20.0;
+        qzms24 = std::pow((120.0 - sfour) / earthRadius, 4);
+        sfour = sfour / earthRadius + 1.0;
+    }
+
+    const double pinvsq = 1.0 / posq;
+    const double tsi = 1.0 / (ao - sfour);
+    this->eta_ = ao * this->ecco_ * tsi;
+    const double etasq = this->eta_ * this->eta_;
+    const double eeta = this->ecco_ * this->eta_;
+    const double psisq = std::fabs(1.0 - etasq);
+    const double coef = qzms24 * std::pow(tsi, 4);
+    const double coef1 = coef / std::pow(psisq, 3.5);
+    const double cc2 = coef1 * this->no_
+                       * (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq))
+                          + 0.375 * j2 * tsi / psisq * this->con41_
+                                * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+    this->cc1_ = this->bstar_ * cc2;
+    double cc3 = 0.0;
+    if (this->ecco_ > 1.0e-4)
+        cc3 = -2.0 * coef * tsi * j3oj2 * this->no_ * sinio / this->ecco_;
+    this->x1mth2_ = 1.0 - cosio2;
+    this->cc4_ = 2.0 * this->no_ * coef1 * ao * omeosq
+                 * (this->eta_ * (2.0 + 0.5 * etasq) + this->ecco_ * (0.5 + 2.0 * etasq)
+                    - j2 * tsi / (ao * psisq)
+                          * (-3.0 * this->con41_ * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta))
+                             + 0.75 * this->x1mth2_ * (2.0 * etasq - eeta * (1.0 + etasq))
+                                   * std::cos(2.0 * this->argpo_)));
+    this->cc5_ = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+
+    const double cosio4 = cosio2 * cosio2;
+    const double temp1 = 1.5 * j2 * pinvsq * this->no_;
+    const double temp2 = 0.5 * temp1 * j2 * pinvsq;
+    const double temp3 = -0.46875 * j4 * pinvsq * pinvsq * this->no_;
+    this->mdot_ = this->no_ + 0.5 * temp1 * rteosq * this->con41_
+                  + 0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+    this->argpdot_ = -0.5 * temp1 * con42 + 0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4)
+                     + temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+    const double xhdot1 = -temp1 * cosio;
+    this->nodedot_ = xhdot1
+                     + (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2))
+                           * cosio;
+    this->omgcof_ = this->bstar_ * cc3 * std::cos(this->argpo_);
+    this->xmcof_ = 0.0;
+    if (this->ecco_ > 1.0e-4)
+        this->xmcof_ = -x2o3 * coef * this->bstar_ / eeta;
+    this->nodecf_ = 3.5 * omeosq * xhdot1 * this->cc1_;
+    this->t2cof_ = 1.5 * this->cc1_;
+    //! Защита от деления на ноль при наклонении 180°
+    const double denominator = std::fabs(cosio + 1.0) > 1.5e-12 ? 1.0 + cosio : temp4;
+    this->xlcof_ = -0.25 * j3oj2 * sinio * (3.0 + 5.0 * cosio) / denominator;
+    this->aycof_ = -0.5 * j3oj2 * sinio;
+    this->delmo_ = std::pow(1.0 + this->eta_ * std::cos(this->mo_), 3);
+    this->sinmao_ = std::sin(this->mo_);
+    this->x7thm1_ = 7.0 * cosio2 - 1.0;
+
+    if (!this->isimp_) {
+        const double cc1sq = this->cc1_ * this->cc1_;
+        this->d2_ = 4.0 * ao * tsi * cc1sq;
+        const double temp = this->d2_ * tsi * this->cc1_ / 3.0;
+        this->d3_ = (17.0 * ao + sfour) * temp;
+        this->d4_ = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * this->cc1_;
+        this->t3cof_ = this->d2_ + 2.0 * cc1sq;
+        this->t4cof_ = 0.25 * (3.0 * this->d3_ + this->cc1_ * (12.0 * this->d2_ + 10.0 * cc1sq));
+        this->t5cof_ = 0.2
+                       * (3.0 * this->d4_ + 12.0 * this->cc1_ * this->d3_
+                          + 6.0 * this->d2_ * this->d2_
+                          + 15.0 * cc1sq * (2.0 * this->d2_ + cc1sq));
+    }
+
+    this->error_ = Error::None;
+    return true;
+}
+
+bool Sgp4::propagate(double minutes, StateVector &state) const
+{
+    if (this->error_ != Error::None)
+        return false;
+
+    const double t = minutes;
+
+    //! Вековые изменения от гравитации и торможения
+    const double xmdf = this->mo_ + this->mdot_ * t;
+    const double argpdf = this->argpo_ + this->argpdot_ * t;
+    const double nodedf = this->nodeo_ + this->nodedot_ * t;
+    double argpm = argpdf;
+    double mm = xmdf;
+    const double t2 = t * t;
+    double nodem = nodedf + this->nodecf_ * t2;
+    double tempa = 1.0 - this->cc1_ * t;
+    double tempe = this->bstar_ * this->cc4_ * t;
+    double templ = this->t2cof_ * t2;
+
+    if (!this->isimp_) {
+        const double delomg = this->omgcof_ * t;
+        const double delmtemp = 1.0 + this->eta_ * std::cos(xmdf);
+        const double delm = this->xmcof_ * (delmtemp * delmtemp * delmtemp - this->delmo_);
+        const double temp = delomg + delm;
+        mm = xmdf + temp;
+        argpm = argpdf - temp;
+        const double t3 = t2 * t;
+        const double t4 = t3 * t;
+        tempa = tempa - this->d2_ * t2 - this->d3_ * t3 - this->d4_ * t4;
+        tempe = tempe + this->bstar_ * this->cc5_ * (std::sin(mm) - this->sinmao_);
+        templ = templ + this->t3cof_ * t3 + t4 * (this->t4cof_ + t * this->t5cof_);
+    }
+
+    const double am = std::pow(xke / this->no_, x2o3) * tempa * tempa;
+    const double nm = xke / std::pow(am, 1.5);
+    double em = this->ecco_ - tempe;
+    if (!(am > 0.0) || em >= 1.0 || em < -0.001)
+        return false;
+    if (em < 1.0e-6)
+        em = 1.0e-6;
+    mm = mm + this->no_ * templ;
+    double xlm = mm + argpm + nodem;
+
+    nodem = std::fmod(nodem, twoPi);
+    argpm = std::fmod(argpm, twoPi);
+    xlm = std::fmod(xlm, twoPi);
+    mm = std::fmod(xlm - argpm - nodem, twoPi);
+
+    const double sinip = std::sin(this->inclo_);
+    const double cosip = std::cos(this->inclo_);
+
+    //! Долгопериодические члены
+    const double axnl = em * std::cos(argpm);
+    double temp = 1.0 / (am * (1.0 - em * em));
+    const double aynl = em * std::sin(argpm) + temp * this->aycof_;
+    const double xl = mm + argpm + nodem + temp * this->xlcof_ * axnl;
+
+    //! Решение уравнения Кеплера
+    const double u = std::fmod(xl - nodem, twoPi);
+    double eo1 = u;
+    double tem5 = 9999.9;
+    double sineo1 = 0.0;
+    double coseo1 = 0.0;
+    for (int ktr = 1; std::fabs(tem5) >= 1.0e-12 && ktr <= 10; ++ktr) {
+        sineo1 = std::sin(eo1);
+        coseo1 = std::cos(eo1);
+        tem5 = 1.0 - coseo1 * axnl - sineo1 * aynl;
+        tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / tem5;
+        if (std::fabs(tem5) >= 0.95)
+            tem5 = tem5 > 0.0 ? 0.95 : -0.95;
+        eo1 = eo1 + tem5;
+    }
+
+    //! Короткопериодические члены
+    const double ecose = axnl * coseo1 + aynl * sineo1;
+    const double esine = axnl * sineo1 - aynl * coseo1;
+    const double el2 = axnl * axnl + aynl * aynl;
+    const double pl = am * (1.0 - el2);
+    if (pl < 0.0)
+        return false;
+
+    const double rl = am * (1.0 - ecose);
+    const double rdotl = std::sqrt(am) * esine / rl;
+    const double rvdotl = std::sqrt(pl) / rl;
+    const double betal = std::sqrt(1.0 - el2);
+    temp = esine / (1.0 + betal);
+    const double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+    const double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+    double su = std::atan2(sinu, cosu);
+    const double sin2u = (cosu + cosu) * sinu;
+    const double cos2u = 1.0 - 2.0 * sinu * sinu;
+    temp = 1.0 / pl;
+    const double temp1 = 0.5 * j2 * temp;
+    const double temp2 = temp1 * temp;
+
+    const double mrt = rl * (1.0 - 1.5 * temp2 * betal * this->con41_)
+                       + 0.5 * temp1 * this->x1mth2_ * cos2u;
+    su = su - 0.25 * temp2 * this->x7thm1_ * sin2u;
+    const double xnode = nodem + 1.5 * temp2 * cosip * sin2u;
+    const double xinc = this->inclo_ + 1.5 * temp2 * cosip * sinip * cos2u;
+    const double mvt = rdotl - nm * temp1 * this->x1mth2_ * sin2u / xke;
+    const double rvdot = rvdotl + nm * temp1 * (this->x1mth2_ * cos2u + 1.5 * this->con41_) / xke;
+
+    //! Ориентация орбиты
+    const double sinsu = std::sin(su);
+    const double cossu = std::cos(su);
+    const double snod = std::sin(xnode);
+    const double cnod = std::cos(xnode);
+    const double sini = std::sin(xinc);
+    const double cosi = std::cos(xinc);
+    const double xmx = -snod * cosi;
+    const double xmy = cnod * cosi;
+    const double ux = xmx * sinsu + cnod * cossu;
+    const double uy = xmy * sinsu + snod * cossu;
+    const double uz = sini * sinsu;
+    const double vx = xmx * cossu - cnod * sinsu;
+    const double vy = xmy * cossu - snod * sinsu;
+    const double vz = sini * cossu;
+
+    state.position[0] = mrt * ux * earthRadius;
+    state.position[1] = mrt * uy * earthRadius;
+    state.position[2] = mrt * uz * earthRadius;
+    state.velocity[0] = (mvt * ux + rvdot * vx) * velocityUnit;
+    state.velocity[1] = (mvt * uy + rvdot * vy) * velocityUnit;
+    state.velocity[2] = (mvt * uz + rvdot * vz) * velocityUnit;
+
+    //! Радиус меньше радиуса Земли: спутник сошёл с орбиты
+    return mrt >= 1.0;
+}
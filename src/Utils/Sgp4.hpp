@@ -0,0 +1,134 @@
+/*!
+ * \file Sgp4.hpp
+ * \brief Заголовочный файл для модели движения SGP4
+ * \details
+ * Этот файл содержит определение класса Sgp4 — прогноза положения и скорости
+ * спутника по элементам TLE (модель SGP4, константы WGS-72,
+ * по "Revisiting Spacetrack Report #3", Vallado и др., 2006).
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef SGP4_HPP
+#define SGP4_HPP
+
+#include "TleRecord.hpp"
+
+/*!
+ * \brief StateVector - положение и скорость в системе TEME
+ */
+struct StateVector
+{
+    double position[3] = {0.0, 0.0, 0.0}; //! Положение (км)
+    double velocity[3] = {0.0, 0.0, 0.0}; //! Скорость (км/с)
+};
+
+/*!
+ * \brief Класс Sgp4
+ * \details
+ * Реализована околоземная ветвь модели (период меньше 225 минут), к которой относится
+ * подавляющая часть каталога. Для высоких орбит (GEO, GTO, HEO, навигационные спутники)
+ * нужна глубококосмическая поправка SDP4, она не реализована: такие записи
+ * получают ошибку DeepSpace, и прогноз для них не выполняется.
+ */
+class Sgp4
+{
+public:
+    //! Ошибка инициализации или прогноза
+    enum class Error {
+        None,            //! Ошибок нет
+        InvalidElements, //! Недопустимые элементы (эксцентриситет, среднее движение)
+        DeepSpace,       //! Период не меньше 225 минут: требуется SDP4
+        Decayed          //! Спутник сошёл с орбиты к моменту прогноза
+    };
+
+    static constexpr double earthRadius = 6378.135; //! Экваториальный радиус Земли (км, WGS-72)
+    static constexpr double earthMu = 398600.8;     //! Гравитационный параметр (км^3/с^2, WGS-72)
+
+    /*!
+     * \brief Sgp4 - пустая модель (isValid() == false)
+     */
+    Sgp4() = default;
+
+    /*!
+     * \brief Sgp4 - модель по записи TLE
+     * \param record Запись TLE
+     */
+    explicit Sgp4(const TleRecord &record);
+
+    /*!
+     * \brief requiredFields - поля записей, которые читает Sgp4(const TleRecord &)
+     * \details Номер объекта нужен всем прогнозам по каталогу для выбора последней эпохи.
+     */
+    static TleFields requiredFields();
+
+    /*!
+     * \brief init - инициализация по элементам орбиты
+     * \param epoch Эпоха элементов (секунды Unix, UTC)
+     * \param bstar Коэффициент торможения B* (1/радиус Земли)
+     * \param inclination Наклонение (градусы)
+     * \param rightAscension Долгота восходящего узла (градусы)
+     * \param eccentricity Эксцентриситет
+     * \param argPerigee Аргумент перигея (градусы)
+     * \param meanAnomaly Средняя аномалия (градусы)
+     * \param meanMotion Среднее движение (об/сут)
+     * \return true, если модель готова к прогнозу
+     */
+    bool init(double epoch,
+              double bstar,
+              double inclination,
+              double rightAscension,
+              double eccentricity,
+              double argPerigee,
+              double meanAnomaly,
+              double meanMotion);
+
+    /*!
+     * \brief propagate - прогноз на заданное время от эпохи
+     * \param minutes Время от эпохи (минуты)
+     * \param state Положение и скорость (TEME)
+     * \return true, если прогноз выполнен
+     */
+    bool propagate(double minutes, StateVector &state) const;
+
+    /*!
+     * \brief propagateAt - прогноз на заданный момент
+     * \param time Момент (секунды Unix, UTC)
+     * \param state Положение и скорость (TEME)
+     * \return true, если прогноз выполнен
+     */
+    bool propagateAt(double time, StateVector &state) const
+    {
+        return this->propagate((time - this->epoch_) / 60.0, state);
+    }
+
+    //! Эпоха элементов (секунды Unix, UTC)
+    double epoch() const { return this->epoch_; }
+
+    //! Период обращения (минуты)
+    double period() const { return this->period_; }
+
+    //! Готова ли модель к прогнозу
+    bool isValid() const { return this->error_ == Error::None; }
+
+    //! Ошибка инициализации
+    Error error() const { return this->error_; }
+
+private:
+    Error error_ = Error::InvalidElements; //! Ошибка инициализации
+    double epoch_ = 0.0;                   //! Эпоха (секунды Unix)
+    double period_ = 0.0;                  //! Период (минуты)
+
+    //! Элементы (радианы, рад/мин)
+    double bstar_ = 0.0, inclo_ = 0.0, nodeo_ = 0.0, ecco_ = 0.0, argpo_ = 0.0, mo_ = 0.0,
+           no_ = 0.0;
+
+    //! Коэффициенты модели, вычисляемые при инициализации
+    bool isimp_ = false;
+    double aycof_ = 0.0, con41_ = 0.0, cc1_ = 0.0, cc4_ = 0.0, cc5_ = 0.0, d2_ = 0.0, d3_ = 0.0,
+           d4_ = 0.0, delmo_ = 0.0, eta_ = 0.0, argpdot_ = 0.0, omgcof_ = 0.0, sinmao_ = 0.0,
+           t2cof_ = 0.0, t3cof_ = 0.0, t4cof_ = 0.0, t5cof_ = 0.0, x1mth2_ = 0.0, x7thm1_ = 0.0,
+           mdot_ = 0.0, nodedot_ = 0.0, xlcof_ = 0.0, xmcof_ = 0.0, nodecf_ = 0.0;
+};
+
+#endif // SGP4_HPP
@@ -0,0 +1,256 @@
+/*!
+ * \file ShardCoordinator.cpp
+ * \brief Реализация многопроцессной обработки архивов TLE
+ * \details
+ * Этот файл содержит реализацию методов класса ShardCoordinator.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "ShardCoordinator.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QQueue>
+#include <QThread>
+
+#include <functional>
+#include <memory>
+
+#include "StreamDecompressor.hpp"
+
+namespace {
+
+constexpr int shardsPerProcess = 4;            //! Частей на процесс при автоматическом делении
+constexpr qint64 minShardSize = 16ll << 20;    //! Наименьший размер части при автоматическом делении
+constexpr qint64 minWorkerMemory = 16ll << 20; //! Наименьший бюджет памяти обработчика
+
+} // namespace
+
+ShardCoordinator::ShardCoordinator(QObject *parent)
+    : QObject(parent)
+    , program_(QCoreApplication::applicationFilePath())
+    , arguments_({QStringLiteral("--shard-worker")})
+{}
+
+void ShardCoordinator::setProcessCount(int count)
+{
+    this->processCount_ = count;
+}
+
+void ShardCoordinator::setShardSize(qint64 bytes)
+{
+    this->shardSize_ = bytes;
+}
+
+void ShardCoordinator::setMaxAttempts(int attempts)
+{
+    this->maxAttempts_ = qMax(1, attempts);
+}
+
+void ShardCoordinator::setMemoryBudget(qint64 bytes)
+{
+    this->memoryBudget_ = bytes;
+}
+
+void ShardCoordinator::setWorkerCommand(const QString &program, const QStringList &arguments)
+{
+    this->program_ = program;
+    this->arguments_ = arguments;
+}
+
+QVector<Shard> ShardCoordinator::plan(const QStringList &files, qint64 shardSize, QString &error)
+{
+    QVector<Shard> shards;
+    for (const QString &path : files) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            error = tr("Не удалось открыть файл %1").arg(path);
+            return {};
+        }
+        const qint64 size = file.size();
+        //! Сжатый файл нельзя начать читать с середины: он обрабатывается одним процессом
+        if (StreamDecompressor::detect(file.peek(StreamDecompressor::magicSize))
+                != Compression::None
+            || size <= shardSize) {
+            Shard shard;
+            shard.path = path;
+            shard.weight = size;
+            shards.append(shard);
+            continue;
+        }
+        qint64 begin = 0;
+        while (begin < size) {
+            const qint64 end = TleStreamProcessor::alignToRecord(file, begin + shardSize);
+            if (end > begin) {
+                Shard shard;
+                shard.path = path;
+                shard.offset = begin;
+                shard.length = end - begin;
+                shard.weight = end - begin;
+                shards.append(shard);
+            }
+            begin = qMax(end, begin + 1);
+        }
+    }
+    return shards;
+}
+
+QStringList ShardCoordinator::workerArguments(const Shard &shard,
+                                              int threads,
+                                              qint64 memory,
+                                              qint64 ageReference) const
+{
+    return this->arguments_
+           + QStringList{shard.path,
+                         QStringLiteral("--offset"),
+                         QString::number(shard.offset),
+                         QStringLiteral("--length"),
+                         QString::number(shard.length),
+                         QStringLiteral("--age-reference"),
+                         QString::number(ageReference),
+                         QStringLiteral("--threads"),
+                         QString::number(threads),
+                         QStringLiteral("--memory"),
+                         QString::number(memory)};
+}
+
+bool ShardCoordinator::run(const QStringList &files)
+{
+    this->summary_ = StreamSummary();
+    this->errorString_.clear();
+
+    const int cores = qMax(1, QThread::idealThreadCount());
+    const int processes = this->processCount_ > 0 ? this->processCount_ : cores;
+
+    qint64 total = 0;
+    for (const QString &path : files)
+        total += QFileInfo(path).size();
+    const qint64 shardSize = this->shardSize_ > 0
+                                 ? this->shardSize_
+                                 : qMax(minShardSize,
+                                        total / (qint64(processes) * shardsPerProcess) + 1);
+
+    QString error;
+    QQueue<Shard> pending;
+    for (const Shard &shard : plan(files, shardSize, error))
+        pending.enqueue(shard);
+    if (!error.isEmpty()) {
+        this->errorString_ = error;
+        emit this->errorOccurred(error);
+        return false;
+    }
+
+    //! Общий момент отсчёта возраста: эскизы частей складываются без сдвига
+    const qint64 ageReference = QDateTime::currentMSecsSinceEpoch() * 1000;
+    this->summary_.ageReference = ageReference;
+    //! Ядра делятся между процессами, каждому — хотя бы один поток разбора
+    const int threads = qMax(1, cores / qMin(processes, qMax(1, pending.size())));
+    const qint64 memory = qMax(minWorkerMemory, this->memoryBudget_ / processes);
+
+    QEventLoop loop;
+    int running = 0;
+    qint64 processed = 0;
+    bool failed = false;
+
+    std::function<void()> launchNext;
+    //! Завершение обработчика: объединение результата или повтор части
+    auto finish = [&](QProcess *process, Shard shard, const QString &problem) {
+        --running;
+        const QByteArray output = problem.isEmpty() ? process->readAllStandardOutput()
+                                                    : QByteArray();
+        process->deleteLater();
+        if (failed) {
+            if (running == 0)
+                loop.quit();
+            return;
+        }
+
+        StreamSummary part;
+        QString reason = problem;
+        if (reason.isEmpty() && !StreamSummary::fromBinary(output, part))
+            reason = tr("обработчик вернул повреждённые данные");
+        if (reason.isEmpty()) {
+            this->summary_.merge(part);
+            processed += shard.weight;
+            emit this->progress(processed, total);
+        } else if (shard.attempts < this->maxAttempts_) {
+            emit this->shardRetried(tr("%1 [%2, +%3]: %4, повтор")
+                                        .arg(shard.path)
+                                        .arg(shard.offset)
+                                        .arg(shard.length)
+                                        .arg(reason));
+            pending.enqueue(shard);
+        } else {
+            failed = true;
+            this->errorString_ = tr("Не удалось обработать %1 [%2, +%3] за %4 попыток: %5")
+                                     .arg(shard.path)
+                                     .arg(shard.offset)
+                                     .arg(shard.length)
+                                     .arg(shard.attempts)
+                                     .arg(reason);
+            //! Результат уже не нужен: остальные обработчики останавливаются
+            for (QProcess *other : this->findChildren<QProcess *>())
+                other->kill();
+        }
+        launchNext();
+    };
+
+    launchNext = [&]() {
+        while (!failed && running < processes && !pending.isEmpty()) {
+            Shard shard = pending.dequeue();
+            ++shard.attempts;
+            auto *process = new QProcess(this);
+            //! Сообщения обработчика об ошибках видны пользователю, результат — в stdout
+            process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+            auto handled = std::make_shared<bool>(false);
+            connect(process,
+                    QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                    this,
+                    [&, process, shard, handled](int exitCode, QProcess::ExitStatus status) {
+                        if (*handled)
+                            return;
+                        *handled = true;
+                        QString problem;
+                        if (status == QProcess::CrashExit)
+                            problem = tr("обработчик завершился аварийно");
+                        else if (exitCode != 0)
+                            problem = tr("обработчик завершился с кодом %1").arg(exitCode);
+                        finish(process, shard, problem);
+                    });
+            //! Процесс, который не удалось запустить, не присылает finished
+            connect(process,
+                    &QProcess::errorOccurred,
+                    this,
+                    [&, process, shard, handled](QProcess::ProcessError processError) {
+                        if (processError != QProcess::FailedToStart || *handled)
+                            return;
+                        *handled = true;
+                        finish(process,
+                               shard,
+                               tr("не удалось запустить обработчик: %1")
+                                   .arg(process->errorString()));
+                    });
+            ++running;
+            process->start(this->program_,
+                           this->workerArguments(shard, threads, memory, ageReference));
+        }
+        if (running == 0)
+            loop.quit();
+    };
+
+    emit this->progress(0, total);
+    //! Запуск из цикла событий: сигналы процессов, завершившихся сразу, не теряются
+    QMetaObject::invokeMethod(this, [&]() { launchNext(); }, Qt::QueuedConnection);
+    loop.exec();
+
+    if (failed) {
+        emit this->errorOccurred(this->errorString_);
+        return false;
+    }
+    return true;
+}
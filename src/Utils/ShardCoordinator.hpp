@@ -0,0 +1,148 @@
+/*!
+ * \file ShardCoordinator.hpp
+ * \brief Заголовочный файл для многопроцессной обработки архивов TLE
+ * \details
+ * Этот файл содержит определение структуры Shard и класса ShardCoordinator,
+ * который делит архивы на части и обрабатывает их отдельными процессами.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef SHARDCOORDINATOR_HPP
+#define SHARDCOORDINATOR_HPP
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "TleStreamProcessor.hpp"
+
+/*!
+ * \brief Shard - часть работы одного процесса
+ */
+struct Shard
+{
+    QString path;       //! Файл
+    qint64 offset = 0;  //! Начало диапазона (граница записи)
+    qint64 length = -1; //! Длина диапазона (-1 — файл целиком)
+    qint64 weight = 0;  //! Байт файла, приходящихся на часть (для хода обработки)
+    int attempts = 0;   //! Выполненные попытки
+};
+
+/*!
+ * \brief Класс ShardCoordinator
+ * \details
+ * Несжатые файлы делятся на диапазоны по границам записей
+ * (TleStreamProcessor::alignToRecord), сжатые обрабатываются целиком.
+ * Каждая часть обрабатывается процессом-обработчиком (по умолчанию — этой же
+ * программой с ключом --shard-worker), который возвращает в стандартный вывод
+ * двоичную статистику StreamSummary::toBinary(). Координатор объединяет части
+ * по мере их готовности; часть, процесс которой завершился аварийно, с ненулевым
+ * кодом или вернул повреждённые данные, запускается заново (до maxAttempts раз).
+ *
+ * Обработчикам передаётся общий момент отсчёта возраста эпох, поэтому результат
+ * совпадает с обработкой тех же файлов одним процессом.
+ */
+class ShardCoordinator : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief ShardCoordinator - конструктор класса
+     * \param parent Родитель объекта
+     */
+    explicit ShardCoordinator(QObject *parent = nullptr);
+
+    /*!
+     * \brief setProcessCount - количество одновременно работающих обработчиков
+     * \param count Количество (0 — по числу ядер)
+     */
+    void setProcessCount(int count);
+
+    /*!
+     * \brief setShardSize - желаемый размер части несжатого файла
+     * \param bytes Размер (0 — файлы делятся на 4 части на процесс, но не мельче 16 МБ)
+     */
+    void setShardSize(qint64 bytes);
+
+    /*!
+     * \brief setMaxAttempts - наибольшее количество попыток обработки части
+     */
+    void setMaxAttempts(int attempts);
+
+    /*!
+     * \brief setMemoryBudget - общий бюджет памяти (делится между обработчиками)
+     */
+    void setMemoryBudget(qint64 bytes);
+
+    /*!
+     * \brief setWorkerCommand - программа обработчика
+     * \param program Исполняемый файл
+     * \param arguments Аргументы перед параметрами части
+     * \details По умолчанию — эта же программа с ключом --shard-worker.
+     */
+    void setWorkerCommand(const QString &program, const QStringList &arguments);
+
+    /*!
+     * \brief plan - деление файлов на части
+     * \param files Файлы 2LE/3LE (возможно, сжатые)
+     * \param shardSize Желаемый размер части несжатого файла
+     * \param error Сообщение об ошибке
+     * \return Части в порядке файлов и смещений; пусто при ошибке
+     */
+    static QVector<Shard> plan(const QStringList &files, qint64 shardSize, QString &error);
+
+    /*!
+     * \brief run - обработка файлов
+     * \param files Файлы 2LE/3LE (возможно, сжатые)
+     * \return true, если все части обработаны
+     * \details Выполняется синхронно: до завершения крутится локальный цикл событий.
+     */
+    bool run(const QStringList &files);
+
+    //! Объединённый результат
+    const StreamSummary &summary() const { return this->summary_; }
+
+    //! Текст последней ошибки
+    QString errorString() const { return this->errorString_; }
+
+signals:
+    /*!
+     * \brief progress - обработана очередная часть
+     * \param processed Байт файлов в обработанных частях
+     * \param total Байт всего
+     */
+    void progress(qint64 processed, qint64 total);
+
+    /*!
+     * \brief shardRetried - часть будет обработана заново
+     * \param message Причина
+     */
+    void shardRetried(const QString &message);
+
+    /*!
+     * \brief errorOccurred - сигнал об ошибке
+     * \param message Сообщение об ошибке
+     */
+    void errorOccurred(const QString &message);
+
+private:
+    //! Аргументы обработчика для части
+    QStringList workerArguments(const Shard &shard,
+                                int threads,
+                                qint64 memory,
+                                qint64 ageReference) const;
+
+    int processCount_ = 0;              //! Одновременно работающих обработчиков
+    qint64 shardSize_ = 0;              //! Желаемый размер части (0 — автоматически)
+    int maxAttempts_ = 3;               //! Попыток на часть
+    qint64 memoryBudget_ = 256ll << 20; //! Общий бюджет памяти
+    QString program_;                   //! Программа обработчика
+    QStringList arguments_;             //! Аргументы обработчика
+    StreamSummary summary_;             //! Результат
+    QString errorString_;               //! Текст последней ошибки
+};
+
+#endif // SHARDCOORDINATOR_HPP
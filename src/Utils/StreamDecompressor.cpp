@@ -0,0 +1,544 @@
+/*!
+ * \file StreamDecompressor.cpp
+ * \brief Потоковая распаковка сжатых файлов
+ * \details
+ * Этот файл содержит реализацию класса StreamDecompressor.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "StreamDecompressor.hpp"
+
+#include <QFileInfo>
+
+#include <cstring>
+#include <functional>
+
+#ifdef SATELLITES_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef SATELLITES_HAVE_LZMA
+#include <lzma.h>
+#endif
+
+namespace {
+
+constexpr int readSize = 256 << 10; //! Порция чтения исходного устройства
+
+//! Число из little-endian байт
+quint32 littleEndian(const char *data, int size)
+{
+    quint32 value = 0;
+    for (int i = size - 1; i >= 0; --i)
+        value = (value << 8) | quint8(data[i]);
+    return value;
+}
+
+/*!
+ * \brief Input - буфер чтения исходного устройства
+ */
+struct Input
+{
+    QIODevice *device;            //! Исходное устройство
+    std::atomic<qint64> *counter; //! Счётчик прочитанных байт
+    QByteArray buffer;            //! Прочитанные данные
+    int position = 0;             //! Начало необработанных данных
+    bool eof = false;             //! Устройство прочитано до конца
+    QString error;                //! Ошибка чтения
+
+    int available() const { return int(this->buffer.size()) - this->position; }
+    const char *data() const { return this->buffer.constData() + this->position; }
+    void consume(int count) { this->position += count; }
+
+    //! Дочитывает порцию данных; false — данных больше нет
+    bool fill()
+    {
+        if (this->eof)
+            return false;
+        this->buffer.remove(0, this->position);
+        this->position = 0;
+        const int size = int(this->buffer.size());
+        this->buffer.resize(size + readSize);
+        const qint64 read = this->device->read(this->buffer.data() + size, readSize);
+        this->buffer.resize(size + int(qMax<qint64>(read, 0)));
+        if (read < 0)
+            this->error = this->device->errorString();
+        if (read <= 0) {
+            this->eof = true;
+            return false;
+        }
+        this->counter->fetch_add(read, std::memory_order_relaxed);
+        return true;
+    }
+
+    //! Дочитывает данные, пока не станет доступно count байт
+    bool ensure(int count)
+    {
+        while (this->available() < count) {
+            if (!this->fill())
+                return false;
+        }
+        return true;
+    }
+};
+
+/*!
+ * \brief Output - накопление распакованных данных в блоки
+ */
+struct Output
+{
+    std::function<bool(const QByteArray &)> deliver; //! Передача блока (false — остановка)
+    QByteArray block;                                //! Заполняемый блок
+    int used = 0;                                    //! Заполнено байт
+    char last = '\n';                                //! Последний выданный байт
+
+    //! Свободное место в блоке (блок выделяется при необходимости)
+    char *space()
+    {
+        if (this->block.isEmpty()) {
+            this->block = QByteArray(StreamDecompressor::blockSize, Qt::Uninitialized);
+            this->used = 0;
+        }
+        return this->block.data() + this->used;
+    }
+    int room() const { return int(this->block.size()) - this->used; }
+
+    //! Учитывает count байт, записанных в space(); полный блок передаётся дальше
+    bool commit(int count)
+    {
+        if (count <= 0)
+            return true;
+        this->used += count;
+        this->last = this->block[this->used - 1];
+        return this->used < this->block.size() || this->flush();
+    }
+
+    //! Копирует данные в блоки
+    bool write(const char *data, int size)
+    {
+        while (size > 0) {
+            char *target = this->space();
+            const int count = qMin(size, this->room());
+            std::memcpy(target, data, size_t(count));
+            if (!this->commit(count))
+                return false;
+            data += count;
+            size -= count;
+        }
+        return true;
+    }
+
+    //! Передаёт неполный блок
+    bool flush()
+    {
+        if (this->used == 0)
+            return true;
+        this->block.resize(this->used);
+        const bool delivered = this->deliver(this->block);
+        this->block = QByteArray();
+        this->used = 0;
+        return delivered;
+    }
+};
+
+/*!
+ * \brief Status - результат распаковки
+ */
+enum class Status { Done, Stopped, Failed };
+
+#ifdef SATELLITES_HAVE_ZLIB
+//! Распаковка одного потока deflate до его конца
+Status inflateStream(z_stream &stream, Input &in, Output &out, QString &error)
+{
+    bool outputFull = false; //! При заполненном блоке zlib может выдать данные без нового ввода
+    for (;;) {
+        if (in.available() == 0 && !outputFull && !in.fill()) {
+            error = in.error.isEmpty() ? QObject::tr("Архив обрезан") : in.error;
+            return Status::Failed;
+        }
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in.data()));
+        stream.avail_in = uInt(in.available());
+        stream.next_out = reinterpret_cast<Bytef *>(out.space());
+        stream.avail_out = uInt(out.room());
+        const int result = inflate(&stream, Z_NO_FLUSH);
+        outputFull = stream.avail_out == 0;
+        in.consume(in.available() - int(stream.avail_in));
+        if (!out.commit(out.room() - int(stream.avail_out)))
+            return Status::Stopped;
+        if (result == Z_STREAM_END)
+            return Status::Done;
+        if (result != Z_OK && result != Z_BUF_ERROR) {
+            error = QObject::tr("Повреждённые сжатые данные: %1")
+                        .arg(QString::fromLatin1(stream.msg ? stream.msg : "zlib"));
+            return Status::Failed;
+        }
+    }
+}
+
+//! gzip: склеенные потоки (как у "cat a.gz b.gz") распаковываются подряд
+Status decodeGzip(Input &in, Output &out, QString &error)
+{
+    z_stream stream{};
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+        error = QObject::tr("Не удалось инициализировать zlib");
+        return Status::Failed;
+    }
+    Status status;
+    for (;;) {
+        status = inflateStream(stream, in, out, error);
+        if (status != Status::Done || !in.ensure(2) || quint8(in.data()[0]) != 0x1f
+            || quint8(in.data()[1]) != 0x8b)
+            break; //! Байты после последнего потока (например, нули выравнивания) не читаются
+        inflateReset(&stream);
+    }
+    inflateEnd(&stream);
+    if (status == Status::Done && !in.error.isEmpty()) {
+        error = in.error;
+        return Status::Failed;
+    }
+    return status;
+}
+
+/*!
+ * \brief decodeZip - распаковка файлов архива ZIP по локальным заголовкам
+ * \details Центральный каталог в конце архива не нужен: файлы читаются по порядку,
+ * поэтому архив распаковывается за один проход и из неперематываемого источника.
+ */
+Status decodeZip(Input &in, Output &out, QString &error)
+{
+    constexpr quint32 localHeader = 0x04034b50;
+    constexpr quint32 descriptorSignature = 0x08074b50;
+    constexpr int headerSize = 30;
+
+    z_stream stream{};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        error = QObject::tr("Не удалось инициализировать zlib");
+        return Status::Failed;
+    }
+    auto fail = [&](const QString &message) {
+        error = message;
+        inflateEnd(&stream);
+        return Status::Failed;
+    };
+
+    //! Архив заканчивается центральным каталогом или просто концом данных
+    while (in.ensure(4) && littleEndian(in.data(), 4) == localHeader) {
+        if (!in.ensure(headerSize))
+            return fail(QObject::tr("Архив ZIP обрезан"));
+        const quint32 flags = littleEndian(in.data() + 6, 2);
+        const quint32 method = littleEndian(in.data() + 8, 2);
+        qint64 compressedSize = littleEndian(in.data() + 18, 4);
+        const quint32 uncompressedSize = littleEndian(in.data() + 22, 4);
+        const int nameLength = int(littleEndian(in.data() + 26, 2));
+        const int extraLength = int(littleEndian(in.data() + 28, 2));
+        if (!in.ensure(headerSize + nameLength + extraLength))
+            return fail(QObject::tr("Архив ZIP обрезан"));
+        const bool directory = nameLength > 0 && in.data()[headerSize + nameLength - 1] == '/';
+
+        //! ZIP64: настоящие размеры — в дополнительном поле 0x0001. В нём по порядку
+        //! перечислены только те размеры, которые в заголовке равны 0xFFFFFFFF:
+        //! сначала исходный, затем сжатый (по 8 байт)
+        bool zip64 = false;
+        for (int at = headerSize + nameLength; at + 4 <= headerSize + nameLength + extraLength;) {
+            const quint32 id = littleEndian(in.data() + at, 2);
+            const int size = int(littleEndian(in.data() + at + 2, 2));
+            if (id == 0x0001 && at + 4 + size <= headerSize + nameLength + extraLength) {
+                zip64 = true;
+                const int offset = uncompressedSize == 0xFFFFFFFFu ? 8 : 0;
+                if (compressedSize == 0xFFFFFFFFLL && size >= offset + 8)
+                    compressedSize = qint64(littleEndian(in.data() + at + 4 + offset + 4, 4)) << 32
+                                     | littleEndian(in.data() + at + 4 + offset, 4);
+            }
+            at += 4 + size;
+        }
+        in.consume(headerSize + nameLength + extraLength);
+
+        if (flags & 0x1)
+            return fail(QObject::tr("Зашифрованные архивы ZIP не поддерживаются"));
+        //! Файлы архива разделяются переводом строки, чтобы записи не склеились
+        if (!directory && out.last != '\n' && !out.write("\n", 1)) {
+            inflateEnd(&stream);
+            return Status::Stopped;
+        }
+
+        if (method == 8) {
+            inflateReset(&stream);
+            const Status status = inflateStream(stream, in, out, error);
+            if (status != Status::Done) {
+                inflateEnd(&stream);
+                return status;
+            }
+        } else if (method == 0 && !(flags & 0x8)) {
+            for (qint64 left = compressedSize; left > 0;) {
+                if (in.available() == 0 && !in.fill())
+                    return fail(QObject::tr("Архив ZIP обрезан"));
+                const int count = int(qMin<qint64>(left, in.available()));
+                if (!directory && !out.write(in.data(), count)) {
+                    inflateEnd(&stream);
+                    return Status::Stopped;
+                }
+                in.consume(count);
+                left -= count;
+            }
+        } else {
+            return fail(QObject::tr("Метод сжатия ZIP %1 не поддерживается").arg(method));
+        }
+
+        //! Дескриптор данных после файла: сигнатура (необязательная), CRC и размеры
+        if (flags & 0x8) {
+            if (in.ensure(4) && littleEndian(in.data(), 4) == descriptorSignature)
+                in.consume(4);
+            const int descriptorSize = zip64 ? 20 : 12;
+            if (!in.ensure(descriptorSize))
+                return fail(QObject::tr("Архив ZIP обрезан"));
+            in.consume(descriptorSize);
+        }
+    }
+    inflateEnd(&stream);
+    if (!in.error.isEmpty()) {
+        error = in.error;
+        return Status::Failed;
+    }
+    return Status::Done;
+}
+#endif
+
+#ifdef SATELLITES_HAVE_LZMA
+//! xz: склеенные потоки распаковываются подряд (LZMA_CONCATENATED)
+Status decodeXz(Input &in, Output &out, QString &error)
+{
+    lzma_stream stream = LZMA_STREAM_INIT;
+    if (lzma_stream_decoder(&stream, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {
+        error = QObject::tr("Не удалось инициализировать liblzma");
+        return Status::Failed;
+    }
+    lzma_action action = LZMA_RUN;
+    Status status = Status::Done;
+    for (;;) {
+        if (in.available() == 0 && action == LZMA_RUN && !in.fill()) {
+            if (!in.error.isEmpty()) {
+                error = in.error;
+                status = Status::Failed;
+                break;
+            }
+            action = LZMA_FINISH;
+        }
+        stream.next_in = reinterpret_cast<const uint8_t *>(in.data());
+        stream.avail_in = size_t(in.available());
+        stream.next_out = reinterpret_cast<uint8_t *>(out.space());
+        stream.avail_out = size_t(out.room());
+        const lzma_ret result = lzma_code(&stream, action);
+        in.consume(in.available() - int(stream.avail_in));
+        if (!out.commit(out.room() - int(stream.avail_out))) {
+            status = Status::Stopped;
+            break;
+        }
+        if (result == LZMA_STREAM_END)
+            break;
+        if (result != LZMA_OK) {
+            error = result == LZMA_BUF_ERROR ? QObject::tr("Архив обрезан")
+                                             : QObject::tr("Повреждённые данные xz (код %1)")
+                                                   .arg(int(result));
+            status = Status::Failed;
+            break;
+        }
+    }
+    lzma_end(&stream);
+    return status;
+}
+#endif
+
+} // namespace
+
+Compression StreamDecompressor::detect(const QByteArray &head)
+{
+    if (head.startsWith("\x1f\x8b"))
+        return Compression::Gzip;
+    if (head.startsWith("PK\x03\x04"))
+        return Compression::Zip;
+    if (head.startsWith(QByteArray("\xfd" "7zXZ\x00", 6)))
+        return Compression::Xz;
+    return Compression::None;
+}
+
+bool StreamDecompressor::isSupported(Compression compression)
+{
+    switch (compression) {
+    case Compression::None:
+        return true;
+    case Compression::Gzip:
+    case Compression::Zip:
+#ifdef SATELLITES_HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case Compression::Xz:
+#ifdef SATELLITES_HAVE_LZMA
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+QString StreamDecompressor::plainSuffix(const QString &fileName)
+{
+    static const QStringList archiveSuffixes = {QStringLiteral("gz"),
+                                                QStringLiteral("gzip"),
+                                                QStringLiteral("zip"),
+                                                QStringLiteral("xz")};
+    QString name = QFileInfo(fileName).fileName();
+    const QString suffix = QFileInfo(name).suffix();
+    if (archiveSuffixes.contains(suffix, Qt::CaseInsensitive))
+        name.chop(suffix.size() + 1);
+    return QFileInfo(name).suffix();
+}
+
+StreamDecompressor::StreamDecompressor(QIODevice *source, Compression compression, QObject *parent)
+    : QIODevice(parent)
+    , source_(source)
+    , compression_(compression)
+    , blocks_(size_t(queueBlocks))
+{}
+
+StreamDecompressor::~StreamDecompressor()
+{
+    this->close();
+}
+
+bool StreamDecompressor::open(OpenMode mode)
+{
+    if ((mode & ~Unbuffered) != ReadOnly || !this->source_ || !this->source_->isReadable()) {
+        this->setErrorString(tr("Устройство открывается только для чтения"));
+        return false;
+    }
+    if (!isSupported(this->compression_)) {
+        this->setErrorString(tr("Формат сжатия не поддерживается этой сборкой"));
+        return false;
+    }
+    this->stop_.store(false);
+    this->sourceBytes_.store(0);
+    this->error_.clear();
+    this->current_.clear();
+    this->currentPos_ = 0;
+    this->finished_ = false;
+    this->failed_ = false;
+    this->worker_.reset(QThread::create([this]() { this->run(); }));
+    this->worker_->start();
+    return QIODevice::open(mode);
+}
+
+void StreamDecompressor::close()
+{
+    if (this->worker_) {
+        //! Поток распаковки может ждать места в очереди: освобождаем её до его завершения
+        this->stop_.store(true);
+        QByteArray block;
+        while (!this->worker_->wait(10)) {
+            while (this->blocks_.tryPop(block)) {
+            }
+        }
+        while (this->blocks_.tryPop(block)) {
+        }
+        this->worker_.reset();
+    }
+    if (this->isOpen())
+        QIODevice::close();
+}
+
+bool StreamDecompressor::atEnd() const
+{
+    return this->finished_ && this->bytesAvailable() == 0;
+}
+
+qint64 StreamDecompressor::bytesAvailable() const
+{
+    return this->current_.size() - this->currentPos_ + QIODevice::bytesAvailable();
+}
+
+qint64 StreamDecompressor::readData(char *data, qint64 maxSize)
+{
+    //! Блок ждём, пока не заполнен запрошенный размер: так части получаются полными
+    qint64 copied = 0;
+    while (copied < maxSize) {
+        if (this->currentPos_ == this->current_.size()) {
+            if (this->finished_)
+                break;
+            this->current_ = this->blocks_.pop();
+            this->currentPos_ = 0;
+            if (this->current_.isEmpty()) {
+                this->finished_ = true;
+                if (!this->error_.isEmpty()) {
+                    this->failed_ = true;
+                    this->setErrorString(this->error_);
+                }
+                break;
+            }
+        }
+        const int count = int(qMin<qint64>(maxSize - copied, this->current_.size() - this->currentPos_));
+        std::memcpy(data + copied, this->current_.constData() + this->currentPos_, size_t(count));
+        this->currentPos_ += count;
+        copied += count;
+    }
+    return copied == 0 && this->failed_ ? -1 : copied;
+}
+
+qint64 StreamDecompressor::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+    return -1; //! Устройство только для чтения
+}
+
+void StreamDecompressor::run()
+{
+    auto stopped = [this]() { return this->stop_.load(std::memory_order_relaxed); };
+    Input in{this->source_, &this->sourceBytes_};
+    Output out;
+    out.deliver = [this, &stopped](const QByteArray &block) {
+        return this->blocks_.pushUntil(block, stopped);
+    };
+
+    QString error;
+    Status status = Status::Failed;
+    switch (this->compression_) {
+#ifdef SATELLITES_HAVE_ZLIB
+    case Compression::Gzip:
+        status = decodeGzip(in, out, error);
+        break;
+    case Compression::Zip:
+        status = decodeZip(in, out, error);
+        break;
+#endif
+#ifdef SATELLITES_HAVE_LZMA
+    case Compression::Xz:
+        status = decodeXz(in, out, error);
+        break;
+#endif
+    case Compression::None:
+        //! Данные без сжатия передаются как есть
+        while (in.fill()) {
+            if (!out.write(in.data(), in.available())) {
+                status = Status::Stopped;
+                break;
+            }
+            in.consume(in.available());
+        }
+        if (status != Status::Stopped)
+            status = in.error.isEmpty() ? Status::Done : Status::Failed;
+        error = in.error;
+        break;
+    default:
+        error = tr("Формат сжатия не поддерживается этой сборкой");
+        break;
+    }
+    if (status == Status::Done && !out.flush())
+        status = Status::Stopped;
+    if (status == Status::Stopped)
+        return;
+
+    this->error_ = error; //! Читается потребителем после признака конца
+    this->blocks_.pushUntil(QByteArray(), stopped);
+}
@@ -0,0 +1,143 @@
+/*!
+ * \file StreamDecompressor.hpp
+ * \brief Заголовочный файл для потоковой распаковки сжатых файлов
+ * \details
+ * Этот файл содержит определение класса StreamDecompressor — устройства ввода,
+ * которое распаковывает архивы gzip, ZIP и xz по мере чтения.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef STREAMDECOMPRESSOR_HPP
+#define STREAMDECOMPRESSOR_HPP
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+#include <QThread>
+
+#include <atomic>
+#include <memory>
+
+#include "BoundedQueue.hpp"
+
+/*!
+ * \brief Compression - формат сжатия
+ */
+enum class Compression : quint8 {
+    None, //! Данные не сжаты
+    Gzip, //! gzip (в том числе несколько склеенных потоков)
+    Zip,  //! ZIP (файлы архива читаются подряд)
+    Xz    //! xz (LZMA2)
+};
+
+/*!
+ * \brief Класс StreamDecompressor
+ * \details
+ * Последовательное устройство только для чтения поверх исходного устройства
+ * (файла, буфера ответа сети). Распаковка идёт в отдельном потоке блоками
+ * по blockSize байт через очередь BoundedQueue, поэтому вызывающий поток
+ * разбирает очередной блок, пока следующий распаковывается. Временные файлы
+ * не создаются, в памяти находится не больше queueBlocks блоков.
+ *
+ * gzip и ZIP распаковываются zlib, xz — liblzma; если библиотека не найдена
+ * при сборке, формат определяется, но isSupported() для него возвращает false.
+ * В ZIP поддерживаются методы stored и deflate; содержимое всех файлов архива
+ * выдаётся подряд, разделённое переводом строки.
+ *
+ * Исходное устройство читается только потоком распаковки от open() до close()
+ * и должно оставаться открытым всё это время.
+ */
+class StreamDecompressor : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    static constexpr int blockSize = 1 << 20; //! Размер блока распакованных данных
+    static constexpr int queueBlocks = 8;     //! Блоков, распакованных с опережением
+    static constexpr int magicSize = 6;       //! Байт, достаточных для detect()
+
+    /*!
+     * \brief detect - определение формата сжатия по первым байтам
+     * \param head Начало данных (не меньше magicSize байт)
+     * \return Формат сжатия или Compression::None
+     */
+    static Compression detect(const QByteArray &head);
+
+    /*!
+     * \brief isSupported - поддерживается ли распаковка формата в этой сборке
+     */
+    static bool isSupported(Compression compression);
+
+    /*!
+     * \brief plainSuffix - расширение файла без расширения архива
+     * \param fileName Имя файла или путь URL ("catalog.json.gz" → "json")
+     * \details Используется как подсказка формата для OmmParser::detectFormat.
+     */
+    static QString plainSuffix(const QString &fileName);
+
+    /*!
+     * \brief StreamDecompressor - конструктор
+     * \param source Исходное устройство, открытое для чтения
+     * \param compression Формат сжатия
+     * \param parent Родитель объекта
+     */
+    StreamDecompressor(QIODevice *source, Compression compression, QObject *parent = nullptr);
+
+    /*!
+     * \brief ~StreamDecompressor - деструктор; останавливает поток распаковки
+     */
+    ~StreamDecompressor() override;
+
+    /*!
+     * \brief open - открытие и запуск потока распаковки
+     * \param mode Только QIODevice::ReadOnly (допускается Unbuffered)
+     */
+    bool open(OpenMode mode) override;
+
+    /*!
+     * \brief close - остановка потока распаковки и закрытие
+     */
+    void close() override;
+
+    bool isSequential() const override { return true; }
+    bool atEnd() const override;
+    qint64 bytesAvailable() const override;
+
+    /*!
+     * \brief sourceBytesRead - прочитано байт исходного (сжатого) устройства
+     * \details Подходит для индикации хода обработки. Можно вызывать из любого потока.
+     */
+    qint64 sourceBytesRead() const { return this->sourceBytes_.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief failed - распаковка завершилась ошибкой (текст — errorString())
+     * \details Известно после того, как чтение вернуло все данные.
+     */
+    bool failed() const { return this->failed_; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    /*!
+     * \brief run - распаковка (выполняется в потоке распаковки)
+     */
+    void run();
+
+    QIODevice *source_;                  //! Исходное устройство
+    Compression compression_;            //! Формат сжатия
+    BoundedQueue<QByteArray> blocks_;    //! Распакованные блоки; пустой блок — конец данных
+    std::unique_ptr<QThread> worker_;    //! Поток распаковки
+    std::atomic<bool> stop_{false};      //! Требование остановить распаковку
+    std::atomic<qint64> sourceBytes_{0}; //! Прочитано байт исходного устройства
+    QString error_;                      //! Ошибка распаковки (читается после признака конца)
+
+    QByteArray current_;    //! Блок, из которого идёт чтение
+    int currentPos_ = 0;    //! Позиция чтения в блоке
+    bool finished_ = false; //! Получен признак конца данных
+    bool failed_ = false;   //! Распаковка завершилась ошибкой
+};
+
+#endif // STREAMDECOMPRESSOR_HPP
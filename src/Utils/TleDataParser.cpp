@@ -0,0 +1,397 @@
+/*!
+ * \file TleDataParser.cpp
+ * \brief Разбор данных TLE и OMM в памяти
+ * \details
+ * Этот файл содержит реализацию класса TleDataParser.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "TleDataParser.hpp"
+
+#include <QBuffer>
+
+#include <cstring>
+
+#include "TleUtils.hpp"
+
+namespace {
+
+/*!
+ * \brief Шаблоны столбцов строк TLE (те же ограничения, что у регулярных выражений формата)
+ * \details
+ * 'd' — цифра, 's' — цифра или пробел, 'N' — цифра или буква Alpha-5 (первый символ
+ * номера объекта), '.' — любой символ, 'C' — класс [UCS ],
+ * 'M' — знак [- +], 'S' — знак [-+ ], 'E' — знак [-+], 'T' — тип эфемерид [0-4],
+ * остальные символы должны совпадать буквально. Часть запуска первой строки
+ * ([A-Z ]{1,3}) имеет переменную длину и проверяется отдельно между началом и концом.
+ */
+const char line1Head[] = "1 NddddC ddddd";
+const char line1Tail[] = " ddd........... M.dddddddd SdddddSd SdddddEd T ssssd";
+const char line2Pattern[] = "2 Ndddd sss.ssss sss.ssss ddddddd sss.ssss sss.ssss ss.sssssssssssssd";
+
+constexpr int line1HeadSize = sizeof(line1Head) - 1;
+constexpr int line1TailSize = sizeof(line1Tail) - 1;
+constexpr int line2Size = sizeof(line2Pattern) - 1;
+constexpr int pieceOffset = line1HeadSize; //! Начало части запуска в первой строке
+constexpr int fullPiece = 3;               //! Длина части запуска в стандартной строке
+
+//! Проверка символов строки line начиная с from по шаблону pattern длины size
+bool matchesPattern(TleText line, int from, const char *pattern, int size)
+{
+    const char *data = line.data() + from;
+    for (int i = 0; i < size; ++i) {
+        const char c = data[i];
+        const bool digit = c >= '0' && c <= '9';
+        bool ok = false;
+        switch (pattern[i]) {
+        case 'd': ok = digit; break;
+        case 's': ok = digit || c == ' '; break;
+        case 'N': ok = digit || TleUtils::alpha5Value(c) >= 0; break;
+        case '.': ok = c != '\n'; break;
+        case 'C': ok = c == 'U' || c == 'C' || c == 'S' || c == ' '; break;
+        case 'M': ok = c == '-' || c == ' ' || c == '+'; break;
+        case 'S': ok = c == '-' || c == '+' || c == ' '; break;
+        case 'E': ok = c == '-' || c == '+'; break;
+        case 'T': ok = c >= '0' && c <= '4'; break;
+        default: ok = c == pattern[i]; break;
+        }
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+//! Проверка формата первой строки TLE
+bool isLine1(TleText line)
+{
+    const int piece = line.size() - line1HeadSize - line1TailSize;
+    if (piece < 1 || piece > fullPiece || !matchesPattern(line, 0, line1Head, line1HeadSize))
+        return false;
+    for (int i = pieceOffset; i < pieceOffset + piece; ++i) {
+        const char c = line.at(i);
+        if (!((c >= 'A' && c <= 'Z') || c == ' '))
+            return false;
+    }
+    return matchesPattern(line, pieceOffset + piece, line1Tail, line1TailSize);
+}
+
+//! Проверка формата второй строки TLE
+bool isLine2(TleText line)
+{
+    return line.size() == line2Size && matchesPattern(line, 0, line2Pattern, line2Size);
+}
+
+//! Целое из поля фиксированной ширины (пробелы по краям допускаются, иначе 0 при ошибке)
+int fieldToInt(TleText field)
+{
+    const TleText s = field.trimmed();
+    int i = 0;
+    bool negative = false;
+    if (i < s.size() && (s.at(i) == '-' || s.at(i) == '+'))
+        negative = s.at(i++) == '-';
+    if (i == s.size())
+        return 0;
+    int value = 0;
+    for (; i < s.size(); ++i) {
+        const char c = s.at(i);
+        if (c < '0' || c > '9')
+            return 0;
+        value = value * 10 + (c - '0');
+    }
+    return negative ? -value : value;
+}
+
+//! Число из поля фиксированной ширины (0 при ошибке)
+double fieldToDouble(TleText field)
+{
+    const TleText s = field.trimmed();
+    return QByteArray(s.data(), s.size()).toDouble();
+}
+
+} // namespace
+
+TleDataParser::TleDataParser(TleFields fields)
+    : fields_(fields | baseTleFields)
+{}
+
+TleParseResult TleDataParser::parse(const QByteArray &data,
+                                    const QString &contentType,
+                                    const QString &fileName)
+{
+    TleParseResult result;
+    if (data.trimmed().isEmpty()) {
+        result.error = tr("Ответ от сервера пустой.");
+        return result;
+    }
+
+    this->reset(); //! Строки нового каталога — в новой арене
+
+    const Compression compression = StreamDecompressor::detect(data);
+    if (compression != Compression::None) {
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+        QString error;
+        if (!this->parseCompressed(buffer,
+                                   compression,
+                                   StreamDecompressor::plainSuffix(fileName),
+                                   result.records,
+                                   error))
+            result.error = error.isEmpty() ? tr("Не удалось разобрать TLE данные.")
+                                           : tr("Ошибка распаковки ответа: %1").arg(error);
+        return result;
+    }
+
+    //! Подсказкой формата служит тип содержимого
+    if (!this->parseData(data, contentType, result.records))
+        result.error = tr("Не удалось разобрать TLE данные.");
+    return result;
+}
+
+bool TleDataParser::parseData(const QByteArray &data,
+                              const QString &formatHint,
+                              QVector<TleRecord> &outRecords)
+{
+    const TleFormat format = OmmParser::detectFormat(data, formatHint); //! Определяем формат
+    if (format == TleFormat::Tle)
+        return this->parseText(data, outRecords); //! 2LE/3LE
+
+    //! OMM (JSON, CSV или XML) разбирается напрямую из байтового буфера
+    return OmmParser().parse(data, format, outRecords);
+}
+
+bool TleDataParser::parseCompressed(QIODevice &source,
+                                    Compression compression,
+                                    const QString &formatHint,
+                                    QVector<TleRecord> &outRecords,
+                                    QString &error)
+{
+    StreamDecompressor decompressor(&source, compression);
+    if (!decompressor.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        error = decompressor.errorString();
+        return false;
+    }
+
+    //! Формат определяется по началу распакованных данных
+    QByteArray pending = decompressor.read(StreamDecompressor::blockSize);
+    const TleFormat format = OmmParser::detectFormat(pending, formatHint);
+    if (format != TleFormat::Tle) {
+        //! Документ OMM разбирается целиком
+        pending += decompressor.readAll();
+        if (decompressor.failed()) {
+            error = decompressor.errorString();
+            return false;
+        }
+        return OmmParser().parse(pending, format, outRecords);
+    }
+
+    //! Пока разбирается блок, поток распаковки готовит следующие
+    for (;;) {
+        pending.remove(0, int(this->parseChunk(pending, outRecords)));
+        const QByteArray block = decompressor.read(StreamDecompressor::blockSize);
+        if (block.isEmpty())
+            break;
+        pending += block;
+    }
+    if (decompressor.failed()) {
+        error = decompressor.errorString();
+        return false;
+    }
+    pending += '\n'; //! Последняя строка файла может не заканчиваться переводом строки
+    this->parseChunk(pending, outRecords);
+    return !outRecords.isEmpty();
+}
+
+bool TleDataParser::parseText(const QByteArray &data, QVector<TleRecord> &outRecords)
+{
+    //! Разбиваем данные на строки (\r\n, \n или \r), пропуская пустые строки
+    QVector<TleText> lines;
+    const char *position = data.constData();
+    const char *end = position + data.size();
+    while (position < end) {
+        const char *eol = position;
+        while (eol < end && *eol != '\n' && *eol != '\r')
+            ++eol;
+        if (eol > position)
+            lines.append(TleText(position, int(eol - position)));
+        position = eol + 1;
+    }
+    const int before = int(outRecords.size());
+    this->parseLines(lines, outRecords);
+    return outRecords.size() > before;
+}
+
+qint64 TleDataParser::parseChunk(const QByteArray &data, QVector<TleRecord> &outRecords)
+{
+    QVector<TleText> lines;   //! Полные непустые строки фрагмента
+    QVector<qint64> lineEnds; //! Смещение за концом каждой строки
+    qint64 pos = 0;
+    while (pos < data.size()) {
+        const qint64 eol = data.indexOf('\n', pos);
+        if (eol < 0)
+            break; //! Строка ещё не дописана
+        TleText line(data.constData() + pos, int(eol - pos));
+        if (!line.isEmpty() && line.at(line.size() - 1) == '\r')
+            line = line.mid(0, line.size() - 1);
+        pos = eol + 1;
+        if (line.isEmpty())
+            continue;
+        lines.append(line);
+        lineEnds.append(pos);
+    }
+
+    //! Байты после последней полной записи разбираются со следующей порцией
+    const int used = this->parseLines(lines, outRecords);
+    return used > 0 ? lineEnds[used - 1] : 0;
+}
+
+int TleDataParser::parseLines(const QVector<TleText> &lines, QVector<TleRecord> &outRecords)
+{
+    if (!this->arena_)
+        this->arena_ = std::make_shared<TleStringArena>();
+
+    int used = 0; //! Строк в полных записях
+    int i = 0;    //! Индекс для перебора строк
+    while (i < lines.size()) {
+        TleText nameLine, line1, line2;
+        //! Проверка, что файл в формате 2LE или 3LE
+        if (i + 2 < lines.size() && !lines[i].startsWith("1 ") && !lines[i].startsWith("2 ")) {
+            //! 3LE (с именем)
+            nameLine = lines[i];
+            line1 = lines[i + 1].trimmed();
+            line2 = lines[i + 2].trimmed();
+            i += 3;
+        } else if (i + 1 < lines.size()
+                   && (lines[i].startsWith("1 ") || lines[i].startsWith("2 "))) {
+            //! 2LE (без имени)
+            line1 = lines[i].trimmed();
+            line2 = lines[i + 1].trimmed();
+            i += 2;
+        } else
+            break; //! Запись ещё не дописана
+        used = i;
+
+        TleRecord rec; //! Создаем новую запись TLE
+        if (this->parseSingleTle(nameLine, line1, line2, rec))
+            outRecords.append(rec); //! Добавляем запись в список записей
+    }
+    return used;
+}
+
+bool TleDataParser::parseSingleTle(TleText nameLine, TleText l1, TleText l2, TleRecord &outRecord)
+{
+    //! Формат проверяется по столбцам, без выделения подстрок
+    if (!isLine1(l1) || !isLine2(l2))
+        return false;
+
+    if (!this->checkTleLine(l1) || !this->checkTleLine(l2))
+        return false; //! Если контрольные суммы не совпадают, возвращаем false
+
+    //! Строки копируются в арену каталога, поля записи ссылаются на неё
+    outRecord.strings = this->arena_;
+    outRecord.name = this->arena_->append(nameLine); //! Записываем имя спутника или объекта
+    outRecord.line1 = this->arena_->append(l1);      //! Записываем первую строку TLE
+    outRecord.line2 = this->arena_->append(l2);      //! Записываем вторую строку TLE
+
+    //! Декодируются только запрошенные поля, остальные — по требованию (decodeFields)
+    outRecord.decodedFields = {};
+    decodeFields(outRecord, this->fields_);
+    return true;
+}
+
+void TleDataParser::decodeFields(TleRecord &record, TleFields fields)
+{
+    const TleFields missing = fields & ~record.decodedFields;
+    if (!missing)
+        return;
+
+    const TleText l1 = record.line1;
+    const TleText l2 = record.line2;
+    //! Поля после части запуска сдвигаются, если она короче трёх символов
+    const int piece = l1.size() - line1HeadSize - line1TailSize;
+    const int shift = piece - fullPiece;
+
+    //! Текстовые поля — представления строк TLE записи, без копирования
+    if (missing & TleField::CatalogNumber)
+        record.catalogNumber = TleUtils::parseCatalogNumber(l1.mid(2, 5));
+    if (missing & TleField::Classification)
+        record.classification = l1.mid(7, 1).trimmed();
+    if (missing & TleField::Designator) {
+        record.yearLaunch = fieldToInt(l1.mid(9, 2));
+        record.numberLaunch = fieldToInt(l1.mid(11, 3));
+        record.launchPiece = l1.mid(pieceOffset, piece).trimmed();
+    }
+    if (missing & TleField::Epoch) {
+        record.epochYearSuffix = fieldToInt(l1.mid(18 + shift, 2));
+        record.epochTime = fieldToDouble(l1.mid(20 + shift, 12));
+    }
+    if (missing & TleField::Derivatives) {
+        record.meanMotionFirstDerivative = fieldToDouble(l1.mid(33 + shift, 10));
+        //! Вторая производная записана в экспоненциальном виде ("12345-5" = 0.12345e-5)
+        record.meanMotionSecondDerivative = TleUtils::parseTleExponent(l1.mid(44 + shift, 8));
+    }
+    if (missing & TleField::Drag)
+        record.brakingCoefficient = l1.mid(53 + shift, 8).trimmed();
+    if (missing & TleField::ElementSet) {
+        record.ephemerisType = fieldToInt(l1.mid(62 + shift, 1));
+        record.elementSetNumber = fieldToInt(l1.mid(64 + shift, 4));
+        record.checksum1 = fieldToInt(l1.mid(68 + shift, 1));
+        record.checksum2 = fieldToInt(l2.mid(68, 1));
+    }
+
+    if (missing & TleField::Inclination)
+        record.inclination = fieldToDouble(l2.mid(8, 8));
+    if (missing & TleField::RightAscension)
+        record.rightAscension = fieldToDouble(l2.mid(17, 8));
+    if (missing & TleField::Eccentricity) {
+        char digits[9] = {'0', '.'}; //! Десятичная точка в поле подразумевается
+        std::memcpy(digits + 2, l2.data() + 26, 7);
+        record.eccentricity = fieldToDouble(TleText(digits, 9));
+    }
+    if (missing & TleField::ArgPerigee)
+        record.argPerigee = fieldToDouble(l2.mid(34, 8));
+    if (missing & TleField::MeanAnomaly)
+        record.meanAnomaly = fieldToDouble(l2.mid(43, 8));
+    if (missing & TleField::MeanMotion)
+        record.meanMotion = fieldToDouble(l2.mid(52, 11));
+    if (missing & TleField::RevolutionNumber)
+        record.revolutionNumberOfEpoch = fieldToInt(l2.mid(63, 5));
+
+    record.decodedFields |= missing;
+}
+
+void TleDataParser::reset()
+{
+    this->arena_.reset();
+}
+
+void TleDataParser::setFields(TleFields fields)
+{
+    this->fields_ = fields | baseTleFields;
+}
+
+TleFields TleDataParser::fields() const
+{
+    return this->fields_;
+}
+
+bool TleDataParser::checkTleLine(TleText line)
+{
+    if (line.isEmpty())
+        return false;
+    const char last = line.at(line.size() - 1); //! последний символ
+    if (last < '0' || last > '9')
+        return false; //! не цифра
+    const int checksum = last - '0';
+    int sum = 0;
+    for (int i = 0; i < line.size() - 1; ++i) {
+        const char c = line.at(i); //! берем символы строки, кроме последнего
+        if (c >= '0' && c <= '9')
+            sum += c - '0'; //! цифра дает свое значение
+        else if (c == '-')
+            sum += 1; //! минус дает 1
+        // остальные символы дают 0
+    }
+    return (sum % 10) == checksum;
+}
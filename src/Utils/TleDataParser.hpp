@@ -0,0 +1,176 @@
+/*!
+ * \file TleDataParser.hpp
+ * \brief Заголовочный файл для класса TleDataParser.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \details
+ * Этот файл содержит определение класса TleDataParser, который разбирает
+ * данные 2LE/3LE и OMM, уже находящиеся в памяти или в открытом устройстве,
+ * в том числе сжатые gzip, ZIP или xz. Класс не является QObject и не обращается
+ * к сети, поэтому его можно создавать в любом потоке.
+ */
+#ifndef TLEDATAPARSER_HPP
+#define TLEDATAPARSER_HPP
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QIODevice>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+#include "OmmParser.hpp"
+#include "StreamDecompressor.hpp"
+#include "TleRecord.hpp"
+
+/*!
+ * \brief TleParseResult - результат разбора данных
+ */
+struct TleParseResult
+{
+    QVector<TleRecord> records; //! Разобранные записи
+    QString error;              //! Сообщение об ошибке (пусто, если записи разобраны)
+};
+
+/*!
+ * \brief Класс TleDataParser
+ * \details
+ * Разбор байтов без сети и сигналов: TleParser использует его для файлов
+ * и ответов сети, а TleUrlRefresher — для ответов, разбираемых в фоновом потоке.
+ * Записи ссылаются на арену строк разборщика; новая арена создаётся
+ * при каждом вызове parse() и после reset().
+ */
+class TleDataParser
+{
+    Q_DECLARE_TR_FUNCTIONS(TleDataParser)
+
+public:
+    /*!
+     * \brief TleDataParser - конструктор
+     * \param fields Поля, которые декодируются при разборе (вместе с baseTleFields)
+     */
+    explicit TleDataParser(TleFields fields = TleField::All);
+
+    /*!
+     * \brief parse - разбор данных, уже загруженных в память
+     * \param data Данные 2LE/3LE или OMM, в том числе сжатые
+     * \param contentType Тип содержимого (подсказка формата несжатых данных)
+     * \param fileName Имя файла или путь URL (подсказка формата содержимого архива)
+     * \return Записи и сообщение об ошибке, если не разобрано ни одной записи
+     */
+    TleParseResult parse(const QByteArray &data,
+                         const QString &contentType,
+                         const QString &fileName);
+
+    /*!
+     * \brief parseData - разбор несжатых данных
+     * \param data - данные в формате 2LE/3LE или OMM (JSON, CSV, XML)
+     * \param formatHint - расширение файла или MIME-тип, помогающий определить формат
+     * \param outRecords - вектор, в конец которого добавляются разобранные записи
+     * \return true, если была разобрана хотя бы одна запись
+     * \details
+     * Определяет формат данных и передаёт их в parseText или OmmParser.
+     */
+    bool parseData(const QByteArray &data,
+                   const QString &formatHint,
+                   QVector<TleRecord> &outRecords);
+
+    /*!
+     * \brief parseCompressed - разбор сжатых данных по мере распаковки
+     * \param source - устройство со сжатыми данными, открытое для чтения
+     * \param compression - формат сжатия
+     * \param formatHint - расширение файла без расширения архива
+     * \param outRecords - вектор, в конец которого добавляются разобранные записи
+     * \param error - выходной параметр для сообщения об ошибке распаковки
+     * \return true, если была разобрана хотя бы одна запись
+     * \details
+     * 2LE/3LE разбираются блоками через parseChunk, пока следующий блок распаковывается;
+     * OMM (JSON, CSV, XML) собирается целиком и разбирается после распаковки.
+     */
+    bool parseCompressed(QIODevice &source,
+                         Compression compression,
+                         const QString &formatHint,
+                         QVector<TleRecord> &outRecords,
+                         QString &error);
+
+    /*!
+     * \brief parseChunk - разбор фрагмента 2LE/3LE данных, дописанного в конец источника
+     * \param data - новые данные (могут заканчиваться неполной строкой или записью)
+     * \param outRecords - вектор, в конец которого добавляются разобранные записи
+     * \return Количество байт, занятых полными записями
+     * \details
+     * Разбираются только строки, завершённые переводом строки, и только полные записи.
+     * Байты после возвращённого смещения нужно передать повторно вместе
+     * со следующей порцией данных.
+     */
+    qint64 parseChunk(const QByteArray &data, QVector<TleRecord> &outRecords);
+
+    //! Следующие записи — в новой арене строк (новый каталог)
+    void reset();
+
+    //! Поля, которые декодируются при разборе (baseTleFields добавляются всегда)
+    void setFields(TleFields fields);
+
+    //! Поля, которые декодируются при разборе
+    TleFields fields() const;
+
+    /*!
+     * \brief decodeFields - декодирование недостающих полей записи из её строк TLE
+     * \param record Запись, разобранная этим классом
+     * \param fields Поля, которые нужны потребителю
+     * \details Уже декодированные поля повторно не разбираются.
+     */
+    static void decodeFields(TleRecord &record, TleFields fields);
+
+private:
+    /*!
+     * \brief parseText - разбор текста TLE данных
+     * \param data - данные 2LE/3LE
+     * \param outRecords - вектор, в конец которого добавляются разобранные записи
+     * \details
+     * Этот метод разбивает данные на строки и вызывает разбор записей (parseLines).
+     */
+    bool parseText(const QByteArray &data, QVector<TleRecord> &outRecords);
+
+    /*!
+     * \brief parseLines - разбор записей 2LE/3LE из непустых строк
+     * \param lines - строки (представления байтов исходных данных)
+     * \param outRecords - вектор, в конец которого добавляются разобранные записи
+     * \return Количество строк, занятых полными записями
+     */
+    int parseLines(const QVector<TleText> &lines, QVector<TleRecord> &outRecords);
+
+    /*!
+     * \brief parseSingleTle - разбор одной записи TLE
+     * \param nameLine - имя спутника или объекта (опционально)
+     * \param l1 - первая строка TLE (начинается с '1 ')
+     * \param l2 - вторая строка TLE (начинается с '2 ')
+     * \param outRecord - выходной параметр, куда будет записана разобранная запись TLE
+     * \return true, если разбор успешен, иначе false
+     * \details Строки копируются в арену arena_, поля записи ссылаются на неё.
+     */
+    bool parseSingleTle(TleText nameLine, TleText l1, TleText l2, TleRecord &outRecord);
+
+    /*!
+     * \brief checkTleLine - проверка контрольной суммы строки TLE
+     * \param line - строка TLE, которую нужно проверить
+     * \return true, если контрольная сумма верна, иначе false
+     */
+    static bool checkTleLine(TleText line);
+
+    /*!
+     * \brief fields_ - поля, декодируемые при разборе
+     */
+    TleFields fields_ = TleField::All;
+
+    /*!
+     * \brief arena_ - арена строк текущего каталога
+     * \details
+     * Создаётся заново для каждого каталога; записи держат её сами,
+     * поэтому она освобождается вместе с последней копией каталога.
+     */
+    std::shared_ptr<TleStringArena> arena_;
+};
+
+#endif // TLEDATAPARSER_HPP
@@ -0,0 +1,172 @@
+/*!
+ * \file TleFileWatcher.cpp
+ * \brief Слежение за файлом с TLE данными
+ * \details
+ * Этот файл содержит реализацию класса TleFileWatcher.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "TleFileWatcher.hpp"
+
+namespace {
+
+//! Размер участков файла, по которым обнаруживается перезапись
+constexpr qint64 printSize = 4096;
+
+//! Задержка по умолчанию перед чтением изменённого файла (мс)
+constexpr int defaultDebounce = 300;
+
+} // namespace
+
+TleFileWatcher::TleFileWatcher(QObject *parent)
+    : QObject(parent)
+{
+    this->debounceTimer_.setSingleShot(true); //! Таймер срабатывает один раз после последнего изменения
+    this->debounceTimer_.setInterval(defaultDebounce);
+
+    this->connect(&this->watcher_,
+                  &QFileSystemWatcher::fileChanged,
+                  this,
+                  &TleFileWatcher::onFileChanged);
+    this->connect(&this->debounceTimer_,
+                  &QTimer::timeout,
+                  this,
+                  &TleFileWatcher::processChanges);
+    this->connect(&this->parser_,
+                  &TleParser::errorOccurred,
+                  this,
+                  &TleFileWatcher::errorOccurred);
+}
+
+void TleFileWatcher::setFile(const QString &filePath)
+{
+    //! Перестаём следить за предыдущим файлом
+    if (!this->watcher_.files().isEmpty())
+        this->watcher_.removePaths(this->watcher_.files());
+
+    this->filePath_ = filePath;
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadOnly)) {
+        //! Хвост можно разбирать только у 2LE/3LE: JSON/XML/CSV перезагружаются целиком
+        const QByteArray head = file.peek(printSize);
+        this->appendable_ = StreamDecompressor::detect(head) == Compression::None
+                            && OmmParser::detectFormat(head, QFileInfo(filePath).suffix())
+                                   == TleFormat::Tle;
+        this->rememberState(file, file.size());
+    }
+    if (this->enabled_)
+        this->watcher_.addPath(filePath);
+}
+
+QString TleFileWatcher::filePath() const
+{
+    return this->filePath_;
+}
+
+void TleFileWatcher::setEnabled(bool enabled)
+{
+    if (this->enabled_ == enabled)
+        return;
+    this->enabled_ = enabled;
+
+    if (enabled) {
+        if (!this->filePath_.isEmpty()) {
+            this->watcher_.addPath(this->filePath_);
+            this->processChanges(); //! Учитываем изменения, сделанные до включения слежения
+        }
+    } else {
+        this->debounceTimer_.stop();
+        if (!this->watcher_.files().isEmpty())
+            this->watcher_.removePaths(this->watcher_.files());
+    }
+}
+
+bool TleFileWatcher::isEnabled() const
+{
+    return this->enabled_;
+}
+
+void TleFileWatcher::setDebounceInterval(int msecs)
+{
+    this->debounceTimer_.setInterval(msecs);
+}
+
+void TleFileWatcher::onFileChanged()
+{
+    //! Перезапускаем таймер: файл читается только после паузы в записи
+    this->debounceTimer_.start();
+}
+
+QByteArray TleFileWatcher::fingerprint(QFile &file, qint64 offset, qint64 size)
+{
+    if (offset < 0 || size <= 0 || !file.seek(offset))
+        return QByteArray();
+    return file.read(size);
+}
+
+void TleFileWatcher::rememberState(QFile &file, qint64 offset)
+{
+    this->offset_ = offset;
+    this->headPrint_ = fingerprint(file, 0, qMin(printSize, offset));
+    this->tailPrint_ = fingerprint(file, qMax<qint64>(0, offset - printSize), qMin(printSize, offset));
+}
+
+void TleFileWatcher::processChanges()
+{
+    if (!this->enabled_ || this->filePath_.isEmpty())
+        return;
+
+    //! При атомарной замене файла (rename) QFileSystemWatcher перестаёт за ним следить
+    if (!this->watcher_.files().contains(this->filePath_) && QFileInfo::exists(this->filePath_))
+        this->watcher_.addPath(this->filePath_);
+
+    QFile file(this->filePath_);
+    if (!file.open(QIODevice::ReadOnly)) {
+        emit errorOccurred(tr("Не удалось открыть файл %1").arg(this->filePath_));
+        return;
+    }
+
+    //! Файл усечён или уже разобранная часть изменилась — нужна полная перезагрузка
+    const qint64 size = file.size();
+    const bool rewritten = size < this->offset_
+                           || fingerprint(file, 0, this->headPrint_.size()) != this->headPrint_
+                           || fingerprint(file,
+                                          this->offset_ - this->tailPrint_.size(),
+                                          this->tailPrint_.size())
+                                  != this->tailPrint_;
+    if (rewritten || !this->appendable_) {
+        file.close();
+        if (rewritten || size != this->offset_)
+            this->reloadAll();
+        return;
+    }
+    if (size == this->offset_)
+        return; //! Нет новых данных
+
+    //! Разбираем только дописанный хвост
+    file.seek(this->offset_);
+    const QByteArray tail = file.readAll();
+    QVector<TleRecord> added;
+    const qint64 consumed = this->parser_.parseChunk(tail, added);
+    if (consumed > 0)
+        this->rememberState(file, this->offset_ + consumed);
+    if (!added.isEmpty())
+        emit recordsAppended(added);
+}
+
+void TleFileWatcher::reloadAll()
+{
+    if (!this->parser_.loadFromFile(this->filePath_))
+        return; //! Ошибка уже передана через errorOccurred
+
+    QFile file(this->filePath_);
+    if (file.open(QIODevice::ReadOnly)) {
+        const QByteArray head = file.peek(printSize);
+        this->appendable_ = StreamDecompressor::detect(head) == Compression::None
+                            && OmmParser::detectFormat(head, QFileInfo(this->filePath_).suffix())
+                                   == TleFormat::Tle;
+        this->rememberState(file, file.size());
+    }
+    emit recordsReloaded(this->parser_.records());
+}
@@ -0,0 +1,135 @@
+/*!
+ * \file TleFileWatcher.hpp
+ * \brief Заголовочный файл для класса TleFileWatcher.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \details
+ * Этот файл содержит определение класса TleFileWatcher, который следит
+ * за изменением файла с TLE данными и разбирает только дописанные записи.
+ */
+#ifndef TLEFILEWATCHER_HPP
+#define TLEFILEWATCHER_HPP
+
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QTimer>
+
+#include "TleParser.hpp"
+
+/*!
+ * \brief Класс TleFileWatcher
+ * \details
+ * Построен на QFileSystemWatcher, поэтому в режиме ожидания не тратит процессорное время.
+ * Уведомления о записи объединяются таймером (debounce), чтобы не читать файл
+ * посреди записи. Если файл только дописан, разбирается лишь его хвост
+ * (неполные строки и записи откладываются до следующей записи).
+ * Если файл усечён или переписан, выполняется полная перезагрузка.
+ */
+class TleFileWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief TleFileWatcher - конструктор класса TleFileWatcher
+     * \param parent Родитель объекта
+     */
+    explicit TleFileWatcher(QObject *parent = nullptr);
+
+    /*!
+     * \brief setFile - задаёт отслеживаемый файл
+     * \param filePath Путь к файлу
+     * \details
+     * Текущее содержимое файла считается уже загруженным:
+     * запоминаются его размер и отпечатки для обнаружения перезаписи.
+     */
+    void setFile(const QString &filePath);
+
+    /*!
+     * \brief filePath
+     * \return Путь к отслеживаемому файлу
+     */
+    QString filePath() const;
+
+    /*!
+     * \brief setEnabled - включает или выключает слежение
+     * \param enabled true — следить за файлом
+     * \details При включении сразу проверяются изменения, сделанные с момента setFile().
+     */
+    void setEnabled(bool enabled);
+
+    /*!
+     * \brief isEnabled
+     * \return true, если слежение включено
+     */
+    bool isEnabled() const;
+
+    /*!
+     * \brief setDebounceInterval - задаёт задержку перед чтением изменённого файла
+     * \param msecs Задержка в миллисекундах
+     */
+    void setDebounceInterval(int msecs);
+
+signals:
+    /*!
+     * \brief recordsAppended - в конец файла дописаны новые записи
+     * \param records Новые записи
+     */
+    void recordsAppended(const QVector<TleRecord> &records);
+
+    /*!
+     * \brief recordsReloaded - файл был переписан и загружен заново
+     * \param records Все записи файла
+     */
+    void recordsReloaded(const QVector<TleRecord> &records);
+
+    /*!
+     * \brief errorOccurred - ошибка при чтении файла
+     * \param message Сообщение об ошибке
+     */
+    void errorOccurred(const QString &message);
+
+private slots:
+    /*!
+     * \brief onFileChanged - реакция на уведомление QFileSystemWatcher
+     */
+    void onFileChanged();
+
+    /*!
+     * \brief processChanges - чтение изменений после задержки
+     */
+    void processChanges();
+
+private:
+    /*!
+     * \brief fingerprint - отпечаток участка файла
+     * \param file Открытый файл
+     * \param offset Начало участка
+     * \param size Размер участка
+     */
+    static QByteArray fingerprint(QFile &file, qint64 offset, qint64 size);
+
+    /*!
+     * \brief rememberState - запоминает состояние файла после разбора до offset
+     * \param file Открытый файл
+     * \param offset Смещение за последней разобранной записью
+     */
+    void rememberState(QFile &file, qint64 offset);
+
+    /*!
+     * \brief reloadAll - полная перезагрузка файла
+     */
+    void reloadAll();
+
+    QFileSystemWatcher watcher_; //! Источник уведомлений об изменении файла
+    QTimer debounceTimer_;       //! Таймер для объединения уведомлений
+    TleParser parser_;           //! Парсер для разбора файла
+    QString filePath_;           //! Отслеживаемый файл
+    bool enabled_ = false;       //! Включено ли слежение
+    bool appendable_ = true;     //! Можно ли разбирать только хвост (2LE/3LE без сжатия, но не OMM)
+    qint64 offset_ = 0;          //! Смещение за последней разобранной записью
+    QByteArray headPrint_;       //! Отпечаток начала файла
+    QByteArray tailPrint_;       //! Отпечаток участка перед offset_
+};
+
+#endif // TLEFILEWATCHER_HPP
@@ -0,0 +1,672 @@
+/*!
+ * \file TleHistoryStore.cpp
+ * \brief Сжатое хранилище истории наборов элементов
+ * \details
+ * Этот файл содержит реализацию класса TleHistoryStore.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "TleHistoryStore.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDataStream>
+#include <QMutexLocker>
+#include <QObject>
+#include <QSaveFile>
+
+#include "OmmParser.hpp"
+#include "TleUtils.hpp"
+
+namespace {
+
+//! Сигнатура и версия формата файла хранилища
+constexpr quint32 storeMagic = 0x544C4548; // "TLEH"
+constexpr quint16 storeVersion = 1;
+
+//! Масштабы фиксированной точки для столбцов (0 — экспоненциальная запись TLE)
+constexpr double columnScales[] = {1e4, 1e4, 1e7, 1e4, 1e4, 1e8, 1e8, 0.0, 0.0, 1.0, 1.0};
+
+//! Zigzag-преобразование: малые по модулю числа → малые беззнаковые
+inline quint64 zigzag(qint64 value)
+{
+    return (quint64(value) << 1) ^ quint64(value >> 63);
+}
+
+inline qint64 unzigzag(quint64 value)
+{
+    return qint64(value >> 1) ^ -qint64(value & 1);
+}
+
+//! Количество значащих бит числа
+inline int bitWidth(quint64 value)
+{
+    int width = 0;
+    while (value) {
+        ++width;
+        value >>= 1;
+    }
+    return width;
+}
+
+/*!
+ * \brief packExponent - упаковывает число в экспоненциальной записи TLE в целое
+ * \details Мантисса из 5 цифр со знаком и порядок в диапазоне [-15, 15].
+ */
+qint64 packExponent(double value)
+{
+    if (value == 0.0 || !std::isfinite(value))
+        return 16;
+    const double magnitude = std::fabs(value);
+    int exponent = int(std::floor(std::log10(magnitude))) + 1;
+    qint64 mantissa = std::llround(magnitude / std::pow(10.0, exponent) * 1e5);
+    if (mantissa >= 100000) {
+        mantissa /= 10;
+        ++exponent;
+    }
+    if (exponent < -15)
+        return 16;
+    exponent = qMin(exponent, 15);
+    return (value < 0 ? -mantissa : mantissa) * 32 + (exponent + 16);
+}
+
+double unpackExponent(qint64 packed)
+{
+    const qint64 biased = ((packed % 32) + 32) % 32;
+    const qint64 mantissa = (packed - biased) / 32;
+    return double(mantissa) * 1e-5 * std::pow(10.0, int(biased) - 16);
+}
+
+//! Запись беззнакового числа в формате LEB128
+void writeVarint(QByteArray &out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+/*!
+ * \brief BitWriter - упаковка чисел заданной ширины в поток байт
+ */
+class BitWriter
+{
+public:
+    explicit BitWriter(QByteArray &out)
+        : out_(out)
+    {}
+
+    void write(quint64 value, int width)
+    {
+        int written = 0;
+        while (written < width) {
+            const int take = qMin(8 - bits_, width - written);
+            current_ |= unsigned((value >> written) & ((1u << take) - 1)) << bits_;
+            bits_ += take;
+            written += take;
+            if (bits_ == 8)
+                this->flush();
+        }
+    }
+
+    //! Дописывает неполный байт
+    void flush()
+    {
+        if (bits_ > 0)
+            out_.append(char(current_));
+        current_ = 0;
+        bits_ = 0;
+    }
+
+private:
+    QByteArray &out_;
+    unsigned current_ = 0; //! Текущий байт
+    int bits_ = 0;         //! Количество заполненных бит текущего байта
+};
+
+/*!
+ * \brief ByteReader - чтение LEB128 и упакованных чисел из блока
+ */
+class ByteReader
+{
+public:
+    explicit ByteReader(const QByteArray &data)
+        : data_(reinterpret_cast<const uchar *>(data.constData()))
+        , size_(data.size())
+    {}
+
+    quint64 readVarint()
+    {
+        quint64 value = 0;
+        int shift = 0;
+        while (pos_ < size_ && shift < 64) {
+            const uchar byte = data_[pos_++];
+            value |= quint64(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                break;
+            shift += 7;
+        }
+        return value;
+    }
+
+    uchar readByte() { return pos_ < size_ ? data_[pos_++] : 0; }
+
+    quint64 readBits(int width)
+    {
+        quint64 value = 0;
+        int read = 0;
+        while (read < width) {
+            if (bits_ == 0) {
+                current_ = this->readByte();
+                bits_ = 8;
+            }
+            const int take = qMin(bits_, width - read);
+            value |= quint64((current_ >> (8 - bits_)) & ((1u << take) - 1)) << read;
+            bits_ -= take;
+            read += take;
+        }
+        return value;
+    }
+
+    //! Пропускает остаток неполного байта
+    void alignToByte() { bits_ = 0; }
+
+private:
+    const uchar *data_;
+    qsizetype size_;
+    qsizetype pos_ = 0;
+    unsigned current_ = 0; //! Текущий байт
+    int bits_ = 0;         //! Количество непрочитанных бит текущего байта
+};
+
+/*!
+ * \brief encodeColumn - сжатие столбца
+ * \param values Значения столбца
+ * \param count Количество значений
+ * \param order Порядок разности (1 — delta, 2 — delta-of-delta)
+ * \param out Выходной буфер
+ * \details
+ * Первое значение пишется как LEB128, остатки — zigzag с общей шириной в битах.
+ */
+void encodeColumn(const qint64 *values, int count, int order, QByteArray &out)
+{
+    qint64 residuals[TleHistoryStore::blockSize];
+    quint64 maxResidual = 0;
+    for (int i = 1; i < count; ++i) {
+        qint64 residual = values[i] - values[i - 1];
+        if (order == 2 && i > 1)
+            residual -= values[i - 1] - values[i - 2];
+        residuals[i] = residual;
+        maxResidual |= zigzag(residual);
+    }
+    writeVarint(out, zigzag(values[0]));
+    if (count < 2)
+        return;
+    const int width = bitWidth(maxResidual);
+    out.append(char(width));
+    BitWriter writer(out);
+    for (int i = 1; i < count; ++i)
+        writer.write(zigzag(residuals[i]), width);
+    writer.flush();
+}
+
+//! Распаковка столбца, сжатого encodeColumn
+void decodeColumn(ByteReader &reader, int count, int order, qint64 *values)
+{
+    values[0] = unzigzag(reader.readVarint());
+    if (count < 2)
+        return;
+    const int width = reader.readByte();
+    qint64 delta = 0;
+    for (int i = 1; i < count; ++i) {
+        const qint64 residual = unzigzag(reader.readBits(width));
+        delta = (order == 2 && i > 1) ? delta + residual : residual;
+        values[i] = values[i - 1] + delta;
+    }
+    reader.alignToByte();
+}
+
+} // namespace
+
+void ElementSetSeries::append(const TleRecord &record)
+{
+    this->epochs.append(TleUtils::epochToUnixMicros(record));
+    this->meanMotion.append(record.meanMotion);
+    this->meanMotionDot.append(record.meanMotionFirstDerivative);
+    this->inclination.append(record.inclination);
+    this->eccentricity.append(record.eccentricity);
+    this->bstar.append(TleUtils::bstar(record));
+    this->elementSetNumbers.append(record.elementSetNumber);
+}
+
+TleHistoryStore::Row TleHistoryStore::rowFromRecord(const TleRecord &record)
+{
+    const double values[ColumnCount] = {record.inclination,
+                                        record.rightAscension,
+                                        record.eccentricity,
+                                        record.argPerigee,
+                                        record.meanAnomaly,
+                                        record.meanMotion,
+                                        record.meanMotionFirstDerivative,
+                                        record.meanMotionSecondDerivative,
+                                        TleUtils::bstar(record),
+                                        double(record.elementSetNumber),
+                                        double(record.revolutionNumberOfEpoch)};
+    Row row;
+    row.epoch = TleUtils::epochToUnixMicros(record);
+    for (int c = 0; c < ColumnCount; ++c)
+        row.values[c] = columnScales[c] > 0 ? std::llround(values[c] * columnScales[c])
+                                            : packExponent(values[c]);
+    return row;
+}
+
+TleRecord TleHistoryStore::baseRecord(int catalogNumber,
+                                      const ObjectHistory &object,
+                                      const std::shared_ptr<TleStringArena> &arena)
+{
+    TleRecord record{};
+    record.strings = arena;
+    record.name = arena->append(object.name);
+    record.catalogNumber = catalogNumber;
+    record.classification = arena->intern(object.classification);
+    record.yearLaunch = object.yearLaunch;
+    record.numberLaunch = object.numberLaunch;
+    record.launchPiece = arena->intern(object.launchPiece);
+    record.ephemerisType = object.ephemerisType;
+    return record;
+}
+
+TleRecord TleHistoryStore::recordFromRow(const TleRecord &base,
+                                         TleStringArena &arena,
+                                         const Row &row)
+{
+    auto value = [&row](Column c) { return double(row.values[c]) / columnScales[c]; };
+
+    TleRecord record = base;
+    TleUtils::unixMicrosToEpoch(row.epoch, record.epochYearSuffix, record.epochTime);
+
+    record.inclination = value(Inclination);
+    record.rightAscension = value(RightAscension);
+    record.eccentricity = value(Eccentricity);
+    record.argPerigee = value(ArgPerigee);
+    record.meanAnomaly = value(MeanAnomaly);
+    record.meanMotion = value(MeanMotion);
+    record.meanMotionFirstDerivative = value(MeanMotionDot);
+    record.meanMotionSecondDerivative = unpackExponent(row.values[MeanMotionDdot]);
+    record.brakingCoefficient = arena.intern(
+        OmmParser::toTleExponent(unpackExponent(row.values[Bstar])));
+    record.elementSetNumber = int(row.values[ElementSetNumber]);
+    record.revolutionNumberOfEpoch = int(row.values[RevolutionNumber]);
+    return record;
+}
+
+TleHistoryStore::Block TleHistoryStore::encodeBlock(const Row *rows, int count)
+{
+    Block block;
+    block.firstEpoch = rows[0].epoch;
+    block.lastEpoch = rows[count - 1].epoch;
+    block.count = count;
+
+    qint64 column[blockSize]; //! Значения одного столбца блока
+    for (int i = 0; i < count; ++i)
+        column[i] = rows[i].epoch;
+    encodeColumn(column, count, 2, block.data); //! Эпохи: delta-of-delta
+
+    for (int c = 0; c < ColumnCount; ++c) {
+        for (int i = 0; i < count; ++i)
+            column[i] = rows[i].values[c];
+        encodeColumn(column, count, 1, block.data); //! Элементы: delta
+    }
+    block.data.squeeze();
+    return block;
+}
+
+QByteArray TleHistoryStore::blockData(const Block &block) const
+{
+    if (block.fileOffset < 0)
+        return block.data;
+
+    QMutexLocker locker(&this->fileMutex_);
+    if (!this->file_.seek(block.fileOffset))
+        return QByteArray();
+    return this->file_.read(block.fileSize);
+}
+
+void TleHistoryStore::decodeBlock(const Block &block, QVector<Row> &out) const
+{
+    const QByteArray data = this->blockData(block);
+    ByteReader reader(data);
+
+    qint64 column[blockSize];
+    const auto first = out.size();
+    out.resize(first + block.count);
+    Row *rows = out.data() + first;
+
+    decodeColumn(reader, block.count, 2, column);
+    for (int i = 0; i < block.count; ++i)
+        rows[i].epoch = column[i];
+    for (int c = 0; c < ColumnCount; ++c) {
+        decodeColumn(reader, block.count, 1, column);
+        for (int i = 0; i < block.count; ++i)
+            rows[i].values[c] = column[i];
+    }
+}
+
+void TleHistoryStore::merge(ObjectHistory &object, QVector<Row> rows)
+{
+    QVector<Block> &blocks = object.blocks;
+
+    //! Первый блок, который нужно перекодировать: последняя эпоха не раньше новых данных
+    auto firstTouched = std::lower_bound(blocks.begin(),
+                                         blocks.end(),
+                                         rows.first().epoch,
+                                         [](const Block &block, qint64 epoch) {
+                                             return block.lastEpoch < epoch;
+                                         })
+                        - blocks.begin();
+    //! Неполный последний блок дополняем, а не начинаем новый
+    if (firstTouched == blocks.size() && !blocks.isEmpty() && blocks.last().count < blockSize)
+        --firstTouched;
+
+    QVector<Row> existing;
+    for (auto i = firstTouched; i < blocks.size(); ++i)
+        this->decodeBlock(blocks[i], existing);
+    blocks.resize(firstTouched);
+
+    //! Слияние по эпохе; при совпадении эпох новый набор заменяет старый
+    QVector<Row> merged;
+    merged.reserve(existing.size() + rows.size());
+    int i = 0, j = 0;
+    while (i < existing.size() || j < rows.size()) {
+        if (j == rows.size() || (i < existing.size() && existing[i].epoch < rows[j].epoch))
+            merged.append(existing[i++]);
+        else {
+            if (i < existing.size() && existing[i].epoch == rows[j].epoch)
+                ++i;
+            merged.append(rows[j++]);
+        }
+    }
+
+    for (int start = 0; start < merged.size(); start += blockSize)
+        blocks.append(encodeBlock(merged.constData() + start,
+                                  qMin(blockSize, int(merged.size()) - start)));
+}
+
+void TleHistoryStore::add(const QVector<TleRecord> &records)
+{
+    //! Группируем новые наборы по объектам
+    QHash<int, QVector<Row>> grouped;
+    for (const TleRecord &record : records) {
+        ObjectHistory &object = this->objects_[record.catalogNumber];
+        if (!record.name.isEmpty())
+            object.name = record.name.toString();
+        object.classification = record.classification.toString();
+        object.yearLaunch = record.yearLaunch;
+        object.numberLaunch = record.numberLaunch;
+        object.launchPiece = record.launchPiece.toString();
+        object.ephemerisType = record.ephemerisType;
+        grouped[record.catalogNumber].append(rowFromRecord(record));
+    }
+
+    for (auto it = grouped.begin(); it != grouped.end(); ++it) {
+        QVector<Row> &rows = it.value();
+        std::stable_sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) {
+            return a.epoch < b.epoch;
+        });
+        //! Среди новых наборов с одинаковой эпохой оставляем последний
+        int last = 0;
+        for (int i = 1; i < rows.size(); ++i) {
+            if (rows[i].epoch != rows[last].epoch)
+                ++last;
+            rows[last] = rows[i];
+        }
+        rows.resize(last + 1);
+        this->merge(this->objects_[it.key()], std::move(rows));
+    }
+}
+
+bool TleHistoryStore::save(const QString &filePath)
+{
+    QSaveFile out(filePath); //! Запись во временный файл с атомарной заменой
+    if (!out.open(QIODevice::WriteOnly)) {
+        this->errorString_ = out.errorString();
+        return false;
+    }
+    QDataStream stream(&out);
+    stream.setVersion(QDataStream::Qt_5_15);
+    stream << storeMagic << storeVersion;
+
+    //! Данные блоков
+    QHash<int, QVector<QPair<qint64, int>>> locations; //! Новые смещения и размеры блоков
+    for (auto it = this->objects_.cbegin(); it != this->objects_.cend(); ++it) {
+        QVector<QPair<qint64, int>> &objectLocations = locations[it.key()];
+        for (const Block &block : it.value().blocks) {
+            const QByteArray data = this->blockData(block);
+            objectLocations.append({out.pos(), int(data.size())});
+            stream.writeRawData(data.constData(), int(data.size()));
+        }
+    }
+
+    //! Индекс
+    const qint64 indexOffset = out.pos();
+    stream << quint32(this->objects_.size());
+    for (auto it = this->objects_.cbegin(); it != this->objects_.cend(); ++it) {
+        const ObjectHistory &object = it.value();
+        const QVector<QPair<qint64, int>> &objectLocations = locations[it.key()];
+        stream << qint32(it.key()) << object.name << object.classification
+               << qint32(object.yearLaunch) << qint32(object.numberLaunch) << object.launchPiece
+               << qint32(object.ephemerisType) << quint32(object.blocks.size());
+        for (int i = 0; i < object.blocks.size(); ++i) {
+            const Block &block = object.blocks[i];
+            stream << block.firstEpoch << block.lastEpoch << qint32(block.count)
+                   << objectLocations[i].first << qint32(objectLocations[i].second);
+        }
+    }
+    stream << indexOffset;
+
+    if (stream.status() != QDataStream::Ok) {
+        this->errorString_ = QObject::tr("Ошибка записи хранилища %1").arg(filePath);
+        out.cancelWriting();
+        return false;
+    }
+
+    //! Старый файл больше не нужен: все блоки уже записаны
+    {
+        QMutexLocker locker(&this->fileMutex_);
+        this->file_.close();
+    }
+    if (!out.commit()) {
+        this->errorString_ = out.errorString();
+        return false;
+    }
+    //! Переоткрываем хранилище: в памяти остаётся только индекс
+    return this->open(filePath);
+}
+
+bool TleHistoryStore::open(const QString &filePath)
+{
+    QMutexLocker locker(&this->fileMutex_);
+    this->file_.close();
+    this->file_.setFileName(filePath);
+    if (!this->file_.open(QIODevice::ReadOnly)) {
+        this->errorString_ = this->file_.errorString();
+        return false;
+    }
+
+    QDataStream stream(&this->file_);
+    stream.setVersion(QDataStream::Qt_5_15);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != storeMagic || version != storeVersion || this->file_.size() < 14) {
+        this->errorString_ = QObject::tr("%1 не является файлом истории TLE").arg(filePath);
+        this->file_.close();
+        return false;
+    }
+
+    qint64 indexOffset = 0;
+    this->file_.seek(this->file_.size() - qint64(sizeof(qint64)));
+    stream >> indexOffset;
+    this->file_.seek(indexOffset);
+
+    QHash<int, ObjectHistory> objects;
+    quint32 objectCount = 0;
+    stream >> objectCount;
+    objects.reserve(int(objectCount));
+    for (quint32 n = 0; n < objectCount && stream.status() == QDataStream::Ok; ++n) {
+        qint32 catalogNumber, yearLaunch, numberLaunch, ephemerisType;
+        quint32 blockCount;
+        ObjectHistory object;
+        stream >> catalogNumber >> object.name >> object.classification >> yearLaunch
+            >> numberLaunch >> object.launchPiece >> ephemerisType >> blockCount;
+        object.yearLaunch = yearLaunch;
+        object.numberLaunch = numberLaunch;
+        object.ephemerisType = ephemerisType;
+        object.blocks.resize(int(blockCount));
+        for (Block &block : object.blocks) {
+            qint32 count, size;
+            stream >> block.firstEpoch >> block.lastEpoch >> count >> block.fileOffset >> size;
+            block.count = count;
+            block.fileSize = size;
+        }
+        objects.insert(catalogNumber, std::move(object));
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        this->errorString_ = QObject::tr("Повреждён индекс файла истории %1").arg(filePath);
+        this->file_.close();
+        return false;
+    }
+    this->objects_ = std::move(objects);
+    return true;
+}
+
+QVector<TleRecord> TleHistoryStore::range(int catalogNumber, qint64 fromMSecs, qint64 toMSecs) const
+{
+    QVector<TleRecord> result;
+    const auto it = this->objects_.constFind(catalogNumber);
+    if (it == this->objects_.cend())
+        return result;
+
+    const qint64 from = fromMSecs * 1000;   //! Начало в микросекундах
+    const qint64 to = toMSecs * 1000 + 999; //! Конец в микросекундах
+    const QVector<Block> &blocks = it->blocks;
+
+    //! Первый блок, пересекающийся с диапазоном
+    auto block = std::lower_bound(blocks.cbegin(),
+                                  blocks.cend(),
+                                  from,
+                                  [](const Block &b, qint64 epoch) { return b.lastEpoch < epoch; });
+    const auto arena = std::make_shared<TleStringArena>(); //! Строки записей результата
+    const TleRecord base = baseRecord(catalogNumber, *it, arena);
+    QVector<Row> rows;
+    for (; block != blocks.cend() && block->firstEpoch <= to; ++block) {
+        rows.clear();
+        this->decodeBlock(*block, rows);
+        for (const Row &row : rows)
+            if (row.epoch >= from && row.epoch <= to)
+                result.append(recordFromRow(base, *arena, row));
+    }
+    return result;
+}
+
+bool TleHistoryStore::asOf(int catalogNumber, qint64 timeMSecs, TleRecord &outRecord) const
+{
+    const auto it = this->objects_.constFind(catalogNumber);
+    if (it == this->objects_.cend())
+        return false;
+
+    const qint64 time = timeMSecs * 1000 + 999; //! Момент в микросекундах
+    const QVector<Block> &blocks = it->blocks;
+
+    //! Последний блок, начинающийся не позже указанного момента
+    auto block = std::upper_bound(blocks.cbegin(),
+                                  blocks.cend(),
+                                  time,
+                                  [](qint64 epoch, const Block &b) { return epoch < b.firstEpoch; });
+    if (block == blocks.cbegin())
+        return false;
+    --block;
+
+    QVector<Row> rows;
+    this->decodeBlock(*block, rows);
+    auto row = std::upper_bound(rows.cbegin(), rows.cend(), time, [](qint64 epoch, const Row &r) {
+        return epoch < r.epoch;
+    });
+    if (row == rows.cbegin())
+        return false;
+    const auto arena = std::make_shared<TleStringArena>();
+    outRecord = recordFromRow(baseRecord(catalogNumber, *it, arena), *arena, *(row - 1));
+    return true;
+}
+
+bool TleHistoryStore::series(int catalogNumber, ElementSetSeries &out) const
+{
+    const auto it = this->objects_.constFind(catalogNumber);
+    if (it == this->objects_.cend())
+        return false;
+
+    out = ElementSetSeries();
+    out.catalogNumber = catalogNumber;
+    int total = 0;
+    for (const Block &block : it->blocks)
+        total += block.count;
+    for (QVector<double> *column : {&out.meanMotion, &out.meanMotionDot, &out.inclination,
+                                    &out.eccentricity, &out.bstar})
+        column->reserve(total);
+    out.epochs.reserve(total);
+    out.elementSetNumbers.reserve(total);
+
+    QVector<Row> rows;
+    for (const Block &block : it->blocks) {
+        rows.clear();
+        this->decodeBlock(block, rows);
+        for (const Row &row : rows) {
+            auto value = [&row](Column c) { return double(row.values[c]) / columnScales[c]; };
+            out.epochs.append(row.epoch);
+            out.meanMotion.append(value(MeanMotion));
+            out.meanMotionDot.append(value(MeanMotionDot));
+            out.inclination.append(value(Inclination));
+            out.eccentricity.append(value(Eccentricity));
+            out.bstar.append(unpackExponent(row.values[Bstar]));
+            out.elementSetNumbers.append(int(row.values[ElementSetNumber]));
+        }
+    }
+    return true;
+}
+
+QVector<int> TleHistoryStore::catalogNumbers() const
+{
+    QVector<int> numbers;
+    numbers.reserve(this->objects_.size());
+    for (auto it = this->objects_.cbegin(); it != this->objects_.cend(); ++it)
+        numbers.append(it.key());
+    std::sort(numbers.begin(), numbers.end());
+    return numbers;
+}
+
+qint64 TleHistoryStore::elementSetCount() const
+{
+    qint64 count = 0;
+    for (const ObjectHistory &object : this->objects_)
+        for (const Block &block : object.blocks)
+            count += block.count;
+    return count;
+}
+
+qint64 TleHistoryStore::compressedSize() const
+{
+    qint64 size = 0;
+    for (const ObjectHistory &object : this->objects_)
+        for (const Block &block : object.blocks)
+            size += block.fileOffset < 0 ? block.data.size() : block.fileSize;
+    return size;
+}
+
+QString TleHistoryStore::errorString() const
+{
+    return this->errorString_;
+}
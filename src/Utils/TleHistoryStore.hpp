@@ -0,0 +1,242 @@
+/*!
+ * \file TleHistoryStore.hpp
+ * \brief Заголовочный файл для класса TleHistoryStore.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \details
+ * Этот файл содержит определение класса TleHistoryStore — сжатого хранилища
+ * истории наборов элементов (element sets) по каждому объекту каталога.
+ */
+#ifndef TLEHISTORYSTORE_HPP
+#define TLEHISTORYSTORE_HPP
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include "TleRecord.hpp"
+
+/*!
+ * \brief ElementSetSeries - история объекта по столбцам
+ * \details
+ * Наборы элементов упорядочены по эпохе. В отличие от записей TleRecord
+ * столбцы не содержат строк, поэтому подходят для проходов по всему архиву.
+ */
+struct ElementSetSeries
+{
+    int catalogNumber = 0;          //! Номер объекта
+    QVector<qint64> epochs;         //! Эпохи (мкс от 01.01.1970 UTC)
+    QVector<double> meanMotion;     //! Среднее движение (об/сут)
+    QVector<double> meanMotionDot;  //! Первая производная среднего движения, делённая на 2
+    QVector<double> inclination;    //! Наклонение (градусы)
+    QVector<double> eccentricity;   //! Эксцентриситет
+    QVector<double> bstar;          //! Баллистический коэффициент B*
+    QVector<int> elementSetNumbers; //! Номера наборов элементов
+
+    //! Количество наборов
+    int size() const { return int(this->epochs.size()); }
+
+    //! Добавляет набор элементов из записи TLE
+    void append(const TleRecord &record);
+};
+
+/*!
+ * \brief Класс TleHistoryStore
+ * \details
+ * Группирует наборы элементов по catalogNumber и упорядочивает их по эпохе.
+ * История каждого объекта хранится блоками по blockSize наборов, каждый блок —
+ * столбцы со сжатием:
+ * - эпохи (в микросекундах) — разность второго порядка (delta-of-delta);
+ * - медленно меняющиеся элементы — фиксированная точка с точностью формата TLE
+ *   и разность первого порядка;
+ * - разности кодируются zigzag и упаковываются с минимальной для блока шириной в битах.
+ *
+ * Для каждого блока известны первая и последняя эпохи, поэтому запросы
+ * по диапазону времени и на момент времени распаковывают только нужные блоки.
+ * Хранилище сохраняется в файл; после open() в памяти находится только индекс,
+ * а данные блоков читаются из файла по запросу.
+ *
+ * \warning Точность хранения совпадает с точностью полей TLE
+ * (например, 1e-4 градуса для углов и 1e-7 для эксцентриситета).
+ */
+class TleHistoryStore
+{
+public:
+    //! Количество наборов элементов в одном блоке
+    static constexpr int blockSize = 128;
+
+    /*!
+     * \brief TleHistoryStore - конструктор пустого хранилища
+     */
+    TleHistoryStore() = default;
+
+    TleHistoryStore(const TleHistoryStore &) = delete;
+    TleHistoryStore &operator=(const TleHistoryStore &) = delete;
+
+    /*!
+     * \brief add - добавляет наборы элементов в хранилище
+     * \param records Записи TLE (порядок и объекты — произвольные)
+     * \details
+     * Записи с совпадающими catalogNumber и эпохой заменяют ранее добавленные.
+     * Перекодируются только затронутые блоки каждого объекта.
+     */
+    void add(const QVector<TleRecord> &records);
+
+    /*!
+     * \brief save - сохраняет хранилище в файл
+     * \param filePath Путь к файлу
+     * \return true, если сохранение прошло успешно
+     */
+    bool save(const QString &filePath);
+
+    /*!
+     * \brief open - открывает ранее сохранённое хранилище
+     * \param filePath Путь к файлу
+     * \return true, если индекс успешно прочитан
+     * \details В память загружается только индекс блоков.
+     */
+    bool open(const QString &filePath);
+
+    /*!
+     * \brief range - наборы элементов объекта в диапазоне времени
+     * \param catalogNumber Номер объекта
+     * \param fromMSecs Начало диапазона (мс от 01.01.1970 UTC, включительно)
+     * \param toMSecs Конец диапазона (мс от 01.01.1970 UTC, включительно)
+     * \return Записи, упорядоченные по эпохе (поля line1/line2 пустые)
+     */
+    QVector<TleRecord> range(int catalogNumber, qint64 fromMSecs, qint64 toMSecs) const;
+
+    /*!
+     * \brief asOf - последний набор элементов объекта на момент времени
+     * \param catalogNumber Номер объекта
+     * \param timeMSecs Момент времени (мс от 01.01.1970 UTC)
+     * \param outRecord Выходной параметр для найденной записи
+     * \return true, если набор с эпохой не позже timeMSecs найден
+     */
+    bool asOf(int catalogNumber, qint64 timeMSecs, TleRecord &outRecord) const;
+
+    /*!
+     * \brief series - вся история объекта по столбцам
+     * \param catalogNumber Номер объекта
+     * \param out Выходной параметр (прежнее содержимое заменяется)
+     * \return true, если объект есть в хранилище
+     * \details Блоки распаковываются без построения записей TleRecord.
+     * Метод можно вызывать из нескольких потоков одновременно.
+     */
+    bool series(int catalogNumber, ElementSetSeries &out) const;
+
+    /*!
+     * \brief catalogNumbers
+     * \return Номера всех объектов в хранилище
+     */
+    QVector<int> catalogNumbers() const;
+
+    /*!
+     * \brief elementSetCount
+     * \return Общее количество наборов элементов
+     */
+    qint64 elementSetCount() const;
+
+    /*!
+     * \brief compressedSize
+     * \return Суммарный размер сжатых блоков в байтах
+     */
+    qint64 compressedSize() const;
+
+    /*!
+     * \brief errorString
+     * \return Описание последней ошибки save() или open()
+     */
+    QString errorString() const;
+
+private:
+    //! Столбцы набора элементов (в фиксированной точке)
+    enum Column {
+        Inclination,
+        RightAscension,
+        Eccentricity,
+        ArgPerigee,
+        MeanAnomaly,
+        MeanMotion,
+        MeanMotionDot,
+        MeanMotionDdot,
+        Bstar,
+        ElementSetNumber,
+        RevolutionNumber,
+        ColumnCount
+    };
+
+    //! Распакованный набор элементов
+    struct Row
+    {
+        qint64 epoch;               //! Эпоха (мкс от 01.01.1970 UTC)
+        qint64 values[ColumnCount]; //! Значения столбцов в фиксированной точке
+    };
+
+    //! Сжатый блок наборов элементов
+    struct Block
+    {
+        qint64 firstEpoch = 0;  //! Эпоха первого набора
+        qint64 lastEpoch = 0;   //! Эпоха последнего набора
+        int count = 0;          //! Количество наборов в блоке
+        QByteArray data;        //! Сжатые данные (пусто, если блок находится в файле)
+        qint64 fileOffset = -1; //! Смещение блока в файле
+        int fileSize = 0;       //! Размер блока в файле
+    };
+
+    //! История одного объекта
+    struct ObjectHistory
+    {
+        QString name;           //! Имя объекта (из последнего добавленного набора)
+        QString classification; //! Класс секретности
+        int yearLaunch = 0;     //! Последние 2 цифры года запуска
+        int numberLaunch = 0;   //! Номер запуска
+        QString launchPiece;    //! Часть запуска
+        int ephemerisType = 0;  //! Тип эфемерид
+        QVector<Block> blocks;  //! Блоки, упорядоченные по эпохе
+    };
+
+    /*!
+     * \brief merge - вливает новые наборы в историю объекта
+     * \param object История объекта
+     * \param rows Новые наборы (упорядоченные по эпохе)
+     */
+    void merge(ObjectHistory &object, QVector<Row> rows);
+
+    /*!
+     * \brief blockData - сжатые данные блока (из памяти или из файла)
+     */
+    QByteArray blockData(const Block &block) const;
+
+    /*!
+     * \brief decodeBlock - распаковывает блок и добавляет наборы в out
+     */
+    void decodeBlock(const Block &block, QVector<Row> &out) const;
+
+    /*!
+     * \brief encodeBlock - сжимает наборы rows[0..count)
+     */
+    static Block encodeBlock(const Row *rows, int count);
+
+    //! Перевод записи TLE в набор столбцов и обратно
+    static Row rowFromRecord(const TleRecord &record);
+    static TleRecord recordFromRow(const TleRecord &base, TleStringArena &arena, const Row &row);
+
+    /*!
+     * \brief baseRecord - общие для всех наборов объекта поля записи
+     * \details Текстовые поля копируются в arena один раз на запрос, а не на каждый набор.
+     */
+    static TleRecord baseRecord(int catalogNumber,
+                                const ObjectHistory &object,
+                                const std::shared_ptr<TleStringArena> &arena);
+
+    QHash<int, ObjectHistory> objects_; //! История по номерам объектов
+    mutable QFile file_;                //! Файл, из которого читаются блоки после open()
+    mutable QMutex fileMutex_;          //! Защита file_ при параллельных запросах
+    QString errorString_;               //! Описание последней ошибки
+};
+
+#endif // TLEHISTORYSTORE_HPP
@@ -11,6 +11,9 @@
  */
 #include "TleParser.hpp"
 
+#include <algorithm>
+#include <utility>
+
 TleParser::TleParser(QObject *parent)
     : QObject(parent)
     , networkManager_(new QNetworkAccessManager(this))
@@ -48,20 +51,46 @@ bool TleParser::loadFromFile(const QString &filePath)
     }
     QFile file(filePath); //! Открываем файл для чтения
 
-    //! Проверяем, является ли файл текстовым
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    //! Файл читается как набор байт: формат (TLE или OMM) определяется по содержимому
+    if (!file.open(QIODevice::ReadOnly)) {
         //! Если файл не удалось открыть, отправляем сигнал об ошибке
         emit this->errorOccurred(tr("Не удалось открыть файл %1").arg(filePath));
         return false;
     }
 
-    QString text = QTextStream(&file).readAll(); //! Читаем весь текст из файла
-    file.close();                                //! Закрываем файл после чтения
+    //! Сжатый файл распаковывается потоком, без временного файла
+    const Compression compression = StreamDecompressor::detect(
+        file.peek(StreamDecompressor::magicSize));
+    if (compression != Compression::None) {
+        this->records_.clear();
+        this->parser_.reset();
+        this->sourcePath_ = filePath;
+        this->sourceUrl_.clear();
+        QString error;
+        if (!this->parser_.parseCompressed(file,
+                                           compression,
+                                           StreamDecompressor::plainSuffix(filePath),
+                                           this->records_,
+                                           error)) {
+            emit this->errorOccurred(
+                error.isEmpty() ? tr("Ошибка разбора TLE данных из файла %1").arg(filePath)
+                                : tr("Ошибка распаковки файла %1: %2").arg(filePath, error));
+            return false;
+        }
+        emit parsingFinished();
+        return true;
+    }
+
+    const QByteArray data = file.readAll(); //! Читаем всё содержимое файла
+    file.close();                           //! Закрываем файл после чтения
 
-    this->records_.clear(); //! Очищаем предыдущие записи
+    this->records_.clear();       //! Очищаем предыдущие записи
+    this->parser_.reset();        //! Строки нового каталога — в новой арене
+    this->sourcePath_ = filePath; //! Запоминаем источник данных
+    this->sourceUrl_.clear();
 
-    //! Разбираем текст на TLE записи
-    if (this->parseText(text)) {
+    //! Разбираем данные, подсказкой формата служит расширение файла
+    if (this->parser_.parseData(data, info.suffix(), this->records_)) {
         //! Если разбор текста успешен, отправляем сигнал о завершении разбора
         emit parsingFinished();
         return true; //! Возвращаем true, если разбор успешен
@@ -82,6 +111,9 @@ bool TleParser::loadFromUrl(const QUrl &url)
         this->currentReply_ = nullptr;         //! Обнуляем указатель на текущий ответ
     }
 
+    this->sourcePath_.clear(); //! Данные будут загружены не из файла
+    this->sourceUrl_ = url;
+
     QNetworkRequest request(url); //! Создаем сетевой запрос с указанным URL
     this->currentReply_ = this->networkManager_->get(request); //! Выполняем GET-запрос
     //! Подключаем слот для обработки завершения запроса
@@ -115,133 +147,76 @@ void TleParser::onNetworkReplyFinished()
         emit errorOccurred(tr("Ошибка HTTP: %1").arg(statusCode));
         return;
     }
-    //! Проверяем, что ответ содержит корректный тип содержимого
-    QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
-    if (!contentType.contains("text/plain", Qt::CaseInsensitive)) {
+    //! Проверяем, что ответ содержит поддерживаемый тип содержимого (TLE или OMM)
+    static const QStringList supportedTypes = {QStringLiteral("text/plain"),
+                                               QStringLiteral("application/json"),
+                                               QStringLiteral("text/csv"),
+                                               QStringLiteral("application/xml"),
+                                               QStringLiteral("text/xml")};
+    const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+    const bool supported = std::any_of(supportedTypes.cbegin(),
+                                       supportedTypes.cend(),
+                                       [&contentType](const QString &type) {
+                                           return contentType.contains(type, Qt::CaseInsensitive);
+                                       });
+    //! Читаем данные ответа; архив принимается при любом типе содержимого (gzip, zip, octet-stream)
+    const QByteArray data = reply->readAll();
+    if (!supported && StreamDecompressor::detect(data) == Compression::None) {
         emit errorOccurred(tr("Неверный тип содержимого: %1").arg(contentType));
         return;
     }
-    //! Читаем данные ответа
-    QString text = QString::fromUtf8(reply->readAll());
-    if (text.trimmed().isEmpty()) {
-        emit errorOccurred(tr("Ответ от сервера пустой."));
-        return;
-    }
-
-    this->records_.clear(); //! Очищаем предыдущие записи
+    //! Для архива подсказкой формата содержимого служит имя файла в пути URL
+    this->loadFromData(data, contentType, reply->url().path());
+}
 
-    //! Пытаемся разобрать текст на TLE записи
-    if (!this->parseText(text)) {
-        emit this->errorOccurred(tr("Не удалось разобрать TLE данные."));
-        return;
+bool TleParser::loadFromData(const QByteArray &data,
+                             const QString &contentType,
+                             const QString &fileName)
+{
+    TleParseResult result = this->parser_.parse(data, contentType, fileName);
+    this->records_ = std::move(result.records);
+    if (!result.error.isEmpty()) {
+        emit this->errorOccurred(result.error);
+        return false;
     }
     emit parsingFinished();
+    return true;
 }
 
-bool TleParser::parseText(const QString &text)
+qint64 TleParser::parseChunk(const QByteArray &data, QVector<TleRecord> &outRecords)
 {
-    //! Разбиваем текст на строки, пропуская пустые строки
-    const QStringList lines = text.split(QRegularExpression(R"(\r\n|\n|\r)"), Qt::SkipEmptyParts);
-    int i = 0; //! Индекс для перебора строк
-    while (i < lines.size()) {
-        //! Проверяем, что текущая строка начинается с '1 ' или '2 '
-        QString nameLine, line1, line2;
-        //! Проверка, что файл в формате 2LE или 3LE
-
-        if (i + 2 < lines.size() && !lines[i].startsWith("1 ") && !lines[i].startsWith("2 ")) {
-            //! 3LE (с именем)
-            nameLine = lines[i];
-            line1 = lines[i + 1].trimmed();
-            line2 = lines[i + 2].trimmed();
-            i += 3;
-        } else if (i + 1 < lines.size()
-                   && (lines[i].startsWith("1 ") || lines[i].startsWith("2 "))) {
-            //! 2LE (без имени)
-            nameLine.clear();
-            line1 = lines[i].trimmed();
-            line2 = lines[i + 1].trimmed();
-            i += 2;
-        } else
-            break;
-
-        TleRecord rec; //! Создаем новую запись TLE
-        if (parseSingleTle(nameLine, line1, line2, rec))
-            this->records_.append(rec); //! Добавляем запись в список записей
-    }
-    return !records_.isEmpty();
+    return this->parser_.parseChunk(data, outRecords);
 }
 
-bool TleParser::parseSingleTle(const QString &nameLine,
-                               const QString &l1,
-                               const QString &l2,
-                               TleRecord &outRecord)
+QString TleParser::sourcePath() const
 {
-    static const QRegularExpression re_1(
-        R"(^(1) (\d{5})([UCS ]) (\d{2})(\d{3})([A-Z ]{1,3}) (\d{2})(\d.{11}) ([- +].\d{8}) ([-+ ]\d{5}[-+ ]\d) ([-+ ]\d{5}[-+]\d) ([0-4]) ([ \d]{4})(\d)$)");
-    static const QRegularExpression re_2(
-        R"(^(2) (\d{5}) ([ \d]{3}.[\d ]{4}) ([ \d]{3}.[ \d]{4}) (\d{7}) ([ \d]{3}.[\d ]{4}) ([ \d]{3}.[\d ]{4}) ([ \d]{2}.[\d ]{8})([ \d]{5})(\d)$)");
-
-    //! Проверяем, что первая строка совпдает с первой строкой формата TLE
-    QRegularExpressionMatch m1 = re_1.match(l1);
-    //! Если первая строка не совпадает, возвращаем false
-    if (!m1.hasMatch())
-        return false;
+    return this->sourcePath_;
+}
 
-    //! Проверяем, что вторая строка совпадает со второй строкой формата TLE
-    QRegularExpressionMatch m2 = re_2.match(l2);
-    //! Если вторая строка не совпадает, возвращаем false
-    if (!m2.hasMatch())
-        return false;
+QUrl TleParser::sourceUrl() const
+{
+    return this->sourceUrl_;
+}
 
-    if (!this->checkTleLine(l1) || !this->checkTleLine(l2))
-        return false; //! Если контрольные суммы не совпадают, возвращаем false
-
-    outRecord.name = nameLine; //! Записываем имя спутника или объекта
-    outRecord.line1 = l1;      //! Записываем первую строку TLE
-    outRecord.line2 = l2;      //! Записываем вторую строку TLE
-
-    outRecord.catalogNumber = m1.captured(2).toInt();
-    outRecord.classification = m1.captured(3).trimmed();
-    outRecord.yearLaunch = m1.captured(4).toInt();
-    outRecord.numberLaunch = m1.captured(5).toInt();
-    outRecord.launchPiece = m1.captured(6).trimmed();
-    outRecord.epochYearSuffix = m1.captured(7).toInt();
-    outRecord.epochTime = m1.captured(8).toDouble();
-    outRecord.meanMotionFirstDerivative = m1.captured(9).toDouble();
-    outRecord.meanMotionSecondDerivative = m1.captured(10).toDouble();
-    outRecord.brakingCoefficient = m1.captured(11).trimmed();
-    outRecord.ephemerisType = m1.captured(12).toInt();
-    outRecord.elementSetNumber = m1.captured(13).trimmed().toInt();
-    outRecord.checksum1 = m1.captured(14).toInt();
-
-    outRecord.inclination = m2.captured(3).toDouble();
-    outRecord.rightAscension = m2.captured(4).toDouble();
-    QString ecc = m2.captured(5);
-    outRecord.eccentricity = QString("0.%1").arg(ecc).toDouble();
-    outRecord.argPerigee = m2.captured(6).toDouble();
-    outRecord.meanAnomaly = m2.captured(7).toDouble();
-    outRecord.meanMotion = m2.captured(8).toDouble();
-    outRecord.revolutionNumberOfEpoch = m2.captured(9).toInt();
-    outRecord.checksum2 = m2.captured(10).toInt();
-    return true;
+void TleParser::decodeFields(TleRecord &record, TleFields fields)
+{
+    TleDataParser::decodeFields(record, fields);
 }
 
-bool TleParser::checkTleLine(const QString &line) const
+void TleParser::decodeFields(QVector<TleRecord> &records, TleFields fields)
 {
-    bool ok;
-    int checksum = line.right(1).toInt(&ok); //! последний символ
-    if (!ok)
-        return false; //! не цифра
-    int sum = 0;
-    for (int i = 0; i < line.length() - 1; ++i) {
-        QChar c = line[i]; //! берем символы строки, кроме последнего
-        if (c.isDigit())
-            sum += c.digitValue(); //! цифра дает свое значение
-        else if (c == QChar('-'))
-            sum += 1; //! минус дает 1
-        // остальные символы дают 0
-    }
-    return (sum % 10) == checksum;
+    for (TleRecord &record : records)
+        decodeFields(record, fields);
+}
+
+void TleParser::setFields(TleFields fields)
+{
+    this->parser_.setFields(fields);
+}
+
+TleFields TleParser::fields() const
+{
+    return this->parser_.fields();
 }
 
 QVector<TleRecord> TleParser::records() const
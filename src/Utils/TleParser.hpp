@@ -6,6 +6,8 @@
  * \details
  * Этот файл содержит определение класса TleParser, который предназначен для
  * чтения и разбора TLE (Two-Line Element) данных из файлов или URL.
+ * Помимо 2LE/3LE поддерживаются сообщения OMM в форматах JSON, CSV и XML,
+ * в том числе сжатые gzip, ZIP или xz.
  */
 #ifndef TLEPARSER_HPP
 #define TLEPARSER_HPP
@@ -13,13 +15,13 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QObject>
-#include <QRegularExpression>
 #include <QStringList>
 #include <QTextStream>
 #include <QUrl>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
 
+#include "TleDataParser.hpp"
 #include "TleStatistics.hpp"
 
 /*!
@@ -55,6 +57,9 @@ public:
      * \brief loadFromFile - загрузка TLE данных из файла
      * \param filePath Путь к файлу, содержащему TLE данные
      * \return true, если загрузка и разбор прошли успешно, иначе false
+     * \details
+     * Сжатые файлы (gzip, ZIP, xz) определяются по сигнатуре и распаковываются
+     * потоком: распаковка идёт в отдельном потоке одновременно с разбором.
      */
     bool loadFromFile(const QString &filePath);
 
@@ -68,6 +73,70 @@ public:
      */
     bool loadFromUrl(const QUrl &url);
 
+    /*!
+     * \brief loadFromData - разбор данных, уже загруженных в память
+     * \param data Данные 2LE/3LE или OMM, в том числе сжатые
+     * \param contentType Тип содержимого (подсказка формата несжатых данных)
+     * \param fileName Имя файла или путь URL (подсказка формата содержимого архива)
+     * \return true, если была разобрана хотя бы одна запись
+     * \details
+     * Так разбираются ответы сети; сам разбор выполняет TleDataParser
+     * (его же использует TleUrlRefresher для ответов, разбираемых в фоне).
+     */
+    bool loadFromData(const QByteArray &data, const QString &contentType, const QString &fileName);
+
+    /*!
+     * \brief sourcePath
+     * \return Путь к последнему загруженному файлу (пусто, если данные загружены из сети)
+     */
+    QString sourcePath() const;
+
+    /*!
+     * \brief sourceUrl
+     * \return URL последней загрузки из сети (пусто, если данные загружены из файла)
+     */
+    QUrl sourceUrl() const;
+
+    /*!
+     * \brief setFields - поля, которые декодируются при разборе
+     * \param fields Маска полей (по умолчанию все)
+     * \details
+     * Формат и контрольные суммы проверяются всегда, а из полей декодируются только
+     * запрошенные: например, для статистики хватает TleStatistics::requiredFields().
+     * Номер объекта (baseTleFields) декодируется при любой маске.
+     * Остальные поля декодируются позже через decodeFields() при первом обращении.
+     */
+    void setFields(TleFields fields);
+
+    /*!
+     * \brief fields
+     * \return Поля, которые декодируются при разборе
+     */
+    TleFields fields() const;
+
+    /*!
+     * \brief decodeFields - декодирование недостающих полей записи из её строк TLE
+     * \param record Запись, разобранная этим классом
+     * \param fields Поля, которые нужны потребителю
+     * \details Уже декодированные поля повторно не разбираются.
+     */
+    static void decodeFields(TleRecord &record, TleFields fields);
+
+    //! Декодирование недостающих полей всех записей
+    static void decodeFields(QVector<TleRecord> &records, TleFields fields);
+
+    /*!
+     * \brief parseChunk - разбор фрагмента 2LE/3LE данных, дописанного в конец источника
+     * \param data - новые данные (могут заканчиваться неполной строкой или записью)
+     * \param outRecords - вектор, в конец которого добавляются разобранные записи
+     * \return Количество байт, занятых полными записями
+     * \details
+     * Разбираются только строки, завершённые переводом строки, и только полные записи.
+     * Байты после возвращённого смещения нужно передать повторно вместе
+     * со следующей порцией данных.
+     */
+    qint64 parseChunk(const QByteArray &data, QVector<TleRecord> &outRecords);
+
 signals:
     /*!
      * \brief parsingFinished
@@ -93,38 +162,6 @@ private slots:
     void onNetworkReplyFinished();
 
 private:
-    /*!
-     * \brief parseText - разбор текста TLE данных
-     * \param text - текст, содержащий TLE данные
-     * \details
-     * Этот метод разбивает текст на строки, проверяет их формат,
-     * и вызывает разбор каждой пары строк TLE.
-     */
-    bool parseText(const QString &text);
-
-    /*!
-     * \brief parseSingleTle - разбор одной записи TLE
-     * \param nameLine - имя спутника или объекта (опционально)
-     * \param l1 - первая строка TLE (начинается с '1 ')
-     * \param l2 - вторая строка TLE (начинается с '2 ')
-     * \param outRecord - выходной параметр, куда будет записана разобранная запись TLE
-     * \param err - выходной параметр для сообщения об ошибке
-     * \return true, если разбор успешен, иначе false
-     */
-    bool parseSingleTle(const QString &nameLine,
-                        const QString &l1,
-                        const QString &l2,
-                        TleRecord &outRecord);
-
-    /*!
-     * \brief checkTleLile - проверка контрольной суммы TLE файла
-     * \param line - строка TLE, которую нужно проверить
-     * \return true, если контрольная сумма верна, иначе false
-     * \details
-     * Этот метод читает файл и проверяет контрольные суммы
-     */
-    bool checkTleLine(const QString &line) const;
-
     /*!
      * \brief networkManager_ - менеджер сетевых запросов
      * \details
@@ -147,6 +184,21 @@ private:
      * разобранные из файла или URL.
      */
     QVector<TleRecord> records_;
+
+    /*!
+     * \brief sourcePath_ - путь к последнему загруженному файлу
+     */
+    QString sourcePath_;
+
+    /*!
+     * \brief sourceUrl_ - URL последней загрузки из сети
+     */
+    QUrl sourceUrl_;
+
+    /*!
+     * \brief parser_ - разбор байтов (поля, арена строк текущего каталога)
+     */
+    TleDataParser parser_;
 };
 
 #endif // TLEPARSER_HPP
@@ -11,44 +11,88 @@
 #ifndef TLERECORD_HPP
 #define TLERECORD_HPP
 
+#include <QFlags>
 #include <QString>
 
+#include <memory>
+
+#include "TleStringArena.hpp"
+
+/*!
+ * \brief TleField - группа полей TleRecord, декодируемых вместе
+ * \details
+ * Имя и строки TLE хранятся всегда; остальные поля декодируются из строк
+ * по маске TleFields (см. TleParser::setFields и TleParser::decodeFields).
+ */
+enum class TleField : quint32 {
+    CatalogNumber = 1u << 0,     //! catalogNumber
+    Classification = 1u << 1,    //! classification
+    Designator = 1u << 2,        //! yearLaunch, numberLaunch, launchPiece
+    Epoch = 1u << 3,             //! epochYearSuffix, epochTime
+    Derivatives = 1u << 4,       //! meanMotionFirstDerivative, meanMotionSecondDerivative
+    Drag = 1u << 5,              //! brakingCoefficient
+    ElementSet = 1u << 6,        //! ephemerisType, elementSetNumber, checksum1, checksum2
+    Inclination = 1u << 7,       //! inclination
+    RightAscension = 1u << 8,    //! rightAscension
+    Eccentricity = 1u << 9,      //! eccentricity
+    ArgPerigee = 1u << 10,       //! argPerigee
+    MeanAnomaly = 1u << 11,      //! meanAnomaly
+    MeanMotion = 1u << 12,       //! meanMotion
+    RevolutionNumber = 1u << 13, //! revolutionNumberOfEpoch
+    All = (1u << 14) - 1         //! Все поля
+};
+Q_DECLARE_FLAGS(TleFields, TleField)
+Q_DECLARE_OPERATORS_FOR_FLAGS(TleFields)
+
+//! Поля, которые разбор декодирует при любой маске: по номеру объекта записи
+//! сопоставляются (повторы, история, сравнение каталогов) ещё до decodeFields
+constexpr TleFields baseTleFields = TleField::CatalogNumber;
+
 /*!
  * \brief TleRecord - структура для хранения данных TLE
  * \details
  * Эта структура содержит поля для хранения информации о спутниках в формате TLE.
+ * Текстовые поля — представления TleText байтов арены strings, общей для всех записей
+ * одного каталога: запись не владеет отдельными строками, а копирование записи
+ * увеличивает только счётчик ссылок арены.
  */
 struct TleRecord
 {
+    //! Арена текстовых полей (общая для записей, разобранных вместе)
+    std::shared_ptr<const TleStringArena> strings;
+
     //! Поля для хранения данных TLE:
-    QString name;  //! Заголовок (имя спутника или объекта)
-    QString line1; //! Первая строка TLE (начинается с '1 ')
-    QString line2; //! Вторая строка TLE (начинается с '2 ')
+    TleText name;  //! Заголовок (имя спутника или объекта)
+    TleText line1; //! Первая строка TLE (начинается с '1 ')
+    TleText line2; //! Вторая строка TLE (начинается с '2 ')
 
     //! Поля из первой строки TLE:
-    int catalogNumber;      //! Номер спутника (из line1)
-    QString classification; //! Класс ('U' — unclassified, 'C' — classified, 'S' — secret)
-    int yearLaunch;         //! Последние 2 цифры года запуска
-    int numberLaunch;       //! Номер запуска
-    QString launchPiece;    //! Часть запуска
-    int epochYearSuffix;    //! Последние две цифры года эпохи
-    double epochTime;       //! Часть эпохи, отвечающая за день (цела часть) и время (дробная часть)
-    double meanMotionFirstDerivative;  //! Первая производная от среднего движения (rev/day^2)
-    double meanMotionSecondDerivative; //! Вторая производная от среднего движения (rev/day^3)
-    QString brakingCoefficient;        //! Коэффициент торможения B*
-    int ephemerisType;                 //! Тип эфемерид (обычно 0)
-    int elementSetNumber;              //! Номер элемента
-    int checksum1;                     //! Контрольная сумма (из line1)
+    int catalogNumber = 0;      //! Номер спутника (из line1)
+    TleText classification;     //! Класс ('U' — unclassified, 'C' — classified, 'S' — secret)
+    int yearLaunch = 0;         //! Последние 2 цифры года запуска
+    int numberLaunch = 0;       //! Номер запуска
+    TleText launchPiece;        //! Часть запуска
+    int epochYearSuffix = 0;    //! Последние две цифры года эпохи
+    double epochTime = 0.0;     //! Часть эпохи, отвечающая за день (цела часть) и время (дробная часть)
+    double meanMotionFirstDerivative = 0.0;  //! Первая производная от среднего движения (rev/day^2)
+    double meanMotionSecondDerivative = 0.0; //! Вторая производная от среднего движения (rev/day^3)
+    TleText brakingCoefficient;              //! Коэффициент торможения B*
+    int ephemerisType = 0;                   //! Тип эфемерид (обычно 0)
+    int elementSetNumber = 0;                //! Номер элемента
+    int checksum1 = 0;                       //! Контрольная сумма (из line1)
 
     //! Поля из второй строки TLE:
-    double inclination;          //! Наклонение (градусы)
-    double rightAscension;       //! Долгота восходящего узла (градусы)
-    double eccentricity;         //! Эксцентриситет (но без точки, например, "0006703" → 0.0006703)
-    double argPerigee;           //! Аргумент перигея (градусы)
-    double meanAnomaly;          //! Средняя аномалия (градусы)
-    double meanMotion;           //! Среднее движение (обращения в день)
-    int revolutionNumberOfEpoch; //! Номер обращения
-    int checksum2;               //! Контрольная сумма (из line2)
+    double inclination = 0.0;        //! Наклонение (градусы)
+    double rightAscension = 0.0;     //! Долгота восходящего узла (градусы)
+    double eccentricity = 0.0;       //! Эксцентриситет (но без точки, например, "0006703" → 0.0006703)
+    double argPerigee = 0.0;         //! Аргумент перигея (градусы)
+    double meanAnomaly = 0.0;        //! Средняя аномалия (градусы)
+    double meanMotion = 0.0;         //! Среднее движение (обращения в день)
+    int revolutionNumberOfEpoch = 0; //! Номер обращения
+    int checksum2 = 0;               //! Контрольная сумма (из line2)
+
+    //! Уже декодированные поля (записи OMM и записи, собранные вручную, заполнены целиком)
+    TleFields decodedFields = TleField::All;
 };
 
 #endif // TLERECORD_HPP
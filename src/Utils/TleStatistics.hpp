@@ -18,7 +18,10 @@
 #include <QTimeZone>
 #include <QVector>
 
+#include "OrbitalMetrics.hpp"
+#include "QuantileSketch.hpp"
 #include "TleRecord.hpp"
+#include "TleUtils.hpp"
 
 /*!
  * \brief TleStatistics - структура для хранения статистики по спутникам TLE
@@ -33,27 +36,89 @@ struct TleStatistics
     QDateTime oldestEpoch = QDateTime::currentDateTime(); //! Самая старая дата из записей TLE
     QMap<int, int> launchesPerYear;                       //! Количество запусков спутников по годам
     QMap<int, int> inclinationBins; //! Количество спутников в каждом диапазоне наклонения
+    DerivedColumns derived;         //! Производные величины (полуось, апогей, перигей, период)
+    QMap<int, int> regimeCounts;    //! Количество спутников по орбитальным режимам (OrbitRegime)
+    QMap<int, int> altitudeBins;    //! Количество спутников по высоте перигея (нижняя граница, км)
+
+    //! Момент, от которого отсчитывается возраст эпох (микросекунды Unix, время создания)
+    qint64 ageReference = QDateTime::currentMSecsSinceEpoch() * 1000;
+    QuantileSketch meanMotionQuantiles;   //! Квантили среднего движения (об/сут)
+    QuantileSketch eccentricityQuantiles; //! Квантили эксцентриситета
+    QuantileSketch perigeeQuantiles;      //! Квантили высоты перигея (км)
+    QuantileSketch epochAgeQuantiles;     //! Квантили возраста эпохи (сутки)
 
     TleStatistics(const QVector<TleRecord> &recs)
         : records(recs)
     {
-        computeOldest();          //! Вычисляем самую старую дату из записей TLE
-        computeLaunchesPerYear(); //! Вычисляем количество запусков по годам
-        computeInclinationBins(); //! Вычисляем количество спутников для каждого наклонения
+        accumulate(0); //! Вычисляем статистику по всем записям
+    }
+
+    /*!
+     * \brief append - добавляет записи и обновляет статистику на месте
+     * \param recs Новые записи TLE
+     * \details
+     * Пересчитываются только вклады новых записей, уже накопленные значения не меняются.
+     */
+    void append(const QVector<TleRecord> &recs)
+    {
+        const int from = int(this->records.size()); //! Индекс первой новой записи
+        this->records += recs;
+        accumulate(from);
+    }
+
+    /*!
+     * \brief requiredFields - поля записей, по которым считается статистика
+     * \details Достаточно декодировать только их (TleParser::setFields).
+     */
+    static TleFields requiredFields()
+    {
+        return TleField::Epoch | TleField::Designator | TleField::Inclination
+               | TleField::Eccentricity | TleField::MeanMotion;
+    }
+
+    /*!
+     * \brief altitudeBinStart - нижняя граница интервала высоты
+     * \param altitude Высота (км)
+     * \return Нижняя граница интервала: шаг 100 км до 2000 км, 1000 км до 50000 км
+     */
+    static int altitudeBinStart(double altitude)
+    {
+        if (altitude < 0.0)
+            return 0;
+        if (altitude < 2000.0)
+            return int(altitude / 100.0) * 100;
+        if (altitude < 50000.0)
+            return int(altitude / 1000.0) * 1000;
+        return 50000;
     }
 
 private:
+    /*!
+     * \brief accumulate - добавляет в статистику вклад записей начиная с from
+     * \param from Индекс первой записи, ещё не учтённой в статистике
+     */
+    void accumulate(int from)
+    {
+        computeOldest(from);          //! Вычисляем самую старую дату из записей TLE
+        computeLaunchesPerYear(from); //! Вычисляем количество запусков по годам
+        computeInclinationBins(from); //! Вычисляем количество спутников для каждого наклонения
+        computeDerived(from);         //! Вычисляем производные величины и распределения по ним
+        computeQuantiles(from);       //! Дополняем эскизы квантилей
+    }
+
     /*!
      * \brief computeOldest - вычисляет самую старую дату из записей TLE
      * \details
      * Этот метод проходит по всем записям TLE и находит самую раннюю дату,
      * основываясь на значении epochTime и epochYearSuffix.
+     * \param from Индекс первой записи, ещё не учтённой в статистике
      */
-    void computeOldest()
+    void computeOldest(int from)
     {
         //! Находим самую старую дату
-        bool first = true; //! Флаг для первого элемента
-        for (const TleRecord &record : this->records) {
+        bool first = (from == 0); //! Флаг для первого элемента
+        for (int i = from; i < this->records.size(); ++i) {
+            const TleRecord &record = this->records[i];
             int day = int(record.epochTime); //! Целая часть epochTime представляет собой день года
             //! Дробная часть epochTime представляет собой время в одном дне
             double frac = record.epochTime - day;
@@ -83,10 +148,12 @@ private:
      * \details
      * Этот метод проходит по всем записям TLE и подсчитывает количество запусков
      * по годам, основываясь на значении yearLaunch.
+     * \param from Индекс первой записи, ещё не учтённой в статистике
      */
-    void computeLaunchesPerYear()
+    void computeLaunchesPerYear(int from)
     {
-        for (auto &rec : this->records) {
+        for (int i = from; i < this->records.size(); ++i) {
+            const TleRecord &rec = this->records[i];
             //! Определяем год запуска
             int year = rec.yearLaunch < 57 ? 2000 + rec.yearLaunch : 1900 + rec.yearLaunch;
             launchesPerYear[year]++; //! Увеличиваем счетчик запусков для этого года
@@ -98,14 +165,57 @@ private:
      * \details
      * Этот метод проходит по всем записям TLE и подсчитывает количество спутников
      * в каждом градусе наклонениня.
+     * \param from Индекс первой записи, ещё не учтённой в статистике
      */
-    void computeInclinationBins()
+    void computeInclinationBins(int from)
     {
-        for (auto &rec : this->records) {
+        for (int i = from; i < this->records.size(); ++i) {
+            const TleRecord &rec = this->records[i];
             int deg = qRound(rec.inclination); //! Округляем наклонение до ближайшего целого числа
             inclinationBins[deg]++; //! Увеличиваем счетчик спутников для этого наклонения
         }
     }
+
+    /*!
+     * \brief computeDerived - вычисляет производные величины и распределения по ним
+     * \details
+     * Столбцы производных величин вычисляются пакетно для всего каталога,
+     * затем подсчитываются количества по орбитальным режимам и высоте перигея.
+     * \param from Индекс первой записи, ещё не учтённой в статистике
+     */
+    void computeDerived(int from)
+    {
+        const DerivedColumns added = OrbitalMetrics::compute(from == 0 ? this->records
+                                                                       : this->records.mid(from));
+        this->derived.semiMajorAxis += added.semiMajorAxis;
+        this->derived.apogeeAltitude += added.apogeeAltitude;
+        this->derived.perigeeAltitude += added.perigeeAltitude;
+        this->derived.period += added.period;
+        this->derived.regime += added.regime;
+        for (int i = from; i < this->derived.size(); ++i) {
+            regimeCounts[this->derived.regime[i]]++; //! Счетчик для орбитального режима
+            altitudeBins[altitudeBinStart(this->derived.perigeeAltitude[i])]++; //! Счетчик высоты
+        }
+    }
+
+    /*!
+     * \brief computeQuantiles - добавляет значения записей в эскизы квантилей
+     * \details
+     * Эскизы хранят только счётчики интервалов, поэтому медиана и p95/p99 доступны
+     * без сортировки столбцов, а при дописывании записей обновляются на месте.
+     * \param from Индекс первой записи, ещё не учтённой в статистике
+     */
+    void computeQuantiles(int from)
+    {
+        for (int i = from; i < this->records.size(); ++i) {
+            const TleRecord &rec = this->records[i];
+            meanMotionQuantiles.add(rec.meanMotion);
+            eccentricityQuantiles.add(rec.eccentricity);
+            perigeeQuantiles.add(this->derived.perigeeAltitude[i]);
+            epochAgeQuantiles.add(double(this->ageReference - TleUtils::epochToUnixMicros(rec))
+                                  / double(TleUtils::microsPerDay));
+        }
+    }
 };
 
 #endif // TLESTATISTICS_HPP
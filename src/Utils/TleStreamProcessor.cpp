@@ -0,0 +1,693 @@
+/*!
+ * \file TleStreamProcessor.cpp
+ * \brief Потоковая обработка больших архивов TLE
+ * \details
+ * Этот файл содержит реализацию класса TleStreamProcessor.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "TleStreamProcessor.hpp"
+
+#include <QDataStream>
+#include <QDate>
+#include <QDateTime>
+#include <QFile>
+#include <QSaveFile>
+#include <QThread>
+#include <QTimeZone>
+#include <QVector>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "BoundedQueue.hpp"
+#include "OrbitalMetrics.hpp"
+#include "StreamDecompressor.hpp"
+#include "TleStatistics.hpp"
+#include "TleUtils.hpp"
+
+namespace {
+
+constexpr int catalogLimit = 100000;         //! Номера объектов в TLE — пять цифр
+constexpr int tleLineLength = 69;            //! Длина строки TLE
+constexpr qint64 minChunkSize = 64ll << 10;  //! Наименьший размер буфера
+constexpr qint64 maxChunkSize = 32ll << 20;  //! Наибольший размер буфера
+constexpr int csvBytesPerLine = 128;         //! Наибольшая длина строки выгрузки
+constexpr quint32 summaryMagic = 0x54535331; //! Сигнатура двоичной статистики ("TSS1")
+constexpr quint16 summaryVersion = 1;        //! Версия двоичной статистики
+constexpr qint64 alignWindow = 64 << 10;     //! Порция поиска границы записи
+
+//! Заголовок выгрузки CSV
+const char csvHeader[] = "catalogNumber,epoch,inclination,eccentricity,meanMotion,"
+                         "perigeeAltitude,apogeeAltitude,period,regime\n";
+
+/*!
+ * \brief Chunk - часть файла, проходящая через конвейер
+ * \details Буферы выделяются один раз и переиспользуются для следующих частей.
+ */
+struct Chunk
+{
+    qint64 sequence = 0;   //! Порядковый номер части
+    QByteArray data;       //! Данные (полные записи)
+    StreamSummary summary; //! Статистика части
+    QByteArray csv;        //! Выгрузка части
+
+    //! Поля принятых записей (рабочие массивы разбора)
+    QVector<int> catalogNumbers;
+    QVector<qint64> epochs;
+    QVector<double> inclination, eccentricity, meanMotion;
+    QVector<double> semiMajorAxis, apogee, perigee, period;
+};
+
+/*!
+ * \brief parseNumber - разбор числа фиксированного поля TLE без выделения памяти
+ * \param text Начало поля
+ * \param length Длина поля
+ * \param value Значение
+ * \return false, если поле содержит посторонние символы
+ * \details Допускаются пробелы по краям, знак и десятичная точка.
+ */
+bool parseNumber(const char *text, int length, double &value)
+{
+    int i = 0;
+    while (i < length && text[i] == ' ')
+        ++i;
+    bool negative = false;
+    if (i < length && (text[i] == '-' || text[i] == '+'))
+        negative = text[i++] == '-';
+
+    double result = 0.0, scale = 1.0;
+    bool digits = false, fraction = false;
+    for (; i < length && text[i] != ' '; ++i) {
+        const char c = text[i];
+        if (c == '.' && !fraction) {
+            fraction = true;
+        } else if (c >= '0' && c <= '9') {
+            digits = true;
+            if (fraction) {
+                scale *= 0.1;
+                result += (c - '0') * scale;
+            } else {
+                result = result * 10.0 + (c - '0');
+            }
+        } else {
+            return false;
+        }
+    }
+    while (i < length && text[i] == ' ')
+        ++i;
+    if (!digits || i != length)
+        return false;
+    value = negative ? -result : result;
+    return true;
+}
+
+//! Разбор целого неотрицательного поля из цифр
+bool parseDigits(const char *text, int length, int &value)
+{
+    int result = 0;
+    for (int i = 0; i < length; ++i) {
+        if (text[i] < '0' || text[i] > '9')
+            return false;
+        result = result * 10 + (text[i] - '0');
+    }
+    value = result;
+    return true;
+}
+
+//! Разбор номера объекта: пять цифр или Alpha-5 (буква и четыре цифры)
+bool parseCatalogNumber(const char *text, int &value)
+{
+    const int letter = TleUtils::alpha5Value(text[0]);
+    if (letter < 0)
+        return parseDigits(text, 5, value);
+    if (!parseDigits(text + 1, 4, value))
+        return false;
+    value += letter * 10000;
+    return true;
+}
+
+//! Проверка контрольной суммы строки TLE (как в TleParser::checkTleLine)
+bool checksumValid(const char *line)
+{
+    int sum = 0;
+    for (int i = 0; i < tleLineLength - 1; ++i) {
+        if (line[i] >= '0' && line[i] <= '9')
+            sum += line[i] - '0';
+        else if (line[i] == '-')
+            sum += 1;
+    }
+    const char last = line[tleLineLength - 1];
+    return last >= '0' && last <= '9' && sum % 10 == last - '0';
+}
+
+//! Длина строки без завершающих пробелов и '\r'
+int trimmedLength(const char *line, int length)
+{
+    while (length > 0 && (line[length - 1] == ' ' || line[length - 1] == '\r'))
+        --length;
+    return length;
+}
+
+/*!
+ * \brief decodeRecord - разбор пары строк TLE в рабочие массивы части
+ * \return false, если запись некорректна
+ */
+bool decodeRecord(const char *l1, int length1, const char *l2, int length2, Chunk &chunk)
+{
+    if (trimmedLength(l1, length1) != tleLineLength || trimmedLength(l2, length2) != tleLineLength)
+        return false;
+    if (!checksumValid(l1) || !checksumValid(l2))
+        return false;
+
+    int catalogNumber, catalogNumber2, launchYear, epochYear, eccentricityDigits;
+    double epochDay, inclination, meanMotion, eccentricity;
+    if (!parseCatalogNumber(l1 + 2, catalogNumber) || !parseCatalogNumber(l2 + 2, catalogNumber2)
+        || catalogNumber != catalogNumber2 || !parseDigits(l1 + 9, 2, launchYear)
+        || !parseDigits(l1 + 18, 2, epochYear) || !parseNumber(l1 + 20, 12, epochDay)
+        || !parseNumber(l2 + 8, 8, inclination) || !parseDigits(l2 + 26, 7, eccentricityDigits)
+        || !parseNumber(l2 + 52, 11, meanMotion))
+        return false;
+    eccentricity = eccentricityDigits * 1e-7; //! Эксцентриситет записан без "0."
+
+    chunk.catalogNumbers.append(catalogNumber);
+    chunk.epochs.append(TleUtils::epochToUnixMicros(epochYear, epochDay));
+    chunk.inclination.append(inclination);
+    chunk.eccentricity.append(eccentricity);
+    chunk.meanMotion.append(meanMotion);
+    chunk.summary.launchesPerYear[TleUtils::fullYear(launchYear)]++;
+    return true;
+}
+
+/*!
+ * \brief appendCsvLine - строка выгрузки для записи i части
+ * \param regimeNames Названия режимов (заранее преобразованные в байты)
+ */
+void appendCsvLine(Chunk &chunk, int i, const QVector<QByteArray> &regimeNames, quint8 regime)
+{
+    //! Дата эпохи без QDateTime: QDate по юлианскому дню не выделяет память
+    const qint64 micros = chunk.epochs[i];
+    qint64 days = micros / TleUtils::microsPerDay;
+    if (micros % TleUtils::microsPerDay < 0)
+        --days;
+    const qint64 rest = micros - days * TleUtils::microsPerDay;
+    int year, month, day;
+    QDate::fromJulianDay(days + 2440588).getDate(&year, &month, &day);
+    const qint64 seconds = rest / 1000000;
+
+    char line[csvBytesPerLine];
+    const int length = std::snprintf(line,
+                                     sizeof(line),
+                                     "%d,%04d-%02d-%02dT%02d:%02d:%02d.%06dZ,%.4f,%.7f,%.8f,"
+                                     "%.3f,%.3f,%.4f,%s\n",
+                                     chunk.catalogNumbers[i],
+                                     year,
+                                     month,
+                                     day,
+                                     int(seconds / 3600),
+                                     int(seconds / 60 % 60),
+                                     int(seconds % 60),
+                                     int(rest % 1000000),
+                                     chunk.inclination[i],
+                                     chunk.eccentricity[i],
+                                     chunk.meanMotion[i],
+                                     chunk.perigee[i],
+                                     chunk.apogee[i],
+                                     chunk.period[i],
+                                     regimeNames[regime].constData());
+    if (length > 0)
+        chunk.csv.append(line, qMin(length, int(sizeof(line)) - 1));
+}
+
+/*!
+ * \brief decodeChunk - разбор части файла и подсчёт её статистики
+ * \param chunk Часть (данные заполнены потоком чтения)
+ * \param exportCsv Нужна ли выгрузка
+ * \param regimeNames Названия режимов для выгрузки
+ */
+void decodeChunk(Chunk &chunk, bool exportCsv, const QVector<QByteArray> &regimeNames)
+{
+    StreamSummary &summary = chunk.summary;
+    summary.bytes = chunk.data.size();
+    summary.records = summary.rejected = 0;
+    summary.oldestEpoch = summary.newestEpoch = 0;
+    summary.objects.fill(false, catalogLimit);
+    summary.launchesPerYear.clear();
+    summary.inclinationBins.clear();
+    summary.regimeCounts.clear();
+    summary.altitudeBins.clear();
+    for (QuantileSketch *sketch : {&summary.meanMotionQuantiles, &summary.eccentricityQuantiles,
+                                   &summary.perigeeQuantiles, &summary.epochAgeQuantiles})
+        *sketch = QuantileSketch();
+    chunk.csv.resize(0);
+    chunk.catalogNumbers.resize(0);
+    chunk.epochs.resize(0);
+    for (QVector<double> *column : {&chunk.inclination, &chunk.eccentricity, &chunk.meanMotion})
+        column->resize(0);
+
+    //! Записью считается строка "1 ", за которой сразу идёт строка "2 "; имена пропускаются
+    const char *begin = chunk.data.constData();
+    const char *end = begin + chunk.data.size();
+    const char *previous = nullptr;
+    int previousLength = 0;
+    for (const char *line = begin; line < end;) {
+        const char *eol = static_cast<const char *>(std::memchr(line, '\n', size_t(end - line)));
+        const int length = int((eol ? eol : end) - line);
+        const bool isLine1 = length >= 2 && line[0] == '1' && line[1] == ' ';
+        const bool isLine2 = length >= 2 && line[0] == '2' && line[1] == ' ';
+        if (previous && isLine2) {
+            if (!decodeRecord(previous, previousLength, line, length, chunk))
+                ++summary.rejected;
+            previous = nullptr;
+        } else {
+            if (previous)
+                ++summary.rejected; //! Первая строка без второй
+            previous = isLine1 ? line : nullptr;
+            previousLength = length;
+        }
+        line = eol ? eol + 1 : end;
+    }
+    if (previous)
+        ++summary.rejected;
+
+    //! Производные величины — пакетом для всей части
+    const int count = int(chunk.meanMotion.size());
+    for (QVector<double> *column : {&chunk.semiMajorAxis, &chunk.apogee, &chunk.perigee,
+                                    &chunk.period})
+        column->resize(count);
+    OrbitalMetrics::computeKernel(chunk.meanMotion.constData(),
+                                  chunk.eccentricity.constData(),
+                                  count,
+                                  chunk.semiMajorAxis.data(),
+                                  chunk.apogee.data(),
+                                  chunk.perigee.data(),
+                                  chunk.period.data());
+
+    summary.records = count;
+    for (int i = 0; i < count; ++i) {
+        const qint64 epoch = chunk.epochs[i];
+        if (i == 0 || epoch < summary.oldestEpoch)
+            summary.oldestEpoch = epoch;
+        if (i == 0 || epoch > summary.newestEpoch)
+            summary.newestEpoch = epoch;
+        summary.objects.setBit(chunk.catalogNumbers[i]);
+        summary.inclinationBins[qRound(chunk.inclination[i])]++;
+        const quint8 regime = quint8(OrbitalMetrics::classify(chunk.apogee[i],
+                                                              chunk.perigee[i],
+                                                              chunk.eccentricity[i],
+                                                              chunk.meanMotion[i],
+                                                              chunk.inclination[i]));
+        summary.regimeCounts[regime]++;
+        summary.altitudeBins[TleStatistics::altitudeBinStart(chunk.perigee[i])]++;
+        summary.meanMotionQuantiles.add(chunk.meanMotion[i]);
+        summary.eccentricityQuantiles.add(chunk.eccentricity[i]);
+        summary.perigeeQuantiles.add(chunk.perigee[i]);
+        summary.epochAgeQuantiles.add(double(summary.ageReference - epoch)
+                                      / double(TleUtils::microsPerDay));
+        if (exportCsv)
+            appendCsvLine(chunk, i, regimeNames, regime);
+    }
+}
+
+/*!
+ * \brief recordBoundary - конец последней полной записи в буфере
+ * \param data Буфер
+ * \return Смещение за последней завершённой строкой "2 ". Если такой нет —
+ * за последней завершённой строкой; если нет и её — размер буфера.
+ */
+qint64 recordBoundary(const QByteArray &data)
+{
+    const char *begin = data.constData();
+    qint64 lineEnd = data.lastIndexOf('\n');
+    if (lineEnd < 0)
+        return data.size();
+    const qint64 lastComplete = lineEnd + 1;
+    while (lineEnd >= 0) {
+        const qint64 lineStart = lineEnd > 0 ? data.lastIndexOf('\n', lineEnd - 1) + 1 : 0;
+        if (lineEnd - lineStart >= 2 && begin[lineStart] == '2' && begin[lineStart + 1] == ' ')
+            return lineEnd + 1;
+        lineEnd = lineStart - 1;
+    }
+    return lastComplete;
+}
+
+//! Преобразование QMap в объект JSON
+QJsonObject mapToJson(const QMap<int, qint64> &map, bool regimeKeys = false)
+{
+    QJsonObject object;
+    for (auto it = map.cbegin(); it != map.cend(); ++it)
+        object.insert(regimeKeys ? OrbitalMetrics::regimeName(OrbitRegime(it.key()))
+                                 : QString::number(it.key()),
+                      it.value());
+    return object;
+}
+
+//! Эпоха в формате ISO 8601
+QString epochText(qint64 micros)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    return QDateTime::fromMSecsSinceEpoch(micros / 1000, Qt::UTC).toString(Qt::ISODate);
+#else
+    return QDateTime::fromMSecsSinceEpoch(micros / 1000, QTimeZone::utc()).toString(Qt::ISODate);
+#endif
+}
+
+} // namespace
+
+QJsonObject StreamSummary::toJson() const
+{
+    QJsonObject result{
+        {"count", this->records},
+        {"objects", this->objectCount()},
+        {"rejected", this->rejected},
+        {"bytes", this->bytes},
+        {"launchesPerYear", mapToJson(this->launchesPerYear)},
+        {"inclinationBins", mapToJson(this->inclinationBins)},
+        {"regimes", mapToJson(this->regimeCounts, true)},
+        {"perigeeAltitudeBins", mapToJson(this->altitudeBins)},
+        {"quantiles",
+         QJsonObject{{"meanMotion", this->meanMotionQuantiles.toJson()},
+                     {"eccentricity", this->eccentricityQuantiles.toJson()},
+                     {"perigee", this->perigeeQuantiles.toJson()},
+                     {"epochAgeDays", this->epochAgeQuantiles.toJson()}}},
+    };
+    if (this->records > 0) {
+        result.insert("oldestEpoch", epochText(this->oldestEpoch));
+        result.insert("newestEpoch", epochText(this->newestEpoch));
+    }
+    return result;
+}
+
+void StreamSummary::merge(const StreamSummary &other)
+{
+    if (other.records > 0) {
+        if (this->records == 0 || other.oldestEpoch < this->oldestEpoch)
+            this->oldestEpoch = other.oldestEpoch;
+        if (this->records == 0 || other.newestEpoch > this->newestEpoch)
+            this->newestEpoch = other.newestEpoch;
+    }
+    this->bytes += other.bytes;
+    this->records += other.records;
+    this->rejected += other.rejected;
+    if (this->objects.size() < other.objects.size())
+        this->objects.resize(other.objects.size());
+    if (!other.objects.isEmpty())
+        this->objects |= other.objects;
+    for (auto it = other.launchesPerYear.cbegin(); it != other.launchesPerYear.cend(); ++it)
+        this->launchesPerYear[it.key()] += it.value();
+    for (auto it = other.inclinationBins.cbegin(); it != other.inclinationBins.cend(); ++it)
+        this->inclinationBins[it.key()] += it.value();
+    for (auto it = other.regimeCounts.cbegin(); it != other.regimeCounts.cend(); ++it)
+        this->regimeCounts[it.key()] += it.value();
+    for (auto it = other.altitudeBins.cbegin(); it != other.altitudeBins.cend(); ++it)
+        this->altitudeBins[it.key()] += it.value();
+    //! Возраст в частях отсчитан от одного момента, поэтому эскизы складываются без пересчёта
+    this->meanMotionQuantiles.merge(other.meanMotionQuantiles);
+    this->eccentricityQuantiles.merge(other.eccentricityQuantiles);
+    this->perigeeQuantiles.merge(other.perigeeQuantiles);
+    this->epochAgeQuantiles.merge(other.epochAgeQuantiles);
+}
+
+QByteArray StreamSummary::toBinary() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_15);
+    stream << summaryMagic << summaryVersion << this->bytes << this->records << this->rejected
+           << this->oldestEpoch << this->newestEpoch << this->ageReference << this->objects
+           << this->launchesPerYear << this->inclinationBins << this->regimeCounts
+           << this->altitudeBins;
+    for (const QuantileSketch *sketch : {&this->meanMotionQuantiles,
+                                         &this->eccentricityQuantiles,
+                                         &this->perigeeQuantiles,
+                                         &this->epochAgeQuantiles})
+        sketch->save(stream);
+    return data;
+}
+
+bool StreamSummary::fromBinary(const QByteArray &data, StreamSummary &out)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_15);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != summaryMagic || version != summaryVersion)
+        return false;
+
+    StreamSummary summary;
+    stream >> summary.bytes >> summary.records >> summary.rejected >> summary.oldestEpoch
+        >> summary.newestEpoch >> summary.ageReference >> summary.objects
+        >> summary.launchesPerYear >> summary.inclinationBins >> summary.regimeCounts
+        >> summary.altitudeBins;
+    for (QuantileSketch *sketch : {&summary.meanMotionQuantiles,
+                                   &summary.eccentricityQuantiles,
+                                   &summary.perigeeQuantiles,
+                                   &summary.epochAgeQuantiles}) {
+        if (!sketch->load(stream))
+            return false;
+    }
+    if (stream.status() != QDataStream::Ok || !stream.atEnd())
+        return false;
+    out = summary;
+    return true;
+}
+
+TleStreamProcessor::TleStreamProcessor(QObject *parent)
+    : QObject(parent)
+{}
+
+void TleStreamProcessor::setMemoryBudget(qint64 bytes)
+{
+    this->memoryBudget_ = bytes;
+}
+
+void TleStreamProcessor::setWorkerCount(int count)
+{
+    this->workerCount_ = count;
+}
+
+void TleStreamProcessor::setAgeReference(qint64 micros)
+{
+    this->ageReference_ = micros;
+}
+
+void TleStreamProcessor::setExportPath(const QString &path)
+{
+    this->exportPath_ = path;
+}
+
+bool TleStreamProcessor::run(const QString &path, qint64 offset, qint64 length)
+{
+    this->summary_ = StreamSummary();
+    this->summary_.ageReference = this->ageReference_ > 0
+                                      ? this->ageReference_
+                                      : QDateTime::currentMSecsSinceEpoch() * 1000;
+    this->errorString_.clear();
+
+    QFile file(path);
+    //! Без буфера QIODevice: данные читаются сразу в буферы конвейера
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+        return this->fail(tr("Не удалось открыть файл %1").arg(path));
+    offset = qBound<qint64>(0, offset, file.size());
+    const qint64 total = length < 0 ? file.size() - offset : qMin(length, file.size() - offset);
+
+    //! Сжатый архив читается через распаковку в отдельном потоке: она идёт параллельно
+    //! с нарезкой и разбором, ход обработки считается по сжатым байтам
+    const Compression compression = StreamDecompressor::detect(
+        file.peek(StreamDecompressor::magicSize));
+    std::unique_ptr<StreamDecompressor> decompressor;
+    QIODevice *input = &file;
+    if (compression != Compression::None) {
+        decompressor.reset(new StreamDecompressor(&file, compression));
+        if (!decompressor->open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+            return this->fail(tr("Не удалось распаковать файл %1: %2")
+                                  .arg(path, decompressor->errorString()));
+        input = decompressor.get();
+    } else if (offset > 0 && !file.seek(offset)) {
+        return this->fail(tr("Ошибка чтения файла %1: %2").arg(path, file.errorString()));
+    }
+    if (decompressor && (offset > 0 || length >= 0))
+        return this->fail(tr("Сжатый файл %1 нельзя обработать по частям").arg(path));
+    //! Непрочитанный остаток диапазона (у сжатого файла — без ограничения)
+    qint64 remaining = decompressor ? std::numeric_limits<qint64>::max() : total;
+
+    QSaveFile exportFile(this->exportPath_);
+    const bool exportCsv = !this->exportPath_.isEmpty();
+    if (exportCsv) {
+        if (!exportFile.open(QIODevice::WriteOnly))
+            return this->fail(tr("Не удалось создать файл %1").arg(this->exportPath_));
+        exportFile.write(csvHeader);
+    }
+
+    //! Размеры конвейера: по два буфера на поток разбора, чтобы чтение не ждало разбора.
+    //! Кроме данных часть занимает рабочие массивы разбора (до половины размера данных)
+    //! и при выгрузке — текст CSV (не больше размера данных)
+    const int workers = this->workerCount_ > 0 ? this->workerCount_
+                                               : qMax(1, QThread::idealThreadCount() - 1);
+    const int chunkCount = 2 * workers + 2;
+    const qint64 chunkSize = qBound(minChunkSize,
+                                    this->memoryBudget_ / chunkCount / (exportCsv ? 3 : 2),
+                                    maxChunkSize);
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    BoundedQueue<Chunk *> freeChunks(size_t(chunkCount)); //! Свободные буферы
+    BoundedQueue<Chunk *> workQueue(size_t(chunkCount + workers)); //! Части для разбора (+ признаки конца)
+    BoundedQueue<Chunk *> doneQueue(size_t(chunkCount)); //! Разобранные части
+    for (int i = 0; i < chunkCount; ++i) {
+        chunks.emplace_back(new Chunk);
+        chunks.back()->summary.ageReference = this->summary_.ageReference;
+        chunks.back()->data.reserve(int(chunkSize));
+        if (exportCsv)
+            chunks.back()->csv.reserve(int(chunkSize));
+        freeChunks.push(chunks.back().get());
+    }
+
+    QVector<QByteArray> regimeNames;
+    for (int regime = 0; regime < int(OrbitRegime::Count); ++regime)
+        regimeNames.append(OrbitalMetrics::regimeName(OrbitRegime(regime)).toUtf8());
+
+    //! Поток чтения: части нарезаются по границам записей, остаток переносится в следующую
+    std::atomic<qint64> chunkTotal{-1}; //! Количество частей (известно после окончания чтения)
+    QString readError;
+    std::unique_ptr<QThread> reader(QThread::create([&]() {
+        QByteArray carry;
+        qint64 sequence = 0;
+        for (;;) {
+            Chunk *chunk = freeChunks.pop();
+            chunk->data.resize(int(chunkSize));
+            std::memcpy(chunk->data.data(), carry.constData(), size_t(carry.size()));
+            const qint64 read = input->read(chunk->data.data() + carry.size(),
+                                            qMin(chunkSize - carry.size(), remaining));
+            if (read > 0)
+                remaining -= read;
+            if (read < 0) {
+                readError = input->errorString();
+                freeChunks.push(chunk);
+                break;
+            }
+            const qint64 filled = carry.size() + read;
+            chunk->data.resize(int(filled));
+            if (filled == 0) {
+                freeChunks.push(chunk);
+                break; //! Файл прочитан
+            }
+            const qint64 cut = (read == 0 || input->atEnd()) ? filled : recordBoundary(chunk->data);
+            carry = chunk->data.mid(int(cut));
+            chunk->data.resize(int(cut));
+            chunk->sequence = sequence++;
+            workQueue.push(chunk);
+        }
+        chunkTotal.store(sequence, std::memory_order_release);
+        for (int i = 0; i < workers; ++i)
+            workQueue.push(nullptr); //! Признак конца для каждого потока разбора
+    }));
+
+    //! Потоки разбора
+    std::vector<std::unique_ptr<QThread>> decoders;
+    for (int i = 0; i < workers; ++i) {
+        decoders.emplace_back(QThread::create([&]() {
+            while (Chunk *chunk = workQueue.pop()) {
+                decodeChunk(*chunk, exportCsv, regimeNames);
+                doneQueue.push(chunk);
+            }
+        }));
+    }
+
+    reader->start();
+    for (const auto &decoder : decoders)
+        decoder->start();
+
+    //! Объединение в исходном порядке: части приходят вразнобой, но в работе одновременно
+    //! не больше chunkCount частей, поэтому хватает кольца из chunkCount ячеек
+    QVector<Chunk *> waiting(chunkCount, nullptr);
+    qint64 merged = 0;
+    bool writeFailed = false;
+    Chunk *chunk = nullptr;
+    auto finished = [&]() {
+        const qint64 count = chunkTotal.load(std::memory_order_acquire);
+        return count >= 0 && merged == count;
+    };
+    while (doneQueue.popUntil(chunk, finished)) {
+        waiting[int(chunk->sequence % chunkCount)] = chunk;
+        while (Chunk *next = waiting[int(merged % chunkCount)]) {
+            if (next->sequence != merged)
+                break;
+            waiting[int(merged % chunkCount)] = nullptr;
+            this->summary_.merge(next->summary);
+            if (exportCsv && !writeFailed
+                && exportFile.write(next->csv) != qint64(next->csv.size()))
+                writeFailed = true;
+            ++merged;
+            freeChunks.push(next);
+            emit this->progress(decompressor ? decompressor->sourceBytesRead() : this->summary_.bytes,
+                                total);
+        }
+    }
+
+    reader->wait();
+    for (const auto &decoder : decoders)
+        decoder->wait();
+
+    if (!readError.isEmpty()) {
+        if (exportCsv)
+            exportFile.cancelWriting();
+        return this->fail(tr("Ошибка чтения файла %1: %2").arg(path, readError));
+    }
+    if (exportCsv && (writeFailed || !exportFile.commit()))
+        return this->fail(tr("Не удалось записать файл %1").arg(this->exportPath_));
+    return true;
+}
+
+qint64 TleStreamProcessor::alignToRecord(QIODevice &file, qint64 offset)
+{
+    const qint64 size = file.size();
+    if (offset <= 0)
+        return 0;
+    //! Окно начинается чуть раньше смещения, чтобы увидеть строку имени 3LE перед записью
+    const qint64 lookBehind = 256;
+    for (qint64 from = qMax<qint64>(0, offset - lookBehind); from < size; from += alignWindow) {
+        if (!file.seek(from))
+            return size;
+        const QByteArray window = file.read(lookBehind + alignWindow + 2 * tleLineLength);
+        const char *data = window.constData();
+        //! Начала строк: первая строка окна неполна, если окно начинается не с начала файла
+        QVector<qint64> starts;
+        for (qint64 i = 0; i < window.size(); ++i) {
+            if ((i == 0 && from == 0) || (i > 0 && data[i - 1] == '\n'))
+                starts.append(i);
+        }
+        for (int k = 0; k + 1 < starts.size(); ++k) {
+            const qint64 line = starts[k];
+            const qint64 next = starts[k + 1];
+            if (from + line < offset || data[line] != '1' || data[line + 1] != ' '
+                || next + 1 >= window.size() || data[next] != '2' || data[next + 1] != ' ')
+                continue;
+            //! Предыдущая строка — имя 3LE, если это не строка TLE и не пустая строка
+            if (k > 0) {
+                const qint64 previous = starts[k - 1];
+                const bool tleLine = (data[previous] == '1' || data[previous] == '2')
+                                     && data[previous + 1] == ' ';
+                const bool empty = data[previous] == '\n' || data[previous] == '\r';
+                if (!tleLine && !empty)
+                    return from + previous;
+            }
+            return from + line;
+        }
+        if (from + window.size() >= size)
+            break;
+    }
+    return size;
+}
+
+bool TleStreamProcessor::fail(const QString &message)
+{
+    this->errorString_ = message;
+    emit this->errorOccurred(message);
+    return false;
+}
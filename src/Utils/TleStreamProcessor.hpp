@@ -0,0 +1,191 @@
+/*!
+ * \file TleStreamProcessor.hpp
+ * \brief Заголовочный файл для потоковой обработки больших архивов TLE
+ * \details
+ * Этот файл содержит определение структуры StreamSummary и класса TleStreamProcessor,
+ * который вычисляет сводную статистику по файлу 2LE/3LE произвольного размера,
+ * не загружая его в память целиком.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef TLESTREAMPROCESSOR_HPP
+#define TLESTREAMPROCESSOR_HPP
+
+#include <QBitArray>
+#include <QByteArray>
+#include <QIODevice>
+#include <QJsonObject>
+#include <QMap>
+#include <QObject>
+#include <QString>
+
+#include "QuantileSketch.hpp"
+
+/*!
+ * \brief StreamSummary - сводная статистика потоковой обработки
+ * \details
+ * Содержит только агрегаты: размер не зависит от количества записей.
+ * Квантили собираются эскизами QuantileSketch (несколько КБ на величину).
+ */
+struct StreamSummary
+{
+    qint64 bytes = 0;       //! Обработано байт
+    qint64 records = 0;     //! Принято записей
+    qint64 rejected = 0;    //! Отброшено записей (формат или контрольная сумма)
+    qint64 oldestEpoch = 0; //! Самая ранняя эпоха (микросекунды Unix, 0 — нет записей)
+    qint64 newestEpoch = 0; //! Самая поздняя эпоха (микросекунды Unix)
+    QBitArray objects;      //! Встреченные номера объектов
+
+    QMap<int, qint64> launchesPerYear; //! Количество записей по году запуска
+    QMap<int, qint64> inclinationBins; //! Количество записей по градусам наклонения
+    QMap<int, qint64> regimeCounts;    //! Количество записей по орбитальным режимам (OrbitRegime)
+    QMap<int, qint64> altitudeBins;    //! Количество записей по высоте перигея (нижняя граница, км)
+
+    //! Момент, от которого отсчитывается возраст эпох (микросекунды Unix, общий для частей)
+    qint64 ageReference = 0;
+    QuantileSketch meanMotionQuantiles;   //! Квантили среднего движения (об/сут)
+    QuantileSketch eccentricityQuantiles; //! Квантили эксцентриситета
+    QuantileSketch perigeeQuantiles;      //! Квантили высоты перигея (км)
+    QuantileSketch epochAgeQuantiles;     //! Квантили возраста эпохи (сутки)
+
+    //! Количество различных объектов
+    int objectCount() const { return this->objects.count(true); }
+
+    /*!
+     * \brief merge - добавляет статистику другой части архива
+     * \param other Статистика части
+     */
+    void merge(const StreamSummary &other);
+
+    /*!
+     * \brief toJson - статистика в виде JSON (ключи совпадают с ответом GET /stats сервера)
+     */
+    QJsonObject toJson() const;
+
+    /*!
+     * \brief toBinary - компактное двоичное представление для передачи между процессами
+     * \details Сигнатура и версия формата, затем все агрегаты (QDataStream).
+     */
+    QByteArray toBinary() const;
+
+    /*!
+     * \brief fromBinary - чтение результата toBinary()
+     * \param data Двоичные данные
+     * \param out Статистика
+     * \return false, если данные неполны или записаны другой версией
+     */
+    static bool fromBinary(const QByteArray &data, StreamSummary &out);
+};
+
+/*!
+ * \brief Класс TleStreamProcessor
+ * \details
+ * Обработка идёт конвейером из трёх звеньев:
+ * - поток чтения заполняет буферы фиксированного размера, разрезая файл по границам записей;
+ * - потоки разбора декодируют записи прямо из байтов буфера (без QString и регулярных
+ *   выражений) и считают статистику своей части;
+ * - вызывающий поток объединяет статистику частей в исходном порядке
+ *   и дописывает выгрузку CSV.
+ *
+ * Звенья связаны очередями BoundedQueue. Буферы выделяются один раз и переиспользуются:
+ * их количество и размер определяются бюджетом памяти, поэтому пиковое потребление
+ * не зависит от размера архива. Сообщения OMM потоковый режим не разбирает.
+ * Архивы gzip, ZIP и xz распаковываются StreamDecompressor перед потоком чтения.
+ */
+class TleStreamProcessor : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief TleStreamProcessor - конструктор класса
+     * \param parent Родитель объекта
+     */
+    explicit TleStreamProcessor(QObject *parent = nullptr);
+
+    /*!
+     * \brief setMemoryBudget - бюджет памяти на буферы конвейера
+     * \param bytes Бюджет (байт, по умолчанию 256 МБ)
+     */
+    void setMemoryBudget(qint64 bytes);
+
+    /*!
+     * \brief setWorkerCount - количество потоков разбора
+     * \param count Количество (0 — по числу ядер)
+     */
+    void setWorkerCount(int count);
+
+    /*!
+     * \brief setAgeReference - момент отсчёта возраста эпох
+     * \param micros Микросекунды Unix (0 — момент запуска run())
+     * \details Части одного архива, обработанные разными процессами,
+     * должны отсчитывать возраст от одного момента, чтобы эскизы складывались.
+     */
+    void setAgeReference(qint64 micros);
+
+    /*!
+     * \brief setExportPath - файл для выгрузки разобранных записей в CSV
+     * \param path Путь (пусто — без выгрузки)
+     */
+    void setExportPath(const QString &path);
+
+    /*!
+     * \brief run - обработка файла
+     * \param path Путь к файлу 2LE/3LE (возможно, сжатому)
+     * \param offset Начало обрабатываемого диапазона (граница записи)
+     * \param length Длина диапазона (-1 — до конца файла)
+     * \return true, если диапазон обработан полностью
+     * \details Выполняется синхронно в вызывающем потоке.
+     * Диапазон задаётся только для несжатых файлов; его границы берутся из alignToRecord().
+     */
+    bool run(const QString &path, qint64 offset = 0, qint64 length = -1);
+
+    /*!
+     * \brief alignToRecord - граница записи не раньше заданного смещения
+     * \param file Открытый несжатый файл 2LE/3LE
+     * \param offset Смещение
+     * \return Начало записи (строки имени 3LE или первой строки), первая строка которой
+     * начинается не раньше offset; размер файла, если такой записи нет
+     * \details Функция монотонна, поэтому соседние диапазоны, границы которых
+     * выровнены ею, не пересекаются и не теряют записей.
+     */
+    static qint64 alignToRecord(QIODevice &file, qint64 offset);
+
+    //! Результат последней обработки
+    const StreamSummary &summary() const { return this->summary_; }
+
+    //! Текст последней ошибки
+    QString errorString() const { return this->errorString_; }
+
+signals:
+    /*!
+     * \brief progress - обработана очередная часть файла
+     * \param processed Обработано байт (для сжатого файла — прочитано сжатых байт)
+     * \param total Размер файла
+     */
+    void progress(qint64 processed, qint64 total);
+
+    /*!
+     * \brief errorOccurred - сигнал об ошибке
+     * \param message Сообщение об ошибке
+     */
+    void errorOccurred(const QString &message);
+
+private:
+    /*!
+     * \brief fail - запоминает ошибку и сообщает о ней
+     * \param message Сообщение об ошибке
+     * \return Всегда false
+     */
+    bool fail(const QString &message);
+
+    qint64 memoryBudget_ = 256ll << 20; //! Бюджет памяти на буферы
+    int workerCount_ = 0;               //! Количество потоков разбора (0 — по числу ядер)
+    qint64 ageReference_ = 0;           //! Момент отсчёта возраста эпох (0 — запуск run())
+    QString exportPath_;                //! Файл выгрузки CSV
+    StreamSummary summary_;             //! Результат
+    QString errorString_;               //! Текст последней ошибки
+};
+
+#endif // TLESTREAMPROCESSOR_HPP
@@ -0,0 +1,54 @@
+/*!
+ * \file TleStringArena.cpp
+ * \brief Реализация хранения текстовых полей каталога
+ * \details
+ * Этот файл содержит реализацию методов класса TleStringArena.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "TleStringArena.hpp"
+
+TleText TleStringArena::append(const char *data, int size)
+{
+    if (size <= 0)
+        return TleText();
+    if (size > this->available_) {
+        //! Строка длиннее следующего блока получает блок своего размера
+        const int blockSize = qMax(this->nextBlockSize_, size);
+        this->blocks_.emplace_back(new char[size_t(blockSize)]);
+        this->current_ = this->blocks_.back().get();
+        this->available_ = blockSize;
+        this->allocated_ += blockSize;
+        this->nextBlockSize_ = qMin(this->nextBlockSize_ * 2, maxBlockSize);
+    }
+    char *copy = this->current_;
+    std::memcpy(copy, data, size_t(size));
+    this->current_ += size;
+    this->available_ -= size;
+    return TleText(copy, size);
+}
+
+TleText TleStringArena::append(const QString &text)
+{
+    const QByteArray utf8 = text.toUtf8();
+    return this->append(utf8.constData(), int(utf8.size()));
+}
+
+TleText TleStringArena::intern(const char *data, int size)
+{
+    if (size > maxInternedSize)
+        return this->append(data, size);
+    const auto it = this->interned_.constFind(TleText(data, size));
+    if (it != this->interned_.cend())
+        return *it;
+    const TleText copy = this->append(data, size);
+    this->interned_.insert(copy);
+    return copy;
+}
+
+TleText TleStringArena::intern(const QString &text)
+{
+    const QByteArray utf8 = text.toUtf8();
+    return this->intern(utf8.constData(), int(utf8.size()));
+}
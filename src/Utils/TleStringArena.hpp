@@ -0,0 +1,167 @@
+/*!
+ * \file TleStringArena.hpp
+ * \brief Заголовочный файл для хранения текстовых полей каталога
+ * \details
+ * Этот файл содержит определение класса TleText — лёгкого представления строки
+ * без владения данными — и класса TleStringArena, в котором хранятся байты
+ * текстовых полей всех записей одного каталога.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef TLESTRINGARENA_HPP
+#define TLESTRINGARENA_HPP
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/*!
+ * \brief Класс TleText
+ * \details
+ * Указатель и длина байтов строки в UTF-8 (для полей TLE — ASCII). Данными не владеет:
+ * они принадлежат TleStringArena записи или буферу, из которого строка выделена,
+ * и должны жить дольше представления. Копирование не выделяет памяти.
+ */
+class TleText
+{
+public:
+    TleText() = default;
+
+    //! Представление size байт начиная с data
+    TleText(const char *data, int size)
+        : data_(data)
+        , size_(size)
+    {}
+
+    const char *data() const { return this->data_; }
+    int size() const { return this->size_; }
+    bool isEmpty() const { return this->size_ == 0; }
+    char at(int i) const { return this->data_[i]; }
+
+    //! Подстрока (границы обрезаются по размеру строки)
+    TleText mid(int position, int length = -1) const
+    {
+        position = qBound(0, position, this->size_);
+        const int rest = this->size_ - position;
+        return TleText(this->data_ + position, length < 0 ? rest : qMin(length, rest));
+    }
+
+    //! Строка без пробельных символов ASCII по краям
+    TleText trimmed() const
+    {
+        int begin = 0, end = this->size_;
+        while (begin < end && isSpace(this->data_[begin]))
+            ++begin;
+        while (end > begin && isSpace(this->data_[end - 1]))
+            --end;
+        return TleText(this->data_ + begin, end - begin);
+    }
+
+    //! Начинается ли строка с prefix
+    bool startsWith(const char *prefix) const
+    {
+        const int length = int(std::strlen(prefix));
+        return this->size_ >= length && std::memcmp(this->data_, prefix, size_t(length)) == 0;
+    }
+
+    //! Копия строки в QString (из UTF-8)
+    QString toString() const { return QString::fromUtf8(this->data_, this->size_); }
+
+    //! Копия байтов строки
+    QByteArray toByteArray() const { return QByteArray(this->data_, this->size_); }
+
+    friend bool operator==(const TleText &a, const TleText &b)
+    {
+        return a.size_ == b.size_
+               && (a.size_ == 0 || std::memcmp(a.data_, b.data_, size_t(a.size_)) == 0);
+    }
+    friend bool operator!=(const TleText &a, const TleText &b) { return !(a == b); }
+
+private:
+    static bool isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+    const char *data_ = nullptr; //! Байты строки
+    int size_ = 0;               //! Длина в байтах
+};
+
+//! Хеш байтов строки (для QHash)
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+inline uint qHash(const TleText &text, uint seed = 0)
+#else
+inline size_t qHash(const TleText &text, size_t seed = 0)
+#endif
+{
+    return qHashBits(text.data(), size_t(text.size()), seed);
+}
+
+/*!
+ * \brief Класс TleStringArena
+ * \details
+ * Байты строк дописываются в блоки, размер которых растёт вдвое до maxBlockSize.
+ * Блоки не перемещаются, поэтому выданные TleText остаются действительными,
+ * пока жива арена; записи держат её через std::shared_ptr. Освобождение каталога
+ * сводится к освобождению нескольких блоков вместо миллионов строк.
+ *
+ * Короткие повторяющиеся строки (класс, часть запуска, B*, имена в истории объекта)
+ * хранятся один раз: intern() возвращает уже сохранённую копию.
+ *
+ * Дописывать может только один поток; читать выданные строки — любые потоки.
+ */
+class TleStringArena
+{
+public:
+    static constexpr int firstBlockSize = 512;   //! Размер первого блока
+    static constexpr int maxBlockSize = 1 << 20; //! Наибольший размер блока
+    static constexpr int maxInternedSize = 32;   //! Строки длиннее не интернируются
+
+    TleStringArena() = default;
+    TleStringArena(const TleStringArena &) = delete;
+    TleStringArena &operator=(const TleStringArena &) = delete;
+
+    /*!
+     * \brief append - копирование строки в арену
+     * \param data Байты строки
+     * \param size Длина
+     * \return Представление копии
+     */
+    TleText append(const char *data, int size);
+
+    //! Копирование строки в арену
+    TleText append(TleText text) { return this->append(text.data(), text.size()); }
+
+    //! Копирование строки в арену (в UTF-8)
+    TleText append(const QString &text);
+
+    /*!
+     * \brief intern - строка из арены, равная заданной
+     * \param data Байты строки
+     * \param size Длина
+     * \return Ранее сохранённая копия или новая (для строк длиннее maxInternedSize — всегда новая)
+     */
+    TleText intern(const char *data, int size);
+
+    //! Строка из арены, равная заданной
+    TleText intern(TleText text) { return this->intern(text.data(), text.size()); }
+
+    //! Строка из арены, равная заданной (в UTF-8)
+    TleText intern(const QString &text);
+
+    //! Выделенная под строки память (байт)
+    qint64 memoryUsage() const { return this->allocated_; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks_; //! Блоки строк
+    char *current_ = nullptr;                     //! Свободное место текущего блока
+    int available_ = 0;                           //! Свободных байт в текущем блоке
+    int nextBlockSize_ = firstBlockSize;          //! Размер следующего блока
+    qint64 allocated_ = 0;                        //! Выделено байт
+    QSet<TleText> interned_;                      //! Интернированные строки (в арене)
+};
+
+#endif // TLESTRINGARENA_HPP
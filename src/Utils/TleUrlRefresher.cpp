@@ -0,0 +1,320 @@
+/*!
+ * \file TleUrlRefresher.cpp
+ * \brief Обновление каталога из URL по расписанию
+ * \details
+ * Этот файл содержит реализацию класса TleUrlRefresher.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "TleUrlRefresher.hpp"
+
+#include <QCryptographicHash>
+#include <QRandomGenerator>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "TleDataParser.hpp"
+
+namespace {
+
+//! Наибольшее время запроса (мс): зависший запрос не должен блокировать источник
+constexpr int requestTimeout = 120000;
+
+} // namespace
+
+TleUrlRefresher::TleUrlRefresher(QObject *parent)
+    : QObject(parent)
+    , network_(new QNetworkAccessManager(this))
+{
+    this->clock_.start();
+    //! Сроки измеряются минутами, поэтому точность таймера в секунду достаточна
+    this->timer_.setSingleShot(true);
+    this->timer_.setTimerType(Qt::VeryCoarseTimer);
+
+    this->connect(&this->timer_, &QTimer::timeout, this, &TleUrlRefresher::schedule);
+    this->connect(&this->watcher_,
+                  &QFutureWatcher<Batch>::finished,
+                  this,
+                  &TleUrlRefresher::onBatchFinished);
+}
+
+void TleUrlRefresher::setSources(const QVector<RefreshSource> &sources)
+{
+    QMap<QString, Source> kept;
+    for (const RefreshSource &settings : sources) {
+        const QString key = settings.url.toString();
+        if (kept.contains(key))
+            continue;
+        const auto previous = this->sources_.find(key);
+        if (previous == this->sources_.end()) {
+            Source source;
+            source.settings = settings;
+            source.due = this->clock_.elapsed(); //! Новый источник загружается сразу
+            kept.insert(key, source);
+            continue;
+        }
+        Source source = previous.value();
+        if (source.settings.interval != settings.interval && !source.failures)
+            source.due = qMin(source.due, this->nextDue(settings.interval));
+        source.settings = settings;
+        kept.insert(key, source);
+        this->sources_.erase(previous);
+    }
+
+    //! Запросы удалённых источников прерываются, их ответы больше не нужны
+    for (auto it = this->sources_.begin(); it != this->sources_.end(); ++it) {
+        if (it->reply) {
+            it->reply->disconnect(this);
+            it->reply->abort();
+            it->reply->deleteLater();
+        }
+        this->pending_.remove(it.key());
+        this->rebuild_ = this->rebuild_ || it->loaded; //! Их записи уходят из статистики
+    }
+    this->sources_ = kept;
+
+    this->startBatch();
+    this->schedule();
+}
+
+QVector<RefreshSource> TleUrlRefresher::sources() const
+{
+    QVector<RefreshSource> sources;
+    for (const Source &source : this->sources_)
+        sources.append(source.settings);
+    return sources;
+}
+
+void TleUrlRefresher::setRecords(const QUrl &url, const QVector<TleRecord> &records)
+{
+    const auto it = this->sources_.find(url.toString());
+    if (it == this->sources_.end())
+        return;
+    it->records = records;
+    it->loaded = true;
+    it->failures = 0;
+    it->due = this->nextDue(it->settings.interval);
+    this->schedule();
+}
+
+void TleUrlRefresher::setFields(TleFields fields)
+{
+    this->fields_ = fields;
+}
+
+void TleUrlRefresher::setJitter(double fraction)
+{
+    this->jitter_ = qBound(0.0, fraction, 0.5);
+}
+
+void TleUrlRefresher::setRetryInterval(int first, int maximum)
+{
+    this->retryFirst_ = qMax(1, first);
+    this->retryMaximum_ = qMax(this->retryFirst_, maximum);
+}
+
+void TleUrlRefresher::setEnabled(bool enabled)
+{
+    if (this->enabled_ == enabled)
+        return;
+    this->enabled_ = enabled;
+    this->schedule(); //! При выключении таймер останавливается
+}
+
+bool TleUrlRefresher::isEnabled() const
+{
+    return this->enabled_;
+}
+
+void TleUrlRefresher::refreshNow()
+{
+    for (auto it = this->sources_.begin(); it != this->sources_.end(); ++it)
+        if (!it->reply)
+            this->fetch(it.key());
+    this->schedule();
+}
+
+void TleUrlRefresher::fetch(const QString &key)
+{
+    Source &source = this->sources_[key];
+    QNetworkRequest request(source.settings.url);
+    //! Условный запрос: неизменившийся каталог сервер не передаёт
+    if (source.loaded) {
+        if (!source.etag.isEmpty())
+            request.setRawHeader("If-None-Match", source.etag);
+        if (!source.lastModified.isEmpty())
+            request.setRawHeader("If-Modified-Since", source.lastModified);
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    request.setTransferTimeout(requestTimeout);
+#endif
+
+    QNetworkReply *reply = this->network_->get(request);
+    source.reply = reply;
+    this->connect(reply, &QNetworkReply::finished, this, [this, key, reply]() {
+        this->onReplyFinished(key, reply);
+    });
+}
+
+void TleUrlRefresher::onReplyFinished(const QString &key, QNetworkReply *reply)
+{
+    reply->deleteLater(); //! Ответ удаляется после обработки
+    const auto it = this->sources_.find(key);
+    if (it == this->sources_.end() || it->reply != reply)
+        return;
+    it->reply = nullptr;
+
+    const QString url = it->settings.url.toString();
+    if (reply->error() != QNetworkReply::NoError) {
+        this->fail(key, tr("Источник %1: %2").arg(url, reply->errorString()));
+        this->schedule();
+        return;
+    }
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode != 200 && statusCode != 304) {
+        this->fail(key, tr("Источник %1: ошибка HTTP %2").arg(url).arg(statusCode));
+        this->schedule();
+        return;
+    }
+
+    it->due = this->nextDue(it->settings.interval);
+    Payload payload;
+    if (statusCode == 200) {
+        payload.data = reply->readAll();
+        payload.digest = QCryptographicHash::hash(payload.data, QCryptographicHash::Sha1);
+    }
+    //! Каталог не изменился: ни разбора, ни пересчёта
+    if (statusCode == 304 || (it->loaded && payload.digest == it->digest)) {
+        if (statusCode == 200) {
+            it->etag = reply->rawHeader("ETag");
+            it->lastModified = reply->rawHeader("Last-Modified");
+        }
+        it->failures = 0;
+        this->schedule();
+        return;
+    }
+
+    payload.etag = reply->rawHeader("ETag");
+    payload.lastModified = reply->rawHeader("Last-Modified");
+    payload.contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+    payload.fileName = reply->url().path();
+    this->pending_.insert(key, payload); //! Неразобранный прошлый ответ источника заменяется
+    this->startBatch();
+    this->schedule();
+}
+
+void TleUrlRefresher::fail(const QString &key, const QString &message)
+{
+    const auto it = this->sources_.find(key);
+    if (it != this->sources_.end()) {
+        ++it->failures;
+        //! Задержка удваивается после каждой ошибки подряд, но не превышает retryMaximum_
+        const double delay = std::ldexp(double(this->retryFirst_), qMin(it->failures - 1, 30));
+        it->due = this->nextDue(qMin(delay, double(this->retryMaximum_)));
+    }
+    emit errorOccurred(message);
+}
+
+qint64 TleUrlRefresher::nextDue(double seconds) const
+{
+    const double spread = this->jitter_
+                          * (2.0 * QRandomGenerator::global()->generateDouble() - 1.0);
+    return this->clock_.elapsed() + qint64(qMax(1.0, seconds * (1.0 + spread)) * 1000.0);
+}
+
+void TleUrlRefresher::startBatch()
+{
+    //! Во время разбора новые ответы только накапливаются
+    if (this->watcher_.isRunning() || (this->pending_.isEmpty() && !this->rebuild_))
+        return;
+
+    QMap<QString, Payload> payloads;
+    payloads.swap(this->pending_);
+    QMap<QString, QVector<TleRecord>> current; //! Записи источников, которые не разбираются заново
+    for (auto it = this->sources_.cbegin(); it != this->sources_.cend(); ++it)
+        if (it->loaded)
+            current.insert(it.key(), it->records);
+    const bool rebuild = std::exchange(this->rebuild_, false);
+    const TleFields fields = this->fields_;
+
+    this->watcher_.setFuture(QtConcurrent::run([payloads, current, rebuild, fields]() {
+        Batch batch;
+        QMap<QString, QVector<TleRecord>> records = current;
+        for (auto it = payloads.cbegin(); it != payloads.cend(); ++it) {
+            //! Свой разборщик на ответ: у каждого каталога своя арена строк
+            TleDataParser parser(fields);
+            const TleParseResult result = parser.parse(it->data, it->contentType, it->fileName);
+            if (!result.error.isEmpty()) {
+                batch.errors.insert(it.key(), result.error);
+                continue;
+            }
+            Payload parsed = it.value();
+            parsed.data.clear(); //! Тело ответа больше не нужно
+            batch.parsed.insert(it.key(), parsed);
+            batch.records.insert(it.key(), result.records);
+            records.insert(it.key(), result.records);
+        }
+        if (batch.records.isEmpty() && !rebuild)
+            return batch; //! Ни один ответ не разобран: статистика прежняя
+
+        QVector<TleRecord> all;
+        for (const QVector<TleRecord> &part : std::as_const(records))
+            all += part;
+        batch.statistics = std::make_shared<TleStatistics>(all);
+        return batch;
+    }));
+}
+
+void TleUrlRefresher::onBatchFinished()
+{
+    const Batch batch = this->watcher_.result();
+    for (auto it = batch.records.cbegin(); it != batch.records.cend(); ++it) {
+        const auto source = this->sources_.find(it.key());
+        if (source == this->sources_.end())
+            continue; //! Источник удалён во время разбора
+        const Payload parsed = batch.parsed.value(it.key());
+        source->records = it.value();
+        source->loaded = true;
+        source->failures = 0;
+        source->digest = parsed.digest;
+        source->etag = parsed.etag;
+        source->lastModified = parsed.lastModified;
+    }
+    for (auto it = batch.errors.cbegin(); it != batch.errors.cend(); ++it)
+        if (this->sources_.contains(it.key()))
+            this->fail(it.key(),
+                       tr("Источник %1: %2").arg(this->sources_[it.key()].settings.url.toString(),
+                                                 it.value()));
+
+    //! Если список источников изменился во время разбора, статистика сразу считается заново
+    if (batch.statistics && !this->rebuild_)
+        emit refreshed(*batch.statistics);
+
+    this->startBatch(); //! Ответы, пришедшие во время разбора
+    this->schedule();
+}
+
+void TleUrlRefresher::schedule()
+{
+    this->timer_.stop();
+    if (!this->enabled_)
+        return;
+
+    const qint64 now = this->clock_.elapsed();
+    qint64 next = std::numeric_limits<qint64>::max();
+    for (auto it = this->sources_.begin(); it != this->sources_.end(); ++it) {
+        if (it->reply)
+            continue; //! Следующий срок назначается по ответу
+        if (it->due <= now) {
+            this->fetch(it.key());
+            continue;
+        }
+        next = qMin(next, it->due);
+    }
+    if (next != std::numeric_limits<qint64>::max())
+        this->timer_.start(int(qMin<qint64>(next - now, std::numeric_limits<int>::max())));
+}
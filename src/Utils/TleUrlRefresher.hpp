@@ -0,0 +1,238 @@
+/*!
+ * \file TleUrlRefresher.hpp
+ * \brief Заголовочный файл для класса TleUrlRefresher.
+ * \details
+ * Этот файл содержит определение класса TleUrlRefresher, который периодически
+ * загружает каталог из одного или нескольких URL и пересчитывает статистику в фоне.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef TLEURLREFRESHER_HPP
+#define TLEURLREFRESHER_HPP
+
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QMap>
+#include <QObject>
+#include <QTimer>
+#include <QUrl>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+#include <memory>
+
+#include "TleStatistics.hpp"
+
+/*!
+ * \brief RefreshSource - источник каталога с периодом обновления
+ */
+struct RefreshSource
+{
+    QUrl url;            //! Адрес источника (http или https)
+    int interval = 3600; //! Период обновления (секунды)
+};
+
+/*!
+ * \brief Класс TleUrlRefresher
+ * \details
+ * Все источники обслуживает один таймер, настроенный на ближайший срок обновления,
+ * поэтому в ожидании класс не тратит процессорное время. Срок каждого источника
+ * сдвигается на случайную долю периода (jitter), чтобы окна, открытые одновременно,
+ * не обращались к серверу в одну и ту же секунду. После ошибки источник
+ * запрашивается повторно с экспоненциально растущей задержкой.
+ *
+ * Запросы условные (If-None-Match, If-Modified-Since): если каталог не изменился,
+ * сервер отвечает 304 и разбор не выполняется; ответ с тем же содержимым
+ * распознаётся по отпечатку SHA-1.
+ *
+ * Перекрывающиеся обновления объединяются: у источника не бывает больше одного
+ * запроса, а в фоне — больше одного разбора. Ответы, пришедшие во время разбора,
+ * ждут его окончания (от источника хранится только последний) и разбираются
+ * следующим заходом вместе. Разбор и пересчёт статистики по объединению источников
+ * выполняются в пуле потоков, готовая статистика передаётся сигналом refreshed().
+ */
+class TleUrlRefresher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief TleUrlRefresher - конструктор класса TleUrlRefresher
+     * \param parent Родитель объекта
+     */
+    explicit TleUrlRefresher(QObject *parent = nullptr);
+
+    /*!
+     * \brief setSources - задаёт источники каталога
+     * \param sources Источники с периодами обновления
+     * \details
+     * Состояние источников, которые остались в списке (записи, отпечаток, ошибки),
+     * сохраняется; если список источников изменился, статистика пересчитывается.
+     */
+    void setSources(const QVector<RefreshSource> &sources);
+
+    /*!
+     * \brief sources
+     * \return Источники каталога
+     */
+    QVector<RefreshSource> sources() const;
+
+    /*!
+     * \brief setRecords - записи, уже загруженные из источника
+     * \param url Адрес источника (должен быть задан в setSources())
+     * \param records Записи источника
+     * \details Следующее обновление источника выполняется через его период.
+     */
+    void setRecords(const QUrl &url, const QVector<TleRecord> &records);
+
+    /*!
+     * \brief setFields - поля, которые декодируются при разборе (TleParser::setFields)
+     * \param fields Маска полей
+     */
+    void setFields(TleFields fields);
+
+    /*!
+     * \brief setJitter - разброс сроков обновления
+     * \param fraction Доля периода, на которую срок сдвигается в обе стороны (0..0.5)
+     */
+    void setJitter(double fraction);
+
+    /*!
+     * \brief setRetryInterval - задержки повторных запросов после ошибок
+     * \param first Задержка после первой ошибки (секунды)
+     * \param maximum Наибольшая задержка (секунды)
+     * \details После каждой следующей ошибки подряд задержка удваивается.
+     */
+    void setRetryInterval(int first, int maximum);
+
+    /*!
+     * \brief setEnabled - включает или выключает обновление по расписанию
+     * \param enabled true — обновлять источники
+     * \details При включении источники, срок которых прошёл, загружаются сразу.
+     */
+    void setEnabled(bool enabled);
+
+    /*!
+     * \brief isEnabled
+     * \return true, если обновление по расписанию включено
+     */
+    bool isEnabled() const;
+
+public slots:
+    /*!
+     * \brief refreshNow - загружает все источники, не дожидаясь сроков
+     * \details Источники, запрос которых уже выполняется, повторно не запрашиваются.
+     */
+    void refreshNow();
+
+signals:
+    /*!
+     * \brief refreshed - каталог изменился, статистика пересчитана
+     * \param statistics Статистика по объединению записей всех источников
+     */
+    void refreshed(const TleStatistics &statistics);
+
+    /*!
+     * \brief errorOccurred - ошибка загрузки или разбора источника
+     * \param message Сообщение об ошибке
+     */
+    void errorOccurred(const QString &message);
+
+private:
+    /*!
+     * \brief Source - состояние источника
+     */
+    struct Source
+    {
+        RefreshSource settings;         //! Адрес и период
+        qint64 due = 0;                 //! Срок следующего запроса (мс по clock_)
+        int failures = 0;               //! Ошибок подряд
+        QNetworkReply *reply = nullptr; //! Выполняющийся запрос
+        QByteArray etag;                //! Заголовок ETag разобранного ответа
+        QByteArray lastModified;        //! Заголовок Last-Modified разобранного ответа
+        QByteArray digest;              //! Отпечаток разобранного ответа (SHA-1)
+        bool loaded = false;            //! Есть ли записи источника
+        QVector<TleRecord> records;     //! Записи последнего разобранного ответа
+    };
+
+    /*!
+     * \brief Payload - ответ источника, ожидающий разбора
+     */
+    struct Payload
+    {
+        QByteArray data;         //! Тело ответа
+        QByteArray digest;       //! Отпечаток тела (SHA-1)
+        QByteArray etag;         //! Заголовок ETag
+        QByteArray lastModified; //! Заголовок Last-Modified
+        QString contentType;     //! Тип содержимого
+        QString fileName;        //! Путь URL (подсказка формата архива)
+    };
+
+    /*!
+     * \brief Batch - результат фонового разбора и пересчёта
+     */
+    struct Batch
+    {
+        QMap<QString, QVector<TleRecord>> records; //! Записи разобранных источников
+        QMap<QString, Payload> parsed;             //! Разобранные ответы (без тела)
+        QMap<QString, QString> errors;             //! Ошибки разбора по источникам
+        std::shared_ptr<TleStatistics> statistics; //! Статистика по всем источникам (если изменилась)
+    };
+
+    /*!
+     * \brief fetch - запрос источника
+     * \param key Ключ источника в sources_
+     */
+    void fetch(const QString &key);
+
+    /*!
+     * \brief onReplyFinished - обработка ответа источника
+     * \param key Ключ источника
+     * \param reply Ответ
+     */
+    void onReplyFinished(const QString &key, QNetworkReply *reply);
+
+    /*!
+     * \brief fail - учёт ошибки источника и перенос срока по экспоненциальной задержке
+     * \param key Ключ источника
+     * \param message Сообщение об ошибке
+     */
+    void fail(const QString &key, const QString &message);
+
+    /*!
+     * \brief nextDue - срок, сдвинутый на задержку с разбросом
+     * \param seconds Задержка (секунды)
+     */
+    qint64 nextDue(double seconds) const;
+
+    /*!
+     * \brief startBatch - запускает фоновый разбор ожидающих ответов, если он не идёт
+     */
+    void startBatch();
+
+    /*!
+     * \brief onBatchFinished - применение результата фонового разбора
+     */
+    void onBatchFinished();
+
+    /*!
+     * \brief schedule - запросы с прошедшим сроком и настройка таймера на ближайший срок
+     */
+    void schedule();
+
+    QNetworkAccessManager *network_;   //! Менеджер сетевых запросов
+    QTimer timer_;                     //! Таймер ближайшего срока
+    QElapsedTimer clock_;              //! Монотонные часы сроков
+    QMap<QString, Source> sources_;    //! Источники по адресу
+    QMap<QString, Payload> pending_;   //! Ответы, ожидающие разбора
+    bool rebuild_ = false;             //! Нужен пересчёт статистики без новых ответов
+    QFutureWatcher<Batch> watcher_;    //! Фоновый разбор
+    TleFields fields_ = TleField::All; //! Поля, декодируемые при разборе
+    double jitter_ = 0.1;              //! Разброс сроков (доля периода)
+    int retryFirst_ = 30;              //! Задержка после первой ошибки (секунды)
+    int retryMaximum_ = 3600;          //! Наибольшая задержка после ошибок (секунды)
+    bool enabled_ = false;             //! Включено ли обновление по расписанию
+};
+
+#endif // TLEURLREFRESHER_HPP
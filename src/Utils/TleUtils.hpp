@@ -0,0 +1,242 @@
+/*!
+ * \file TleUtils.hpp
+ * \brief Вспомогательные функции для работы с полями TLE
+ * \details
+ * Этот файл содержит функции перевода эпохи TLE (две цифры года и день года)
+ * в абсолютное время и обратно, а также разбор полей в экспоненциальной записи TLE
+ * и номеров объектов (в том числе в формате Alpha-5).
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef TLEUTILS_HPP
+#define TLEUTILS_HPP
+
+#include <algorithm>
+#include <cmath>
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include "TleRecord.hpp"
+
+namespace TleUtils {
+
+//! Количество микросекунд в сутках
+constexpr qint64 microsPerDay = Q_INT64_C(86400000000);
+
+/*!
+ * \brief fullYear - полный год по двум последним цифрам
+ * \param twoDigitYear Последние две цифры года (как в TLE)
+ * \return Год: 57–99 → 1957–1999, 00–56 → 2000–2056
+ */
+inline int fullYear(int twoDigitYear)
+{
+    return twoDigitYear < 57 ? 2000 + twoDigitYear : 1900 + twoDigitYear;
+}
+
+/*!
+ * \brief daysFromCivil - количество дней от 01.01.1970 до указанной даты
+ * \details Алгоритм Говарда Хиннанта для пролептического григорианского календаря.
+ */
+inline qint64 daysFromCivil(int year, unsigned month, unsigned day)
+{
+    year -= month <= 2;
+    const qint64 era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = unsigned(year - era * 400);
+    const unsigned dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + qint64(dayOfEra) - 719468;
+}
+
+/*!
+ * \brief yearFromDays - год по количеству дней от 01.01.1970
+ */
+inline int yearFromDays(qint64 days)
+{
+    days += 719468;
+    const qint64 era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned dayOfEra = unsigned(days - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096)
+                               / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned monthPrime = (5 * dayOfYear + 2) / 153;
+    return int(yearOfEra + era * 400) + (monthPrime >= 10 ? 1 : 0);
+}
+
+/*!
+ * \brief epochToUnixMicros - эпоха TLE в микросекундах от 01.01.1970 (UTC)
+ * \param yearSuffix Последние две цифры года эпохи
+ * \param epochTime День года с дробной частью (1.0 — начало 1 января)
+ */
+inline qint64 epochToUnixMicros(int yearSuffix, double epochTime)
+{
+    const double day = std::floor(epochTime);
+    const qint64 days = daysFromCivil(fullYear(yearSuffix), 1, 1) + qint64(day) - 1;
+    return days * microsPerDay + qint64(std::llround((epochTime - day) * double(microsPerDay)));
+}
+
+//! Эпоха записи в микросекундах от 01.01.1970 (UTC)
+inline qint64 epochToUnixMicros(const TleRecord &record)
+{
+    return epochToUnixMicros(record.epochYearSuffix, record.epochTime);
+}
+
+//! Эпоха записи в секундах от 01.01.1970 (UTC)
+inline double epochToUnixSeconds(const TleRecord &record)
+{
+    return double(epochToUnixMicros(record)) * 1e-6;
+}
+
+/*!
+ * \brief unixMicrosToEpoch - обратное преобразование в представление TLE
+ * \param micros Микросекунды от 01.01.1970 (UTC)
+ * \param yearSuffix Выход: последние две цифры года
+ * \param epochTime Выход: день года с дробной частью
+ */
+inline void unixMicrosToEpoch(qint64 micros, int &yearSuffix, double &epochTime)
+{
+    qint64 days = micros / microsPerDay;
+    if (micros % microsPerDay < 0)
+        --days; //! Округление вниз для дат до 1970 года
+    const qint64 rest = micros - days * microsPerDay;
+    const int year = yearFromDays(days);
+    yearSuffix = year % 100;
+    epochTime = double(days - daysFromCivil(year, 1, 1) + 1) + double(rest) / double(microsPerDay);
+}
+
+/*!
+ * \brief unixSecondsToJulian - юлианская дата по секундам от 01.01.1970 (UTC)
+ */
+inline double unixSecondsToJulian(double seconds)
+{
+    return seconds / 86400.0 + 2440587.5;
+}
+
+/*!
+ * \brief powerOfTen - 10^k умножениями
+ * \details
+ * До 10^22 результат точен; в отличие от std::pow, он одинаков во всех
+ * реализациях стандартной библиотеки.
+ */
+inline double powerOfTen(int k)
+{
+    double power = 1.0;
+    for (int i = 0; i < k; ++i)
+        power *= 10.0;
+    return power;
+}
+
+/*!
+ * \brief parseTleExponent - разбор поля в экспоненциальной записи TLE
+ * \param text Строка вида "-16227-2" (означает -0.16227e-2)
+ * \return Значение поля или 0, если строка некорректна
+ */
+inline double parseTleExponent(TleText text)
+{
+    const TleText s = text.trimmed();
+    if (s.size() < 3)
+        return 0.0;
+    bool mantissaOk = false, exponentOk = false;
+    const double mantissa = QByteArray(s.data(), s.size() - 2).toDouble(&mantissaOk);
+    const int exponent = QByteArray(s.data() + s.size() - 2, 2).toInt(&exponentOk);
+    if (!mantissaOk || !exponentOk)
+        return 0.0;
+    //! Одно деление или умножение на точную степень десяти — одно округление
+    return exponent <= 5 ? mantissa / powerOfTen(5 - exponent)
+                         : mantissa * powerOfTen(exponent - 5);
+}
+
+//! Коэффициент торможения B* записи в виде числа
+inline double bstar(const TleRecord &record)
+{
+    return parseTleExponent(record.brakingCoefficient);
+}
+
+//! Наибольший номер объекта, представимый в TLE (Alpha-5 "Z9999")
+constexpr int maxCatalogNumber = 339999;
+
+/*!
+ * \brief alpha5Value - значение первого символа номера в формате Alpha-5
+ * \details
+ * Номера от 100000 до 339999 записываются буквой (A = 10 … Z = 33, без I и O,
+ * чтобы не путать с 1 и 0) и четырьмя цифрами: 100000 = "A0000", 339999 = "Z9999".
+ * \return Значение буквы или -1, если символ не буква Alpha-5
+ */
+inline int alpha5Value(char c)
+{
+    if (c < 'A' || c > 'Z' || c == 'I' || c == 'O')
+        return -1;
+    return 10 + (c - 'A') - (c > 'I' ? 1 : 0) - (c > 'O' ? 1 : 0);
+}
+
+/*!
+ * \brief parseCatalogNumber - номер объекта из 5-символьного поля TLE
+ * \param field Поле: цифры (допускаются пробелы слева) или Alpha-5
+ * \return Номер или 0, если поле некорректно
+ */
+inline int parseCatalogNumber(TleText field)
+{
+    const int letter = field.size() == 5 ? alpha5Value(field.at(0)) : -1;
+    int value = letter >= 0 ? letter : 0;
+    int i = letter >= 0 ? 1 : 0;
+    while (letter < 0 && i < field.size() && field.at(i) == ' ')
+        ++i;
+    if (i == field.size())
+        return 0;
+    for (; i < field.size(); ++i) {
+        const char c = field.at(i);
+        if (c < '0' || c > '9')
+            return 0;
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+/*!
+ * \brief formatCatalogNumber - 5-символьное поле номера объекта
+ * \param number Номер (до 99999 — цифрами, до maxCatalogNumber — в формате Alpha-5)
+ * \param out Выход: 5 байт
+ * \return false, если номер не представим в TLE (поле не изменяется)
+ */
+inline bool formatCatalogNumber(int number, char *out)
+{
+    static const char letters[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+    if (number < 0 || number > maxCatalogNumber)
+        return false;
+    int rest = number % 10000;
+    for (int i = 4; i >= 1; --i, rest /= 10)
+        out[i] = char('0' + rest % 10);
+    const int head = number / 10000;
+    out[0] = head < 10 ? char('0' + head) : letters[head - 10];
+    return true;
+}
+
+/*!
+ * \brief latestEpochIndices - по одной записи на объект: с самой поздней эпохой
+ * \param records Записи (объект может встречаться несколько раз)
+ * \return Индексы выбранных записей по возрастанию
+ */
+inline QVector<int> latestEpochIndices(const QVector<TleRecord> &records)
+{
+    QHash<int, int> latest;
+    for (int i = 0; i < records.size(); ++i) {
+        auto it = latest.find(records[i].catalogNumber);
+        if (it == latest.end())
+            latest.insert(records[i].catalogNumber, i);
+        else if (epochToUnixMicros(records[i]) > epochToUnixMicros(records[it.value()]))
+            it.value() = i;
+    }
+    QVector<int> indices;
+    indices.reserve(latest.size());
+    for (auto it = latest.cbegin(); it != latest.cend(); ++it)
+        indices.append(it.value());
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+} // namespace TleUtils
+
+#endif // TLEUTILS_HPP
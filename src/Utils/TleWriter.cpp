@@ -0,0 +1,336 @@
+/*!
+ * \file TleWriter.cpp
+ * \brief Запись каталога в формате TLE
+ * \details
+ * Этот файл содержит реализацию класса TleWriter.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include "TleWriter.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include "TleUtils.hpp"
+
+namespace {
+
+constexpr int lineBytes = TleWriter::lineLength + 1; //! Строка с переводом строки
+
+/*!
+ * \brief writeInteger - неотрицательное целое, выровненное по правому краю
+ * \param out Начало поля
+ * \param width Ширина поля
+ * \param value Значение (отрицательное записывается как 0, слишком большое — девятками)
+ * \param pad Символ заполнения слева ('0' или ' ')
+ */
+void writeInteger(char *out, int width, qint64 value, char pad)
+{
+    quint64 rest = value > 0 ? quint64(value) : 0;
+    int position = width - 1;
+    do {
+        out[position--] = char('0' + rest % 10);
+        rest /= 10;
+    } while (rest > 0 && position >= 0);
+    if (rest > 0) {
+        std::memset(out, '9', size_t(width));
+        return;
+    }
+    while (position >= 0)
+        out[position--] = pad;
+}
+
+/*!
+ * \brief writeFixed - число с фиксированной точкой (как printf("%*.*f"))
+ * \param out Начало поля
+ * \param width Ширина поля
+ * \param decimals Количество знаков после точки
+ * \param value Значение
+ * \param pad Символ заполнения целой части слева
+ * \details
+ * Округление выполняется в целых числах, поэтому результат не зависит
+ * от локали C (десятичный разделитель всегда точка).
+ */
+void writeFixed(char *out, int width, int decimals, double value, char pad = ' ')
+{
+    qint64 unit = 1;
+    for (int i = 0; i < decimals; ++i)
+        unit *= 10;
+    const qint64 scaled = std::isfinite(value)
+                              ? qint64(std::llround(std::fabs(value) * double(unit)))
+                              : 0;
+
+    //! Дробная часть справа, затем точка и целая часть
+    qint64 fraction = scaled % unit;
+    for (int i = 0; i < decimals; ++i) {
+        out[width - 1 - i] = char('0' + fraction % 10);
+        fraction /= 10;
+    }
+    const int integerWidth = width - 1 - decimals;
+    out[integerWidth] = '.';
+    writeInteger(out, integerWidth, scaled / unit, pad);
+
+    //! Знак ставится перед первой значащей цифрой (углы и среднее движение неотрицательны)
+    if (value < 0.0 && scaled != 0) {
+        int position = 0;
+        while (position < integerWidth - 1 && out[position] == ' ')
+            ++position;
+        out[position > 0 ? position - 1 : 0] = '-';
+    }
+}
+
+/*!
+ * \brief writeBstar - поле B*, сохранённое в записи в текстовом виде
+ * \details Корректный текст переносится без изменений, иначе записывается ноль.
+ */
+void writeBstar(TleText text, char *out)
+{
+    //! Вид поля: необязательный знак, пять цифр мантиссы, знак и цифра порядка
+    const int length = int(text.size());
+    bool valid = length == 7 || length == 8;
+    const int offset = 8 - length;
+    for (int i = 0; valid && i < length; ++i) {
+        const char c = text.at(i);
+        const int column = i + offset; //! Позиция в 8-символьном поле
+        if (column == 0)
+            valid = c == '-' || c == '+' || c == ' ';
+        else if (column == 6)
+            valid = c == '-' || c == '+';
+        else
+            valid = c >= '0' && c <= '9';
+    }
+    if (!valid) {
+        std::memcpy(out, " 00000+0", 8);
+        return;
+    }
+    out[0] = ' ';
+    for (int i = 0; i < length; ++i)
+        out[i + offset] = text.at(i);
+}
+
+/*!
+ * \brief sourceExponent - экспоненциальное поле исходной строки, как TleUtils::parseTleExponent
+ * \param field Начало 8-символьного поля вида "-16227-3"
+ * \param value Выход: значение поля
+ * \return false, если поле некорректно
+ */
+bool sourceExponent(const char *field, double &value)
+{
+    if ((field[0] != ' ' && field[0] != '-' && field[0] != '+')
+        || (field[6] != '-' && field[6] != '+') || field[7] < '0' || field[7] > '9')
+        return false;
+    qint64 mantissa = 0;
+    for (int i = 1; i < 6; ++i) {
+        if (field[i] < '0' || field[i] > '9')
+            return false;
+        mantissa = mantissa * 10 + (field[i] - '0');
+    }
+    if (field[0] == '-')
+        mantissa = -mantissa;
+    const int exponent = field[6] == '-' ? -(field[7] - '0') : field[7] - '0';
+    value = exponent <= 5 ? double(mantissa) / TleUtils::powerOfTen(5 - exponent)
+                          : double(mantissa) * TleUtils::powerOfTen(exponent - 5);
+    return true;
+}
+
+/*!
+ * \brief sourceField - поле исходной первой строки записи
+ * \param record Запись
+ * \param column Столбец поля в строке стандартной длины
+ * \return Начало поля или nullptr, если исходной строки нет
+ * \details
+ * Экспоненциальное поле исходной строки переносится без изменений, если задаёт то же
+ * значение, что и поле записи: например, нулевая вторая производная " 00000-0"
+ * (так её пишет Celestrak) при форматировании по значению дала бы " 00000+0"
+ * и другую контрольную сумму.
+ */
+const char *sourceField(const TleRecord &record, int column)
+{
+    //! Поля после части запуска сдвинуты, если она короче трёх символов
+    const int shift = int(record.line1.size()) - TleWriter::lineLength;
+    if (shift < -2 || shift > 0)
+        return nullptr;
+    return record.line1.data() + column + shift;
+}
+
+} // namespace
+
+TleWriter::TleWriter(QIODevice *device, bool withNames, int bufferSize)
+    : device_(device)
+    , withNames_(withNames)
+{
+    this->buffer_.resize(qMax(bufferSize, 4 * lineBytes));
+}
+
+TleWriter::~TleWriter()
+{
+    this->flush();
+}
+
+bool TleWriter::write(const TleRecord &record)
+{
+    //! Номер не заменяется другим: запись, которую нельзя записать без искажения, пропускается
+    if (record.catalogNumber < 0 || record.catalogNumber > TleUtils::maxCatalogNumber) {
+        ++this->skipped_;
+        return false;
+    }
+    const int nameLength = this->withNames_ ? int(record.name.size()) : 0;
+    const int required = (nameLength > 0 ? nameLength + 1 : 0) + 2 * lineBytes;
+    if (this->used_ + required > this->buffer_.size()) {
+        this->flush();
+        if (required > this->buffer_.size())
+            this->buffer_.resize(required); //! Только для имён длиннее буфера
+    }
+
+    char *out = this->buffer_.data() + this->used_;
+    if (nameLength > 0) {
+        //! Имена в TLE — ASCII; прочие символы (UTF-8) заменяются на '?'
+        const char *name = record.name.data();
+        for (int i = 0; i < nameLength; ++i) {
+            const uchar c = uchar(name[i]);
+            if (c < 0x80)
+                *out++ = char(c);
+            else if (c >= 0xC0)
+                *out++ = '?'; //! Первый байт символа; продолжения 10xxxxxx пропускаются
+        }
+        *out++ = '\n';
+    }
+    formatLine1(record, out);
+    out[lineLength] = '\n';
+    out += lineBytes;
+    formatLine2(record, out);
+    out[lineLength] = '\n';
+    out += lineBytes;
+
+    this->used_ = int(out - this->buffer_.constData());
+    return this->ok_;
+}
+
+bool TleWriter::write(const QVector<TleRecord> &records)
+{
+    for (const TleRecord &record : records)
+        this->write(record);
+    return this->ok_;
+}
+
+int TleWriter::skipped() const
+{
+    return this->skipped_;
+}
+
+bool TleWriter::flush()
+{
+    if (this->used_ > 0 && this->device_) {
+        if (this->device_->write(this->buffer_.constData(), this->used_) != this->used_)
+            this->ok_ = false;
+    }
+    this->used_ = 0;
+    return this->ok_;
+}
+
+void TleWriter::formatLine1(const TleRecord &record, char *out)
+{
+    std::memset(out, ' ', lineLength);
+    out[0] = '1';
+    TleUtils::formatCatalogNumber(record.catalogNumber, out + 2);
+    out[7] = record.classification.isEmpty() ? ' ' : record.classification.at(0);
+
+    //! Международное обозначение: год, номер запуска, часть (по левому краю)
+    writeInteger(out + 9, 2, record.yearLaunch, '0');
+    writeInteger(out + 11, 3, record.numberLaunch, '0');
+    for (int i = 0; i < 3 && i < record.launchPiece.size(); ++i)
+        out[14 + i] = record.launchPiece.at(i);
+
+    //! Эпоха: год и день года "ddd.dddddddd"
+    writeInteger(out + 18, 2, record.epochYearSuffix, '0');
+    writeFixed(out + 20, 12, 8, record.epochTime, '0');
+
+    //! Первая производная среднего движения: знак и ".dddddddd"
+    const double derivative = record.meanMotionFirstDerivative;
+    qint64 scaled = qint64(std::llround(std::fabs(derivative) * 1e8));
+    scaled = qMin<qint64>(scaled, 99999999);
+    out[33] = derivative < 0.0 && scaled != 0 ? '-' : ' ';
+    out[34] = '.';
+    writeInteger(out + 35, 8, scaled, '0');
+
+    formatExponent(record.meanMotionSecondDerivative, out + 44);
+    const char *source = sourceField(record, 44);
+    double secondDerivative = 0.0;
+    if (source && sourceExponent(source, secondDerivative)
+        && secondDerivative == record.meanMotionSecondDerivative)
+        std::memcpy(out + 44, source, 8); //! Например, " 00000-0"
+    writeBstar(record.brakingCoefficient, out + 53);
+
+    out[62] = char('0' + qBound(0, record.ephemerisType, 9));
+    writeInteger(out + 64, 4, qBound(0, record.elementSetNumber, 9999), ' ');
+    out[68] = char('0' + checksum(out));
+}
+
+void TleWriter::formatLine2(const TleRecord &record, char *out)
+{
+    std::memset(out, ' ', lineLength);
+    out[0] = '2';
+    TleUtils::formatCatalogNumber(record.catalogNumber, out + 2);
+    writeFixed(out + 8, 8, 4, record.inclination);
+    writeFixed(out + 17, 8, 4, record.rightAscension);
+
+    //! Эксцентриситет: семь цифр с подразумеваемой точкой
+    const qint64 eccentricity = qint64(std::llround(record.eccentricity * 1e7));
+    writeInteger(out + 26, 7, qBound<qint64>(0, eccentricity, 9999999), '0');
+
+    writeFixed(out + 34, 8, 4, record.argPerigee);
+    writeFixed(out + 43, 8, 4, record.meanAnomaly);
+    writeFixed(out + 52, 11, 8, record.meanMotion);
+    writeInteger(out + 63, 5, qBound(0, record.revolutionNumberOfEpoch, 99999), ' ');
+    out[68] = char('0' + checksum(out));
+}
+
+void TleWriter::formatExponent(double value, char *out)
+{
+    if (value == 0.0 || !std::isfinite(value)) {
+        std::memcpy(out, " 00000+0", 8);
+        return;
+    }
+
+    const double magnitude = std::fabs(value);
+    //! magnitude · 10^shift одним умножением или делением на точную степень десяти:
+    //! без log10 и pow запись не зависит от реализации libm
+    auto scaled = [magnitude](int shift) {
+        return shift >= 0 ? magnitude * TleUtils::powerOfTen(shift)
+                          : magnitude / TleUtils::powerOfTen(-shift);
+    };
+    //! Мантисса с подразумеваемой точкой: 0.xxxxx * 10^exponent, то есть magnitude < 10^exponent
+    int exponent = 0;
+    while (exponent < 30 && scaled(-exponent) >= 1.0)
+        ++exponent;
+    while (exponent > -30 && scaled(1 - exponent) < 1.0)
+        --exponent;
+    qint64 mantissa = std::llround(scaled(5 - exponent));
+    if (mantissa >= 100000) {
+        mantissa /= 10;
+        ++exponent;
+    }
+    if (exponent < -9) {
+        std::memcpy(out, " 00000+0", 8); //! Значение меньше представимого
+        return;
+    }
+    exponent = qMin(exponent, 9);
+
+    out[0] = value < 0.0 ? '-' : ' ';
+    writeInteger(out + 1, 5, mantissa, '0');
+    out[6] = exponent < 0 ? '-' : '+';
+    out[7] = char('0' + std::abs(exponent));
+}
+
+int TleWriter::checksum(const char *line)
+{
+    int sum = 0;
+    for (int i = 0; i < lineLength - 1; ++i) {
+        if (line[i] >= '0' && line[i] <= '9')
+            sum += line[i] - '0';
+        else if (line[i] == '-')
+            sum += 1; //! Минус даёт 1, остальные символы — 0
+    }
+    return sum % 10;
+}
@@ -0,0 +1,122 @@
+/*!
+ * \file TleWriter.hpp
+ * \brief Заголовочный файл для класса TleWriter
+ * \details
+ * Этот файл содержит определение класса TleWriter, который формирует строки TLE
+ * по разобранным полям TleRecord и записывает каталог в формате 2LE/3LE.
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#ifndef TLEWRITER_HPP
+#define TLEWRITER_HPP
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QVector>
+
+#include "TleRecord.hpp"
+
+/*!
+ * \brief Класс TleWriter
+ * \details
+ * Строки формируются по полям записи (а не копируются из line1/line2), поэтому
+ * записывать можно и записи, загруженные из OMM. Поля с подразумеваемой точкой
+ * и экспоненциальные поля форматируются так же, как в исходных TLE, обе контрольные
+ * суммы вычисляются заново: результат TleParser разбирает в те же значения полей,
+ * а повторная запись даёт те же байты. Если у записи есть исходные строки,
+ * экспоненциальные поля, которые читаются в то же значение, переносятся из них
+ * без изменений, и разобранный каталог записывается байт в байт.
+ *
+ * Строки собираются в байтовом буфере фиксированного размера, который
+ * сбрасывается в устройство по заполнении: при записи память не выделяется.
+ */
+class TleWriter
+{
+public:
+    static constexpr int lineLength = 69; //! Длина строки TLE без перевода строки
+
+    /*!
+     * \brief TleWriter - запись в устройство
+     * \param device Открытое для записи устройство (файл, сокет, буфер)
+     * \param withNames Записывать ли строку имени (3LE); записи без имени пишутся как 2LE
+     * \param bufferSize Размер буфера (байт)
+     */
+    explicit TleWriter(QIODevice *device, bool withNames = true, int bufferSize = 1 << 20);
+
+    /*!
+     * \brief ~TleWriter - сбрасывает оставшиеся в буфере данные
+     */
+    ~TleWriter();
+
+    TleWriter(const TleWriter &) = delete;
+    TleWriter &operator=(const TleWriter &) = delete;
+
+    /*!
+     * \brief write - запись одной записи
+     * \param record Запись TLE
+     * \return false, если устройство не приняло данные или запись пропущена
+     * \details
+     * Номера от 100000 до 339999 записываются в формате Alpha-5. Запись с номером
+     * вне 0…339999 в TLE не представима: она пропускается и учитывается в skipped().
+     */
+    bool write(const TleRecord &record);
+
+    /*!
+     * \brief write - запись набора записей
+     * \param records Записи TLE
+     * \return false, если устройство не приняло данные
+     */
+    bool write(const QVector<TleRecord> &records);
+
+    /*!
+     * \brief skipped
+     * \return Количество пропущенных записей с непредставимым номером объекта
+     */
+    int skipped() const;
+
+    /*!
+     * \brief flush - сброс буфера в устройство
+     * \return false, если устройство не приняло данные
+     */
+    bool flush();
+
+    /*!
+     * \brief formatLine1 - первая строка TLE
+     * \param record Запись (номер объекта не больше TleUtils::maxCatalogNumber,
+     * иначе поле номера остаётся пустым)
+     * \param out Выход: ровно lineLength байт (без завершающего нуля и перевода строки)
+     */
+    static void formatLine1(const TleRecord &record, char *out);
+
+    /*!
+     * \brief formatLine2 - вторая строка TLE
+     * \param record Запись
+     * \param out Выход: ровно lineLength байт
+     */
+    static void formatLine2(const TleRecord &record, char *out);
+
+    /*!
+     * \brief formatExponent - поле в экспоненциальной записи TLE
+     * \param value Значение (например, B* = -0.00016227)
+     * \param out Выход: 8 байт вида "-16227-3" или " 00000+0"
+     */
+    static void formatExponent(double value, char *out);
+
+    /*!
+     * \brief checksum - контрольная сумма строки TLE
+     * \param line Строка (учитываются первые lineLength - 1 символов)
+     * \return Цифра контрольной суммы (0–9)
+     */
+    static int checksum(const char *line);
+
+private:
+    QIODevice *device_; //! Устройство вывода
+    bool withNames_;    //! Записывать строки имён
+    QByteArray buffer_; //! Буфер вывода (размер постоянный)
+    int used_ = 0;      //! Заполненная часть буфера
+    bool ok_ = true;    //! Все предыдущие записи в устройство успешны
+    int skipped_ = 0;   //! Пропущено записей с непредставимым номером
+};
+
+#endif // TLEWRITER_HPP
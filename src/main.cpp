@@ -4,13 +4,516 @@
  * \details
  * Этот файл содержит точку входа в приложение. Он создает экземпляр QApplication,
  * создает главное окно приложения и запускает главный цикл обработки событий.
+ * С ключом --serve приложение запускается без интерфейса как локальный HTTP-сервер каталога,
+ * с ключом --stream — как потоковый обработчик больших архивов TLE
+ * (с --processes — несколькими процессами, запускающими себя с ключом --shard-worker),
+ * с ключом --scan — как поиск манёвров в истории наборов элементов,
+ * с ключами --history-import и --history-query — как импорт наборов элементов
+ * в хранилище истории и запрос к нему.
  * \author KorzikAlex
  * \copyright This project is released under the MIT License.
  * \date 2025
  */
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QTimeZone>
+
+#include <clocale>
+#include <cstdio>
+#include <limits>
+
+#ifdef Q_OS_WIN
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 #include "UI/MainWindow.hpp"
+#include "Utils/CatalogServer.hpp"
+#include "Utils/ManeuverDetector.hpp"
+#include "Utils/ShardCoordinator.hpp"
+#include "Utils/TleHistoryStore.hpp"
+#include "Utils/TleParser.hpp"
+#include "Utils/TleStreamProcessor.hpp"
+#include "Utils/TleWriter.hpp"
+
+/*!
+ * \brief runServer - запуск приложения в режиме сервера.
+ * \param argc Количество аргументов командной строки.
+ * \param argv Массив аргументов командной строки.
+ * \details
+ * Источники (файлы или URL) передаются позиционными аргументами и загружаются один раз,
+ * после чего сервер отвечает на запросы до завершения процесса.
+ * \return Возвращает код завершения приложения.
+ */
+static int runServer(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv); //! Режим сервера не требует графического интерфейса
+
+    QCommandLineParser parser; //! Разбор аргументов командной строки
+    parser.setApplicationDescription(QStringLiteral("Локальный HTTP-сервер каталога TLE"));
+    parser.addHelpOption();
+    parser.addOption({QStringLiteral("serve"), QStringLiteral("Запуск в режиме сервера.")});
+    parser.addOption({{QStringLiteral("p"), QStringLiteral("port")},
+                      QStringLiteral("Порт сервера (по умолчанию 8080)."),
+                      QStringLiteral("port"),
+                      QStringLiteral("8080")});
+    parser.addOption({QStringLiteral("bind"),
+                      QStringLiteral("Адрес сервера (по умолчанию 127.0.0.1)."),
+                      QStringLiteral("address"),
+                      QStringLiteral("127.0.0.1")});
+    parser.addPositionalArgument(QStringLiteral("sources"),
+                                 QStringLiteral("Файлы или URL с данными TLE/OMM."),
+                                 QStringLiteral("<source>..."));
+    parser.process(app);
+
+    const QStringList sources = parser.positionalArguments();
+    if (sources.isEmpty()) {
+        qCritical("Не указаны источники данных");
+        return 1;
+    }
+
+    CatalogServer server; //! Сервер каталога
+    QObject::connect(&server, &CatalogServer::errorOccurred, [](const QString &message) {
+        qWarning("%s", qUtf8Printable(message));
+    });
+    QObject::connect(&server, &CatalogServer::reloaded, [](int count) {
+        qInfo("Загружено записей: %d", count);
+    });
+
+    server.setSources(sources);
+    if (!server.listen(QHostAddress(parser.value(QStringLiteral("bind"))),
+                       quint16(parser.value(QStringLiteral("port")).toUInt()))) {
+        qCritical("%s", qUtf8Printable(server.errorString()));
+        return 1;
+    }
+    qInfo("Сервер запущен на порту %u", unsigned(server.serverPort()));
+
+    server.reload();   //! Первая загрузка источников
+    return app.exec(); //! Запуск главного цикла обработки событий
+}
+
+/*!
+ * \brief runStream - потоковая обработка архива без загрузки в память.
+ * \param argc Количество аргументов командной строки.
+ * \param argv Массив аргументов командной строки.
+ * \details
+ * Сводная статистика выводится в стандартный вывод в формате JSON,
+ * ход обработки и затраченное время — в поток ошибок.
+ * С --processes N > 1 файлы делятся на части, которые обрабатываются
+ * N процессами (ShardCoordinator); результат совпадает с однопроцессным.
+ * \return Возвращает код завершения приложения.
+ */
+static int runStream(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    //! Выгрузка CSV форматирует числа через snprintf: десятичный разделитель — точка
+    std::setlocale(LC_NUMERIC, "C");
+
+    QCommandLineParser parser; //! Разбор аргументов командной строки
+    parser.setApplicationDescription(QStringLiteral("Потоковая обработка архива TLE"));
+    parser.addHelpOption();
+    parser.addOption({QStringLiteral("stream"), QStringLiteral("Запуск в потоковом режиме.")});
+    parser.addOption({QStringLiteral("export"),
+                      QStringLiteral("Выгрузка разобранных записей в CSV."),
+                      QStringLiteral("file")});
+    parser.addOption({QStringLiteral("memory"),
+                      QStringLiteral("Бюджет памяти на буферы, МБ (по умолчанию 256)."),
+                      QStringLiteral("megabytes"),
+                      QStringLiteral("256")});
+    parser.addOption({QStringLiteral("threads"),
+                      QStringLiteral("Количество потоков разбора (по умолчанию по числу ядер)."),
+                      QStringLiteral("count"),
+                      QStringLiteral("0")});
+    parser.addOption({QStringLiteral("processes"),
+                      QStringLiteral("Количество процессов обработки (по умолчанию 1)."),
+                      QStringLiteral("count"),
+                      QStringLiteral("1")});
+    parser.addPositionalArgument(QStringLiteral("files"),
+                                 QStringLiteral("Файлы 2LE/3LE (несколько — только с --processes)."),
+                                 QStringLiteral("<file>..."));
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    const int processes = parser.value(QStringLiteral("processes")).toInt();
+    const qint64 memory = qint64(parser.value(QStringLiteral("memory")).toUInt()) << 20;
+    if (files.isEmpty() || (processes <= 1 && files.size() != 1)) {
+        qCritical("Укажите один файл для обработки или несколько с --processes");
+        return 1;
+    }
+    if (processes > 1 && parser.isSet(QStringLiteral("export"))) {
+        qCritical("Выгрузка CSV выполняется только одним процессом");
+        return 1;
+    }
+
+    int lastPercent = -1; //! Ход обработки выводится не чаще одного раза на процент
+    const auto showProgress = [&lastPercent](qint64 processed, qint64 total) {
+        const int percent = total > 0 ? int(processed * 100 / total) : 100;
+        if (percent != lastPercent) {
+            lastPercent = percent;
+            fprintf(stderr, "\r%3d%%", percent);
+        }
+    };
+
+    QElapsedTimer timer; //! Время обработки (для сравнения режимов)
+    timer.start();
+    bool ok = false;
+    QString error;
+    StreamSummary summary;
+    if (processes > 1) {
+        ShardCoordinator coordinator; //! Обработка частями в нескольких процессах
+        coordinator.setProcessCount(processes);
+        coordinator.setMemoryBudget(memory);
+        QObject::connect(&coordinator, &ShardCoordinator::progress, showProgress);
+        QObject::connect(&coordinator, &ShardCoordinator::shardRetried, [](const QString &message) {
+            fprintf(stderr, "\n");
+            qWarning("%s", qUtf8Printable(message));
+        });
+        ok = coordinator.run(files);
+        error = coordinator.errorString();
+        summary = coordinator.summary();
+    } else {
+        TleStreamProcessor processor; //! Потоковый обработчик
+        processor.setMemoryBudget(memory);
+        processor.setWorkerCount(parser.value(QStringLiteral("threads")).toInt());
+        processor.setExportPath(parser.value(QStringLiteral("export")));
+        QObject::connect(&processor, &TleStreamProcessor::progress, showProgress);
+        ok = processor.run(files.first());
+        error = processor.errorString();
+        summary = processor.summary();
+    }
+    fprintf(stderr, "\n");
+    if (!ok) {
+        qCritical("%s", qUtf8Printable(error));
+        return 1;
+    }
+    fprintf(stderr,
+            "Обработано %lld байт за %.3f с\n",
+            static_cast<long long>(summary.bytes),
+            timer.nsecsElapsed() / 1e9);
+    const QByteArray json = QJsonDocument(summary.toJson()).toJson();
+    fwrite(json.constData(), 1, size_t(json.size()), stdout);
+    return 0;
+}
+
+/*!
+ * \brief runShardWorker - обработка части архива по заданию ShardCoordinator.
+ * \param argc Количество аргументов командной строки.
+ * \param argv Массив аргументов командной строки.
+ * \details
+ * Служебный режим: статистика части выводится в стандартный вывод
+ * в двоичном виде (StreamSummary::toBinary), ошибки — в поток ошибок.
+ * \return Возвращает код завершения приложения.
+ */
+static int runShardWorker(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser; //! Разбор аргументов командной строки
+    parser.addOption({QStringLiteral("shard-worker"), QStringLiteral("Обработка части архива.")});
+    parser.addOption(
+        {QStringLiteral("offset"), QStringLiteral("Начало части."), QStringLiteral("bytes")});
+    parser.addOption(
+        {QStringLiteral("length"), QStringLiteral("Длина части."), QStringLiteral("bytes")});
+    parser.addOption({QStringLiteral("age-reference"),
+                      QStringLiteral("Момент отсчёта возраста эпох, мкс Unix."),
+                      QStringLiteral("micros")});
+    parser.addOption(
+        {QStringLiteral("threads"), QStringLiteral("Потоков разбора."), QStringLiteral("count")});
+    parser.addOption(
+        {QStringLiteral("memory"), QStringLiteral("Бюджет памяти, байт."), QStringLiteral("bytes")});
+    parser.process(app);
+    if (parser.positionalArguments().size() != 1) {
+        qCritical("Укажите один файл для обработки");
+        return 1;
+    }
+
+    TleStreamProcessor processor; //! Потоковый обработчик части
+    processor.setWorkerCount(parser.value(QStringLiteral("threads")).toInt());
+    if (parser.isSet(QStringLiteral("memory")))
+        processor.setMemoryBudget(parser.value(QStringLiteral("memory")).toLongLong());
+    processor.setAgeReference(parser.value(QStringLiteral("age-reference")).toLongLong());
+    const qint64 length = parser.isSet(QStringLiteral("length"))
+                              ? parser.value(QStringLiteral("length")).toLongLong()
+                              : -1;
+    if (!processor.run(parser.positionalArguments().first(),
+                       parser.value(QStringLiteral("offset")).toLongLong(),
+                       length)) {
+        qCritical("%s", qUtf8Printable(processor.errorString()));
+        return 1;
+    }
+
+#ifdef Q_OS_WIN
+    _setmode(_fileno(stdout), _O_BINARY); //! Без замены \n на \r\n в двоичных данных
+#endif
+    const QByteArray data = processor.summary().toBinary();
+    if (fwrite(data.constData(), 1, size_t(data.size()), stdout) != size_t(data.size())
+        || fflush(stdout) != 0)
+        return 1;
+    return 0;
+}
+
+/*!
+ * \brief loadFiles - загрузка наборов элементов из файлов TLE/OMM (в том числе сжатых).
+ * \param files Пути к файлам.
+ * \param fields Поля, которые нужно декодировать.
+ * \param records Выход: записи всех файлов дописываются в конец.
+ * \return false, если какой-либо файл не удалось загрузить (ошибка выводится в журнал).
+ */
+static bool loadFiles(const QStringList &files, TleFields fields, QVector<TleRecord> &records)
+{
+    for (const QString &file : files) {
+        TleParser tleParser;
+        tleParser.setFields(fields); //! Остальные поля не нужны
+        QObject::connect(&tleParser, &TleParser::errorOccurred, [](const QString &message) {
+            qWarning("%s", qUtf8Printable(message));
+        });
+        if (!tleParser.loadFromFile(file))
+            return false;
+        records += tleParser.records();
+    }
+    return true;
+}
+
+/*!
+ * \brief runScan - поиск манёвров и аномалий в истории наборов элементов.
+ * \param argc Количество аргументов командной строки.
+ * \param argv Массив аргументов командной строки.
+ * \details
+ * Источник — файл хранилища истории (TleHistoryStore) или файлы TLE/OMM,
+ * содержащие несколько наборов элементов каждого объекта.
+ * События выводятся в стандартный вывод в формате CSV.
+ * \return Возвращает код завершения приложения.
+ */
+static int runScan(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    std::setlocale(LC_NUMERIC, "C"); //! Числа в CSV выводятся через printf с точкой
+
+    QCommandLineParser parser; //! Разбор аргументов командной строки
+    parser.setApplicationDescription(QStringLiteral("Поиск манёвров в истории наборов элементов"));
+    parser.addHelpOption();
+    parser.addOption({QStringLiteral("scan"), QStringLiteral("Запуск поиска манёвров.")});
+    parser.addOption({QStringLiteral("sigma"),
+                      QStringLiteral("Порог скачков в робастных СКО (по умолчанию 8)."),
+                      QStringLiteral("value"),
+                      QStringLiteral("8")});
+    parser.addOption({QStringLiteral("bstar-ratio"),
+                      QStringLiteral("Во сколько раз должен измениться уровень B* (по умолчанию 5)."),
+                      QStringLiteral("value"),
+                      QStringLiteral("5")});
+    parser.addOption({QStringLiteral("min-missing"),
+                      QStringLiteral("Сколько номеров наборов подряд должно быть пропущено "
+                                     "(по умолчанию 3)."),
+                      QStringLiteral("count"),
+                      QStringLiteral("3")});
+    parser.addPositionalArgument(QStringLiteral("sources"),
+                                 QStringLiteral("Файл хранилища истории или файлы TLE/OMM."),
+                                 QStringLiteral("<file>..."));
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        qCritical("Не указаны источники данных");
+        return 1;
+    }
+
+    ManeuverSettings settings; //! Пороги поиска
+    settings.sigma = parser.value(QStringLiteral("sigma")).toDouble();
+    settings.bstarRatio = parser.value(QStringLiteral("bstar-ratio")).toDouble();
+    settings.minMissingSets = qMax(1, parser.value(QStringLiteral("min-missing")).toInt());
+
+    QVector<ManeuverEvent> events; //! Найденные события
+    TleHistoryStore store;         //! Хранилище истории
+    if (files.size() == 1 && store.open(files.first())) {
+        events = ManeuverDetector::scan(store, settings);
+    } else {
+        QVector<TleRecord> records; //! Наборы элементов из всех файлов
+        if (!loadFiles(files, ManeuverDetector::requiredFields(), records))
+            return 1;
+        events = ManeuverDetector::scan(records, settings);
+    }
+
+    printf("catalogNumber,epoch,previousEpoch,type,value,threshold\n");
+    for (const ManeuverEvent &event : events) {
+        const auto epochText = [](qint64 micros) {
+            return QDateTime::fromMSecsSinceEpoch(micros / 1000).toUTC().toString(Qt::ISODateWithMs);
+        };
+        printf("%d,%s,%s,%s,%.8g,%.8g\n",
+               event.catalogNumber,
+               qPrintable(epochText(event.epoch)),
+               qPrintable(epochText(event.previousEpoch)),
+               qUtf8Printable(ManeuverDetector::typeName(event.type)),
+               event.value,
+               event.threshold);
+    }
+    qInfo("Найдено событий: %d", int(events.size()));
+    return 0;
+}
+
+/*!
+ * \brief runHistoryImport - пополнение хранилища истории наборами элементов из файлов.
+ * \param argc Количество аргументов командной строки.
+ * \param argv Массив аргументов командной строки.
+ * \details
+ * Если файл хранилища уже существует, он открывается и пополняется: наборы с той же
+ * эпохой заменяются, остальные добавляются. Хранилище заменяется атомарно.
+ * \return Возвращает код завершения приложения.
+ */
+static int runHistoryImport(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser; //! Разбор аргументов командной строки
+    parser.setApplicationDescription(QStringLiteral("Импорт наборов элементов в историю"));
+    parser.addHelpOption();
+    parser.addOption({QStringLiteral("history-import"),
+                      QStringLiteral("Файл хранилища истории (создаётся, если его нет)."),
+                      QStringLiteral("store")});
+    parser.addPositionalArgument(QStringLiteral("sources"),
+                                 QStringLiteral("Файлы TLE/OMM (можно сжатые)."),
+                                 QStringLiteral("<file>..."));
+    parser.process(app);
+
+    const QString storePath = parser.value(QStringLiteral("history-import"));
+    const QStringList files = parser.positionalArguments();
+    if (storePath.isEmpty() || files.isEmpty()) {
+        qCritical("Укажите файл хранилища и файлы для импорта");
+        return 1;
+    }
+
+    TleHistoryStore store; //! Хранилище истории
+    //! Существующий файл пополняется; файл другого формата не перезаписывается
+    if (QFileInfo::exists(storePath) && !store.open(storePath)) {
+        qCritical("%s", qUtf8Printable(store.errorString()));
+        return 1;
+    }
+    QVector<TleRecord> records; //! Наборы элементов из всех файлов
+    if (!loadFiles(files, TleField::All, records))
+        return 1;
+    store.add(records);
+    if (!store.save(storePath)) {
+        qCritical("%s", qUtf8Printable(store.errorString()));
+        return 1;
+    }
+    qInfo("Импортировано наборов: %d; в хранилище объектов: %d, наборов: %lld, байт: %lld",
+          int(records.size()),
+          int(store.catalogNumbers().size()),
+          store.elementSetCount(),
+          store.compressedSize());
+    return 0;
+}
+
+/*!
+ * \brief parseUtc - момент времени ISO 8601 (без смещения — UTC).
+ * \param text Строка вида 2025-03-19 или 2025-03-19T12:00:00.
+ * \param msecs Выход: миллисекунды от 01.01.1970 UTC.
+ * \return false, если строка не разобрана.
+ */
+static bool parseUtc(const QString &text, qint64 &msecs)
+{
+    QDateTime time = QDateTime::fromString(text, Qt::ISODate);
+    if (!time.isValid()) {
+        const QDate date = QDate::fromString(text, Qt::ISODate);
+        if (!date.isValid())
+            return false;
+        time = QDateTime(date, QTime(0, 0)); //! Начало суток; ниже переводится в UTC
+    }
+    if (time.timeSpec() == Qt::LocalTime) {
+#if QT_VERSION < QT_VERSION_CHECK(6, 5, 0)
+        time = QDateTime(time.date(), time.time(), Qt::UTC);
+#else
+        time = QDateTime(time.date(), time.time(), QTimeZone::utc());
+#endif
+    }
+    msecs = time.toMSecsSinceEpoch();
+    return true;
+}
+
+/*!
+ * \brief runHistoryQuery - наборы элементов объекта из хранилища истории.
+ * \param argc Количество аргументов командной строки.
+ * \param argv Массив аргументов командной строки.
+ * \details
+ * С ключом --as-of выводится последний набор на момент времени, иначе — все наборы
+ * в диапазоне --from/--to (по умолчанию — вся история). Наборы выводятся в стандартный
+ * вывод в формате 3LE.
+ * \return Возвращает код завершения приложения.
+ */
+static int runHistoryQuery(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser; //! Разбор аргументов командной строки
+    parser.setApplicationDescription(QStringLiteral("Запрос к хранилищу истории"));
+    parser.addHelpOption();
+    parser.addOption({QStringLiteral("history-query"),
+                      QStringLiteral("Файл хранилища истории."),
+                      QStringLiteral("store")});
+    parser.addOption(
+        {QStringLiteral("catalog"), QStringLiteral("Номер объекта."), QStringLiteral("number")});
+    parser.addOption({QStringLiteral("from"),
+                      QStringLiteral("Начало диапазона эпох (ISO 8601, UTC)."),
+                      QStringLiteral("time")});
+    parser.addOption({QStringLiteral("to"),
+                      QStringLiteral("Конец диапазона эпох (ISO 8601, UTC)."),
+                      QStringLiteral("time")});
+    parser.addOption({QStringLiteral("as-of"),
+                      QStringLiteral("Последний набор на момент времени (ISO 8601, UTC)."),
+                      QStringLiteral("time")});
+    parser.process(app);
+
+    bool numberOk = false;
+    const int catalogNumber = parser.value(QStringLiteral("catalog")).toInt(&numberOk);
+    if (!numberOk) {
+        qCritical("Укажите номер объекта в --catalog");
+        return 1;
+    }
+    //! Вся история по умолчанию (хранилище переводит миллисекунды в микросекунды)
+    qint64 from = std::numeric_limits<qint64>::min() / 1000;
+    qint64 to = std::numeric_limits<qint64>::max() / 1000 - 1;
+    qint64 asOf = 0;
+    const bool single = parser.isSet(QStringLiteral("as-of"));
+    //! Необязательный момент времени: не задан — значение остаётся прежним
+    auto optionTime = [&parser](const QString &name, qint64 &msecs) {
+        return !parser.isSet(name) || parseUtc(parser.value(name), msecs);
+    };
+    if (!optionTime(QStringLiteral("from"), from) || !optionTime(QStringLiteral("to"), to)
+        || !optionTime(QStringLiteral("as-of"), asOf)) {
+        qCritical("Неверный момент времени (ожидается ISO 8601, например 2025-03-19T12:00:00)");
+        return 1;
+    }
+
+    TleHistoryStore store; //! Хранилище истории
+    if (!store.open(parser.value(QStringLiteral("history-query")))) {
+        qCritical("%s", qUtf8Printable(store.errorString()));
+        return 1;
+    }
+    QVector<TleRecord> records; //! Найденные наборы
+    if (single) {
+        TleRecord record;
+        if (store.asOf(catalogNumber, asOf, record))
+            records.append(record);
+    } else {
+        records = store.range(catalogNumber, from, to);
+    }
+
+#ifdef Q_OS_WIN
+    _setmode(_fileno(stdout), _O_BINARY); //! Без замены \n на \r\n: вывод совпадает с файлом
+#endif
+    QFile output;
+    if (!output.open(stdout, QIODevice::WriteOnly))
+        return 1;
+    TleWriter writer(&output);
+    if (!writer.write(records) || !writer.flush())
+        return 1;
+    qInfo("Найдено наборов: %d", int(records.size()));
+    return 0;
+}
 
 /*!
  * \brief qMain функция приложения.
@@ -23,6 +526,22 @@
  */
 int main(int argc, char *argv[])
 {
+    //! Режимы без интерфейса выбираются до создания QApplication
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--serve") == 0)
+            return runServer(argc, argv);
+        if (qstrcmp(argv[i], "--stream") == 0)
+            return runStream(argc, argv);
+        if (qstrcmp(argv[i], "--shard-worker") == 0)
+            return runShardWorker(argc, argv);
+        if (qstrcmp(argv[i], "--scan") == 0)
+            return runScan(argc, argv);
+        if (qstrcmp(argv[i], "--history-import") == 0)
+            return runHistoryImport(argc, argv);
+        if (qstrcmp(argv[i], "--history-query") == 0)
+            return runHistoryQuery(argc, argv);
+    }
+
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
     QCoreApplication::setAttribute(Qt::AA_EnableHighDpiScaling); //! Включение поддержки HighDPI
     //! Использование высококачественных пиктограмм
@@ -0,0 +1,89 @@
+/*!
+ * \file TleWriterRoundTrip.cpp
+ * \brief Проверка повторной записи разобранного каталога.
+ * \details
+ * Этот файл содержит консольную проверку для ctest: каждая запись файлов 2LE/3LE,
+ * разобранная TleDataParser, записывается TleWriter, и результат должен совпасть
+ * с её исходными строками байт в байт (включая обе контрольные суммы).
+ * \author KorzikAlex
+ * \copyright This project is released under the MIT License.
+ * \date 2025
+ */
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+
+#include "Utils/TleDataParser.hpp"
+#include "Utils/TleWriter.hpp"
+
+namespace {
+
+/*!
+ * \brief checkFile - разбор и повторная запись одного файла
+ * \return Количество записей, записанных не так, как в файле
+ */
+int checkFile(const QString &path, QTextStream &err)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        err << path << ": не удалось открыть файл\n";
+        return 1;
+    }
+    QByteArray data = file.readAll();
+    if (!data.endsWith('\n'))
+        data += '\n'; //! parseChunk разбирает только завершённые строки
+
+    TleDataParser parser(TleField::All); //! Писатель читает все поля
+    QVector<TleRecord> records;
+    parser.parseChunk(data, records);
+    if (records.isEmpty()) {
+        err << path << ": нет записей TLE\n";
+        return 1;
+    }
+
+    //! Каждая запись записывается отдельно и сравнивается со своими исходными строками
+    int failures = 0;
+    for (const TleRecord &record : records) {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        {
+            TleWriter writer(&buffer);
+            writer.write(record);
+        }
+        QByteArray expected;
+        if (!record.name.isEmpty())
+            expected += QByteArray(record.name.data(), record.name.size()) + '\n';
+        expected += QByteArray(record.line1.data(), record.line1.size()) + '\n';
+        expected += QByteArray(record.line2.data(), record.line2.size()) + '\n';
+        if (buffer.data() != expected) {
+            err << path << ": запись " << record.catalogNumber << " записана иначе\n"
+                << "исходная:\n" << expected << "записана:\n" << buffer.data();
+            ++failures;
+        }
+    }
+    err << path << ": записей " << records.size() << ", расхождений " << failures << '\n';
+    return failures;
+}
+
+} // namespace
+
+/*!
+ * \brief main - точка входа проверки
+ * \return 0, если все записи файлов из аргументов записаны байт в байт
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream err(stderr);
+
+    const QStringList files = app.arguments().mid(1);
+    if (files.isEmpty()) {
+        err << "Использование: TleWriterRoundTrip <file>...\n";
+        return 2;
+    }
+    int failures = 0;
+    for (const QString &path : files)
+        failures += checkFile(path, err);
+    return failures == 0 ? 0 : 1;
+}